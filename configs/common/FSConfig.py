@@ -774,6 +774,8 @@ def makeDistRoot(
     linkspeed,
     linkdelay,
     dumpfile,
+    transport="tcp",
+    shm_name="gem5-dist",
 ):
     self = Root(full_system=True)
     self.testsys = testSystem
@@ -785,6 +787,8 @@ def makeDistRoot(
         dist_size=size,
         server_name=server_name,
         server_port=server_port,
+        transport=transport,
+        shm_name=shm_name,
         sync_start=sync_start,
         sync_repeat=sync_repeat,
     )
@@ -413,6 +413,21 @@ def addCommonOptions(parser):
         type=int,
         help="Message server listen port\nDEFAULT: 2200",
     )
+    parser.add_argument(
+        "--dist-transport",
+        default="tcp",
+        choices=["tcp", "shm"],
+        help="Transport between the dist-gem5 processes, shm only works "
+        "when they all run on one host\nDEFAULT: tcp",
+    )
+    parser.add_argument(
+        "--dist-shm-name",
+        default="gem5-dist",
+        action="store",
+        type=str,
+        help="Prefix of the shared memory segments of the shm transport, "
+        "unique to each simulation on the host\nDEFAULT: gem5-dist",
+    )
     parser.add_argument(
         "--dist-sync-repeat",
         default="0us",
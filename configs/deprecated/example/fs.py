@@ -396,6 +396,8 @@ elif len(bm) == 1 and args.dist:
         args.ethernet_linkspeed,
         args.ethernet_linkdelay,
         args.etherdump,
+        transport=args.dist_transport,
+        shm_name=args.dist_shm_name,
     )
 elif len(bm) == 1:
     root = Root(full_system=True, system=test_sys)
@@ -54,6 +54,8 @@ def build_switch(args):
             dist_size=args.dist_size,
             server_name=args.dist_server_name,
             server_port=args.dist_server_port,
+            transport=args.dist_transport,
+            shm_name=args.dist_shm_name,
             sync_start=args.dist_sync_start,
             sync_repeat=args.dist_sync_repeat,
             is_switch=True,
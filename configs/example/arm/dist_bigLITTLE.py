@@ -87,6 +87,21 @@ def addOptions(parser):
         type=int,
         help="Message server listen port\nDEFAULT: 2200",
     )
+    parser.add_argument(
+        "--dist-transport",
+        default="tcp",
+        choices=["tcp", "shm"],
+        help="Transport between the dist-gem5 processes, shm only works "
+        "when they all run on one host\nDEFAULT: tcp",
+    )
+    parser.add_argument(
+        "--dist-shm-name",
+        default="gem5-dist",
+        action="store",
+        type=str,
+        help="Prefix of the shared memory segments of the shm transport, "
+        "unique to each simulation on the host\nDEFAULT: gem5-dist",
+    )
     parser.add_argument(
         "--dist-sync-repeat",
         default="0us",
@@ -149,6 +164,8 @@ def addEthernet(system, options):
         dist_size=options.dist_size,
         server_name=options.dist_server_name,
         server_port=options.dist_server_port,
+        transport=options.dist_transport,
+        shm_name=options.dist_shm_name,
         sync_start=options.dist_sync_start,
         sync_repeat=options.dist_sync_repeat,
     )
@@ -0,0 +1,70 @@
+# Copyright (c) 2026 The Regents of The University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Replays a branch trace, recorded by attaching a BranchTraceRecorder to a
+# CPU, through a branch predictor and reports its accuracy in the stats.
+#
+# Record:
+#   cpu.branch_recorder = BranchTraceRecorder(manager=cpu)
+# Replay:
+#   gem5.opt configs/example/branch_trace_replay.py \
+#       --trace m5out/branches.trace.gz --bpred TAGE_SC_L_64KB
+
+import argparse
+
+import m5
+from m5.util import fatal
+from m5.objects import *
+
+parser = argparse.ArgumentParser(
+    formatter_class=argparse.ArgumentDefaultsHelpFormatter
+)
+parser.add_argument("--trace", required=True, help="Branch trace to replay")
+parser.add_argument(
+    "--bpred", default="LTAGE", help="Branch predictor class to evaluate"
+)
+parser.add_argument(
+    "--max-branches",
+    type=int,
+    default=0,
+    help="Number of branches to replay, 0 for all",
+)
+args = parser.parse_args()
+
+bpred_class = getattr(m5.objects, args.bpred, None)
+if bpred_class is None or not issubclass(bpred_class, BranchPredictor):
+    fatal(f"{args.bpred} is not a branch predictor.")
+
+root = Root(full_system=False)
+root.replayer = BranchTraceReplayer(
+    bpred=bpred_class(),
+    trace_file=args.trace,
+    max_branches=args.max_branches,
+)
+
+m5.instantiate()
+exit_event = m5.simulate()
+print(f"Exiting @ tick {m5.curTick()} because {exit_event.getCause()}")
@@ -199,6 +199,7 @@ MMU::invalidateMiscReg()
     s1State.miscRegValid = false;
     s1State.computeAddrTop.flush();
     s2State.computeAddrTop.flush();
+    translationsChanged();
 }
 
 Fault
@@ -314,6 +314,7 @@ class MMU : public BaseMMU
     void
     flushStage1(const OP &tlbi_op)
     {
+        translationsChanged();
         for (auto tlb : instruction) {
             static_cast<TLB*>(tlb)->flush(tlbi_op);
         }
@@ -329,6 +330,7 @@ class MMU : public BaseMMU
     void
     flushStage2(const OP &tlbi_op)
     {
+        translationsChanged();
         itbStage2->flush(tlbi_op);
         dtbStage2->flush(tlbi_op);
     }
@@ -337,6 +339,7 @@ class MMU : public BaseMMU
     void
     iflush(const OP &tlbi_op)
     {
+        translationsChanged();
         for (auto tlb : instruction) {
             static_cast<TLB*>(tlb)->flush(tlbi_op);
         }
@@ -349,6 +352,7 @@ class MMU : public BaseMMU
     void
     dflush(const OP &tlbi_op)
     {
+        translationsChanged();
         for (auto tlb : data) {
             static_cast<TLB*>(tlb)->flush(tlbi_op);
         }
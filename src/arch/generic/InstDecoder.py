@@ -34,3 +34,8 @@ class InstDecoder(SimObject):
     cxx_class = "gem5::InstDecoder"
 
     isa = Param.BaseISA(NULL, "ISA object for this context")
+    shared_decode_cache = Param.SharedDecodeCache(
+        NULL,
+        "Decoded instruction cache shared with other decoders. Only "
+        "share a cache between decoders of identically configured ISAs.",
+    )
@@ -31,6 +31,7 @@
 
 #include "base/types.hh"
 #include "cpu/decode_cache.hh"
+#include "cpu/shared_decode_cache.hh"
 #include "cpu/static_inst_fwd.hh"
 
 namespace gem5
@@ -70,7 +71,14 @@ class BasicDecodeCache
             return entry.inst;
         }
 
-        entry.inst = decoder->decodeInst(mach_inst);
+        if (auto *shared = decoder->sharedDecodeCache()) {
+            entry.inst = shared->decode(mach_inst, 0,
+                    [decoder](const EMI &inst) {
+                        return decoder->decodeInst(inst);
+                    });
+        } else {
+            entry.inst = decoder->decodeInst(mach_inst);
+        }
         instMap[mach_inst] = entry.inst;
         return entry.inst;
     }
@@ -39,6 +39,8 @@
 namespace gem5
 {
 
+class SharedDecodeCache;
+
 class InstDecoder : public SimObject
 {
   protected:
@@ -49,14 +51,20 @@ class InstDecoder : public SimObject
     bool instDone = false;
     bool outOfBytes = true;
 
+    /// Optional cache shared with other decoders, see SharedDecodeCache.
+    SharedDecodeCache *const _sharedDecodeCache;
+
   public:
     template <typename MoreBytesType>
     InstDecoder(const InstDecoderParams &params, MoreBytesType *mb_buf) :
         SimObject(params), _moreBytesPtr(mb_buf),
         _moreBytesSize(sizeof(MoreBytesType)),
-        _pcMask(~mask(floorLog2(_moreBytesSize)))
+        _pcMask(~mask(floorLog2(_moreBytesSize))),
+        _sharedDecodeCache(params.shared_decode_cache)
     {}
 
+    SharedDecodeCache *sharedDecodeCache() const { return _sharedDecodeCache; }
+
     virtual StaticInstPtr fetchRomMicroop(
             MicroPC micropc, StaticInstPtr curMacroop);
     virtual void
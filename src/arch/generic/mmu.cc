@@ -80,6 +80,7 @@ BaseMMU::init()
 void
 BaseMMU::flushAll()
 {
+    translationsChanged();
     for (auto tlb : instruction) {
         tlb->flushAll();
     }
@@ -96,6 +97,7 @@ BaseMMU::flushAll()
 void
 BaseMMU::demapPage(Addr vaddr, uint64_t asn)
 {
+    translationsChanged();
     itb->demapPage(vaddr, asn);
     dtb->demapPage(vaddr, asn);
 }
@@ -169,6 +171,7 @@ BaseMMU::takeOverFrom(BaseMMU *old_mmu)
 
     itb->takeOverFrom(old_mmu->itb);
     dtb->takeOverFrom(old_mmu->dtb);
+    translationsChanged();
 }
 
 } // namespace gem5
@@ -111,6 +111,19 @@ class BaseMMU : public SimObject
 
     void demapPage(Addr vaddr, uint64_t asn);
 
+    /**
+     * A number which changes whenever translations may change, for
+     * anything caching the results of translations to check they're
+     * still valid. It changes when entries of the TLBs are invalidated,
+     * and when the state of the translating threads changes, e.g., on
+     * execution mode switches, as long as their thread contexts report
+     * it through translationsChanged().
+     */
+    uint64_t translationGen() const { return _translationGen; }
+
+    /** Signal that translations may have changed. */
+    void translationsChanged() { _translationGen++; }
+
     virtual Fault
     translateAtomic(const RequestPtr &req, ThreadContext *tc,
                     Mode mode);
@@ -182,6 +195,8 @@ class BaseMMU : public SimObject
     std::set<BaseTLB*> data;
     std::set<BaseTLB*> unified;
 
+  private:
+    uint64_t _translationGen = 0;
 };
 
 } // namespace gem5
@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __ARCH_GENERIC_SET_ASSOC_TLB_HH__
+#define __ARCH_GENERIC_SET_ASSOC_TLB_HH__
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "base/bitfield.hh"
+#include "base/logging.hh"
+#include "base/types.hh"
+#include "mem/cache/replacement_policies/base.hh"
+#include "mem/cache/replacement_policies/replaceable_entry.hh"
+
+namespace gem5
+{
+
+/**
+ * Set-associative array of TLB entries, which ISA TLBs can build on.
+ *
+ * Entries are found by a key, typically a virtual address combined with
+ * an address space identifier, and each entry ignores some low bits of
+ * the key, e.g., the offset in its page. An entry is placed in the set
+ * the bits of the key above the ones it ignores map to, so lookups
+ * probe one set per page size present in the TLB, starting from the
+ * smallest pages. The tags are kept apart from the entries for lookups
+ * to only scan them.
+ *
+ * The entries to replace are picked by a replacement policy among the
+ * entries of their set. Without a policy, the least recently used entry
+ * is replaced, the recency being kept as a sequence number which unlike
+ * LRURP's tick never ties.
+ */
+template <class Entry>
+class SetAssociativeTLB
+{
+  private:
+    struct Way : public ReplaceableEntry
+    {
+        Entry entry;
+    };
+
+    /** Number of ignored bits of invalid ways. */
+    static constexpr uint8_t Invalid = 0xff;
+
+    const size_t numEntries;
+    const size_t assoc;
+    const size_t numSets;
+    /** Smallest number of low bits which don't index sets. */
+    const unsigned indexShift;
+    replacement_policy::Base *const policy;
+
+    std::vector<Way> ways;
+    std::vector<Addr> tags;
+    std::vector<uint8_t> ignoredBits;
+    /** Sequence number of the last use of each way, without a policy. */
+    std::vector<uint64_t> lastUse;
+    uint64_t useCount;
+
+    /** Number of valid entries ignoring each number of bits. */
+    std::array<size_t, 64> numByBits;
+    /** Numbers of ignored bits used by valid entries, as a mask. */
+    uint64_t bitsInUse;
+    size_t numValid;
+
+    size_t
+    firstWay(Addr key, unsigned bits) const
+    {
+        return ((key >> std::max(bits, indexShift)) % numSets) * assoc;
+    }
+
+    size_t
+    find(Addr key) const
+    {
+        for (uint64_t in_use = bitsInUse; in_use; in_use &= in_use - 1) {
+            const unsigned bits = ctz64(in_use);
+            const size_t first = firstWay(key, bits);
+            for (size_t i = first; i < first + assoc; i++) {
+                if (ignoredBits[i] == bits && !((key ^ tags[i]) >> bits))
+                    return i;
+            }
+        }
+        return numEntries;
+    }
+
+    void
+    invalidateWay(size_t i)
+    {
+        assert(ignoredBits[i] != Invalid);
+        const unsigned bits = ignoredBits[i];
+        if (--numByBits[bits] == 0)
+            bitsInUse &= ~(1ULL << bits);
+        numValid--;
+        ignoredBits[i] = Invalid;
+        if (policy)
+            policy->invalidate(ways[i].replacementData);
+    }
+
+    void
+    touch(size_t i)
+    {
+        if (policy)
+            policy->touch(ways[i].replacementData);
+        else
+            lastUse[i] = ++useCount;
+    }
+
+    size_t
+    victim(size_t first)
+    {
+        if (!policy) {
+            return std::min_element(lastUse.begin() + first,
+                                    lastUse.begin() + first + assoc) -
+                lastUse.begin();
+        }
+        ReplacementCandidates candidates(assoc);
+        for (size_t i = 0; i < assoc; i++)
+            candidates[i] = &ways[first + i];
+        return first +
+            static_cast<Way *>(policy->getVictim(candidates))->getWay();
+    }
+
+  public:
+    /**
+     * @param num_entries Number of entries.
+     * @param associativity Number of entries of each set, or 0 for a
+     * fully associative TLB.
+     * @param index_shift Number of low bits of the keys which never
+     * index sets, typically the shift of the smallest pages.
+     * @param replacement_policy Replacement policy of the sets, or
+     * nullptr to replace the least recently used entry.
+     */
+    SetAssociativeTLB(size_t num_entries, size_t associativity,
+                      unsigned index_shift,
+                      replacement_policy::Base *replacement_policy)
+        : numEntries(num_entries),
+          assoc(associativity ? associativity : num_entries),
+          numSets(assoc ? num_entries / assoc : 0), indexShift(index_shift),
+          policy(replacement_policy), ways(num_entries),
+          tags(num_entries, 0), ignoredBits(num_entries, Invalid),
+          lastUse(policy ? 0 : num_entries, 0), useCount(0),
+          numByBits{}, bitsInUse(0), numValid(0)
+    {
+        fatal_if(!num_entries, "TLBs must have a non-zero size.\n");
+        fatal_if(num_entries % assoc, "The size of a TLB (%d) must be a "
+                 "multiple of its associativity (%d).\n", num_entries, assoc);
+
+        for (size_t i = 0; i < numEntries; i++) {
+            ways[i].setPosition(i / assoc, i % assoc);
+            if (policy)
+                ways[i].replacementData = policy->instantiateEntry();
+        }
+    }
+
+    /**
+     * Find the entry a key maps to, favoring the smallest pages.
+     *
+     * @param key Key to look up.
+     * @param update Whether the access updates the replacement data.
+     * @return The entry, or nullptr on a miss.
+     */
+    Entry *
+    lookup(Addr key, bool update=true)
+    {
+        const size_t i = find(key);
+        if (i == numEntries)
+            return nullptr;
+        if (update)
+            touch(i);
+        return &ways[i].entry;
+    }
+
+    /**
+     * Insert an entry, replacing one of its set if it's full.
+     *
+     * @param key Key of the entry.
+     * @param ignored_bits Number of low bits of keys the entry ignores.
+     * @param entry The entry to insert.
+     * @return The inserted entry.
+     */
+    Entry *
+    insert(Addr key, unsigned ignored_bits, const Entry &entry)
+    {
+        assert(ignored_bits < 64);
+        const size_t first = firstWay(key, ignored_bits);
+
+        size_t way = numEntries;
+        for (size_t i = first; i < first + assoc; i++) {
+            if (ignoredBits[i] == Invalid) {
+                way = i;
+                break;
+            }
+        }
+        if (way == numEntries) {
+            way = victim(first);
+            invalidateWay(way);
+        }
+
+        ways[way].entry = entry;
+        tags[way] = key;
+        ignoredBits[way] = ignored_bits;
+        numByBits[ignored_bits]++;
+        bitsInUse |= 1ULL << ignored_bits;
+        numValid++;
+        if (policy)
+            policy->reset(ways[way].replacementData);
+        else
+            lastUse[way] = ++useCount;
+        return &ways[way].entry;
+    }
+
+    /**
+     * Invalidate the entry a key maps to, if any.
+     *
+     * @return Whether an entry was invalidated.
+     */
+    bool
+    invalidate(Addr key)
+    {
+        const size_t i = find(key);
+        if (i == numEntries)
+            return false;
+        invalidateWay(i);
+        return true;
+    }
+
+    /** Invalidate the entries a predicate holds for. */
+    template <class Pred>
+    void
+    invalidateIf(Pred pred)
+    {
+        for (size_t i = 0; i < numEntries && numValid; i++) {
+            if (ignoredBits[i] != Invalid && pred(ways[i].entry))
+                invalidateWay(i);
+        }
+    }
+
+    /** Invalidate all the entries. */
+    void invalidateAll() { invalidateIf([](const Entry &) { return true; }); }
+
+    /** Call a function with every valid entry. */
+    template <class Func>
+    void
+    forEach(Func func) const
+    {
+        for (size_t i = 0; i < numEntries; i++) {
+            if (ignoredBits[i] != Invalid)
+                func(ways[i].entry);
+        }
+    }
+
+    /** Number of valid entries. */
+    size_t size() const { return numValid; }
+
+    /** Number of entries the TLB can hold. */
+    size_t capacity() const { return numEntries; }
+};
+
+} // namespace gem5
+
+#endif // __ARCH_GENERIC_SET_ASSOC_TLB_HH__
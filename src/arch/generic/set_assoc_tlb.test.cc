@@ -0,0 +1,206 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "arch/generic/set_assoc_tlb.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+struct Entry
+{
+    int id = 0;
+};
+
+const unsigned SmallPage = 12;
+const unsigned LargePage = 21;
+
+/** A TLB replacing its least recently used entries. */
+class LruTLB : public SetAssociativeTLB<Entry>
+{
+  public:
+    LruTLB(size_t size, size_t assoc)
+        : SetAssociativeTLB<Entry>(size, assoc, SmallPage, nullptr)
+    {}
+
+    void
+    insert(Addr key, int id, unsigned bits=SmallPage)
+    {
+        SetAssociativeTLB<Entry>::insert(key, bits, Entry{id});
+    }
+
+    /** The entry a key maps to, or -1 on a miss. */
+    int
+    idOf(Addr key, bool update=true)
+    {
+        const Entry *entry = lookup(key, update);
+        return entry ? entry->id : -1;
+    }
+};
+
+} // anonymous namespace
+
+TEST(SetAssociativeTLBTest, HitAndMiss)
+{
+    LruTLB tlb(8, 0);
+    EXPECT_EQ(tlb.capacity(), 8);
+    EXPECT_EQ(tlb.size(), 0);
+    EXPECT_EQ(tlb.idOf(0x1000), -1);
+
+    tlb.insert(0x1000, 1);
+    EXPECT_EQ(tlb.size(), 1);
+    EXPECT_EQ(tlb.idOf(0x1000), 1);
+    EXPECT_EQ(tlb.idOf(0x1fff), 1);
+    EXPECT_EQ(tlb.idOf(0x2000), -1);
+    EXPECT_EQ(tlb.idOf(0x0fff), -1);
+}
+
+TEST(SetAssociativeTLBTest, MixedPageSizes)
+{
+    LruTLB tlb(16, 4);
+    tlb.insert(0x200000, 1, LargePage);
+    tlb.insert(0x1000, 2);
+    EXPECT_EQ(tlb.idOf(0x200000), 1);
+    EXPECT_EQ(tlb.idOf(0x3fffff), 1);
+    EXPECT_EQ(tlb.idOf(0x400000), -1);
+    EXPECT_EQ(tlb.idOf(0x1abc), 2);
+
+    // The smallest page is found first when both map a key.
+    tlb.insert(0x0, 3, LargePage);
+    EXPECT_EQ(tlb.idOf(0x1abc), 2);
+    EXPECT_EQ(tlb.idOf(0x2abc), 3);
+    EXPECT_EQ(tlb.size(), 3);
+
+    // Removing the last small page leaves the large ones reachable.
+    EXPECT_TRUE(tlb.invalidate(0x1000));
+    EXPECT_EQ(tlb.idOf(0x1abc), 3);
+    EXPECT_EQ(tlb.idOf(0x200000), 1);
+    EXPECT_FALSE(tlb.invalidate(0x1000 + (1 << LargePage) * 4));
+}
+
+TEST(SetAssociativeTLBTest, FullyAssociativeEviction)
+{
+    LruTLB tlb(4, 0);
+    for (int i = 0; i < 4; i++)
+        tlb.insert(i << SmallPage, i);
+
+    // Entries 0 and 1 are used again, 2 is looked up without updating
+    // the recency, so 2 and then 3 are the least recently used.
+    EXPECT_EQ(tlb.idOf(0 << SmallPage), 0);
+    EXPECT_EQ(tlb.idOf(1 << SmallPage), 1);
+    EXPECT_EQ(tlb.idOf(2 << SmallPage, false), 2);
+
+    tlb.insert(4 << SmallPage, 4);
+    EXPECT_EQ(tlb.size(), 4);
+    EXPECT_EQ(tlb.idOf(2 << SmallPage), -1);
+
+    tlb.insert(5 << SmallPage, 5);
+    EXPECT_EQ(tlb.idOf(3 << SmallPage), -1);
+    EXPECT_EQ(tlb.idOf(0 << SmallPage), 0);
+    EXPECT_EQ(tlb.idOf(1 << SmallPage), 1);
+    EXPECT_EQ(tlb.idOf(4 << SmallPage), 4);
+    EXPECT_EQ(tlb.idOf(5 << SmallPage), 5);
+}
+
+/** Accesses in the same tick are still ordered, unlike with LRURP. */
+TEST(SetAssociativeTLBTest, RecencyOfSameTickAccesses)
+{
+    LruTLB tlb(2, 0);
+    tlb.insert(0x1000, 1);
+    tlb.insert(0x2000, 2);
+    EXPECT_EQ(tlb.idOf(0x1000), 1);
+    tlb.insert(0x3000, 3);
+    EXPECT_EQ(tlb.idOf(0x1000), 1);
+    EXPECT_EQ(tlb.idOf(0x2000), -1);
+}
+
+TEST(SetAssociativeTLBTest, SetAssociativeEviction)
+{
+    // 4 sets of 2 ways, indexed by the small page number.
+    LruTLB tlb(8, 2);
+    tlb.insert(0 << SmallPage, 0);
+    tlb.insert(4 << SmallPage, 4);
+    tlb.insert(1 << SmallPage, 1);
+    tlb.insert(5 << SmallPage, 5);
+
+    // Set 0 is full, so entry 0 is replaced even if set 2 is empty.
+    tlb.insert(8 << SmallPage, 8);
+    EXPECT_EQ(tlb.size(), 4);
+    EXPECT_EQ(tlb.idOf(0 << SmallPage), -1);
+    EXPECT_EQ(tlb.idOf(4 << SmallPage), 4);
+    EXPECT_EQ(tlb.idOf(8 << SmallPage), 8);
+    EXPECT_EQ(tlb.idOf(1 << SmallPage), 1);
+    EXPECT_EQ(tlb.idOf(5 << SmallPage), 5);
+
+    // Large pages are indexed by their own page number.
+    tlb.insert(0 << LargePage, 10, LargePage);
+    tlb.insert(4 << LargePage, 14, LargePage);
+    tlb.insert(8 << LargePage, 18, LargePage);
+    EXPECT_EQ(tlb.idOf(0 << LargePage), -1);
+    EXPECT_EQ(tlb.idOf(4 << LargePage), 14);
+    EXPECT_EQ(tlb.idOf(8 << LargePage), 18);
+    EXPECT_EQ(tlb.idOf(1 << SmallPage), 1);
+}
+
+TEST(SetAssociativeTLBTest, InvalidateIf)
+{
+    LruTLB tlb(8, 2);
+    for (int i = 0; i < 8; i++)
+        tlb.insert(i << SmallPage, i);
+    // The large page replaces entry 1 in set 1.
+    tlb.insert(1 << LargePage, 8, LargePage);
+    EXPECT_EQ(tlb.size(), 8);
+    EXPECT_EQ(tlb.idOf(1 << SmallPage), -1);
+
+    tlb.invalidateIf([](const Entry &e) { return e.id % 2; });
+    EXPECT_EQ(tlb.size(), 5);
+
+    std::vector<int> ids;
+    tlb.forEach([&ids](const Entry &e) { ids.push_back(e.id); });
+    std::sort(ids.begin(), ids.end());
+    EXPECT_EQ(ids, std::vector<int>({0, 2, 4, 6, 8}));
+    EXPECT_EQ(tlb.idOf(3 << SmallPage), -1);
+    EXPECT_EQ(tlb.idOf(2 << SmallPage), 2);
+    EXPECT_EQ(tlb.idOf(1 << LargePage), 8);
+
+    // The invalidated ways are reused before replacing any entry.
+    tlb.insert(9 << SmallPage, 9);
+    EXPECT_EQ(tlb.size(), 6);
+    EXPECT_EQ(tlb.idOf(1 << LargePage), 8);
+
+    tlb.invalidateAll();
+    EXPECT_EQ(tlb.size(), 0);
+    EXPECT_EQ(tlb.idOf(2 << SmallPage), -1);
+    EXPECT_EQ(tlb.idOf(1 << LargePage), -1);
+}
@@ -68,6 +68,10 @@ class Decoder : public InstDecoder
     static GenericISA::BasicDecodeCache<Decoder, ExtMachInst> defaultCache;
     friend class GenericISA::BasicDecodeCache<Decoder, ExtMachInst>;
 
+    /// The static cache above isn't thread safe, so decoders backed by a
+    /// SharedDecodeCache use a private cache in front of it instead.
+    GenericISA::BasicDecodeCache<Decoder, ExtMachInst> privateCache;
+
     StaticInstPtr decodeInst(ExtMachInst mach_inst);
 
     /// Decode a machine instruction.
@@ -76,7 +80,8 @@ class Decoder : public InstDecoder
     StaticInstPtr
     decode(ExtMachInst mach_inst, Addr addr)
     {
-        StaticInstPtr si = defaultCache.decode(this, mach_inst, addr);
+        auto &cache = sharedDecodeCache() ? privateCache : defaultCache;
+        StaticInstPtr si = cache.decode(this, mach_inst, addr);
         DPRINTF(Decode, "Decode: Decoded %s instruction: %#x\n",
                 si->getName(), mach_inst);
         return si;
@@ -33,6 +33,7 @@ from m5.proxy import *
 
 from m5.objects.BaseTLB import BaseTLB
 from m5.objects.ClockedObject import ClockedObject
+from m5.objects.ReplacementPolicies import LRURP
 
 
 class RiscvPagetableWalker(ClockedObject):
@@ -45,6 +46,20 @@ class RiscvPagetableWalker(ClockedObject):
     num_squash_per_cycle = Param.Unsigned(
         4, "Number of outstanding walks that can be squashed per cycle"
     )
+    num_walkers = Param.Unsigned(
+        1, "Number of walks which can be in progress at once"
+    )
+    walk_cache_size = Param.Unsigned(
+        0,
+        "Number of non-leaf page table entries cached by the walker, or 0 "
+        "for no walk cache",
+    )
+    walk_cache_assoc = Param.Unsigned(
+        0, "Associativity of the walk cache, or 0 for a fully associative one"
+    )
+    walk_cache_replacement_policy = Param.BaseReplacementPolicy(
+        LRURP(), "Replacement policy of the walk cache sets"
+    )
     # Grab the pma_checker from the MMU
     pma_checker = Param.PMAChecker(Parent.any, "PMA Checker")
     pmp = Param.PMP(Parent.any, "PMP")
@@ -56,6 +71,14 @@ class RiscvTLB(BaseTLB):
     cxx_header = "arch/riscv/tlb.hh"
 
     size = Param.Int(64, "TLB size")
+    assoc = Param.Unsigned(
+        0, "Associativity of the TLB, or 0 for a fully associative TLB"
+    )
+    replacement_policy = Param.BaseReplacementPolicy(
+        NULL,
+        "Replacement policy of the TLB sets, or NULL to replace the least "
+        "recently used entry",
+    )
     walker = Param.RiscvPagetableWalker(
         RiscvPagetableWalker(), "page table walker"
     )
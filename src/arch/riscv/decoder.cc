@@ -30,6 +30,7 @@
 #include "arch/riscv/decoder.hh"
 #include "arch/riscv/types.hh"
 #include "base/bitfield.hh"
+#include "cpu/shared_decode_cache.hh"
 #include "debug/Decode.hh"
 
 namespace gem5
@@ -87,8 +88,16 @@ Decoder::decode(ExtMachInst mach_inst, Addr addr)
             mach_inst.instBits, addr);
 
     StaticInstPtr &si = instMap[mach_inst];
-    if (!si)
-        si = decodeInst(mach_inst);
+    if (!si) {
+        if (auto *shared = sharedDecodeCache()) {
+            si = shared->decode(mach_inst, 0,
+                    [this](const ExtMachInst &inst) {
+                        return decodeInst(inst);
+                    });
+        } else {
+            si = decodeInst(mach_inst);
+        }
+    }
 
     DPRINTF(Decode, "Decode: Decoded %s instruction: %#x\n",
             si->getName(), mach_inst);
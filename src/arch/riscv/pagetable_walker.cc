@@ -69,6 +69,81 @@ namespace gem5
 
 namespace RiscvISA {
 
+Walker::Walker(const Params &params) :
+    ClockedObject(params), port(name() + ".port", this),
+    funcState(this, NULL, NULL, true),
+    numWalkers(params.num_walkers), tlb(NULL), sys(params.system),
+    pma(params.pma_checker),
+    pmp(params.pmp),
+    requestorId(sys->getRequestorId(this)),
+    numSquashable(params.num_squash_per_cycle),
+    startWalkWrapperEvent([this]{ startWalkWrapper(); }, name()),
+    stats(this)
+{
+    fatal_if(!numWalkers, "%s: At least one walk must be possible.\n",
+             name());
+    for (unsigned i = 0; i < numWalkers; i++)
+        freeStates.push_back(new WalkerState(this, NULL, NULL));
+    if (params.walk_cache_size) {
+        walkCache.reset(new SetAssociativeTLB<WalkCacheEntry>(
+            params.walk_cache_size, params.walk_cache_assoc, 0,
+            params.walk_cache_replacement_policy));
+    }
+}
+
+Walker::~Walker()
+{
+    for (auto *state : freeStates)
+        delete state;
+}
+
+Walker::WalkerStats::WalkerStats(statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(walks, statistics::units::Count::get(),
+               "Number of page table walks"),
+      ADD_STAT(walkCacheHits, statistics::units::Count::get(),
+               "Number of walks started from an entry of the walk cache"),
+      ADD_STAT(entryReads, statistics::units::Count::get(),
+               "Number of page table entries read")
+{
+}
+
+Walker::WalkerState *
+Walker::allocState(BaseMMU::Translation *translation, const RequestPtr &req)
+{
+    if (freeStates.empty())
+        return new WalkerState(this, translation, req);
+    WalkerState *state = freeStates.back();
+    freeStates.pop_back();
+    *state = WalkerState(this, translation, req);
+    return state;
+}
+
+void
+Walker::freeState(WalkerState *state)
+{
+    if (freeStates.size() < numWalkers)
+        freeStates.push_back(state);
+    else
+        delete state;
+}
+
+unsigned
+Walker::numStarted() const
+{
+    unsigned started = 0;
+    for (auto *state : currStates)
+        started += state->started;
+    return started;
+}
+
+void
+Walker::flushWalkCache()
+{
+    if (walkCache)
+        walkCache->invalidateAll();
+}
+
 Fault
 Walker::start(ThreadContext * _tc, BaseMMU::Translation *_translation,
               const RequestPtr &_req, BaseMMU::Mode _mode)
@@ -76,9 +151,9 @@ Walker::start(ThreadContext * _tc, BaseMMU::Translation *_translation,
     // TODO: in timing mode, instead of blocking when there are other
     // outstanding requests, see if this request can be coalesced with
     // another one (i.e. either coalesce or start walk)
-    WalkerState * newState = new WalkerState(this, _translation, _req);
+    WalkerState * newState = allocState(_translation, _req);
     newState->initState(_tc, _mode, sys->isTimingMode());
-    if (currStates.size()) {
+    if (numStarted() >= numWalkers || currStates.size() > numStarted()) {
         assert(newState->isTiming());
         DPRINTF(PageTableWalker, "Walks in progress: %d\n", currStates.size());
         currStates.push_back(newState);
@@ -87,8 +162,8 @@ Walker::start(ThreadContext * _tc, BaseMMU::Translation *_translation,
         currStates.push_back(newState);
         Fault fault = newState->startWalk();
         if (!newState->isTiming()) {
-            currStates.pop_front();
-            delete newState;
+            currStates.pop_back();
+            freeState(newState);
         }
         return fault;
     }
@@ -125,10 +200,11 @@ Walker::recvTimingResp(PacketPtr pkt)
                 break;
             }
         }
-        delete senderWalk;
-        // Since we block requests when another is outstanding, we
+        freeState(senderWalk);
+        // Since we block requests when too many are outstanding, we
         // need to check if there is a waiting request to be serviced
-        if (currStates.size() && !startWalkWrapperEvent.scheduled())
+        if (currStates.size() > numStarted() &&
+                !startWalkWrapperEvent.scheduled())
             // delay sending any new requests until we are finished
             // with the responses
             schedule(startWalkWrapperEvent, clockEdge());
@@ -199,37 +275,46 @@ void
 Walker::startWalkWrapper()
 {
     unsigned num_squashed = 0;
-    WalkerState *currState = currStates.front();
-    while ((num_squashed < numSquashable) && currState &&
-        currState->translation->squashed()) {
-        currStates.pop_front();
-        num_squashed++;
-
-        DPRINTF(PageTableWalker, "Squashing table walk for address %#x\n",
-            currState->req->getVaddr());
-
-        // finish the translation which will delete the translation object
-        currState->translation->finish(
-            std::make_shared<UnimpFault>("Squashed Inst"),
-            currState->req, currState->tc, currState->mode);
-
-        // delete the current request if there are no inflight packets.
-        // if there is something in flight, delete when the packets are
-        // received and inflight is zero.
-        if (currState->numInflight() == 0) {
-            delete currState;
-        } else {
-            currState->squash();
+    unsigned num_started = numStarted();
+    auto it = currStates.begin();
+    while (it != currStates.end()) {
+        WalkerState *currState = *it;
+        // Walks start in order, as walkers free up.
+        if (!currState->wasStarted() && num_started >= numWalkers)
+            break;
+        if (num_squashed < numSquashable &&
+                currState->translation->squashed()) {
+            it = currStates.erase(it);
+            num_squashed++;
+            if (currState->wasStarted())
+                num_started--;
+
+            DPRINTF(PageTableWalker,
+                    "Squashing table walk for address %#x\n",
+                    currState->req->getVaddr());
+
+            // finish the translation which will delete the translation
+            // object
+            currState->translation->finish(
+                std::make_shared<UnimpFault>("Squashed Inst"),
+                currState->req, currState->tc, currState->mode);
+
+            // delete the current request if there are no inflight packets.
+            // if there is something in flight, delete when the packets are
+            // received and inflight is zero.
+            if (currState->numInflight() == 0) {
+                freeState(currState);
+            } else {
+                currState->squash();
+            }
+            continue;
         }
-
-        // check the next translation request, if it exists
-        if (currStates.size())
-            currState = currStates.front();
-        else
-            currState = NULL;
+        if (!currState->wasStarted()) {
+            currState->startWalk();
+            num_started++;
+        }
+        it++;
     }
-    if (currState && !currState->wasStarted())
-        currState->startWalk();
 }
 
 Fault
@@ -238,6 +323,7 @@ Walker::WalkerState::startWalk()
     Fault fault = NoFault;
     assert(!started);
     started = true;
+    walker->stats.walks++;
     setupWalk(req->getVaddr());
     if (timing) {
         nextState = state;
@@ -298,6 +384,8 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
     bool doEndWalk = false;
 
     DPRINTF(PageTableWalker, "Got level%d PTE: %#x\n", level, pte);
+    if (!functional)
+        walker->stats.entryReads++;
 
     // step 2:
     // Performing PMA/PMP checks on physical address of PTE
@@ -388,6 +476,7 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
                     Addr idx = (entry.vaddr >> shift) & LEVEL_MASK;
                     nextRead = (pte.ppn << PageShift) + (idx * sizeof(pte));
                     nextState = Translate;
+                    cacheTable(pte.ppn << PageShift);
                 }
             }
         }
@@ -440,6 +529,31 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
     return fault;
 }
 
+void
+Walker::WalkerState::cacheTable(Addr table)
+{
+    if (functional || !walker->walkCache)
+        return;
+
+    // The entry covers the addresses the entries of the upper levels
+    // index.
+    const unsigned ignored_bits = PageShift + LEVEL_BITS * (level + 1);
+    const Addr vaddr = mbits(entry.vaddr, VADDR_BITS - 1, ignored_bits);
+
+    WalkCacheEntry cached;
+    cached.root = satp;
+    cached.vaddr = vaddr;
+    cached.table = table;
+    cached.level = level;
+
+    // Replace any entry for the same page table, e.g., inserted by
+    // another walk in the meantime.
+    walker->walkCache->invalidateIf([&](const WalkCacheEntry &e) {
+        return e.vaddr == vaddr && e.level == level;
+    });
+    walker->walkCache->insert(vaddr, ignored_bits, cached);
+}
+
 void
 Walker::WalkerState::endWalk()
 {
@@ -458,6 +572,27 @@ Walker::WalkerState::setupWalk(Addr vaddr)
     Addr topAddr = (satp.ppn << PageShift) + (idx * sizeof(PTESv39));
     level = 2;
 
+    // Start from the deepest page table the walk cache has.
+    WalkCacheEntry *cached = nullptr;
+    if (!functional && walker->walkCache) {
+        const Addr key = bits(vaddr, VADDR_BITS - 1, 0);
+        cached = walker->walkCache->lookup(key);
+        // Drop the entries of other address spaces.
+        while (cached && cached->root != satp) {
+            walker->walkCache->invalidate(key);
+            cached = walker->walkCache->lookup(key);
+        }
+    }
+    if (cached) {
+        walker->stats.walkCacheHits++;
+        level = cached->level;
+        shift = PageShift + LEVEL_BITS * level;
+        idx = (vaddr >> shift) & LEVEL_MASK;
+        topAddr = cached->table + idx * sizeof(PTESv39);
+        DPRINTF(PageTableWalker, "Walk cache hit for %#x, level%d table "
+                "at %#x\n", vaddr, level, cached->table);
+    }
+
     DPRINTF(PageTableWalker, "Performing table walk for address %#x\n", vaddr);
     DPRINTF(PageTableWalker, "Loading level%d PTE from %#x\n", level, topAddr);
 
@@ -39,13 +39,16 @@
 #ifndef __ARCH_RISCV_TABLE_WALKER_HH__
 #define __ARCH_RISCV_TABLE_WALKER_HH__
 
+#include <memory>
 #include <vector>
 
 #include "arch/generic/mmu.hh"
+#include "arch/generic/set_assoc_tlb.hh"
 #include "arch/riscv/pagetable.hh"
 #include "arch/riscv/pma_checker.hh"
 #include "arch/riscv/pmp.hh"
 #include "arch/riscv/tlb.hh"
+#include "base/statistics.hh"
 #include "base/types.hh"
 #include "mem/packet.hh"
 #include "params/RiscvPagetableWalker.hh"
@@ -141,6 +144,7 @@ namespace RiscvISA
           private:
             void setupWalk(Addr vaddr);
             Fault stepWalk(PacketPtr &write);
+            void cacheTable(Addr table);
             void sendPackets();
             void endWalk();
             Fault pageFault(bool present);
@@ -152,6 +156,34 @@ namespace RiscvISA
         std::list<WalkerState *> currStates;
         // State for functional accesses (only need one of these per walker)
         WalkerState funcState;
+        // States which aren't in use, to avoid allocating one per walk
+        std::vector<WalkerState *> freeStates;
+
+        WalkerState *allocState(BaseMMU::Translation *translation,
+                                const RequestPtr &req);
+        void freeState(WalkerState *state);
+
+        // The number of walks which can be in progress at once.
+        unsigned numWalkers;
+        unsigned numStarted() const;
+
+        // Entry of the walk cache, which points to a page table the walks
+        // of the addresses it covers can start from.
+        struct WalkCacheEntry
+        {
+            // The root of the page tables the entry belongs to (SATP)
+            RegVal root;
+            // The first address the entry covers
+            Addr vaddr;
+            // Physical address of the page table
+            Addr table;
+            // The level of the page table
+            int level;
+        };
+
+        // Cache of the non-leaf page table entries, which walks don't need
+        // to read again.
+        std::unique_ptr<SetAssociativeTLB<WalkCacheEntry>> walkCache;
 
         struct WalkerSenderState : public Packet::SenderState
         {
@@ -169,6 +201,9 @@ namespace RiscvISA
         Port &getPort(const std::string &if_name,
                       PortID idx=InvalidPortID) override;
 
+        // Invalidate all the entries of the walk cache.
+        void flushWalkCache();
+
       protected:
         // The TLB we're supposed to load.
         TLB * tlb;
@@ -193,6 +228,15 @@ namespace RiscvISA
         void recvReqRetry();
         bool sendTiming(WalkerState * sendingState, PacketPtr pkt);
 
+        struct WalkerStats : public statistics::Group
+        {
+            WalkerStats(statistics::Group *parent);
+
+            statistics::Scalar walks;
+            statistics::Scalar walkCacheHits;
+            statistics::Scalar entryReads;
+        } stats;
+
       public:
 
         void setTLB(TLB * _tlb)
@@ -202,16 +246,8 @@ namespace RiscvISA
 
         using Params = RiscvPagetableWalkerParams;
 
-        Walker(const Params &params) :
-            ClockedObject(params), port(name() + ".port", this),
-            funcState(this, NULL, NULL, true), tlb(NULL), sys(params.system),
-            pma(params.pma_checker),
-            pmp(params.pmp),
-            requestorId(sys->getRequestorId(this)),
-            numSquashable(params.num_squash_per_cycle),
-            startWalkWrapperEvent([this]{ startWalkWrapper(); }, name())
-        {
-        }
+        Walker(const Params &params);
+        ~Walker();
     };
 
 } // namespace RiscvISA
@@ -71,15 +71,9 @@ buildKey(Addr vpn, uint16_t asid)
 }
 
 TLB::TLB(const Params &p) :
-    BaseTLB(p), size(p.size), tlb(size),
-    lruSeq(0), stats(this), pma(p.pma_checker),
-    pmp(p.pmp)
+    BaseTLB(p), tlb(p.size, p.assoc, PageShift, p.replacement_policy),
+    stats(this), pma(p.pma_checker), pmp(p.pmp)
 {
-    for (size_t x = 0; x < size; x++) {
-        tlb[x].trieHandle = NULL;
-        freeList.push_back(&tlb[x]);
-    }
-
     walker = p.walker;
     walker->setTLB(this);
 }
@@ -90,30 +84,12 @@ TLB::getWalker()
     return walker;
 }
 
-void
-TLB::evictLRU()
-{
-    // Find the entry with the lowest (and hence least recently updated)
-    // sequence number.
-
-    size_t lru = 0;
-    for (size_t i = 1; i < size; i++) {
-        if (tlb[i].lruSeq < tlb[lru].lruSeq)
-            lru = i;
-    }
-
-    remove(lru);
-}
-
 TlbEntry *
 TLB::lookup(Addr vpn, uint16_t asid, BaseMMU::Mode mode, bool hidden)
 {
-    TlbEntry *entry = trie.lookup(buildKey(vpn, asid));
+    TlbEntry *entry = tlb.lookup(buildKey(vpn, asid), !hidden);
 
     if (!hidden) {
-        if (entry)
-            entry->lruSeq = nextSeq();
-
         if (mode == BaseMMU::Write)
             stats.writeAccesses++;
         else
@@ -154,18 +130,9 @@ TLB::insert(Addr vpn, const TlbEntry &entry)
         return newEntry;
     }
 
-    if (freeList.empty())
-        evictLRU();
-
-    newEntry = freeList.front();
-    freeList.pop_front();
-
     Addr key = buildKey(vpn, entry.asid);
-    *newEntry = entry;
-    newEntry->lruSeq = nextSeq();
+    newEntry = tlb.insert(key, entry.logBytes, entry);
     newEntry->vaddr = vpn;
-    newEntry->trieHandle =
-    trie.insert(key, TlbEntryTrie::MaxBits - entry.logBytes, newEntry);
     return newEntry;
 }
 
@@ -177,21 +144,23 @@ TLB::demapPage(Addr vpn, uint64_t asid)
     if (vpn == 0 && asid == 0)
         flushAll();
     else {
+        walker->flushWalkCache();
         DPRINTF(TLB, "flush(vpn=%#x, asid=%#x)\n", vpn, asid);
         if (vpn != 0 && asid != 0) {
-            TlbEntry *newEntry = lookup(vpn, asid, BaseMMU::Read, true);
-            if (newEntry)
-                remove(newEntry - tlb.data());
+            tlb.invalidate(buildKey(vpn, asid));
         }
         else {
-            for (size_t i = 0; i < size; i++) {
-                if (tlb[i].trieHandle) {
-                    Addr mask = ~(tlb[i].size() - 1);
-                    if ((vpn == 0 || (vpn & mask) == tlb[i].vaddr) &&
-                        (asid == 0 || tlb[i].asid == asid))
-                        remove(i);
+            tlb.invalidateIf([&](const TlbEntry &entry) {
+                Addr mask = ~(entry.size() - 1);
+                if ((vpn != 0 && (vpn & mask) != entry.vaddr) ||
+                        (asid != 0 && entry.asid != asid)) {
+                    return false;
                 }
-            }
+                DPRINTF(TLB, "remove(vpn=%#x, asid=%#x): ppn=%#x pte=%#x "
+                        "size=%#x\n", entry.vaddr, entry.asid, entry.paddr,
+                        entry.pte, entry.size());
+                return true;
+            });
         }
     }
 }
@@ -200,23 +169,8 @@ void
 TLB::flushAll()
 {
     DPRINTF(TLB, "flushAll()\n");
-    for (size_t i = 0; i < size; i++) {
-        if (tlb[i].trieHandle)
-            remove(i);
-    }
-}
-
-void
-TLB::remove(size_t idx)
-{
-    DPRINTF(TLB, "remove(vpn=%#x, asid=%#x): ppn=%#x pte=%#x size=%#x\n",
-        tlb[idx].vaddr, tlb[idx].asid, tlb[idx].paddr, tlb[idx].pte,
-        tlb[idx].size());
-
-    assert(tlb[idx].trieHandle);
-    trie.remove(tlb[idx].trieHandle);
-    tlb[idx].trieHandle = NULL;
-    freeList.push_back(&tlb[idx]);
+    tlb.invalidateAll();
+    walker->flushWalkCache();
 }
 
 Fault
@@ -482,15 +436,13 @@ void
 TLB::serialize(CheckpointOut &cp) const
 {
     // Only store the entries in use.
-    uint32_t _size = size - freeList.size();
+    uint32_t _size = tlb.size();
     SERIALIZE_SCALAR(_size);
-    SERIALIZE_SCALAR(lruSeq);
 
     uint32_t _count = 0;
-    for (uint32_t x = 0; x < size; x++) {
-        if (tlb[x].trieHandle != NULL)
-            tlb[x].serializeSection(cp, csprintf("Entry%d", _count++));
-    }
+    tlb.forEach([&](const TlbEntry &entry) {
+        entry.serializeSection(cp, csprintf("Entry%d", _count++));
+    });
 }
 
 void
@@ -499,20 +451,14 @@ TLB::unserialize(CheckpointIn &cp)
     // Do not allow to restore with a smaller tlb.
     uint32_t _size;
     UNSERIALIZE_SCALAR(_size);
-    if (_size > size) {
+    if (_size > tlb.capacity()) {
         fatal("TLB size less than the one in checkpoint!");
     }
 
-    UNSERIALIZE_SCALAR(lruSeq);
-
     for (uint32_t x = 0; x < _size; x++) {
-        TlbEntry *newEntry = freeList.front();
-        freeList.pop_front();
-
-        newEntry->unserializeSection(cp, csprintf("Entry%d", x));
-        Addr key = buildKey(newEntry->vaddr, newEntry->asid);
-        newEntry->trieHandle = trie.insert(key,
-            TlbEntryTrie::MaxBits - newEntry->logBytes, newEntry);
+        TlbEntry entry;
+        entry.unserializeSection(cp, csprintf("Entry%d", x));
+        tlb.insert(buildKey(entry.vaddr, entry.asid), entry.logBytes, entry);
     }
 }
 
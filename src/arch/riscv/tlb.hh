@@ -32,8 +32,7 @@
 #ifndef __ARCH_RISCV_TLB_HH__
 #define __ARCH_RISCV_TLB_HH__
 
-#include <list>
-
+#include "arch/generic/set_assoc_tlb.hh"
 #include "arch/generic/tlb.hh"
 #include "arch/riscv/isa.hh"
 #include "arch/riscv/pagetable.hh"
@@ -58,14 +57,8 @@ class Walker;
 
 class TLB : public BaseTLB
 {
-    typedef std::list<TlbEntry *> EntryList;
-
   protected:
-    size_t size;
-    std::vector<TlbEntry> tlb;  // our TLB
-    TlbEntryTrie trie;          // for quick access
-    EntryList freeList;         // free entries
-    uint64_t lruSeq;
+    SetAssociativeTLB<TlbEntry> tlb;
 
     Walker *walker;
 
@@ -136,13 +129,8 @@ class TLB : public BaseTLB
                            BaseMMU::Mode mode) const override;
 
   private:
-    uint64_t nextSeq() { return ++lruSeq; }
-
     TlbEntry *lookup(Addr vpn, uint16_t asid, BaseMMU::Mode mode, bool hidden);
 
-    void evictLRU();
-    void remove(size_t idx);
-
     Fault translate(const RequestPtr &req, ThreadContext *tc,
                     BaseMMU::Translation *translation, BaseMMU::Mode mode,
                     bool &delayed);
@@ -38,6 +38,7 @@ from m5.proxy import *
 
 from m5.objects.BaseTLB import BaseTLB
 from m5.objects.ClockedObject import ClockedObject
+from m5.objects.ReplacementPolicies import LRURP
 
 
 class X86PagetableWalker(ClockedObject):
@@ -50,6 +51,20 @@ class X86PagetableWalker(ClockedObject):
     num_squash_per_cycle = Param.Unsigned(
         4, "Number of outstanding walks that can be squashed per cycle"
     )
+    num_walkers = Param.Unsigned(
+        1, "Number of walks which can be in progress at once"
+    )
+    walk_cache_size = Param.Unsigned(
+        0,
+        "Number of non-leaf long mode page table entries cached by the "
+        "walker, or 0 for no walk cache",
+    )
+    walk_cache_assoc = Param.Unsigned(
+        0, "Associativity of the walk cache, or 0 for a fully associative one"
+    )
+    walk_cache_replacement_policy = Param.BaseReplacementPolicy(
+        LRURP(), "Replacement policy of the walk cache sets"
+    )
 
 
 class X86TLB(BaseTLB):
@@ -58,6 +73,14 @@ class X86TLB(BaseTLB):
     cxx_header = "arch/x86/tlb.hh"
 
     size = Param.Unsigned(64, "TLB size")
+    assoc = Param.Unsigned(
+        0, "Associativity of the TLB, or 0 for a fully associative TLB"
+    )
+    replacement_policy = Param.BaseReplacementPolicy(
+        NULL,
+        "Replacement policy of the TLB sets, or NULL to replace the least "
+        "recently used entry",
+    )
     system = Param.System(Parent.any, "system object")
     walker = Param.X86PagetableWalker(
         X86PagetableWalker(), "page table walker"
@@ -44,6 +44,7 @@
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "base/types.hh"
+#include "cpu/shared_decode_cache.hh"
 #include "debug/Decode.hh"
 #include "debug/Decoder.hh"
 
@@ -695,7 +696,14 @@ Decoder::decode(ExtMachInst mach_inst, Addr addr)
     if (iter != instMap->end()) {
         si = iter->second;
     } else {
-        si = decodeInst(mach_inst);
+        if (auto *shared = sharedDecodeCache()) {
+            si = shared->decode(mach_inst, instMapKey,
+                    [this](const ExtMachInst &inst) {
+                        return decodeInst(inst);
+                    });
+        } else {
+            si = decodeInst(mach_inst);
+        }
         (*instMap)[mach_inst] = si;
     }
 
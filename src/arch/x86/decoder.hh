@@ -246,6 +246,13 @@ class Decoder : public InstDecoder
             CacheKey, decode_cache::InstMap<ExtMachInst> *> InstCacheMap;
     static InstCacheMap instCacheMap;
 
+    /// The static map above isn't thread safe, so decoders backed by a
+    /// SharedDecodeCache use a private map in front of it instead.
+    InstCacheMap privateInstCacheMap;
+
+    /// The m5Reg instMap belongs to, used as the SharedDecodeCache context.
+    CacheKey instMapKey = 0;
+
     StaticInstPtr decodeInst(ExtMachInst mach_inst);
 
     /// Decode a machine instruction.
@@ -287,13 +294,16 @@ class Decoder : public InstDecoder
             addrCacheMap[m5Reg] = decodePages;
         }
 
-        InstCacheMap::iterator imIter = instCacheMap.find(m5Reg);
-        if (imIter != instCacheMap.end()) {
+        InstCacheMap &inst_cache_map =
+            sharedDecodeCache() ? privateInstCacheMap : instCacheMap;
+        InstCacheMap::iterator imIter = inst_cache_map.find(m5Reg);
+        if (imIter != inst_cache_map.end()) {
             instMap = imIter->second;
         } else {
             instMap = new decode_cache::InstMap<ExtMachInst>;
-            instCacheMap[m5Reg] = instMap;
+            inst_cache_map[m5Reg] = instMap;
         }
+        instMapKey = m5Reg;
     }
 
     void
@@ -59,6 +59,7 @@ class MMU : public BaseMMU
     void
     flushNonGlobal()
     {
+        translationsChanged();
         static_cast<TLB*>(itb)->flushNonGlobal();
         static_cast<TLB*>(dtb)->flushNonGlobal();
     }
@@ -44,7 +44,6 @@
 #include "arch/x86/page_size.hh"
 #include "base/bitunion.hh"
 #include "base/types.hh"
-#include "base/trie.hh"
 #include "mem/port_proxy.hh"
 #include "sim/serialize.hh"
 
@@ -53,13 +52,6 @@ namespace gem5
 
 class ThreadContext;
 
-namespace X86ISA
-{
-    struct TlbEntry;
-}
-
-typedef Trie<Addr, X86ISA::TlbEntry> TlbEntryTrie;
-
 namespace X86ISA
 {
     struct TlbEntry : public Serializable
@@ -88,10 +80,6 @@ namespace X86ISA
         bool patBit;
         // Whether or not memory on this page can be executed.
         bool noExec;
-        // A sequence number to keep track of LRU.
-        uint64_t lruSeq;
-
-        TlbEntryTrie::Handle trieHandle;
 
         TlbEntry(Addr asn, Addr _vaddr, Addr _paddr,
                  bool uncacheable, bool read_only);
@@ -68,6 +68,79 @@ namespace gem5
 
 namespace X86ISA {
 
+Walker::Walker(const Params &params) :
+    ClockedObject(params), port(name() + ".port", this),
+    funcState(this, NULL, NULL, true),
+    numWalkers(params.num_walkers), tlb(NULL), sys(params.system),
+    requestorId(sys->getRequestorId(this)),
+    numSquashable(params.num_squash_per_cycle),
+    startWalkWrapperEvent([this]{ startWalkWrapper(); }, name()),
+    stats(this)
+{
+    fatal_if(!numWalkers, "%s: At least one walk must be possible.\n",
+             name());
+    for (unsigned i = 0; i < numWalkers; i++)
+        freeStates.push_back(new WalkerState(this, NULL, NULL));
+    if (params.walk_cache_size) {
+        walkCache.reset(new SetAssociativeTLB<WalkCacheEntry>(
+            params.walk_cache_size, params.walk_cache_assoc, 0,
+            params.walk_cache_replacement_policy));
+    }
+}
+
+Walker::~Walker()
+{
+    for (auto *state : freeStates)
+        delete state;
+}
+
+Walker::WalkerStats::WalkerStats(statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(walks, statistics::units::Count::get(),
+               "Number of page table walks"),
+      ADD_STAT(walkCacheHits, statistics::units::Count::get(),
+               "Number of walks started from an entry of the walk cache"),
+      ADD_STAT(entryReads, statistics::units::Count::get(),
+               "Number of page table entries read")
+{
+}
+
+Walker::WalkerState *
+Walker::allocState(BaseMMU::Translation *translation, const RequestPtr &req)
+{
+    if (freeStates.empty())
+        return new WalkerState(this, translation, req);
+    WalkerState *state = freeStates.back();
+    freeStates.pop_back();
+    *state = WalkerState(this, translation, req);
+    return state;
+}
+
+void
+Walker::freeState(WalkerState *state)
+{
+    if (freeStates.size() < numWalkers)
+        freeStates.push_back(state);
+    else
+        delete state;
+}
+
+unsigned
+Walker::numStarted() const
+{
+    unsigned started = 0;
+    for (auto *state : currStates)
+        started += state->started;
+    return started;
+}
+
+void
+Walker::flushWalkCache()
+{
+    if (walkCache)
+        walkCache->invalidateAll();
+}
+
 Fault
 Walker::start(ThreadContext * _tc, BaseMMU::Translation *_translation,
               const RequestPtr &_req, BaseMMU::Mode _mode)
@@ -75,9 +148,9 @@ Walker::start(ThreadContext * _tc, BaseMMU::Translation *_translation,
     // TODO: in timing mode, instead of blocking when there are other
     // outstanding requests, see if this request can be coalesced with
     // another one (i.e. either coalesce or start walk)
-    WalkerState * newState = new WalkerState(this, _translation, _req);
+    WalkerState * newState = allocState(_translation, _req);
     newState->initState(_tc, _mode, sys->isTimingMode());
-    if (currStates.size()) {
+    if (numStarted() >= numWalkers || currStates.size() > numStarted()) {
         assert(newState->isTiming());
         DPRINTF(PageTableWalker, "Walks in progress: %d\n", currStates.size());
         currStates.push_back(newState);
@@ -86,8 +159,8 @@ Walker::start(ThreadContext * _tc, BaseMMU::Translation *_translation,
         currStates.push_back(newState);
         Fault fault = newState->startWalk();
         if (!newState->isTiming()) {
-            currStates.pop_front();
-            delete newState;
+            currStates.pop_back();
+            freeState(newState);
         }
         return fault;
     }
@@ -124,10 +197,11 @@ Walker::recvTimingResp(PacketPtr pkt)
                 break;
             }
         }
-        delete senderWalk;
-        // Since we block requests when another is outstanding, we
+        freeState(senderWalk);
+        // Since we block requests when too many are outstanding, we
         // need to check if there is a waiting request to be serviced
-        if (currStates.size() && !startWalkWrapperEvent.scheduled())
+        if (currStates.size() > numStarted() &&
+                !startWalkWrapperEvent.scheduled())
             // delay sending any new requests until we are finished
             // with the responses
             schedule(startWalkWrapperEvent, clockEdge());
@@ -193,37 +267,46 @@ void
 Walker::startWalkWrapper()
 {
     unsigned num_squashed = 0;
-    WalkerState *currState = currStates.front();
-    while ((num_squashed < numSquashable) && currState &&
-        currState->translation->squashed()) {
-        currStates.pop_front();
-        num_squashed++;
-
-        DPRINTF(PageTableWalker, "Squashing table walk for address %#x\n",
-            currState->req->getVaddr());
-
-        // finish the translation which will delete the translation object
-        currState->translation->finish(
-            std::make_shared<UnimpFault>("Squashed Inst"),
-            currState->req, currState->tc, currState->mode);
-
-        // delete the current request if there are no inflight packets.
-        // if there is something in flight, delete when the packets are
-        // received and inflight is zero.
-        if (currState->numInflight() == 0) {
-            delete currState;
-        } else {
-            currState->squash();
+    unsigned num_started = numStarted();
+    auto it = currStates.begin();
+    while (it != currStates.end()) {
+        WalkerState *currState = *it;
+        // Walks start in order, as walkers free up.
+        if (!currState->wasStarted() && num_started >= numWalkers)
+            break;
+        if (num_squashed < numSquashable &&
+                currState->translation->squashed()) {
+            it = currStates.erase(it);
+            num_squashed++;
+            if (currState->wasStarted())
+                num_started--;
+
+            DPRINTF(PageTableWalker,
+                    "Squashing table walk for address %#x\n",
+                    currState->req->getVaddr());
+
+            // finish the translation which will delete the translation
+            // object
+            currState->translation->finish(
+                std::make_shared<UnimpFault>("Squashed Inst"),
+                currState->req, currState->tc, currState->mode);
+
+            // delete the current request if there are no inflight packets.
+            // if there is something in flight, delete when the packets are
+            // received and inflight is zero.
+            if (currState->numInflight() == 0) {
+                freeState(currState);
+            } else {
+                currState->squash();
+            }
+            continue;
         }
-
-        // check the next translation request, if it exists
-        if (currStates.size())
-            currState = currStates.front();
-        else
-            currState = NULL;
+        if (!currState->wasStarted()) {
+            currState->startWalk();
+            num_started++;
+        }
+        it++;
     }
-    if (currState && !currState->wasStarted())
-        currState->startWalk();
 }
 
 Fault
@@ -232,6 +315,7 @@ Walker::WalkerState::startWalk()
     Fault fault = NoFault;
     assert(!started);
     started = true;
+    walker->stats.walks++;
     setupWalk(req->getVaddr());
     if (timing) {
         nextState = state;
@@ -297,6 +381,9 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
     bool doTLBInsert = false;
     bool doEndWalk = false;
     bool badNX = pte.nx && mode == BaseMMU::Execute && enableNX;
+    if (!functional)
+        walker->stats.entryReads++;
+    noExecPath = noExecPath || pte.nx;
     switch(state) {
       case LongPML4:
         DPRINTF(PageTableWalker, "Got long mode PML4 entry %#016x.\n", pte);
@@ -312,6 +399,7 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
         }
         entry.noExec = pte.nx;
         nextState = LongPDP;
+        cacheTable(mbits(pte, 51, 12), 39, nextState, uncacheable);
         break;
       case LongPDP:
         DPRINTF(PageTableWalker, "Got long mode PDP entry %#016x.\n", pte);
@@ -326,6 +414,7 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
             break;
         }
         nextState = LongPD;
+        cacheTable(mbits(pte, 51, 12), 30, nextState, uncacheable);
         break;
       case LongPD:
         DPRINTF(PageTableWalker, "Got long mode PD entry %#016x.\n", pte);
@@ -343,6 +432,7 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
             entry.logBytes = 12;
             nextRead = mbits(pte, 51, 12) + vaddr.longl1 * dataSize;
             nextState = LongPTE;
+            cacheTable(mbits(pte, 51, 12), 21, nextState, uncacheable);
             break;
         } else {
             // 2 MB page
@@ -547,6 +637,34 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
     return fault;
 }
 
+void
+Walker::WalkerState::cacheTable(Addr table, unsigned ignored_bits,
+                                State table_state, bool uncacheable)
+{
+    if (functional || !walker->walkCache)
+        return;
+
+    const Addr vaddr = mbits(entry.vaddr, 47, ignored_bits);
+
+    WalkCacheEntry cached;
+    cached.root = root;
+    cached.vaddr = vaddr;
+    cached.table = table;
+    cached.state = table_state;
+    cached.uncacheable = uncacheable;
+    cached.writable = entry.writable;
+    cached.user = entry.user;
+    cached.noExec = entry.noExec;
+    cached.noExecPath = noExecPath;
+
+    // Replace any entry for the same page table, e.g., inserted by
+    // another walk in the meantime.
+    walker->walkCache->invalidateIf([&](const WalkCacheEntry &e) {
+        return e.vaddr == vaddr && e.state == table_state;
+    });
+    walker->walkCache->insert(vaddr, ignored_bits, cached);
+}
+
 void
 Walker::WalkerState::endWalk()
 {
@@ -593,6 +711,8 @@ Walker::WalkerState::setupWalk(Addr vaddr)
 
     nextState = Ready;
     entry.vaddr = vaddr;
+    noExecPath = false;
+    root = cr3;
 
     Request::Flags flags = Request::PHYSICAL;
 
@@ -601,6 +721,46 @@ Walker::WalkerState::setupWalk(Addr vaddr)
     if (!cr4.pcide && cr3.pcd)
         flags.set(Request::UNCACHEABLE);
 
+    // Start from the deepest page table the walk cache has, unless an
+    // entry on the way there forbids an execution, for the walk to fault
+    // where it should.
+    WalkCacheEntry *cached = nullptr;
+    if (efer.lma && !functional && walker->walkCache) {
+        const Addr key = bits(vaddr, 47, 0);
+        cached = walker->walkCache->lookup(key);
+        // Drop the entries of other address spaces.
+        while (cached && cached->root != root) {
+            walker->walkCache->invalidate(key);
+            cached = walker->walkCache->lookup(key);
+        }
+    }
+    if (cached &&
+            !(cached->noExecPath && mode == BaseMMU::Execute && enableNX)) {
+        walker->stats.walkCacheHits++;
+        state = cached->state;
+        switch (state) {
+          case LongPDP:
+            topAddr = cached->table + addr.longl3 * dataSize;
+            break;
+          case LongPD:
+            topAddr = cached->table + addr.longl2 * dataSize;
+            break;
+          case LongPTE:
+            topAddr = cached->table + addr.longl1 * dataSize;
+            break;
+          default:
+            panic("Bad page table walker state %d in the walk cache.\n",
+                  state);
+        }
+        flags.set(Request::UNCACHEABLE, cached->uncacheable);
+        entry.writable = cached->writable;
+        entry.user = cached->user;
+        entry.noExec = cached->noExec;
+        noExecPath = cached->noExecPath;
+        DPRINTF(PageTableWalker, "Walk cache hit for %#x, table at %#x.\n",
+                vaddr, cached->table);
+    }
+
     RequestPtr request = std::make_shared<Request>(
         topAddr, dataSize, flags, walker->requestorId);
 
@@ -38,11 +38,14 @@
 #ifndef __ARCH_X86_PAGE_TABLE_WALKER_HH__
 #define __ARCH_X86_PAGE_TABLE_WALKER_HH__
 
+#include <memory>
 #include <vector>
 
 #include "arch/generic/mmu.hh"
+#include "arch/generic/set_assoc_tlb.hh"
 #include "arch/x86/pagetable.hh"
 #include "arch/x86/tlb.hh"
+#include "base/statistics.hh"
 #include "base/types.hh"
 #include "mem/packet.hh"
 #include "params/X86PagetableWalker.hh"
@@ -115,6 +118,10 @@ namespace X86ISA
             bool retrying;
             bool started;
             bool squashed;
+            // Whether any entry read so far forbids execution
+            bool noExecPath;
+            // The root of the page tables, to tag walk cache entries
+            Addr root;
           public:
             WalkerState(Walker * _walker, BaseMMU::Translation *_translation,
                         const RequestPtr &_req, bool _isFunctional = false) :
@@ -122,7 +129,8 @@ namespace X86ISA
                 nextState(Ready), inflight(0),
                 translation(_translation),
                 functional(_isFunctional), timing(false),
-                retrying(false), started(false), squashed(false)
+                retrying(false), started(false), squashed(false),
+                noExecPath(false), root(0)
             {
             }
             void initState(ThreadContext * _tc, BaseMMU::Mode _mode,
@@ -141,6 +149,8 @@ namespace X86ISA
           private:
             void setupWalk(Addr vaddr);
             Fault stepWalk(PacketPtr &write);
+            void cacheTable(Addr table, unsigned ignored_bits,
+                            State table_state, bool uncacheable);
             void sendPackets();
             void endWalk();
             Fault pageFault(bool present);
@@ -152,6 +162,42 @@ namespace X86ISA
         std::list<WalkerState *> currStates;
         // State for functional accesses (only need one of these per walker)
         WalkerState funcState;
+        // States which aren't in use, to avoid allocating one per walk
+        std::vector<WalkerState *> freeStates;
+
+        WalkerState *allocState(BaseMMU::Translation *translation,
+                                const RequestPtr &req);
+        void freeState(WalkerState *state);
+
+        // The number of walks which can be in progress at once.
+        unsigned numWalkers;
+        unsigned numStarted() const;
+
+        // Entry of the walk cache, which points to a page table the walks
+        // of the addresses it covers can start from.
+        struct WalkCacheEntry
+        {
+            // The root of the page tables the entry belongs to (CR3)
+            Addr root;
+            // The first address the entry covers
+            Addr vaddr;
+            // Physical address of the page table
+            Addr table;
+            // The state reading the page table is in
+            WalkerState::State state;
+            // Whether the page table is uncacheable
+            bool uncacheable;
+            // Permissions of the entries leading to the page table
+            bool writable;
+            bool user;
+            bool noExec;
+            bool noExecPath;
+        };
+
+        // Cache of the non-leaf long mode page table entries, which walks
+        // don't need to read again, like the paging-structure caches of
+        // x86 CPUs.
+        std::unique_ptr<SetAssociativeTLB<WalkCacheEntry>> walkCache;
 
         struct WalkerSenderState : public Packet::SenderState
         {
@@ -169,6 +215,9 @@ namespace X86ISA
         Port &getPort(const std::string &if_name,
                       PortID idx=InvalidPortID) override;
 
+        // Invalidate all the entries of the walk cache.
+        void flushWalkCache();
+
       protected:
         // The TLB we're supposed to load.
         TLB * tlb;
@@ -191,6 +240,15 @@ namespace X86ISA
         void recvReqRetry();
         bool sendTiming(WalkerState * sendingState, PacketPtr pkt);
 
+        struct WalkerStats : public statistics::Group
+        {
+            WalkerStats(statistics::Group *parent);
+
+            statistics::Scalar walks;
+            statistics::Scalar walkCacheHits;
+            statistics::Scalar entryReads;
+        } stats;
+
       public:
 
         void setTLB(TLB * _tlb)
@@ -200,14 +258,8 @@ namespace X86ISA
 
         using Params = X86PagetableWalkerParams;
 
-        Walker(const Params &params) :
-            ClockedObject(params), port(name() + ".port", this),
-            funcState(this, NULL, NULL, true), tlb(NULL), sys(params.system),
-            requestorId(sys->getRequestorId(this)),
-            numSquashable(params.num_squash_per_cycle),
-            startWalkWrapperEvent([this]{ startWalkWrapper(); }, name())
-        {
-        }
+        Walker(const Params &params);
+        ~Walker();
     };
 
 } // namespace X86ISA
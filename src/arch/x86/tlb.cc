@@ -63,39 +63,14 @@ namespace gem5
 namespace X86ISA {
 
 TLB::TLB(const Params &p)
-    : BaseTLB(p), configAddress(0), size(p.size),
-      tlb(size), lruSeq(0), m5opRange(p.system->m5opRange()), stats(this)
+    : BaseTLB(p), configAddress(0),
+      tlb(p.size, p.assoc, PageShift, p.replacement_policy),
+      m5opRange(p.system->m5opRange()), stats(this)
 {
-    if (!size)
-        fatal("TLBs must have a non-zero size.\n");
-
-    for (int x = 0; x < size; x++) {
-        tlb[x].trieHandle = NULL;
-        freeList.push_back(&tlb[x]);
-    }
-
     walker = p.walker;
     walker->setTLB(this);
 }
 
-void
-TLB::evictLRU()
-{
-    // Find the entry with the lowest (and hence least recently updated)
-    // sequence number.
-
-    unsigned lru = 0;
-    for (unsigned i = 1; i < size; i++) {
-        if (tlb[i].lruSeq < tlb[lru].lruSeq)
-            lru = i;
-    }
-
-    assert(tlb[lru].trieHandle);
-    trie.remove(tlb[lru].trieHandle);
-    tlb[lru].trieHandle = NULL;
-    freeList.push_back(&tlb[lru]);
-}
-
 TlbEntry *
 TLB::insert(Addr vpn, const TlbEntry &entry, uint64_t pcid)
 {
@@ -106,52 +81,30 @@ TLB::insert(Addr vpn, const TlbEntry &entry, uint64_t pcid)
     vpn = concAddrPcid(vpn, pcid);
 
     // If somebody beat us to it, just use that existing entry.
-    TlbEntry *newEntry = trie.lookup(vpn);
+    TlbEntry *newEntry = tlb.lookup(vpn, false);
     if (newEntry) {
         assert(newEntry->vaddr == vpn);
         return newEntry;
     }
 
-    if (freeList.empty())
-        evictLRU();
-
-    newEntry = freeList.front();
-    freeList.pop_front();
-
-    *newEntry = entry;
-    newEntry->lruSeq = nextSeq();
+    // In SE mode, the pcid has to match too.
+    newEntry = tlb.insert(vpn, FullSystem ? entry.logBytes : 0, entry);
     newEntry->vaddr = vpn;
-    if (FullSystem) {
-        newEntry->trieHandle =
-        trie.insert(vpn, TlbEntryTrie::MaxBits-entry.logBytes, newEntry);
-    }
-    else {
-        newEntry->trieHandle =
-        trie.insert(vpn, TlbEntryTrie::MaxBits, newEntry);
-    }
     return newEntry;
 }
 
 TlbEntry *
 TLB::lookup(Addr va, bool update_lru)
 {
-    TlbEntry *entry = trie.lookup(va);
-    if (entry && update_lru)
-        entry->lruSeq = nextSeq();
-    return entry;
+    return tlb.lookup(va, update_lru);
 }
 
 void
 TLB::flushAll()
 {
     DPRINTF(TLB, "Invalidating all entries.\n");
-    for (unsigned i = 0; i < size; i++) {
-        if (tlb[i].trieHandle) {
-            trie.remove(tlb[i].trieHandle);
-            tlb[i].trieHandle = NULL;
-            freeList.push_back(&tlb[i]);
-        }
-    }
+    tlb.invalidateAll();
+    walker->flushWalkCache();
 }
 
 void
@@ -164,24 +117,16 @@ void
 TLB::flushNonGlobal()
 {
     DPRINTF(TLB, "Invalidating all non global entries.\n");
-    for (unsigned i = 0; i < size; i++) {
-        if (tlb[i].trieHandle && !tlb[i].global) {
-            trie.remove(tlb[i].trieHandle);
-            tlb[i].trieHandle = NULL;
-            freeList.push_back(&tlb[i]);
-        }
-    }
+    tlb.invalidateIf([](const TlbEntry &entry) { return !entry.global; });
+    walker->flushWalkCache();
 }
 
 void
 TLB::demapPage(Addr va, uint64_t asn)
 {
-    TlbEntry *entry = trie.lookup(va);
-    if (entry) {
-        trie.remove(entry->trieHandle);
-        entry->trieHandle = NULL;
-        freeList.push_back(entry);
-    }
+    tlb.invalidate(va);
+    // Like INVLPG, drop all the cached non-leaf entries.
+    walker->flushWalkCache();
 }
 
 namespace
@@ -584,15 +529,13 @@ void
 TLB::serialize(CheckpointOut &cp) const
 {
     // Only store the entries in use.
-    uint32_t _size = size - freeList.size();
+    uint32_t _size = tlb.size();
     SERIALIZE_SCALAR(_size);
-    SERIALIZE_SCALAR(lruSeq);
 
     uint32_t _count = 0;
-    for (uint32_t x = 0; x < size; x++) {
-        if (tlb[x].trieHandle != NULL)
-            tlb[x].serializeSection(cp, csprintf("Entry%d", _count++));
-    }
+    tlb.forEach([&](const TlbEntry &entry) {
+        entry.serializeSection(cp, csprintf("Entry%d", _count++));
+    });
 }
 
 void
@@ -601,19 +544,14 @@ TLB::unserialize(CheckpointIn &cp)
     // Do not allow to restore with a smaller tlb.
     uint32_t _size;
     UNSERIALIZE_SCALAR(_size);
-    if (_size > size) {
+    if (_size > tlb.capacity()) {
         fatal("TLB size less than the one in checkpoint!");
     }
 
-    UNSERIALIZE_SCALAR(lruSeq);
-
     for (uint32_t x = 0; x < _size; x++) {
-        TlbEntry *newEntry = freeList.front();
-        freeList.pop_front();
-
-        newEntry->unserializeSection(cp, csprintf("Entry%d", x));
-        newEntry->trieHandle = trie.insert(newEntry->vaddr,
-            TlbEntryTrie::MaxBits - newEntry->logBytes, newEntry);
+        TlbEntry entry;
+        entry.unserializeSection(cp, csprintf("Entry%d", x));
+        tlb.insert(entry.vaddr, entry.logBytes, entry);
     }
 }
 
@@ -38,12 +38,9 @@
 #ifndef __ARCH_X86_TLB_HH__
 #define __ARCH_X86_TLB_HH__
 
-#include <list>
-#include <vector>
-
+#include "arch/generic/set_assoc_tlb.hh"
 #include "arch/generic/tlb.hh"
 #include "arch/x86/pagetable.hh"
-#include "base/trie.hh"
 #include "mem/request.hh"
 #include "params/X86TLB.hh"
 #include "sim/stats.hh"
@@ -62,8 +59,6 @@ namespace X86ISA
       protected:
         friend class Walker;
 
-        typedef std::list<TlbEntry *> EntryList;
-
         uint32_t configAddress;
 
       public:
@@ -84,8 +79,6 @@ namespace X86ISA
 
       protected:
 
-        EntryList::iterator lookupIt(Addr va, bool update_lru = true);
-
         Walker * walker;
 
       public:
@@ -98,14 +91,7 @@ namespace X86ISA
         void demapPage(Addr va, uint64_t asn) override;
 
       protected:
-        uint32_t size;
-
-        std::vector<TlbEntry> tlb;
-
-        EntryList freeList;
-
-        TlbEntryTrie trie;
-        uint64_t lruSeq;
+        SetAssociativeTLB<TlbEntry> tlb;
 
         AddrRange m5opRange;
 
@@ -127,14 +113,6 @@ namespace X86ISA
 
       public:
 
-        void evictLRU();
-
-        uint64_t
-        nextSeq()
-        {
-            return ++lruSeq;
-        }
-
         Fault translateAtomic(
             const RequestPtr &req, ThreadContext *tc,
             BaseMMU::Mode mode) override;
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_SPSC_QUEUE_HH__
+#define __BASE_SPSC_QUEUE_HH__
+
+#include <atomic>
+#include <utility>
+
+namespace gem5
+{
+
+/**
+ * Unbounded queue between one producer thread and one consumer thread.
+ *
+ * The queue is a linked list which starts with a dummy node. The
+ * producer appends nodes to the tail, and the consumer moves the value
+ * out of the node after the dummy, which becomes the new dummy. The
+ * threads only share the next pointers, so neither takes a lock.
+ *
+ * @tparam T Type of the elements, which must be default constructible.
+ */
+template <typename T>
+class SpscQueue
+{
+  private:
+    struct Node
+    {
+        std::atomic<Node *> next{nullptr};
+        T value;
+    };
+
+    /** Dummy node, only used by the consumer. */
+    Node *head;
+    /** Last node, only used by the producer. */
+    Node *tail;
+
+  public:
+    SpscQueue() : head(new Node), tail(head) {}
+
+    SpscQueue(const SpscQueue &) = delete;
+    SpscQueue &operator=(const SpscQueue &) = delete;
+
+    ~SpscQueue()
+    {
+        while (head) {
+            Node *next = head->next.load(std::memory_order_relaxed);
+            delete head;
+            head = next;
+        }
+    }
+
+    /** Append a value to the queue (producer). */
+    void
+    push(T value)
+    {
+        Node *node = new Node;
+        node->value = std::move(value);
+        tail->next.store(node, std::memory_order_release);
+        tail = node;
+    }
+
+    /**
+     * Take the value at the head of the queue (consumer).
+     *
+     * @return false if the queue is empty.
+     */
+    bool
+    pop(T &value)
+    {
+        Node *next = head->next.load(std::memory_order_acquire);
+        if (!next)
+            return false;
+        value = std::move(next->value);
+        next->value = T();
+        delete head;
+        head = next;
+        return true;
+    }
+
+    /** Whether the queue looks empty to the consumer. */
+    bool
+    empty() const
+    {
+        return !head->next.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Visit the values in the queue, from the head. Neither thread may
+     * use the queue meanwhile, e.g., when serializing.
+     */
+    template <typename F>
+    void
+    forEach(F f) const
+    {
+        for (Node *node = head->next.load(std::memory_order_acquire); node;
+                node = node->next.load(std::memory_order_acquire)) {
+            f(node->value);
+        }
+    }
+};
+
+} // namespace gem5
+
+#endif // __BASE_SPSC_QUEUE_HH__
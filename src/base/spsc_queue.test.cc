@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "base/spsc_queue.hh"
+
+using namespace gem5;
+
+/** Values come out of the queue in the order they went in. */
+TEST(SpscQueueTest, Fifo)
+{
+    SpscQueue<int> queue;
+    ASSERT_TRUE(queue.empty());
+
+    int value = 0;
+    ASSERT_FALSE(queue.pop(value));
+
+    queue.push(1);
+    queue.push(2);
+    ASSERT_FALSE(queue.empty());
+    ASSERT_TRUE(queue.pop(value));
+    ASSERT_EQ(value, 1);
+    queue.push(3);
+    ASSERT_TRUE(queue.pop(value));
+    ASSERT_EQ(value, 2);
+    ASSERT_TRUE(queue.pop(value));
+    ASSERT_EQ(value, 3);
+    ASSERT_TRUE(queue.empty());
+}
+
+/** forEach visits the queued values from the head. */
+TEST(SpscQueueTest, ForEach)
+{
+    SpscQueue<int> queue;
+    for (int i = 0; i < 4; i++)
+        queue.push(i);
+    int value;
+    queue.pop(value);
+
+    std::vector<int> seen;
+    queue.forEach([&seen](int v) { seen.push_back(v); });
+    ASSERT_EQ(seen, std::vector<int>({1, 2, 3}));
+}
+
+/** Popped values aren't kept alive by the queue. */
+TEST(SpscQueueTest, ReleasePopped)
+{
+    SpscQueue<std::shared_ptr<int>> queue;
+    auto ptr = std::make_shared<int>(42);
+    queue.push(ptr);
+
+    std::shared_ptr<int> out;
+    ASSERT_TRUE(queue.pop(out));
+    ASSERT_EQ(*out, 42);
+    out = nullptr;
+    ASSERT_EQ(ptr.use_count(), 1);
+}
+
+/** A producer and a consumer thread don't lose or reorder values. */
+TEST(SpscQueueTest, TwoThreads)
+{
+    const int count = 100000;
+    SpscQueue<int> queue;
+
+    std::thread producer([&queue]() {
+        for (int i = 0; i < count; i++)
+            queue.push(i);
+    });
+
+    for (int expected = 0; expected < count;) {
+        int value;
+        if (queue.pop(value)) {
+            ASSERT_EQ(value, expected++);
+        }
+    }
+    producer.join();
+    ASSERT_TRUE(queue.empty());
+}
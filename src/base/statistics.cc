@@ -44,6 +44,7 @@
 #include <list>
 #include <map>
 #include <string>
+#include <unordered_set>
 #include <utility>
 
 #include "base/callback.hh"
@@ -204,17 +205,47 @@ Formula::operator/=(Temp r)
 }
 
 
+namespace
+{
+
+/** Number of the stats dump in progress, or 0 if not dumping. */
+uint64_t currentDump = 0;
+uint64_t numDumps = 0;
+
+} // anonymous namespace
+
 void
 Formula::result(VResult &vec) const
 {
-    if (root)
+    if (!root)
+        return;
+
+    if (!currentDump) {
         vec = root->result();
+        return;
+    }
+
+    if (resultDump != currentDump) {
+        cachedResult = root->result();
+        resultDump = currentDump;
+    }
+    vec = cachedResult;
 }
 
 Result
 Formula::total() const
 {
-    return root ? root->total() : 0.0;
+    if (!root)
+        return 0.0;
+
+    if (!currentDump)
+        return root->total();
+
+    if (totalDump != currentDump) {
+        cachedTotal = root->total();
+        totalDump = currentDump;
+    }
+    return cachedTotal;
 }
 
 size_type
@@ -248,6 +279,54 @@ Formula::str() const
     return root ? root->str() : "";
 }
 
+void
+Formula::dependencies(std::vector<const statistics::Info *> &deps) const
+{
+    if (root)
+        root->dependencies(deps);
+}
+
+void
+prepare(const std::vector<Group *> &roots)
+{
+    std::vector<const Info *> pending;
+    std::function<void(const Group *)> add_stats =
+        [&](const Group *group) {
+            const auto &stats = group->getStats();
+            pending.insert(pending.end(), stats.begin(), stats.end());
+            for (const auto &g : group->getStatGroups())
+                add_stats(g.second);
+        };
+    for (const auto *root : roots)
+        add_stats(root);
+
+    std::unordered_set<const Info *> prepared;
+    while (!pending.empty()) {
+        const Info *info = pending.back();
+        pending.pop_back();
+        if (!prepared.insert(info).second)
+            continue;
+
+        if (auto formula = dynamic_cast<const FormulaInfo *>(info))
+            formula->dependencies(pending);
+
+        // Formulas only refer to the stats they depend on as const.
+        const_cast<Info *>(info)->prepare();
+    }
+}
+
+void
+beginDump()
+{
+    currentDump = ++numDumps;
+}
+
+void
+endDump()
+{
+    currentDump = 0;
+}
+
 Handler resetHandler = NULL;
 Handler dumpHandler = NULL;
 
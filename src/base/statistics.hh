@@ -911,6 +911,9 @@ class ScalarProxy
     {
         return csprintf("%s[%d]", stat.info()->name, index);
     }
+
+    /** Return the information class of the accessed vector. */
+    const statistics::Info *info() const { return stat.info(); }
 };
 
 /**
@@ -1543,6 +1546,12 @@ class Node
      */
     virtual std::string str() const = 0;
 
+    /**
+     * Add the stats this subtree is computed from to deps.
+     * @param deps The stats the formula depends on.
+     */
+    virtual void dependencies(std::vector<const Info *> &deps) const {}
+
     virtual ~Node() {};
 };
 
@@ -1573,6 +1582,12 @@ class ScalarStatNode : public Node
      *
      */
     std::string str() const { return data->name; }
+
+    void
+    dependencies(std::vector<const Info *> &deps) const
+    {
+        deps.push_back(data);
+    }
 };
 
 template <class Stat>
@@ -1614,6 +1629,12 @@ class ScalarProxyNode : public Node
     {
         return proxy.str();
     }
+
+    void
+    dependencies(std::vector<const Info *> &deps) const
+    {
+        deps.push_back(proxy.info());
+    }
 };
 
 class VectorStatNode : public Node
@@ -1629,6 +1650,12 @@ class VectorStatNode : public Node
     size_type size() const { return data->size(); }
 
     std::string str() const { return data->name; }
+
+    void
+    dependencies(std::vector<const Info *> &deps) const
+    {
+        deps.push_back(data);
+    }
 };
 
 template <class T>
@@ -1760,6 +1787,12 @@ class UnaryNode : public Node
     {
         return OpString<Op>::str() + l->str();
     }
+
+    void
+    dependencies(std::vector<const Info *> &deps) const
+    {
+        l->dependencies(deps);
+    }
 };
 
 template <class Op>
@@ -1857,6 +1890,13 @@ class BinaryNode : public Node
     {
         return csprintf("(%s %s %s)", l->str(), OpString<Op>::str(), r->str());
     }
+
+    void
+    dependencies(std::vector<const Info *> &deps) const override
+    {
+        l->dependencies(deps);
+        r->dependencies(deps);
+    }
 };
 
 template <class Op>
@@ -1908,6 +1948,12 @@ class SumNode : public Node
     {
         return csprintf("total(%s)", l->str());
     }
+
+    void
+    dependencies(std::vector<const Info *> &deps) const
+    {
+        l->dependencies(deps);
+    }
 };
 
 
@@ -2393,6 +2439,12 @@ class FormulaInfoProxy : public InfoProxy<Stat, FormulaInfo>
     VCounter &value() const { return cvec; }
 
     std::string str() const { return this->s.str(); }
+
+    void
+    dependencies(std::vector<const Info *> &deps) const override
+    {
+        this->s.dependencies(deps);
+    }
 };
 
 template <class Stat>
@@ -2542,6 +2594,12 @@ class Formula : public DataWrapVec<Formula, FormulaInfoProxy>
     NodePtr root;
     friend class Temp;
 
+    /** Results of the formula in the current dump, if computed. */
+    mutable VResult cachedResult;
+    mutable Result cachedTotal;
+    mutable uint64_t resultDump = 0;
+    mutable uint64_t totalDump = 0;
+
   public:
     /**
      * Create and initialize thie formula, and register it with the database.
@@ -2625,6 +2683,12 @@ class Formula : public DataWrapVec<Formula, FormulaInfoProxy>
     bool zero() const;
 
     std::string str() const;
+
+    /**
+     * Add the stats this formula is computed from to deps.
+     * @param deps The stats the formula depends on.
+     */
+    void dependencies(std::vector<const statistics::Info *> &deps) const;
 };
 
 class FormulaNode : public Node
@@ -2641,6 +2705,12 @@ class FormulaNode : public Node
     Result total() const { return formula.total(); }
 
     std::string str() const { return formula.str(); }
+
+    void
+    dependencies(std::vector<const Info *> &deps) const
+    {
+        deps.push_back(formula.info());
+    }
 };
 
 /**
@@ -2886,6 +2956,23 @@ void enable();
 bool enabled();
 const Info* resolve(const std::string &name);
 
+/**
+ * Prepare the stats of some groups and their sub-groups for data
+ * access, along with the stats their formulas are computed from, which
+ * may belong to other groups. Each stat is only prepared once.
+ *
+ * @param roots The groups whose stats are about to be accessed.
+ */
+void prepare(const std::vector<Group *> &roots);
+
+/**
+ * Mark the beginning and the end of a stats dump. Formulas are only
+ * computed once in between, the first time they are accessed, as the
+ * stats they depend on can't change while being dumped.
+ */
+void beginDump();
+void endDump();
+
 /**
  * Register reset and dump handlers.  These are the functions which
  * will actually perform the whole statistics reset/dump actions
@@ -0,0 +1,453 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/columnar.hh"
+
+#include <cstring>
+
+#include "base/cprintf.hh"
+#include "base/logging.hh"
+#include "base/output.hh"
+#include "base/stats/info.hh"
+#include "base/varint.hh"
+#include "sim/cur_tick.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+namespace
+{
+
+const char Magic[8] = {'g', 'e', 'm', '5', 'c', 'o', 'l', '1'};
+
+enum RecordKind : uint8_t
+{
+    SchemaRecord = 'S',
+    DumpRecord = 'D',
+};
+
+/** Dumps which may wait for the writer before end() blocks. */
+constexpr size_t MaxQueuedDumps = 4;
+
+void
+appendString(std::vector<uint8_t> &out, const std::string &str)
+{
+    varint::append(out, str.size());
+    out.insert(out.end(), str.begin(), str.end());
+}
+
+} // anonymous namespace
+
+Columnar::Columnar(const std::string &file, bool desc, bool background)
+    : descriptions(desc), layoutPos(0), schemaChanged(false),
+      stream(file, std::ios::out | std::ios::trunc | std::ios::binary),
+      stopping(false)
+{
+    fatal_if(!stream, "Unable to open statistics file %s for writing\n",
+             file);
+    stream.write(Magic, sizeof(Magic));
+
+    if (background)
+        writer = std::thread([this]() { writerLoop(); });
+}
+
+Columnar::~Columnar()
+{
+    if (writer.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        cond.notify_all();
+        writer.join();
+    }
+    stream.flush();
+}
+
+bool
+Columnar::valid() const
+{
+    return stream.good();
+}
+
+void
+Columnar::begin()
+{
+    layoutPos = 0;
+    schemaChanged = false;
+    values.clear();
+    values.reserve(schema.size());
+}
+
+void
+Columnar::end()
+{
+    // Stats which aren't dumped anymore at the end change the schema
+    // too.
+    if (!schemaChanged && layoutPos != layout.size()) {
+        schemaChanged = true;
+        layout.resize(layoutPos);
+        schema.resize(values.size());
+    }
+
+    Dump dump;
+    dump.tick = curTick();
+    dump.values.swap(values);
+    if (schemaChanged)
+        dump.schema = std::make_unique<std::vector<Column>>(schema);
+
+    if (!writer.joinable()) {
+        write(dump);
+        stream.flush();
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        cond.wait(lock, [this]() { return queue.size() < MaxQueuedDumps; });
+        queue.push_back(std::move(dump));
+    }
+    cond.notify_all();
+}
+
+void
+Columnar::writerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        cond.wait(lock, [this]() { return stopping || !queue.empty(); });
+        if (queue.empty())
+            return;
+
+        Dump dump = std::move(queue.front());
+        queue.pop_front();
+        lock.unlock();
+        cond.notify_all();
+
+        write(dump);
+        stream.flush();
+
+        lock.lock();
+    }
+}
+
+void
+Columnar::writeRecord(uint8_t kind)
+{
+    uint8_t header[1 + varint::MaxBytes];
+    header[0] = kind;
+    const size_t len = 1 + varint::encode(record.size(), header + 1);
+    stream.write(reinterpret_cast<const char *>(header), len);
+    stream.write(reinterpret_cast<const char *>(record.data()),
+                 record.size());
+}
+
+void
+Columnar::write(const Dump &dump)
+{
+    if (dump.schema) {
+        record.clear();
+        varint::append(record, dump.schema->size());
+        for (const auto &column: *dump.schema) {
+            appendString(record, column.name);
+            appendString(record, column.unit);
+            appendString(record, column.desc);
+        }
+        writeRecord(SchemaRecord);
+
+        // The values of a new schema are relative to zeros.
+        prevValues.assign(dump.schema->size(), 0.0);
+    }
+    assert(dump.values.size() == prevValues.size());
+
+    // Only the columns which changed are written, as the gap from the
+    // previous one written, and the XOR of their bits with their
+    // previous value.
+    std::vector<uint8_t> changes;
+    uint64_t num_changes = 0;
+    uint64_t last = 0;
+    for (size_t i = 0; i < dump.values.size(); i++) {
+        uint64_t bits, prev_bits;
+        memcpy(&bits, &dump.values[i], sizeof(bits));
+        memcpy(&prev_bits, &prevValues[i], sizeof(prev_bits));
+        if (bits == prev_bits)
+            continue;
+        varint::append(changes, i - last);
+        varint::append(changes, bits ^ prev_bits);
+        last = i;
+        num_changes++;
+        prevValues[i] = dump.values[i];
+    }
+
+    record.clear();
+    varint::append(record, dump.tick);
+    varint::append(record, num_changes);
+    record.insert(record.end(), changes.begin(), changes.end());
+    writeRecord(DumpRecord);
+}
+
+std::string
+Columnar::statName(const std::string &name) const
+{
+    if (path.empty())
+        return name;
+    else
+        return csprintf("%s.%s", path.top(), name);
+}
+
+void
+Columnar::beginGroup(const char *name)
+{
+    if (path.empty()) {
+        path.push(name);
+    } else {
+        path.push(csprintf("%s.%s", path.top(), name));
+    }
+}
+
+void
+Columnar::endGroup()
+{
+    assert(!path.empty());
+    path.pop();
+}
+
+bool
+Columnar::noOutput(const Info &info) const
+{
+    // Unlike in text, stats with a zero prerequisite are still output,
+    // so that the schema doesn't change.
+    return !info.flags.isSet(display);
+}
+
+bool
+Columnar::beginStat(const Info &info, size_t columns)
+{
+    if (!schemaChanged && layoutPos < layout.size() &&
+            layout[layoutPos].id == info.id &&
+            layout[layoutPos].columns == columns) {
+        layoutPos++;
+        return false;
+    }
+
+    // From the first stat which differs from the previous dumps, the
+    // layout and the schema are rebuilt.
+    if (!schemaChanged) {
+        schemaChanged = true;
+        layout.resize(layoutPos);
+        schema.resize(values.size());
+    }
+    layout.push_back({info.id, columns});
+    layoutPos++;
+    return true;
+}
+
+void
+Columnar::addColumn(const Info &info, const std::string &name)
+{
+    schema.push_back({name, info.unit->getUnitString(),
+                      descriptions ? info.desc : ""});
+}
+
+void
+Columnar::visit(const ScalarInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    if (beginStat(info, 1))
+        addColumn(info, statName(info.name));
+    values.push_back(info.result());
+}
+
+void
+Columnar::visit(const VectorInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    const VResult &result = info.result();
+    const bool total = info.flags.isSet(statistics::total);
+    if (beginStat(info, result.size() + total)) {
+        const std::string base = statName(info.name) + info.separatorString;
+        for (size_t i = 0; i < result.size(); i++) {
+            const bool named =
+                i < info.subnames.size() && !info.subnames[i].empty();
+            addColumn(info,
+                      base + (named ? info.subnames[i] : std::to_string(i)));
+        }
+        if (total)
+            addColumn(info, base + "total");
+    }
+    values.insert(values.end(), result.begin(), result.end());
+    if (total)
+        values.push_back(info.total());
+}
+
+void
+Columnar::visit(const Vector2dInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    if (beginStat(info, info.x * info.y)) {
+        const std::string base = statName(info.name);
+        for (size_t i = 0; i < info.x; i++) {
+            const bool x_named =
+                i < info.subnames.size() && !info.subnames[i].empty();
+            const std::string x_name = base + "_" +
+                (x_named ? info.subnames[i] : std::to_string(i)) +
+                info.separatorString;
+            for (size_t j = 0; j < info.y; j++) {
+                const bool y_named = j < info.y_subnames.size() &&
+                    !info.y_subnames[j].empty();
+                addColumn(info, x_name +
+                          (y_named ? info.y_subnames[j] : std::to_string(j)));
+            }
+        }
+    }
+    values.insert(values.end(), info.cvec.begin(), info.cvec.end());
+}
+
+size_t
+Columnar::distColumns(const DistData &data) const
+{
+    // samples, sum, squares and either logs, or min, max, underflow and
+    // overflow, and the buckets
+    switch (data.type) {
+      case Deviation:
+        return 3;
+      case Hist:
+        return 4 + data.cvec.size();
+      default:
+        return 7 + data.cvec.size();
+    }
+}
+
+void
+Columnar::addDist(const Info &info, const std::string &name,
+                  const DistData &data, bool names)
+{
+    const std::string base = name + info.separatorString;
+    if (names) {
+        for (const char *field: {"samples", "sum", "squares"})
+            addColumn(info, base + field);
+    }
+    values.push_back(data.samples);
+    values.push_back(data.sum);
+    values.push_back(data.squares);
+
+    if (data.type == Deviation)
+        return;
+
+    if (data.type == Hist) {
+        if (names)
+            addColumn(info, base + "logs");
+        values.push_back(data.logs);
+    } else {
+        if (names) {
+            for (const char *field:
+                    {"min_value", "max_value", "underflows", "overflows"}) {
+                addColumn(info, base + field);
+            }
+        }
+        values.push_back(data.min_val);
+        values.push_back(data.max_val);
+        values.push_back(data.underflow);
+        values.push_back(data.overflow);
+    }
+
+    if (names) {
+        for (size_t i = 0; i < data.cvec.size(); i++) {
+            const Counter low = data.min + i * data.bucket_size;
+            const Counter high =
+                std::min(low + data.bucket_size - 1.0, data.max);
+            addColumn(info, data.bucket_size == 1 ?
+                      base + csprintf("%g", low) :
+                      base + csprintf("%g-%g", low, high));
+        }
+    }
+    values.insert(values.end(), data.cvec.begin(), data.cvec.end());
+}
+
+void
+Columnar::visit(const DistInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    const bool names = beginStat(info, distColumns(info.data));
+    addDist(info, statName(info.name), info.data, names);
+}
+
+void
+Columnar::visit(const VectorDistInfo &info)
+{
+    if (noOutput(info))
+        return;
+
+    size_t columns = 0;
+    for (const auto &data: info.data)
+        columns += distColumns(data);
+    const bool names = beginStat(info, columns);
+
+    const std::string base = statName(info.name) + info.separatorString;
+    for (size_t i = 0; i < info.data.size(); i++) {
+        const bool named =
+            i < info.subnames.size() && !info.subnames[i].empty();
+        addDist(info, base + (named ? info.subnames[i] : std::to_string(i)),
+                info.data[i], names);
+    }
+}
+
+void
+Columnar::visit(const FormulaInfo &info)
+{
+    visit((const VectorInfo &)info);
+}
+
+void
+Columnar::visit(const SparseHistInfo &info)
+{
+    // Their buckets change from dump to dump.
+    warn_once("Sparse histograms aren't supported by columnar stats "
+              "outputs\n");
+}
+
+std::unique_ptr<Output>
+initColumnar(const std::string &filename, bool desc, bool background)
+{
+    return std::unique_ptr<Output>(
+        new Columnar(simout.resolve(filename), desc, background));
+}
+
+} // namespace statistics
+} // namespace gem5
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_STATS_COLUMNAR_HH__
+#define __BASE_STATS_COLUMNAR_HH__
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stack>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base/stats/output.hh"
+#include "base/stats/types.hh"
+#include "base/types.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+class Info;
+
+/**
+ * Statistics output in a compact, columnar binary stream, meant for
+ * frequent periodic dumps of many stats.
+ *
+ * Every value of every stat is a column. The names, units and
+ * descriptions of the columns are written in a schema record, once,
+ * or again when the set of dumped stats changes, and each dump is a
+ * record of the columns which changed since the previous one. Values
+ * are stored as the XOR of their bits with the previous ones, which
+ * only has a few low bits set for slowly changing values.
+ *
+ * The values are collected while the stats are visited, but are
+ * encoded and written by a background thread, if enabled.
+ *
+ * The stream can be exported to Apache Arrow or Parquet with
+ * util/stats_columnar.py. Sparse histograms aren't supported.
+ */
+class Columnar : public Output
+{
+  public:
+    Columnar(const std::string &file, bool desc, bool background);
+    ~Columnar();
+
+    Columnar(const Columnar &other) = delete;
+    Columnar &operator=(const Columnar &other) = delete;
+
+  public: // Output interface
+    void begin() override;
+    void end() override;
+    bool valid() const override;
+
+    void beginGroup(const char *name) override;
+    void endGroup() override;
+
+    void visit(const ScalarInfo &info) override;
+    void visit(const VectorInfo &info) override;
+    void visit(const DistInfo &info) override;
+    void visit(const VectorDistInfo &info) override;
+    void visit(const Vector2dInfo &info) override;
+    void visit(const FormulaInfo &info) override;
+    void visit(const SparseHistInfo &info) override;
+
+  private:
+    struct Column
+    {
+        std::string name;
+        std::string unit;
+        std::string desc;
+    };
+
+    /** Stat dumped at some position, and the number of its columns. */
+    struct StatLayout
+    {
+        int id;
+        size_t columns;
+    };
+
+    struct Dump
+    {
+        Tick tick;
+        std::vector<double> values;
+        /** New schema of the dump, if it has changed. */
+        std::unique_ptr<std::vector<Column>> schema;
+    };
+
+    const bool descriptions;
+
+    std::stack<std::string> path;
+
+    /** Stats and columns of the last dump. */
+    std::vector<StatLayout> layout;
+    std::vector<Column> schema;
+
+    /** Position in the layout of the current dump. */
+    size_t layoutPos;
+    bool schemaChanged;
+    std::vector<double> values;
+
+    std::string statName(const std::string &name) const;
+    bool noOutput(const Info &info) const;
+
+    /**
+     * Check a stat against the layout of the previous dumps.
+     *
+     * @return Whether the names of its columns have to be added.
+     */
+    bool beginStat(const Info &info, size_t columns);
+    void addColumn(const Info &info, const std::string &name);
+
+    size_t distColumns(const DistData &data) const;
+    void addDist(const Info &info, const std::string &name,
+                 const DistData &data, bool names);
+
+    // Writer side, only accessed by the writer thread if there's one
+    std::ofstream stream;
+    std::vector<double> prevValues;
+    std::vector<uint8_t> record;
+
+    void write(const Dump &dump);
+    void writeRecord(uint8_t kind);
+
+    // Dumps waiting for the writer thread
+    std::thread writer;
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::deque<Dump> queue;
+    bool stopping;
+
+    void writerLoop();
+};
+
+std::unique_ptr<Output> initColumnar(const std::string &filename,
+                                     bool desc=true, bool background=true);
+
+} // namespace statistics
+} // namespace gem5
+
+#endif // __BASE_STATS_COLUMNAR_HH__
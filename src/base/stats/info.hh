@@ -245,6 +245,9 @@ class FormulaInfo : public VectorInfo
 {
   public:
     virtual std::string str() const = 0;
+
+    /** Add the stats the formula is computed from to deps. */
+    virtual void dependencies(std::vector<const Info *> &deps) const = 0;
 };
 
 class SparseHistInfo : public Info
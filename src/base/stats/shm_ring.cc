@@ -0,0 +1,390 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/shm_ring.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <type_traits>
+
+#include "base/cprintf.hh"
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/stats/info.hh"
+#include "sim/cur_tick.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+namespace
+{
+
+const char Magic[8] = {'g', 'e', 'm', '5', 's', 'h', 'm', '1'};
+
+/** Slots are aligned to cache lines, for readers not to share them. */
+constexpr size_t SlotAlign = 64;
+
+/** Offsets of the fields of a slot. */
+constexpr size_t SlotSeq = 0;
+constexpr size_t SlotTick = 8;
+constexpr size_t SlotValues = 16;
+
+static_assert(std::is_standard_layout<ShmRing::Header>::value,
+              "The header is shared with other processes");
+static_assert(std::atomic<uint64_t>::is_always_lock_free,
+              "Shared sequence numbers must be lock free");
+
+} // anonymous namespace
+
+ShmRing::ShmRing(const std::string &name,
+                 const std::vector<std::string> &stats, size_t slots)
+    : segmentName(name[0] == '/' ? name : "/" + name),
+      numSlots(slots), layoutPos(0), layoutChanged(false),
+      header(nullptr), segmentSize(0)
+{
+    fatal_if(slots == 0, "The stats ring %s needs at least one slot\n",
+             name);
+    filter.setExpression(stats);
+}
+
+ShmRing::~ShmRing()
+{
+    closeSegment();
+}
+
+bool
+ShmRing::valid() const
+{
+    return true;
+}
+
+void
+ShmRing::closeSegment()
+{
+    if (!header)
+        return;
+
+    header->valid.store(0, std::memory_order_release);
+    munmap(header, segmentSize);
+    shm_unlink(segmentName.c_str());
+    header = nullptr;
+}
+
+void
+ShmRing::createSegment()
+{
+    // Readers of the previous segment see it isn't valid anymore, and
+    // reopen the new one, which is only valid once it's complete.
+    closeSegment();
+
+    std::string names;
+    for (const auto &column: columns) {
+        names.append(column.first).push_back('\0');
+        names.append(column.second).push_back('\0');
+    }
+
+    const size_t names_offset = roundUp(sizeof(Header), 8);
+    const size_t slots_offset =
+        roundUp(names_offset + names.size(), SlotAlign);
+    const size_t slot_size =
+        roundUp(SlotValues + columns.size() * sizeof(double), SlotAlign);
+    segmentSize = slots_offset + slot_size * numSlots;
+
+    // Replace any segment left behind by a previous simulation.
+    shm_unlink(segmentName.c_str());
+    int fd = shm_open(segmentName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    fatal_if(fd == -1, "Could not create the shared memory segment %s: %s\n",
+             segmentName, strerror(errno));
+    fatal_if(ftruncate(fd, segmentSize),
+             "Could not set the size of the shared memory segment %s\n",
+             segmentName);
+    void *addr = mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE,
+                      MAP_SHARED, fd, 0);
+    close(fd);
+    fatal_if(addr == MAP_FAILED, "Could not map the shared memory segment "
+             "%s: %s\n", segmentName, strerror(errno));
+
+    // The segment is zeroed by ftruncate, which makes the sequence
+    // numbers of all the slots even.
+    uint8_t *base = static_cast<uint8_t *>(addr);
+    memcpy(base + names_offset, names.data(), names.size());
+
+    header = new (addr) Header;
+    memcpy(header->magic, Magic, sizeof(Magic));
+    header->numColumns = columns.size();
+    header->numSlots = numSlots;
+    header->namesOffset = names_offset;
+    header->namesSize = names.size();
+    header->slotsOffset = slots_offset;
+    header->slotSize = slot_size;
+    header->numDumps.store(0, std::memory_order_relaxed);
+    header->valid.store(1, std::memory_order_release);
+}
+
+void
+ShmRing::begin()
+{
+    layoutPos = 0;
+    layoutChanged = false;
+    values.clear();
+    values.reserve(columns.size());
+}
+
+void
+ShmRing::end()
+{
+    if (!layoutChanged && layoutPos != layout.size()) {
+        layoutChanged = true;
+        layout.resize(layoutPos);
+        columns.resize(values.size());
+    }
+
+    if (layoutChanged || !header)
+        createSegment();
+
+    assert(values.size() == header->numColumns);
+    const uint64_t dump = header->numDumps.load(std::memory_order_relaxed);
+    uint8_t *slot = reinterpret_cast<uint8_t *>(header) +
+        header->slotsOffset + (dump % numSlots) * header->slotSize;
+    auto *seq = reinterpret_cast<std::atomic<uint64_t> *>(slot + SlotSeq);
+
+    // Seqlock write: the sequence number is odd while the slot is
+    // being written.
+    const uint64_t s = seq->load(std::memory_order_relaxed);
+    seq->store(s + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    const uint64_t tick = curTick();
+    memcpy(slot + SlotTick, &tick, sizeof(tick));
+    memcpy(slot + SlotValues, values.data(), values.size() * sizeof(double));
+
+    seq->store(s + 2, std::memory_order_release);
+    header->numDumps.store(dump + 1, std::memory_order_release);
+}
+
+std::string
+ShmRing::statName(const std::string &name) const
+{
+    if (path.empty())
+        return name;
+    else
+        return csprintf("%s.%s", path.top(), name);
+}
+
+void
+ShmRing::beginGroup(const char *name)
+{
+    if (path.empty()) {
+        path.push(name);
+    } else {
+        path.push(csprintf("%s.%s", path.top(), name));
+    }
+}
+
+void
+ShmRing::endGroup()
+{
+    assert(!path.empty());
+    path.pop();
+}
+
+bool
+ShmRing::isSelected(const Info &info)
+{
+    if (!info.flags.isSet(display))
+        return false;
+    if (filter.empty())
+        return true;
+
+    // Stats keep their names once dumped, so the decision is only made
+    // the first time.
+    auto it = selected.find(info.id);
+    if (it == selected.end()) {
+        const bool match = filter.match(statName(info.name));
+        it = selected.emplace(info.id, match).first;
+    }
+    return it->second;
+}
+
+bool
+ShmRing::beginStat(const Info &info, size_t num_columns)
+{
+    if (!layoutChanged && layoutPos < layout.size() &&
+            layout[layoutPos].first == info.id &&
+            layout[layoutPos].second == num_columns) {
+        layoutPos++;
+        return false;
+    }
+
+    if (!layoutChanged) {
+        layoutChanged = true;
+        layout.resize(layoutPos);
+        columns.resize(values.size());
+    }
+    layout.emplace_back(info.id, num_columns);
+    layoutPos++;
+    return true;
+}
+
+void
+ShmRing::addColumn(const Info &info, const std::string &name)
+{
+    columns.emplace_back(name, info.unit->getUnitString());
+}
+
+void
+ShmRing::visit(const ScalarInfo &info)
+{
+    if (!isSelected(info))
+        return;
+
+    if (beginStat(info, 1))
+        addColumn(info, statName(info.name));
+    values.push_back(info.result());
+}
+
+void
+ShmRing::visit(const VectorInfo &info)
+{
+    if (!isSelected(info))
+        return;
+
+    const VResult &result = info.result();
+    const bool total = info.flags.isSet(statistics::total);
+    if (beginStat(info, result.size() + total)) {
+        const std::string base = statName(info.name) + info.separatorString;
+        for (size_t i = 0; i < result.size(); i++) {
+            const bool named =
+                i < info.subnames.size() && !info.subnames[i].empty();
+            addColumn(info,
+                      base + (named ? info.subnames[i] : std::to_string(i)));
+        }
+        if (total)
+            addColumn(info, base + "total");
+    }
+    values.insert(values.end(), result.begin(), result.end());
+    if (total)
+        values.push_back(info.total());
+}
+
+void
+ShmRing::visit(const Vector2dInfo &info)
+{
+    if (!isSelected(info))
+        return;
+
+    if (beginStat(info, info.x * info.y)) {
+        const std::string base = statName(info.name);
+        for (size_t i = 0; i < info.x; i++) {
+            const bool x_named =
+                i < info.subnames.size() && !info.subnames[i].empty();
+            const std::string x_name = base + "_" +
+                (x_named ? info.subnames[i] : std::to_string(i)) +
+                info.separatorString;
+            for (size_t j = 0; j < info.y; j++) {
+                const bool y_named = j < info.y_subnames.size() &&
+                    !info.y_subnames[j].empty();
+                addColumn(info, x_name +
+                          (y_named ? info.y_subnames[j] : std::to_string(j)));
+            }
+        }
+    }
+    values.insert(values.end(), info.cvec.begin(), info.cvec.end());
+}
+
+void
+ShmRing::addDist(const Info &info, const std::string &name,
+                 const DistData &data, bool names)
+{
+    // Monitors only get the number of samples and their mean, the
+    // buckets are left to the other outputs.
+    if (names) {
+        addColumn(info, name + info.separatorString + "samples");
+        addColumn(info, name + info.separatorString + "mean");
+    }
+    values.push_back(data.samples);
+    values.push_back(data.samples ? data.sum / data.samples : 0.0);
+}
+
+void
+ShmRing::visit(const DistInfo &info)
+{
+    if (!isSelected(info))
+        return;
+
+    addDist(info, statName(info.name), info.data, beginStat(info, 2));
+}
+
+void
+ShmRing::visit(const VectorDistInfo &info)
+{
+    if (!isSelected(info))
+        return;
+
+    const bool names = beginStat(info, 2 * info.data.size());
+    const std::string base = statName(info.name) + info.separatorString;
+    for (size_t i = 0; i < info.data.size(); i++) {
+        const bool named =
+            i < info.subnames.size() && !info.subnames[i].empty();
+        addDist(info, base + (named ? info.subnames[i] : std::to_string(i)),
+                info.data[i], names);
+    }
+}
+
+void
+ShmRing::visit(const FormulaInfo &info)
+{
+    visit((const VectorInfo &)info);
+}
+
+void
+ShmRing::visit(const SparseHistInfo &info)
+{
+    if (isSelected(info)) {
+        warn_once("Sparse histograms aren't published to shared memory "
+                  "stats rings\n");
+    }
+}
+
+std::unique_ptr<Output>
+initShmRing(const std::string &name, const std::vector<std::string> &stats,
+            size_t slots)
+{
+    return std::unique_ptr<Output>(new ShmRing(name, stats, slots));
+}
+
+} // namespace statistics
+} // namespace gem5
@@ -0,0 +1,162 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_STATS_SHM_RING_HH__
+#define __BASE_STATS_SHM_RING_HH__
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stack>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "base/match.hh"
+#include "base/stats/output.hh"
+#include "base/stats/types.hh"
+
+namespace gem5
+{
+
+namespace statistics
+{
+
+class Info;
+
+/**
+ * Statistics output which publishes the values of selected stats to a
+ * POSIX shared memory segment, for external monitors to poll while the
+ * simulation runs.
+ *
+ * The segment starts with a Header, followed by the names and units of
+ * the columns, as pairs of NUL terminated strings, and a ring of
+ * slots. Each slot holds a sequence number, the tick of a dump and the
+ * values of the columns, as doubles. The last dump is in slot
+ * (numDumps - 1) % numSlots, and is written as a seqlock: the sequence
+ * number of its slot is odd while it is written. Readers copy a slot,
+ * and retry if its sequence number was odd or changed during the copy.
+ *
+ * When the selected stats change, the segment is replaced, and the
+ * valid field of the old one is cleared for readers to reopen it.
+ */
+class ShmRing : public Output
+{
+  public:
+    struct Header
+    {
+        char magic[8];
+        /** Cleared when the segment is replaced or closed. */
+        std::atomic<uint64_t> valid;
+        uint64_t numColumns;
+        uint64_t numSlots;
+        uint64_t namesOffset;
+        uint64_t namesSize;
+        uint64_t slotsOffset;
+        uint64_t slotSize;
+        /** Number of dumps published so far. */
+        std::atomic<uint64_t> numDumps;
+    };
+
+    /**
+     * @param name Name of the shared memory segment.
+     * @param stats Stats to publish, as ObjectMatch expressions, or all
+     * of them if empty.
+     * @param slots Number of dumps kept in the ring.
+     */
+    ShmRing(const std::string &name, const std::vector<std::string> &stats,
+            size_t slots);
+    ~ShmRing();
+
+    ShmRing(const ShmRing &other) = delete;
+    ShmRing &operator=(const ShmRing &other) = delete;
+
+  public: // Output interface
+    void begin() override;
+    void end() override;
+    bool valid() const override;
+
+    void beginGroup(const char *name) override;
+    void endGroup() override;
+
+    void visit(const ScalarInfo &info) override;
+    void visit(const VectorInfo &info) override;
+    void visit(const DistInfo &info) override;
+    void visit(const VectorDistInfo &info) override;
+    void visit(const Vector2dInfo &info) override;
+    void visit(const FormulaInfo &info) override;
+    void visit(const SparseHistInfo &info) override;
+
+  private:
+    const std::string segmentName;
+    const size_t numSlots;
+    ObjectMatch filter;
+
+    /** Whether a stat, by id, is published. */
+    std::unordered_map<int, bool> selected;
+
+    std::stack<std::string> path;
+
+    /** Stats and number of columns published by the last dump. */
+    std::vector<std::pair<int, size_t>> layout;
+    /** Names and units of the columns of the segment. */
+    std::vector<std::pair<std::string, std::string>> columns;
+
+    size_t layoutPos;
+    bool layoutChanged;
+    std::vector<double> values;
+
+    Header *header;
+    size_t segmentSize;
+
+    std::string statName(const std::string &name) const;
+    bool isSelected(const Info &info);
+
+    /**
+     * Check a stat against the layout of the previous dumps.
+     *
+     * @return Whether the names of its columns have to be added.
+     */
+    bool beginStat(const Info &info, size_t columns);
+    void addColumn(const Info &info, const std::string &name);
+    void addDist(const Info &info, const std::string &name,
+                 const DistData &data, bool names);
+
+    /** Replace the segment by one for the current columns. */
+    void createSegment();
+    void closeSegment();
+};
+
+std::unique_ptr<Output> initShmRing(const std::string &name,
+                                    const std::vector<std::string> &stats,
+                                    size_t slots);
+
+} // namespace statistics
+} // namespace gem5
+
+#endif // __BASE_STATS_SHM_RING_HH__
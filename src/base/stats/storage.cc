@@ -53,6 +53,7 @@ void
 DistStor::sample(Counter val, int number)
 {
     assert(bucket_size > 0);
+    dirty = true;
     if (val < min_track)
         underflow += number;
     else if (val > max_track)
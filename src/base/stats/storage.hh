@@ -106,9 +106,15 @@ class StatStor
     void prepare(const StorageParams* const storage_params) { }
 
     /**
-     * Reset stat value to default
+     * Reset stat value to default. Untouched stats are left alone, so
+     * that resetting them doesn't write to their cache lines.
      */
-    void reset(const StorageParams* const storage_params) { data = Counter(); }
+    void
+    reset(const StorageParams* const storage_params)
+    {
+        if (data != Counter())
+            data = Counter();
+    }
 
     /**
      * @return true if zero value
@@ -255,6 +261,8 @@ class DistStor
     Counter samples;
     /** Counter for each bucket. */
     VCounter cvec;
+    /** Whether anything was sampled since the last reset. */
+    bool dirty;
 
   public:
     /** The parameters for a distribution stat. */
@@ -285,7 +293,8 @@ class DistStor
     };
 
     DistStor(const StorageParams* const storage_params)
-        : cvec(safe_cast<const Params *>(storage_params)->buckets)
+        : cvec(safe_cast<const Params *>(storage_params)->buckets),
+          dirty(true)
     {
         reset(storage_params);
     }
@@ -339,11 +348,16 @@ class DistStor
     }
 
     /**
-     * Reset stat value to default
+     * Reset stat value to default. The buckets of distributions which
+     * weren't sampled since the last reset are already cleared.
      */
     void
     reset(const StorageParams* const storage_params)
     {
+        if (!dirty)
+            return;
+        dirty = false;
+
         const Params *params = safe_cast<const Params *>(storage_params);
         min_track = params->min;
         max_track = params->max;
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_VARINT_HH__
+#define __BASE_VARINT_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace gem5
+{
+
+/**
+ * @file base/varint.hh
+ *
+ * Variable length (LEB128) encoding of integers, as used by compact
+ * binary trace formats. Small values take a single byte and a 64 bit
+ * value takes at most ten. Signed values, e.g., deltas between
+ * addresses, should be zigzag encoded first so that small negative
+ * values stay small.
+ */
+
+namespace varint
+{
+
+/** Maximum number of bytes used to encode a 64 bit value. */
+constexpr size_t MaxBytes = 10;
+
+/** Map signed values onto unsigned ones, keeping small magnitudes small. */
+constexpr uint64_t
+zigzag(int64_t val)
+{
+    return (static_cast<uint64_t>(val) << 1) ^
+        static_cast<uint64_t>(val >> 63);
+}
+
+/** Reverse zigzag(). */
+constexpr int64_t
+unzigzag(uint64_t val)
+{
+    return static_cast<int64_t>(val >> 1) ^ -static_cast<int64_t>(val & 1);
+}
+
+/**
+ * Encode a value into a buffer.
+ * @param buf Buffer with room for at least MaxBytes bytes.
+ * @return The number of bytes used.
+ */
+inline size_t
+encode(uint64_t val, uint8_t *buf)
+{
+    size_t len = 0;
+    while (val >= 0x80) {
+        buf[len++] = static_cast<uint8_t>(val) | 0x80;
+        val >>= 7;
+    }
+    buf[len++] = static_cast<uint8_t>(val);
+    return len;
+}
+
+/** Append the encoding of a value to a vector. */
+inline void
+append(std::vector<uint8_t> &out, uint64_t val)
+{
+    uint8_t buf[MaxBytes];
+    out.insert(out.end(), buf, buf + encode(val, buf));
+}
+
+/**
+ * Decode a value from a buffer.
+ * @param buf The encoded value.
+ * @param size Number of valid bytes in buf.
+ * @param val The decoded value.
+ * @return The number of bytes consumed, or 0 if buf doesn't contain a
+ * complete, valid encoding.
+ */
+inline size_t
+decode(const uint8_t *buf, size_t size, uint64_t &val)
+{
+    val = 0;
+    for (size_t i = 0; i < size && i < MaxBytes; i++) {
+        val |= static_cast<uint64_t>(buf[i] & 0x7f) << (7 * i);
+        if (!(buf[i] & 0x80))
+            return i + 1;
+    }
+    return 0;
+}
+
+} // namespace varint
+} // namespace gem5
+
+#endif // __BASE_VARINT_HH__
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "base/varint.hh"
+
+using namespace gem5;
+
+TEST(VarintTest, Zigzag)
+{
+    EXPECT_EQ(0, varint::zigzag(0));
+    EXPECT_EQ(1, varint::zigzag(-1));
+    EXPECT_EQ(2, varint::zigzag(1));
+    EXPECT_EQ(3, varint::zigzag(-2));
+    EXPECT_EQ(std::numeric_limits<uint64_t>::max(),
+              varint::zigzag(std::numeric_limits<int64_t>::min()));
+
+    for (int64_t val: {int64_t(0), int64_t(-1), int64_t(1), int64_t(-4096),
+                       std::numeric_limits<int64_t>::min(),
+                       std::numeric_limits<int64_t>::max()}) {
+        EXPECT_EQ(val, varint::unzigzag(varint::zigzag(val)));
+    }
+}
+
+TEST(VarintTest, EncodedLength)
+{
+    uint8_t buf[varint::MaxBytes];
+    EXPECT_EQ(1, varint::encode(0, buf));
+    EXPECT_EQ(1, varint::encode(0x7f, buf));
+    EXPECT_EQ(2, varint::encode(0x80, buf));
+    EXPECT_EQ(2, varint::encode(0x3fff, buf));
+    EXPECT_EQ(3, varint::encode(0x4000, buf));
+    EXPECT_EQ(varint::MaxBytes,
+              varint::encode(std::numeric_limits<uint64_t>::max(), buf));
+}
+
+TEST(VarintTest, RoundTrip)
+{
+    const std::vector<uint64_t> values = {
+        0, 1, 0x7f, 0x80, 0x1234, 0xdeadbeef, 0x7fffffffffffffffULL,
+        std::numeric_limits<uint64_t>::max(),
+    };
+
+    std::vector<uint8_t> encoded;
+    for (auto val: values)
+        varint::append(encoded, val);
+
+    size_t pos = 0;
+    for (auto expected: values) {
+        uint64_t val;
+        size_t len = varint::decode(&encoded[pos], encoded.size() - pos, val);
+        ASSERT_NE(0, len);
+        EXPECT_EQ(expected, val);
+        pos += len;
+    }
+    EXPECT_EQ(encoded.size(), pos);
+}
+
+TEST(VarintTest, Truncated)
+{
+    uint8_t buf[varint::MaxBytes];
+    size_t len = varint::encode(0x123456, buf);
+    uint64_t val;
+    EXPECT_EQ(0, varint::decode(buf, len - 1, val));
+    EXPECT_EQ(len, varint::decode(buf, len, val));
+    EXPECT_EQ(0x123456, val);
+}
@@ -46,3 +46,16 @@ class NativeTrace(ExeTracer):
     type = "NativeTrace"
     cxx_class = "gem5::trace::NativeTrace"
     cxx_header = "cpu/nativetrace.hh"
+
+
+class BinTracer(InstTracer):
+    type = "BinTracer"
+    cxx_class = "gem5::trace::BinTracer"
+    cxx_header = "cpu/bin_trace.hh"
+
+    file_name = Param.String(
+        "inst_trace.bin.gz", "Instruction trace file, relative to the outdir"
+    )
+    buffer_size = Param.MemorySize(
+        "1MiB", "Size of the records buffered before compression"
+    )
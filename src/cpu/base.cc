@@ -381,17 +381,20 @@ BaseCPU::regProbePoints()
     ppRetiredLoads = pmuProbePoint("RetiredLoads");
     ppRetiredStores = pmuProbePoint("RetiredStores");
     ppRetiredBranches = pmuProbePoint("RetiredBranches");
+    ppRetiredBranchesPC = new ProbePointArg<RetiredBranch>(
+            getProbeManager(), "RetiredBranchesPC");
 
     ppSleeping = new ProbePointArg<bool>(this->getProbeManager(),
                                          "Sleeping");
 }
 
 void
-BaseCPU::probeInstCommit(const StaticInstPtr &inst, Addr pc)
+BaseCPU::probeInstCommit(const StaticInstPtr &inst, const PCStateBase &pc)
 {
-    if (!inst->isMicroop() || inst->isLastMicroop()) {
+    const bool last_op = !inst->isMicroop() || inst->isLastMicroop();
+    if (last_op) {
         ppRetiredInsts->notify(1);
-        ppRetiredInstsPC->notify(pc);
+        ppRetiredInstsPC->notify(pc.instAddr());
     }
 
     if (inst->isLoad())
@@ -400,8 +403,11 @@ BaseCPU::probeInstCommit(const StaticInstPtr &inst, Addr pc)
     if (inst->isStore() || inst->isAtomic())
         ppRetiredStores->notify(1);
 
-    if (inst->isControl())
+    if (inst->isControl()) {
         ppRetiredBranches->notify(1);
+        if (last_op)
+            ppRetiredBranchesPC->notify({inst.get(), &pc});
+    }
 }
 
 BaseCPU::
@@ -496,9 +496,20 @@ class BaseCPU : public ClockedObject
      * instruction.
      *
      * @param inst Instruction that just committed
-     * @param pc PC of the instruction that just committed
+     * @param pc PC state of the thread after executing the instruction,
+     *           i.e., with the PC of the instruction and the next PC of
+     *           the instruction that really follows it, e.g., the target
+     *           of a taken branch, rather than the predicted one
      */
-    virtual void probeInstCommit(const StaticInstPtr &inst, Addr pc);
+    virtual void probeInstCommit(const StaticInstPtr &inst,
+                                 const PCStateBase &pc);
+
+    /** Argument of the RetiredBranchesPC probe point. */
+    struct RetiredBranch
+    {
+        const StaticInst *inst;
+        const PCStateBase *pc;
+    };
 
    protected:
     /**
@@ -528,6 +539,11 @@ class BaseCPU : public ClockedObject
 
     /** Retired branches (any type) */
     probing::PMUUPtr ppRetiredBranches;
+    /**
+     * Retired branches, with their outcome. Only notified for the last
+     * microop of an instruction.
+     */
+    ProbePointArg<RetiredBranch> *ppRetiredBranchesPC;
 
     /** CPU cycle counter even if any thread Context is suspended*/
     probing::PMUUPtr ppAllCycles;
@@ -0,0 +1,338 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/bin_trace.hh"
+
+#include <zlib.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "base/loader/symtab.hh"
+#include "base/logging.hh"
+#include "base/output.hh"
+#include "base/varint.hh"
+#include "cpu/base.hh"
+#include "cpu/thread_context.hh"
+#include "enums/OpClass.hh"
+#include "sim/core.hh"
+#include "sim/full_system.hh"
+
+namespace gem5
+{
+
+namespace trace {
+
+namespace
+{
+
+const char Magic[8] = {'g', 'e', 'm', '5', 'b', 'i', 't', '2'};
+
+} // anonymous namespace
+
+/**
+ * Compresses the chunks of records of one or more tracers to a trace file
+ * in a background thread. Each chunk is prefixed with the id of the
+ * stream it belongs to and its size.
+ */
+class BinTraceWriter
+{
+  private:
+    gzFile file;
+    unsigned numStreams = 0;
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::deque<std::pair<unsigned, std::vector<uint8_t>>> chunks;
+    bool done = false;
+    std::thread thread;
+
+    void
+    compress(const void *data, size_t len)
+    {
+        if (!len)
+            return;
+        int errnum;
+        fatal_if(gzwrite(file, data, len) != (int)len,
+                 "Failed to write instruction trace: %s.",
+                 gzerror(file, &errnum));
+    }
+
+    void
+    run()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true) {
+            cond.wait(lock, [this]() { return done || !chunks.empty(); });
+            if (chunks.empty())
+                break;
+            auto [stream, chunk] = std::move(chunks.front());
+            chunks.pop_front();
+
+            // Compress without holding the lock, so the tracers are never
+            // blocked on compression.
+            lock.unlock();
+            uint8_t header[2 * varint::MaxBytes];
+            size_t len = varint::encode(stream, header);
+            len += varint::encode(chunk.size(), header + len);
+            compress(header, len);
+            compress(chunk.data(), chunk.size());
+            lock.lock();
+        }
+    }
+
+  public:
+    BinTraceWriter(const std::string &filename)
+    {
+        file = gzopen(filename.c_str(), "wb");
+        fatal_if(!file, "Failed to open instruction trace %s.", filename);
+        compress(Magic, sizeof(Magic));
+        thread = std::thread([this]() { run(); });
+    }
+
+    ~BinTraceWriter()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            done = true;
+        }
+        cond.notify_one();
+        thread.join();
+        fatal_if(gzclose(file) != Z_OK,
+                 "Failed to write the end of instruction trace.");
+    }
+
+    unsigned
+    newStream()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return numStreams++;
+    }
+
+    void
+    write(unsigned stream, std::vector<uint8_t> &&chunk)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            chunks.emplace_back(stream, std::move(chunk));
+        }
+        cond.notify_one();
+    }
+
+    /** Get the writer of a file, shared by all the tracers using it. */
+    static std::shared_ptr<BinTraceWriter>
+    get(const std::string &filename)
+    {
+        static std::map<std::string, std::weak_ptr<BinTraceWriter>> writers;
+        auto &weak = writers[filename];
+        auto writer = weak.lock();
+        if (!writer) {
+            writer = std::make_shared<BinTraceWriter>(filename);
+            weak = writer;
+        }
+        return writer;
+    }
+};
+
+BinTracer::BinTracer(const BinTracerParams &p)
+    : InstTracer(p),
+      writer(BinTraceWriter::get(simout.resolve(p.file_name))),
+      bufferSize(p.buffer_size),
+      streamId(writer->newStream())
+{
+    buffer.reserve(bufferSize);
+    // Simulation objects aren't destroyed on exit, so flush the trace
+    // explicitly.
+    registerExitCallback([this]() {
+        flush();
+        writer.reset();
+    });
+}
+
+BinTracer::~BinTracer()
+{
+    if (writer)
+        flush();
+}
+
+InstRecord *
+BinTracer::getInstRecord(Tick when, ThreadContext *tc,
+        const StaticInstPtr si, const PCStateBase &pc,
+        const StaticInstPtr mi)
+{
+    if (!writer)
+        return nullptr;
+    return new BinTracerRecord(*this, when, tc, si, pc, mi);
+}
+
+void
+BinTracer::flush()
+{
+    if (buffer.empty())
+        return;
+    std::vector<uint8_t> chunk;
+    chunk.reserve(bufferSize);
+    chunk.swap(buffer);
+    writer->write(streamId, std::move(chunk));
+}
+
+uint64_t
+BinTracer::intern(const std::string &str)
+{
+    auto [it, inserted] = strings.emplace(str, strings.size());
+    if (inserted) {
+        varint::append(buffer, BinTraceHeader::StringDef);
+        varint::append(buffer, str.size());
+        buffer.insert(buffer.end(), str.begin(), str.end());
+    }
+    return it->second;
+}
+
+uint64_t
+BinTracer::internInst(const StaticInstPtr &inst, Addr pc, bool in_user_mode)
+{
+    if (const uint64_t *id = instStrings.find(inst, pc, in_user_mode))
+        return *id;
+
+    // The parts of an ExeTracer line which only depend on the
+    // instruction, separated by NUL characters.
+    std::string str;
+    loader::SymbolTable::const_iterator sym;
+    if ((!FullSystem || !in_user_mode) &&
+            (sym = loader::debugSymbolTable.findNearest(pc)) !=
+                loader::debugSymbolTable.end()) {
+        Addr delta = pc - sym->address;
+        if (delta)
+            str = csprintf(" @%s+%d", sym->name, delta);
+        else
+            str = csprintf(" @%s", sym->name);
+    }
+    str += '\0';
+    str += inst->disassemble(pc, &loader::debugSymbolTable);
+    str += '\0';
+    str += enums::OpClassStrings[inst->opClass()];
+
+    uint64_t id = intern(str);
+    instStrings.insert(inst, pc, in_user_mode, id);
+    return id;
+}
+
+uint64_t
+BinTracer::internCPU(ThreadContext *tc)
+{
+    BaseCPU *cpu = tc->getCpuPtr();
+    auto it = cpuNames.find(cpu);
+    if (it == cpuNames.end())
+        it = cpuNames.emplace(cpu, intern(cpu->name())).first;
+    return it->second;
+}
+
+void
+BinTracerRecord::traceInst(const StaticInstPtr &inst, bool ran)
+{
+    auto &buffer = tracer.buffer;
+
+    // Strings have to be defined before the record using them.
+    const bool in_user_mode = thread->getIsaPtr()->inUserMode();
+    const uint64_t inst_id = tracer.internInst(inst, pc->instAddr(),
+                                               in_user_mode);
+    const uint64_t cpu_id = tracer.internCPU(thread);
+    const int context = (cpu_id << 8) | thread->threadId();
+
+    BinTraceHeader header;
+    header.kind = ran ? BinTraceHeader::Inst : BinTraceHeader::MacroInst;
+    header.userMode = in_user_mode;
+    header.context = context != tracer.lastContext;
+    header.microop = inst->isMicroop();
+    if (ran) {
+        header.predFalse = !predicate;
+        header.dataStatus = dataStatus;
+        header.mem = mem_valid;
+        header.fetchSeq = fetch_seq_valid;
+        header.cpSeq = cp_seq_valid;
+    }
+    varint::append(buffer, header.encode());
+
+    if (header.context) {
+        varint::append(buffer, cpu_id);
+        varint::append(buffer, thread->threadId());
+        tracer.lastContext = context;
+    }
+
+    varint::append(buffer, varint::zigzag(when - tracer.lastWhen));
+    tracer.lastWhen = when;
+    varint::append(buffer, varint::zigzag(pc->instAddr() - tracer.lastPC));
+    tracer.lastPC = pc->instAddr();
+    if (header.microop)
+        varint::append(buffer, pc->microPC());
+    varint::append(buffer, inst_id);
+
+    if (ran) {
+        if (dataStatus == DataReg) {
+            const std::string str = data.asReg.asString();
+            varint::append(buffer, str.size());
+            buffer.insert(buffer.end(), str.begin(), str.end());
+        } else if (dataStatus != DataInvalid) {
+            varint::append(buffer, data.asInt);
+        }
+        if (mem_valid) {
+            varint::append(buffer, varint::zigzag(addr - tracer.lastAddr));
+            tracer.lastAddr = addr;
+        }
+        if (fetch_seq_valid) {
+            varint::append(buffer,
+                    varint::zigzag(fetch_seq - tracer.lastFetchSeq));
+            tracer.lastFetchSeq = fetch_seq;
+        }
+        if (cp_seq_valid) {
+            varint::append(buffer,
+                    varint::zigzag(cp_seq - tracer.lastCPSeq));
+            tracer.lastCPSeq = cp_seq;
+        }
+    }
+
+    if (buffer.size() >= tracer.bufferSize)
+        tracer.flush();
+}
+
+void
+BinTracerRecord::dump()
+{
+    // Record what ExeTracer prints when both ExecMacro and ExecMicro are
+    // enabled, the decoder can filter it.
+    if (staticInst->isMicroop() && macroStaticInst &&
+            staticInst->isFirstMicroop()) {
+        traceInst(macroStaticInst, false);
+    }
+    traceInst(staticInst, true);
+}
+
+} // namespace trace
+} // namespace gem5
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_BIN_TRACE_HH__
+#define __CPU_BIN_TRACE_HH__
+
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "base/types.hh"
+#include "cpu/bin_trace_format.hh"
+#include "cpu/static_inst.hh"
+#include "params/BinTracer.hh"
+#include "sim/insttracer.hh"
+
+namespace gem5
+{
+
+class ThreadContext;
+
+namespace trace {
+
+class BinTraceWriter;
+class BinTracer;
+
+/**
+ * Ids of the interned strings of instructions, by instruction, PC and
+ * whether it ran in user mode, which decides whether it gets a symbol.
+ * Instructions are told apart by address, so the table keeps them alive
+ * for their addresses not to be reused.
+ */
+template <class InstPtr>
+class InstIdTable
+{
+  private:
+    typedef std::tuple<const void *, Addr, bool> Key;
+    std::map<Key, std::pair<InstPtr, uint64_t>> ids;
+
+  public:
+    /** @return The id of an instruction, or nullptr if it has none. */
+    const uint64_t *
+    find(const InstPtr &inst, Addr pc, bool in_user_mode) const
+    {
+        auto it = ids.find(Key(inst.get(), pc, in_user_mode));
+        return it == ids.end() ? nullptr : &it->second.second;
+    }
+
+    void
+    insert(const InstPtr &inst, Addr pc, bool in_user_mode, uint64_t id)
+    {
+        ids.emplace(Key(inst.get(), pc, in_user_mode),
+                    std::make_pair(inst, id));
+    }
+
+    size_t size() const { return ids.size(); }
+};
+
+/**
+ * Binary version of the ExeTracer output. Records are varint encoded,
+ * with PCs, addresses, ticks and sequence numbers delta encoded, and
+ * the text which only depends on the instruction (disassembly, symbol and
+ * op class) is interned in a string table. util/decode_bin_trace.py turns
+ * a trace back into the text ExeTracer prints with the Exec debug flags.
+ *
+ * Every tracer buffers its records, and hands full buffers over to a
+ * background thread which compresses them to the trace file. Tracers of
+ * CPUs running in different event queues share the file without
+ * contention, as their records are written as separate chunks.
+ */
+class BinTracerRecord : public InstRecord
+{
+  public:
+    BinTracerRecord(BinTracer &_tracer, Tick when, ThreadContext *tc,
+                    const StaticInstPtr si, const PCStateBase &pc,
+                    const StaticInstPtr mi=nullptr)
+        : InstRecord(when, tc, si, pc, mi), tracer(_tracer)
+    {}
+
+    void dump() override;
+
+  protected:
+    BinTracer &tracer;
+
+    void traceInst(const StaticInstPtr &inst, bool ran);
+};
+
+class BinTracer : public InstTracer
+{
+  public:
+    BinTracer(const BinTracerParams &p);
+    ~BinTracer();
+
+    InstRecord *getInstRecord(Tick when, ThreadContext *tc,
+            const StaticInstPtr si, const PCStateBase &pc,
+            const StaticInstPtr mi=nullptr) override;
+
+  protected:
+    std::shared_ptr<BinTraceWriter> writer;
+    const size_t bufferSize;
+    /** Chunk stream of this tracer in the trace file. */
+    const unsigned streamId;
+
+    std::vector<uint8_t> buffer;
+
+    /** @{ */
+    /** State of the delta encoding. */
+    Tick lastWhen = 0;
+    Addr lastPC = 0;
+    Addr lastAddr = 0;
+    InstSeqNum lastFetchSeq = 0;
+    InstSeqNum lastCPSeq = 0;
+    int lastContext = -1;
+    /** @} */
+
+    /** Interned strings. */
+    std::unordered_map<std::string, uint64_t> strings;
+    /** Interned instruction strings. */
+    InstIdTable<StaticInstPtr> instStrings;
+    /** Interned CPU names, by CPU. */
+    std::unordered_map<const void *, uint64_t> cpuNames;
+
+    uint64_t intern(const std::string &str);
+    uint64_t internInst(const StaticInstPtr &inst, Addr pc,
+                        bool in_user_mode);
+    uint64_t internCPU(ThreadContext *tc);
+
+    void flush();
+
+    friend class BinTracerRecord;
+};
+
+} // namespace trace
+} // namespace gem5
+
+#endif // __CPU_BIN_TRACE_HH__
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "base/refcnt.hh"
+#include "cpu/bin_trace.hh"
+
+using namespace gem5;
+using namespace gem5::trace;
+
+namespace
+{
+
+/** Stands for a StaticInst, which is reference counted the same way. */
+class TestInst : public RefCounted
+{
+};
+
+typedef RefCountingPtr<TestInst> TestInstPtr;
+
+} // anonymous namespace
+
+/** Different instructions at the same PC, e.g., microops, are apart. */
+TEST(InstIdTableTest, InstructionsAtTheSamePC)
+{
+    TestInstPtr macroop = new TestInst;
+    TestInstPtr microop = new TestInst;
+    InstIdTable<TestInstPtr> table;
+
+    table.insert(macroop, 0x1000, false, 1);
+    EXPECT_EQ(table.find(microop, 0x1000, false), nullptr);
+    table.insert(microop, 0x1000, false, 2);
+
+    ASSERT_NE(table.find(macroop, 0x1000, false), nullptr);
+    ASSERT_NE(table.find(microop, 0x1000, false), nullptr);
+    EXPECT_EQ(*table.find(macroop, 0x1000, false), 1);
+    EXPECT_EQ(*table.find(microop, 0x1000, false), 2);
+    EXPECT_EQ(table.size(), 2);
+}
+
+TEST(InstIdTableTest, PCAndMode)
+{
+    TestInstPtr inst = new TestInst;
+    InstIdTable<TestInstPtr> table;
+
+    table.insert(inst, 0x1000, false, 1);
+    table.insert(inst, 0x1000, true, 2);
+    table.insert(inst, 0x2000, false, 3);
+    EXPECT_EQ(*table.find(inst, 0x1000, false), 1);
+    EXPECT_EQ(*table.find(inst, 0x1000, true), 2);
+    EXPECT_EQ(*table.find(inst, 0x2000, false), 3);
+    EXPECT_EQ(table.find(inst, 0x2000, true), nullptr);
+}
+
+/** The table keeps instructions alive, so their addresses can't be reused. */
+TEST(InstIdTableTest, KeepsInstructionsAlive)
+{
+    InstIdTable<TestInstPtr> table;
+    const TestInst *addr;
+    {
+        TestInstPtr inst = new TestInst;
+        addr = inst.get();
+        table.insert(inst, 0x1000, false, 1);
+    }
+    TestInstPtr other = new TestInst;
+    EXPECT_NE(other.get(), addr);
+    EXPECT_EQ(table.find(other, 0x1000, false), nullptr);
+}
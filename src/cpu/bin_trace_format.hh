@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_BIN_TRACE_FORMAT_HH__
+#define __CPU_BIN_TRACE_FORMAT_HH__
+
+#include <cstdint>
+
+namespace gem5
+{
+
+namespace trace {
+
+/**
+ * Header of a BinTracer record, which says what kind of record it is and
+ * which optional fields follow it. util/decode_bin_trace.py has to be
+ * kept in sync with this layout.
+ */
+struct BinTraceHeader
+{
+    /** Kinds of records, in the low bits of the header. */
+    enum Kind
+    {
+        StringDef = 0,
+        Inst = 1,
+        MacroInst = 2
+    };
+
+    /** @{ */
+    /** Layout of the header. */
+    static constexpr uint64_t KindMask = 0x3;
+    static constexpr uint64_t MicroopFlag = 1 << 2;
+    static constexpr uint64_t PredFalseFlag = 1 << 3;
+    static constexpr int DataStatusShift = 4;
+    /** Wide enough for all the InstRecord::DataStatus values. */
+    static constexpr uint64_t DataStatusMask = 0xf;
+    static constexpr uint64_t MemFlag = 1 << 8;
+    static constexpr uint64_t FetchSeqFlag = 1 << 9;
+    static constexpr uint64_t CPSeqFlag = 1 << 10;
+    static constexpr uint64_t UserModeFlag = 1 << 11;
+    static constexpr uint64_t ContextFlag = 1 << 12;
+    /** @} */
+
+    Kind kind = StringDef;
+    bool microop = false;
+    bool predFalse = false;
+    unsigned dataStatus = 0;
+    bool mem = false;
+    bool fetchSeq = false;
+    bool cpSeq = false;
+    bool userMode = false;
+    bool context = false;
+
+    uint64_t
+    encode() const
+    {
+        return (uint64_t)kind |
+            (microop ? MicroopFlag : 0) |
+            (predFalse ? PredFalseFlag : 0) |
+            ((dataStatus & DataStatusMask) << DataStatusShift) |
+            (mem ? MemFlag : 0) |
+            (fetchSeq ? FetchSeqFlag : 0) |
+            (cpSeq ? CPSeqFlag : 0) |
+            (userMode ? UserModeFlag : 0) |
+            (context ? ContextFlag : 0);
+    }
+
+    static BinTraceHeader
+    decode(uint64_t bits)
+    {
+        BinTraceHeader header;
+        header.kind = (Kind)(bits & KindMask);
+        header.microop = bits & MicroopFlag;
+        header.predFalse = bits & PredFalseFlag;
+        header.dataStatus = (bits >> DataStatusShift) & DataStatusMask;
+        header.mem = bits & MemFlag;
+        header.fetchSeq = bits & FetchSeqFlag;
+        header.cpSeq = bits & CPSeqFlag;
+        header.userMode = bits & UserModeFlag;
+        header.context = bits & ContextFlag;
+        return header;
+    }
+};
+
+} // namespace trace
+} // namespace gem5
+
+#endif // __CPU_BIN_TRACE_FORMAT_HH__
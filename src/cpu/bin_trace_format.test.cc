@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include "cpu/bin_trace_format.hh"
+
+using namespace gem5;
+using namespace gem5::trace;
+
+namespace
+{
+
+// InstRecord::DataStatus values: DataInvalid, DataInt8, DataInt16,
+// DataDouble, DataInt32, DataReg and DataInt64.
+const unsigned DataStatuses[] = {0, 1, 2, 3, 4, 5, 8};
+
+void
+expectEqual(const BinTraceHeader &a, const BinTraceHeader &b)
+{
+    EXPECT_EQ(a.kind, b.kind);
+    EXPECT_EQ(a.microop, b.microop);
+    EXPECT_EQ(a.predFalse, b.predFalse);
+    EXPECT_EQ(a.dataStatus, b.dataStatus);
+    EXPECT_EQ(a.mem, b.mem);
+    EXPECT_EQ(a.fetchSeq, b.fetchSeq);
+    EXPECT_EQ(a.cpSeq, b.cpSeq);
+    EXPECT_EQ(a.userMode, b.userMode);
+    EXPECT_EQ(a.context, b.context);
+}
+
+} // anonymous namespace
+
+TEST(BinTraceHeaderTest, RoundTrip)
+{
+    for (unsigned status: DataStatuses) {
+        for (unsigned flags = 0; flags < (1 << 7); flags++) {
+            BinTraceHeader header;
+            header.kind = flags & 1 ?
+                BinTraceHeader::Inst : BinTraceHeader::MacroInst;
+            header.microop = flags & 2;
+            header.predFalse = flags & 4;
+            header.dataStatus = status;
+            header.mem = flags & 8;
+            header.fetchSeq = flags & 16;
+            header.cpSeq = flags & 32;
+            header.userMode = flags & 64;
+            header.context = !(flags & 64);
+            expectEqual(header, BinTraceHeader::decode(header.encode()));
+        }
+    }
+}
+
+TEST(BinTraceHeaderTest, DataStatusDoesNotSetFlags)
+{
+    // A 64 bit result used to overflow into the memory flag.
+    for (unsigned status: DataStatuses) {
+        BinTraceHeader header;
+        header.kind = BinTraceHeader::Inst;
+        header.dataStatus = status;
+        const BinTraceHeader decoded =
+            BinTraceHeader::decode(header.encode());
+        EXPECT_EQ(decoded.dataStatus, status);
+        EXPECT_FALSE(decoded.mem);
+        EXPECT_FALSE(decoded.fetchSeq);
+        EXPECT_EQ(decoded.kind, BinTraceHeader::Inst);
+    }
+}
+
+TEST(BinTraceHeaderTest, StringDef)
+{
+    // String definitions are only the kind, the decoder relies on it.
+    EXPECT_EQ(BinTraceHeader().encode(), BinTraceHeader::StringDef);
+}
@@ -29,10 +29,16 @@
 #ifndef __CPU_DECODE_CACHE_HH__
 #define __CPU_DECODE_CACHE_HH__
 
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
 
 #include "base/bitfield.hh"
 #include "base/compiler.hh"
+#include "base/types.hh"
 #include "cpu/static_inst_fwd.hh"
 
 namespace gem5
@@ -135,6 +141,109 @@ class AddrMap
     }
 };
 
+/**
+ * A thread safe hash of decoded instructions keyed by the machine
+ * instruction and an opaque decoder context (e.g., the x86 m5Reg). It is
+ * intended to be shared by decoders which may live on different event
+ * queue threads, so it is split into independently locked shards to keep
+ * contention low. Entries are never removed.
+ *
+ * InstPtr is the handle the decoded instructions are stored as. It is
+ * only a parameter so the map can be tested without real instructions.
+ */
+template <typename EMI, typename InstPtr=StaticInstPtr>
+class SharedInstMap
+{
+  public:
+    struct Key
+    {
+        EMI machInst;
+        uint64_t context;
+
+        bool
+        operator==(const Key &other) const
+        {
+            return context == other.context && machInst == other.machInst;
+        }
+    };
+
+  private:
+    struct KeyHash
+    {
+        size_t
+        operator()(const Key &key) const
+        {
+            // Mix the context in so that identical encodings decoded in
+            // different contexts end up in different buckets.
+            return std::hash<EMI>()(key.machInst) ^
+                (key.context * 0x9e3779b97f4a7c15ULL);
+        }
+    };
+
+    using Map = std::unordered_map<Key, InstPtr, KeyHash>;
+
+    static constexpr unsigned NumShards = 64;
+
+    struct Shard
+    {
+        mutable std::shared_mutex lock;
+        Map map;
+    };
+    std::array<Shard, NumShards> shards;
+
+    Shard &
+    shard(const Key &key)
+    {
+        return shards[KeyHash()(key) % NumShards];
+    }
+
+  public:
+    /** Approximate host memory used by one entry of the map. */
+    static constexpr size_t EntryBytes =
+        sizeof(typename Map::value_type) + 2 * sizeof(void *);
+
+    /**
+     * Look up a decoded instruction.
+     * @retval The instruction, or nullptr if it hasn't been inserted yet.
+     */
+    InstPtr
+    find(const EMI &mach_inst, uint64_t context)
+    {
+        const Key key{mach_inst, context};
+        Shard &s = shard(key);
+        std::shared_lock<std::shared_mutex> guard(s.lock);
+        auto it = s.map.find(key);
+        if (it == s.map.end())
+            return InstPtr();
+        return it->second;
+    }
+
+    /**
+     * Insert a decoded instruction unless another thread beat us to it.
+     * @retval The instruction which is in the map after the call.
+     */
+    InstPtr
+    insert(const EMI &mach_inst, uint64_t context, const InstPtr &si)
+    {
+        const Key key{mach_inst, context};
+        Shard &s = shard(key);
+        std::unique_lock<std::shared_mutex> guard(s.lock);
+        return s.map.emplace(key, si).first->second;
+    }
+
+    /** Number of entries across all shards. */
+    size_t
+    size() const
+    {
+        size_t total = 0;
+        for (const auto &s: shards) {
+            std::shared_lock<std::shared_mutex> guard(s.lock);
+            total += s.map.size();
+        }
+        return total;
+    }
+};
+
 } // namespace decode_cache
 } // namespace gem5
 
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "cpu/decode_cache.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+using Inst = std::shared_ptr<const uint64_t>;
+using InstMap = decode_cache::SharedInstMap<uint64_t, Inst>;
+
+constexpr unsigned NumThreads = 8;
+constexpr uint64_t NumMachInsts = 2000;
+constexpr uint64_t NumContexts = 3;
+
+} // anonymous namespace
+
+/** A miss returns a null instruction and the first insert wins. */
+TEST(SharedInstMapTest, FirstInsertWins)
+{
+    InstMap map;
+    EXPECT_EQ(map.find(1, 0), nullptr);
+
+    Inst first = std::make_shared<const uint64_t>(1);
+    Inst second = std::make_shared<const uint64_t>(1);
+    EXPECT_EQ(map.insert(1, 0, first), first);
+    EXPECT_EQ(map.insert(1, 0, second), first);
+    EXPECT_EQ(map.find(1, 0), first);
+
+    // The same encoding under another context is a different key.
+    EXPECT_EQ(map.find(1, 1), nullptr);
+    EXPECT_EQ(map.insert(1, 1, second), second);
+    EXPECT_EQ(map.size(), 2);
+}
+
+/**
+ * Several threads decode the same instructions, each in its own order, and
+ * race to insert them. Every thread has to end up with the one instance
+ * which made it into the map for each key.
+ */
+TEST(SharedInstMapTest, ConcurrentFindInsert)
+{
+    InstMap map;
+
+    std::vector<std::pair<uint64_t, uint64_t>> keys;
+    for (uint64_t mach_inst = 0; mach_inst < NumMachInsts; mach_inst++)
+        for (uint64_t context = 0; context < NumContexts; context++)
+            keys.emplace_back(mach_inst, context);
+
+    std::vector<std::vector<Inst>> seen(NumThreads,
+                                        std::vector<Inst>(keys.size()));
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < NumThreads; t++) {
+        threads.emplace_back([&, t]() {
+            std::vector<size_t> order(keys.size());
+            for (size_t i = 0; i < order.size(); i++)
+                order[i] = i;
+            std::shuffle(order.begin(), order.end(), std::mt19937(t));
+
+            // Go over the keys twice so later lookups hit what this and
+            // the other threads inserted.
+            for (int pass = 0; pass < 2; pass++) {
+                for (size_t i: order) {
+                    auto [mach_inst, context] = keys[i];
+                    Inst inst = map.find(mach_inst, context);
+                    if (!inst) {
+                        inst = map.insert(mach_inst, context,
+                                std::make_shared<const uint64_t>(mach_inst));
+                    }
+                    if (pass == 0)
+                        seen[t][i] = inst;
+                    else if (seen[t][i] != inst)
+                        seen[t][i] = nullptr;
+                }
+            }
+        });
+    }
+    for (auto &thread: threads)
+        thread.join();
+
+    ASSERT_EQ(map.size(), keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+        auto [mach_inst, context] = keys[i];
+        Inst inst = map.find(mach_inst, context);
+        ASSERT_NE(inst, nullptr);
+        EXPECT_EQ(*inst, mach_inst);
+        for (unsigned t = 0; t < NumThreads; t++)
+            EXPECT_EQ(seen[t][i], inst) << "thread " << t << " key " << i;
+    }
+}
@@ -881,7 +881,12 @@ Execute::doInstCommitAccounting(MinorDynInstPtr inst)
     if (inst->traceData)
         inst->traceData->setCPSeq(thread->numOp);
 
-    cpu.probeInstCommit(inst->staticInst, inst->pc->instAddr());
+    /* After execute, the thread's PC still refers to this instruction,
+     *  with the next PC where execution really goes, unless a fault has
+     *  moved it to a handler already */
+    const PCStateBase &pc = thread->pcState();
+    cpu.probeInstCommit(inst->staticInst,
+        pc.instAddr() == inst->pc->instAddr() ? pc : *inst->pc);
 }
 
 bool
@@ -1163,7 +1163,7 @@ CPU::instDone(ThreadID tid, const DynInstPtr &inst)
     thread[tid]->threadStats.numOps++;
     commitStats[tid]->numOpsNotNOP++;
 
-    probeInstCommit(inst->staticInst, inst->pcState().instAddr());
+    probeInstCommit(inst->staticInst, inst->pcState());
 }
 
 void
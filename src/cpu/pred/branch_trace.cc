@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/pred/branch_trace.hh"
+
+#include <cstring>
+
+#include "base/logging.hh"
+#include "base/varint.hh"
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+namespace
+{
+
+const char Magic[8] = {'g', 'e', 'm', '5', 'b', 'r', 't', '1'};
+
+// Layout of the first byte of a record.
+constexpr uint8_t TypeMask = 0x0f;
+constexpr uint8_t TakenFlag = 0x10;
+constexpr uint8_t TargetFlag = 0x20;
+
+constexpr size_t MaxRecordBytes = 1 + 4 * varint::MaxBytes;
+constexpr size_t BufferSize = 64 * 1024;
+
+} // anonymous namespace
+
+BranchTraceWriter::BranchTraceWriter(const std::string &filename)
+{
+    file = gzopen(filename.c_str(), "wb");
+    fatal_if(!file, "Failed to open branch trace %s.", filename);
+    buffer.reserve(BufferSize + MaxRecordBytes);
+    buffer.insert(buffer.end(), Magic, Magic + sizeof(Magic));
+}
+
+BranchTraceWriter::~BranchTraceWriter()
+{
+    flush();
+    gzclose(file);
+}
+
+void
+BranchTraceWriter::flush()
+{
+    if (buffer.empty())
+        return;
+    const int bytes = gzwrite(file, buffer.data(), buffer.size());
+    fatal_if(bytes != static_cast<int>(buffer.size()),
+            "Failed to write branch trace.");
+    buffer.clear();
+}
+
+void
+BranchTraceWriter::write(const TraceBranch &branch)
+{
+    const bool fall_through = branch.target == branch.pc + branch.size;
+
+    uint8_t flags = static_cast<uint8_t>(branch.type) & TypeMask;
+    if (branch.taken)
+        flags |= TakenFlag;
+    if (!fall_through)
+        flags |= TargetFlag;
+    buffer.push_back(flags);
+
+    varint::append(buffer, varint::zigzag(branch.pc - lastPC));
+    varint::append(buffer, branch.size);
+    if (!fall_through)
+        varint::append(buffer, varint::zigzag(branch.target - branch.pc));
+    varint::append(buffer, branch.insts);
+    lastPC = branch.pc;
+
+    if (buffer.size() >= BufferSize)
+        flush();
+}
+
+BranchTraceReader::BranchTraceReader(const std::string &filename)
+{
+    file = gzopen(filename.c_str(), "rb");
+    fatal_if(!file, "Failed to open branch trace %s.", filename);
+
+    char magic[sizeof(Magic)];
+    fatal_if(gzread(file, magic, sizeof(magic)) != sizeof(magic) ||
+            memcmp(magic, Magic, sizeof(Magic)),
+            "%s is not a branch trace.", filename);
+}
+
+BranchTraceReader::~BranchTraceReader()
+{
+    gzclose(file);
+}
+
+void
+BranchTraceReader::refill()
+{
+    if (eof || buffer.size() - pos >= MaxRecordBytes)
+        return;
+
+    buffer.erase(buffer.begin(), buffer.begin() + pos);
+    pos = 0;
+
+    const size_t old_size = buffer.size();
+    buffer.resize(BufferSize);
+    const int bytes = gzread(file, buffer.data() + old_size,
+                             BufferSize - old_size);
+    fatal_if(bytes < 0, "Failed to read branch trace.");
+    buffer.resize(old_size + bytes);
+    if (bytes == 0)
+        eof = true;
+}
+
+bool
+BranchTraceReader::readVarint(uint64_t &val)
+{
+    size_t len = varint::decode(buffer.data() + pos, buffer.size() - pos,
+                                val);
+    fatal_if(!len, "Truncated branch trace.");
+    pos += len;
+    return true;
+}
+
+bool
+BranchTraceReader::read(TraceBranch &branch)
+{
+    refill();
+    if (pos == buffer.size())
+        return false;
+
+    const uint8_t flags = buffer[pos++];
+    const unsigned type = flags & TypeMask;
+    fatal_if(type >= enums::Num_BranchType,
+            "Bad branch type %d in branch trace.", type);
+    branch.type = static_cast<BranchType>(type);
+    branch.taken = flags & TakenFlag;
+
+    uint64_t val;
+    readVarint(val);
+    branch.pc = lastPC + varint::unzigzag(val);
+    lastPC = branch.pc;
+
+    readVarint(val);
+    branch.size = val;
+
+    if (flags & TargetFlag) {
+        readVarint(val);
+        branch.target = branch.pc + varint::unzigzag(val);
+    } else {
+        branch.target = branch.pc + branch.size;
+    }
+
+    readVarint(branch.insts);
+    return true;
+}
+
+} // namespace branch_prediction
+} // namespace gem5
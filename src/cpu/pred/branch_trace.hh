@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_PRED_BRANCH_TRACE_HH__
+#define __CPU_PRED_BRANCH_TRACE_HH__
+
+#include <zlib.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base/types.hh"
+#include "enums/BranchType.hh"
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+typedef enums::BranchType BranchType;
+
+/**
+ * @file
+ * A compact, gzip compressed trace of retired branches which can be
+ * replayed through a branch predictor without simulating a CPU.
+ *
+ * Each record starts with a byte holding the branch type and flags,
+ * followed by LEB128 varints: the zigzag encoded delta from the previous
+ * branch PC, the instruction size, the zigzag encoded delta from the
+ * branch PC to its target (only if the target isn't the fall through
+ * PC) and the number of instructions retired since the previous branch.
+ */
+
+/** A retired branch. */
+struct TraceBranch
+{
+    /// Address of the branch.
+    Addr pc = 0;
+    /// Address of the instruction retired after the branch.
+    Addr target = 0;
+    /// Size of the branch instruction, 0 if unknown.
+    unsigned size = 0;
+    BranchType type = BranchType::NoBranch;
+    bool taken = false;
+    /// Instructions retired since the previous branch, including this one.
+    uint64_t insts = 1;
+
+    bool
+    operator==(const TraceBranch &other) const
+    {
+        return pc == other.pc && target == other.target &&
+            size == other.size && type == other.type &&
+            taken == other.taken && insts == other.insts;
+    }
+};
+
+class BranchTraceWriter
+{
+  private:
+    gzFile file;
+    std::vector<uint8_t> buffer;
+    Addr lastPC = 0;
+
+    void flush();
+
+  public:
+    BranchTraceWriter(const std::string &filename);
+    ~BranchTraceWriter();
+
+    void write(const TraceBranch &branch);
+};
+
+class BranchTraceReader
+{
+  private:
+    gzFile file;
+    std::vector<uint8_t> buffer;
+    size_t pos = 0;
+    bool eof = false;
+    Addr lastPC = 0;
+
+    /// Make sure at least MaxRecordBytes are buffered, unless at the end.
+    void refill();
+
+    bool readVarint(uint64_t &val);
+
+  public:
+    BranchTraceReader(const std::string &filename);
+    ~BranchTraceReader();
+
+    /**
+     * Read the next branch.
+     * @return false at the end of the trace.
+     */
+    bool read(TraceBranch &branch);
+};
+
+} // namespace branch_prediction
+} // namespace gem5
+
+#endif // __CPU_PRED_BRANCH_TRACE_HH__
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "cpu/pred/branch_trace.hh"
+
+using namespace gem5;
+using namespace gem5::branch_prediction;
+
+namespace
+{
+
+std::string
+tempTraceName()
+{
+    char name[] = "/tmp/branch_trace_test.XXXXXX";
+    int fd = mkstemp(name);
+    EXPECT_NE(fd, -1);
+    close(fd);
+    return name;
+}
+
+} // anonymous namespace
+
+TEST(BranchTraceTest, Empty)
+{
+    const std::string name = tempTraceName();
+    {
+        BranchTraceWriter writer(name);
+    }
+    BranchTraceReader reader(name);
+    TraceBranch branch;
+    EXPECT_FALSE(reader.read(branch));
+    std::remove(name.c_str());
+}
+
+TEST(BranchTraceTest, RoundTrip)
+{
+    std::vector<TraceBranch> branches;
+    Addr pc = 0x400000;
+    for (int i = 0; i < 100000; i++) {
+        TraceBranch branch;
+        branch.type = static_cast<BranchType>(1 + i % 7);
+        branch.size = i % 3 ? 4 : 2;
+        branch.pc = pc;
+        branch.taken = i % 5;
+        branch.target = branch.taken ? pc - 0x40 * (i % 11) + 0x100 :
+            pc + branch.size;
+        branch.insts = 1 + i % 17;
+        branches.push_back(branch);
+        pc = branch.target + 8 * (i % 4);
+    }
+    // Extreme deltas.
+    branches.push_back({0xffffffffffff0000, 0x10, 4,
+            BranchType::IndirectUncond, true, 1});
+    branches.push_back({0x10, 0xffffffffffff0000, 4,
+            BranchType::Return, true, 1000000});
+
+    const std::string name = tempTraceName();
+    {
+        BranchTraceWriter writer(name);
+        for (const auto &branch : branches)
+            writer.write(branch);
+    }
+
+    BranchTraceReader reader(name);
+    TraceBranch branch;
+    for (size_t i = 0; i < branches.size(); i++) {
+        ASSERT_TRUE(reader.read(branch));
+        EXPECT_EQ(branch, branches[i]) << "record " << i;
+    }
+    EXPECT_FALSE(reader.read(branch));
+    std::remove(name.c_str());
+}
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/pred/branch_trace_replayer.hh"
+
+#include "arch/generic/pcstate.hh"
+#include "base/trace.hh"
+#include "debug/Branch.hh"
+#include "sim/sim_exit.hh"
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+namespace
+{
+
+/** A PC state for instructions of any size. */
+class TracePCState : public GenericISA::PCStateWithNext
+{
+  private:
+    unsigned _size;
+
+  public:
+    TracePCState(Addr pc, unsigned size) : _size(size) { set(pc); }
+
+    PCStateBase *clone() const override { return new TracePCState(*this); }
+
+    void
+    set(Addr val) override
+    {
+        GenericISA::PCStateWithNext::set(val);
+        npc(val + _size);
+    }
+
+    void
+    update(const PCStateBase &other) override
+    {
+        GenericISA::PCStateWithNext::update(other);
+        _size = other.as<TracePCState>()._size;
+    }
+
+    bool branching() const override { return npc() != pc() + _size; }
+
+    void
+    advance() override
+    {
+        _pc = _npc;
+        _npc += _size;
+    }
+};
+
+/** A branch of a given type, which can't be executed. */
+class TraceBranchInst : public StaticInst
+{
+  public:
+    TraceBranchInst(BranchType type, unsigned size)
+        : StaticInst("trace_branch", No_OpClass)
+    {
+        flags[IsControl] = true;
+        switch (type) {
+          case BranchType::Return:
+            flags[IsReturn] = true;
+            flags[IsIndirectControl] = true;
+            flags[IsUncondControl] = true;
+            break;
+          case BranchType::CallDirect:
+            flags[IsCall] = true;
+            flags[IsDirectControl] = true;
+            flags[IsUncondControl] = true;
+            break;
+          case BranchType::CallIndirect:
+            flags[IsCall] = true;
+            flags[IsIndirectControl] = true;
+            flags[IsUncondControl] = true;
+            break;
+          case BranchType::DirectCond:
+            flags[IsDirectControl] = true;
+            flags[IsCondControl] = true;
+            break;
+          case BranchType::DirectUncond:
+            flags[IsDirectControl] = true;
+            flags[IsUncondControl] = true;
+            break;
+          case BranchType::IndirectCond:
+            flags[IsIndirectControl] = true;
+            flags[IsCondControl] = true;
+            break;
+          case BranchType::IndirectUncond:
+            flags[IsIndirectControl] = true;
+            flags[IsUncondControl] = true;
+            break;
+          default:
+            panic("Unexpected branch type %s.", toString(type));
+        }
+        this->size(size);
+    }
+
+    Fault
+    execute(ExecContext *xc, trace::InstRecord *traceData) const override
+    {
+        panic("Trace branches can't be executed.");
+    }
+
+    void
+    advancePC(PCStateBase &pc) const override
+    {
+        pc.as<TracePCState>().advance();
+    }
+
+    std::unique_ptr<PCStateBase>
+    buildRetPC(const PCStateBase &cur_pc,
+            const PCStateBase &call_pc) const override
+    {
+        PCStateBase *ret_pc = call_pc.clone();
+        ret_pc->set(call_pc.instAddr() + size());
+        return std::unique_ptr<PCStateBase>{ret_pc};
+    }
+
+    std::string
+    generateDisassembly(Addr pc,
+            const loader::SymbolTable *symtab) const override
+    {
+        return mnemonic;
+    }
+};
+
+} // anonymous namespace
+
+BranchTraceReplayer::BranchTraceReplayer(
+        const BranchTraceReplayerParams &p)
+    : SimObject(p),
+      bpred(p.bpred),
+      traceFile(p.trace_file),
+      maxBranches(p.max_branches),
+      defaultInstSize(p.default_inst_size),
+      replayEvent([this]{ replay(); }, name()),
+      stats(this)
+{
+}
+
+void
+BranchTraceReplayer::startup()
+{
+    schedule(replayEvent, curTick());
+}
+
+const StaticInstPtr &
+BranchTraceReplayer::branchInst(BranchType type, unsigned size)
+{
+    StaticInstPtr &inst = insts[{type, size}];
+    if (!inst)
+        inst = new TraceBranchInst(type, size);
+    return inst;
+}
+
+void
+BranchTraceReplayer::replay()
+{
+    BranchTraceReader reader(traceFile);
+    TraceBranch branch;
+    InstSeqNum seq_num = 0;
+
+    while ((!maxBranches || stats.branches.value() < maxBranches) &&
+            reader.read(branch)) {
+        if (branch.type == BranchType::NoBranch) {
+            // The instructions retired before it still count.
+            stats.insts += branch.insts;
+            continue;
+        }
+
+        const unsigned size = branch.size ? branch.size : defaultInstSize;
+        const StaticInstPtr &inst = branchInst(branch.type, size);
+
+        // The BPU predicts in place, starting from the branch PC.
+        TracePCState pc(branch.pc, size);
+        bpred->predict(inst, ++seq_num, pc, 0);
+
+        if (pc.instAddr() != branch.target) {
+            DPRINTF(Branch, "Replay: %s branch at %#x mispredicted, "
+                    "predicted %#x, actual %#x.\n", toString(branch.type),
+                    branch.pc, pc.instAddr(), branch.target);
+            TracePCState corr_target(branch.target, size);
+            bpred->squash(seq_num, corr_target, branch.taken, 0);
+            stats.mispredicted[branch.type]++;
+        }
+        bpred->update(seq_num, 0);
+
+        stats.branches++;
+        stats.insts += branch.insts;
+    }
+
+    exitSimLoop("branch trace replayed");
+}
+
+BranchTraceReplayer::ReplayerStats::ReplayerStats(statistics::Group *parent)
+    : statistics::Group(parent),
+      ADD_STAT(branches, statistics::units::Count::get(),
+               "Number of branches replayed"),
+      ADD_STAT(insts, statistics::units::Count::get(),
+               "Number of instructions covered by the replayed branches"),
+      ADD_STAT(mispredicted, statistics::units::Count::get(),
+               "Number of mispredicted branches, by branch type"),
+      ADD_STAT(mpki, statistics::units::Rate<
+                    statistics::units::Count, statistics::units::Count>::get(),
+               "Mispredictions per thousand instructions",
+               sum(mispredicted) * 1000 / insts)
+{
+    mispredicted
+        .init(enums::Num_BranchType)
+        .flags(statistics::total | statistics::pdf);
+    for (int i = 0; i < enums::Num_BranchType; i++)
+        mispredicted.subname(i, enums::BranchTypeStrings[i]);
+
+    mpki.precision(4);
+}
+
+} // namespace branch_prediction
+} // namespace gem5
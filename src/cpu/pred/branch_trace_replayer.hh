@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_PRED_BRANCH_TRACE_REPLAYER_HH__
+#define __CPU_PRED_BRANCH_TRACE_REPLAYER_HH__
+
+#include <map>
+#include <utility>
+
+#include "base/statistics.hh"
+#include "cpu/pred/bpred_unit.hh"
+#include "cpu/pred/branch_trace.hh"
+#include "params/BranchTraceReplayer.hh"
+#include "sim/eventq.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+/**
+ * Replays a branch trace recorded by a BranchTraceRecorder through a
+ * branch predictor, without simulating a CPU, and exits the simulation
+ * loop once done. Each branch is predicted, squashed if mispredicted and
+ * committed before the next one is predicted, i.e., the predictor sees
+ * no wrong path and no delayed updates.
+ */
+class BranchTraceReplayer : public SimObject
+{
+  public:
+    BranchTraceReplayer(const BranchTraceReplayerParams &params);
+
+    void startup() override;
+
+  private:
+    BPredUnit *bpred;
+    const std::string traceFile;
+    const uint64_t maxBranches;
+    const unsigned defaultInstSize;
+
+    /** Synthetic branch instructions, by branch type and size. */
+    std::map<std::pair<BranchType, unsigned>, StaticInstPtr> insts;
+
+    EventFunctionWrapper replayEvent;
+
+    const StaticInstPtr &branchInst(BranchType type, unsigned size);
+
+    void replay();
+
+    struct ReplayerStats : public statistics::Group
+    {
+        ReplayerStats(statistics::Group *parent);
+
+        statistics::Scalar branches;
+        statistics::Scalar insts;
+        statistics::Vector mispredicted;
+        statistics::Formula mpki;
+    } stats;
+};
+
+} // namespace branch_prediction
+} // namespace gem5
+
+#endif // __CPU_PRED_BRANCH_TRACE_REPLAYER_HH__
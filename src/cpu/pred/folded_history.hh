@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_PRED_FOLDED_HISTORY_HH__
+#define __CPU_PRED_FOLDED_HISTORY_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+/**
+ * A set of folded (compressed) global histories, as used to mix long
+ * global histories into the indices and tags of TAGE-like tables.
+ *
+ * Every branch updates all of the folded histories at once, so they are
+ * stored as a structure of arrays and updated in flat loops with no
+ * loop-carried dependencies, which the compiler can vectorize. The
+ * folding itself is bit-exact with the classic per-history formulation.
+ *
+ * Histories which were never initialized stay zero.
+ */
+class FoldedHistories
+{
+  private:
+    std::vector<uint32_t> _comp;
+    std::vector<uint32_t> compLength;
+    std::vector<uint32_t> compMask;
+    std::vector<uint32_t> origLength;
+    std::vector<uint32_t> outpoint;
+
+    /// Scratch space holding the history bit leaving each history.
+    std::vector<uint32_t> outBits;
+
+    /**
+     * Gather the global history bit leaving each folded history. This
+     * is kept out of the update loops as it is the only indirect access.
+     */
+    void
+    gatherOutBits(const uint8_t *h)
+    {
+        const size_t n = _comp.size();
+        for (size_t i = 0; i < n; i++)
+            outBits[i] = h[origLength[i]];
+    }
+
+  public:
+    FoldedHistories(size_t size=0) { resize(size); }
+
+    void
+    resize(size_t size)
+    {
+        _comp.resize(size, 0);
+        // Geometry of an uninitialized history which keeps it at zero.
+        compLength.resize(size, 1);
+        compMask.resize(size, 0);
+        origLength.resize(size, 0);
+        outpoint.resize(size, 0);
+        outBits.resize(size, 0);
+    }
+
+    size_t size() const { return _comp.size(); }
+
+    /**
+     * Set up a folded history.
+     * @param idx The history to set up.
+     * @param original_length Number of global history bits folded.
+     * @param compressed_length Width of the folded history.
+     */
+    void
+    init(size_t idx, int original_length, int compressed_length)
+    {
+        panic_if(compressed_length <= 0 || compressed_length > 31,
+                "Unsupported folded history length %d.", compressed_length);
+        _comp[idx] = 0;
+        origLength[idx] = original_length;
+        compLength[idx] = compressed_length;
+        compMask[idx] = (1ULL << compressed_length) - 1;
+        outpoint[idx] = original_length % compressed_length;
+    }
+
+    unsigned comp(size_t idx) const { return _comp[idx]; }
+    void comp(size_t idx, unsigned val) { _comp[idx] = val; }
+
+    /**
+     * Shift a new bit into all the folded histories.
+     * @param h The global history, with the new bit already in h[0].
+     */
+    void
+    update(const uint8_t *h)
+    {
+        gatherOutBits(h);
+
+        const size_t n = _comp.size();
+        const uint32_t in = h[0];
+        for (size_t i = 0; i < n; i++) {
+            uint32_t c = (_comp[i] << 1) | in;
+            c ^= outBits[i] << outpoint[i];
+            c ^= c >> compLength[i];
+            _comp[i] = c & compMask[i];
+        }
+    }
+
+    /**
+     * Undo update(), i.e., shift the most recent bit back out of all the
+     * folded histories.
+     * @param h The global history, still holding the bit in h[0].
+     */
+    void
+    restore(const uint8_t *h)
+    {
+        gatherOutBits(h);
+
+        const size_t n = _comp.size();
+        const uint32_t in = h[0];
+        for (size_t i = 0; i < n; i++) {
+            uint32_t c = _comp[i] ^ (outBits[i] << outpoint[i]);
+            const uint32_t tmp = (c & 1) ^ in;
+            _comp[i] = (tmp << (compLength[i] - 1)) | (c >> 1);
+        }
+    }
+};
+
+} // namespace branch_prediction
+} // namespace gem5
+
+#endif // __CPU_PRED_FOLDED_HISTORY_HH__
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "cpu/pred/folded_history.hh"
+
+using namespace gem5;
+using branch_prediction::FoldedHistories;
+
+namespace
+{
+
+/** The classic, one history at a time, formulation of folding. */
+struct ReferenceFoldedHistory
+{
+    unsigned comp = 0;
+    int compLength;
+    int origLength;
+    int outpoint;
+
+    ReferenceFoldedHistory(int original_length, int compressed_length)
+        : compLength(compressed_length), origLength(original_length),
+          outpoint(original_length % compressed_length)
+    {}
+
+    void
+    update(uint8_t *h)
+    {
+        comp = (comp << 1) | h[0];
+        comp ^= h[origLength] << outpoint;
+        comp ^= (comp >> compLength);
+        comp &= (1ULL << compLength) - 1;
+    }
+
+    void
+    restore(uint8_t *h)
+    {
+        comp ^= h[origLength] << outpoint;
+        auto tmp = (comp & 1) ^ h[0];
+        comp = (tmp << (compLength - 1)) | (comp >> 1);
+    }
+};
+
+/** Geometries of the TAGE_SC_L_64KB tagged tables. */
+const std::vector<std::pair<int, int>> geometries = {
+    {4, 10}, {6, 10}, {10, 11}, {16, 11}, {25, 11}, {37, 11}, {57, 12},
+    {89, 12}, {137, 13}, {212, 13}, {328, 14}, {507, 14}, {783, 15},
+    {1211, 15}, {1500, 16}, {3000, 16}, {37, 9}, {1211, 14}, {3000, 15},
+};
+
+} // anonymous namespace
+
+/** Uninitialized histories stay zero. */
+TEST(FoldedHistoriesTest, Uninitialized)
+{
+    std::vector<uint8_t> history(64, 1);
+    FoldedHistories folded(4);
+    for (int i = 0; i < 32; i++)
+        folded.update(&history[32 - i]);
+    for (int i = 0; i < 32; i++)
+        folded.restore(&history[i]);
+    for (int i = 0; i < 4; i++)
+        EXPECT_EQ(0, folded.comp(i));
+}
+
+/**
+ * Shift random branch outcomes into the histories, and back out again,
+ * checking they always match the reference implementation.
+ */
+TEST(FoldedHistoriesTest, MatchesReference)
+{
+    const int max_hist = 3000;
+    const int num_bits = 20000;
+    // Leave room for the longest history past the oldest bit.
+    std::vector<uint8_t> history(num_bits + max_hist + 1, 0);
+
+    std::vector<ReferenceFoldedHistory> reference;
+    // Leave index 0 unused, as TAGE does for the bimodal table.
+    FoldedHistories folded(geometries.size() + 1);
+    for (size_t i = 0; i < geometries.size(); i++) {
+        const auto &[orig, comp] = geometries[i];
+        reference.emplace_back(orig, comp);
+        folded.init(i + 1, orig, comp);
+    }
+
+    std::mt19937 rng(0x7a6e);
+    uint8_t *h = &history[num_bits];
+    for (int n = 0; n < num_bits; n++) {
+        h--;
+        h[0] = rng() & 1;
+        folded.update(h);
+        for (size_t i = 0; i < reference.size(); i++) {
+            reference[i].update(h);
+            ASSERT_EQ(reference[i].comp, folded.comp(i + 1));
+        }
+    }
+
+    for (int n = 0; n < num_bits; n++) {
+        folded.restore(h);
+        for (size_t i = 0; i < reference.size(); i++) {
+            reference[i].restore(h);
+            ASSERT_EQ(reference[i].comp, folded.comp(i + 1));
+        }
+        h++;
+    }
+
+    // Having shifted everything back out, we should be back to zero.
+    for (size_t i = 0; i < folded.size(); i++)
+        EXPECT_EQ(0, folded.comp(i));
+}
@@ -118,6 +118,8 @@ MultiperspectivePerceptron::ThreadData::ThreadData(int num_filters,
 
     for (int i = 0; i < table_sizes.size(); i += 1) {
         mpreds.push_back(0);
+        train_indices.push_back(0);
+        is_best.push_back(false);
         tables.push_back(std::vector<short int>(table_sizes[i]));
         sign_bits.push_back(std::vector<std::array<bool, 2>>(table_sizes[i]));
         for (int j = 0; j < table_sizes[i]; j += 1) {
@@ -343,9 +345,19 @@ MultiperspectivePerceptron::computeOutput(ThreadID tid, MPPBranchInfo &bi)
     // find the best subset of features to use in case of a low-confidence
     // branch
     findBest(tid, best_preds);
+    std::vector<bool> &is_best = threadData[tid]->is_best;
+    std::fill(is_best.begin(), is_best.end(), false);
+    if (threshold >= 0) {
+        for (int j = 0; j < std::min(nbest, (int) best_preds.size()); j++) {
+            if (best_preds[j] >= 0) {
+                is_best[best_preds[j]] = true;
+            }
+        }
+    }
 
     // begin computation of the sum for low-confidence branch
     int bestval = 0;
+    const unsigned int sign_idx = bi.getHPC() % n_sign_bits;
 
     for (int i = 0; i < specs.size(); i += 1) {
         HistorySpec const &spec = *specs[i];
@@ -354,8 +366,7 @@ MultiperspectivePerceptron::computeOutput(ThreadID tid, MPPBranchInfo &bi)
         // add the weight; first get the weight's magnitude
         int counter = threadData[tid]->tables[i][hashed_idx];
         // get the sign
-        bool sign =
-          threadData[tid]->sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
+        bool sign = threadData[tid]->sign_bits[i][hashed_idx][sign_idx];
         // apply the transfer function and multiply by a coefficient
         int weight = spec.coeff * ((spec.width == 5) ?
                                    xlat4[counter] : xlat[counter]);
@@ -364,16 +375,8 @@ MultiperspectivePerceptron::computeOutput(ThreadID tid, MPPBranchInfo &bi)
         // add the value
         bi.yout += val;
         // if this is one of those good features, add the value to bestval
-        if (threshold >= 0) {
-            for (int j = 0;
-                 j < std::min(nbest, (int) best_preds.size());
-                 j += 1)
-            {
-                if (best_preds[j] == i) {
-                    bestval += val;
-                    break;
-                }
-            }
+        if (is_best[i]) {
+            bestval += val;
         }
     }
     // apply a fudge factor to affect when training is triggered
@@ -429,16 +432,29 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
     bool correct = (bi.yout >= 1) == taken;
     // what is the magnitude of yout?
     int abs_yout = abs(bi.yout);
+    bool tune = (threshold >= 0) && (!tuneonly || (abs_yout <= threshold));
+    // if the branch was predicted incorrectly or the correct
+    // prediction was weak, update the weights
+    bool do_train = !correct || (abs_yout <= theta);
+    if (!tune && !do_train) return;
+
+    // the histories do not change while training, so hash the index of
+    // each table only once
+    std::vector<unsigned int> &indices = threadData[tid]->train_indices;
+    for (int i = 0; i < specs.size(); i += 1) {
+        indices[i] = getIndex(tid, bi, *specs[i], i);
+    }
+    const unsigned int sign_idx = bi.getHPC() % n_sign_bits;
+
     // keep track of mispredictions per table
-    if (threshold >= 0) if (!tuneonly || (abs_yout <= threshold)) {
+    if (tune) {
         bool halve = false;
 
         // for each table, figure out if there was a misprediction
         for (int i = 0; i < specs.size(); i += 1) {
             HistorySpec const &spec = *specs[i];
-            // get the hash to index the table
-            unsigned int hashed_idx = getIndex(tid, bi, spec, i);
-            bool sign = sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
+            unsigned int hashed_idx = indices[i];
+            bool sign = sign_bits[i][hashed_idx][sign_idx];
             int counter = tables[i][hashed_idx];
             int weight = spec.coeff * ((spec.width == 5) ?
                                        xlat4[counter] : xlat[counter]);
@@ -458,9 +474,6 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
             }
         }
     }
-    // if the branch was predicted incorrectly or the correct
-    // prediction was weak, update the weights
-    bool do_train = !correct || (abs_yout <= theta);
     if (!do_train) return;
 
     // adaptive theta training, adapted from O-GEHL
@@ -485,15 +498,15 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
     for (int i = 0; i < specs.size(); i += 1) {
         HistorySpec const &spec = *specs[i];
         // get the magnitude
-        unsigned int hashed_idx = getIndex(tid, bi, spec, i);
+        unsigned int hashed_idx = indices[i];
         int counter = tables[i][hashed_idx];
         // get the sign
-        bool sign = sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
+        bool sign = sign_bits[i][hashed_idx][sign_idx];
         // increment/decrement if taken/not taken
         satIncDec(taken, sign, counter, (1 << (spec.width - 1)) - 1);
         // update the magnitude and sign
         tables[i][hashed_idx] = counter;
-        sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits] = sign;
+        sign_bits[i][hashed_idx][sign_idx] = sign;
         int weight = ((spec.width == 5) ? xlat4[counter] : xlat[counter]);
         // update the new version of yout
         if (sign) {
@@ -519,10 +532,9 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
                 for (int j = 0; j < specs.size(); j += 1) {
                     int i = (nrand + j) % specs.size();
                     HistorySpec const &spec = *specs[i];
-                    unsigned int hashed_idx = getIndex(tid, bi, spec, i);
+                    unsigned int hashed_idx = indices[i];
                     int counter = tables[i][hashed_idx];
-                    bool sign =
-                        sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
+                    bool sign = sign_bits[i][hashed_idx][sign_idx];
                     int weight = ((spec.width == 5) ?
                             xlat4[counter] : xlat[counter]);
                     int signed_weight = sign ? -weight : weight;
@@ -537,10 +549,9 @@ MultiperspectivePerceptron::train(ThreadID tid, MPPBranchInfo &bi, bool taken)
                 if (besti != -1) {
                     int i = besti;
                     HistorySpec const &spec = *specs[i];
-                    unsigned int hashed_idx = getIndex(tid, bi, spec, i);
+                    unsigned int hashed_idx = indices[i];
                     int counter = tables[i][hashed_idx];
-                    bool sign =
-                        sign_bits[i][hashed_idx][bi.getHPC() % n_sign_bits];
+                    bool sign = sign_bits[i][hashed_idx][sign_idx];
                     if (counter > 1) {
                         counter--;
                         tables[i][hashed_idx] = counter;
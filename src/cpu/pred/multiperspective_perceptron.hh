@@ -365,6 +365,10 @@ class MultiperspectivePerceptron : public BPredUnit
         int occupancy;
 
         std::vector<int> mpreds;
+        /** Scratch space for the table indices when training */
+        std::vector<unsigned int> train_indices;
+        /** Scratch space for the best subset of tables when predicting */
+        std::vector<bool> is_best;
         std::vector<std::vector<short int>> tables;
         std::vector<std::vector<std::array<bool, 2>>> sign_bits;
     };
@@ -72,11 +72,11 @@ MPP_TAGE::handleTAGEUpdate(Addr branch_pc, bool taken,
                            TAGEBase::BranchInfo* bi)
 {
     if (bi->hitBank > 0) {
-        if (abs (2 * gtable[bi->hitBank][bi->hitBankIndex].ctr + 1) == 1) {
+        if (abs (2 * gtable.ctr(bi->hitBank, bi->hitBankIndex) + 1) == 1) {
             if (bi->longestMatchPred != taken) {
                 // acts as a protection
                 if (bi->altBank > 0) {
-                    ctrUpdate(gtable[bi->altBank][bi->altBankIndex].ctr, taken,
+                    ctrUpdate(gtable.ctr(bi->altBank, bi->altBankIndex), taken,
                               tagTableCounterBits);
                 }
                 if (bi->altBank == 0){
@@ -85,12 +85,12 @@ MPP_TAGE::handleTAGEUpdate(Addr branch_pc, bool taken,
             }
         }
 
-        ctrUpdate(gtable[bi->hitBank][bi->hitBankIndex].ctr, taken,
+        ctrUpdate(gtable.ctr(bi->hitBank, bi->hitBankIndex), taken,
                   tagTableCounterBits);
 
         //sign changes: no way it can have been useful
-        if (abs (2 * gtable[bi->hitBank][bi->hitBankIndex].ctr + 1) == 1) {
-            gtable[bi->hitBank][bi->hitBankIndex].u = 0;
+        if (abs (2 * gtable.ctr(bi->hitBank, bi->hitBankIndex) + 1) == 1) {
+            gtable.u(bi->hitBank, bi->hitBankIndex) = 0;
         }
     } else {
         baseUpdate(branch_pc, taken, bi);
@@ -98,8 +98,8 @@ MPP_TAGE::handleTAGEUpdate(Addr branch_pc, bool taken,
 
     if ((bi->longestMatchPred != bi->altTaken) &&
         (bi->longestMatchPred == taken) &&
-        (gtable[bi->hitBank][bi->hitBankIndex].u < (1 << tagTableUBits) -1)) {
-            gtable[bi->hitBank][bi->hitBankIndex].u++;
+        (gtable.u(bi->hitBank, bi->hitBankIndex) < (1 << tagTableUBits) -1)) {
+            gtable.u(bi->hitBank, bi->hitBankIndex)++;
     }
 }
 
@@ -124,9 +124,9 @@ MPP_TAGE::handleAllocAndUReset(bool alloc, bool taken,
 
     for (int i = dep; i <= nHistoryTables; i += 1) {
         if (noSkip[i]) {
-            if (gtable[i][bi->tableIndices[i]].u == 0) {
-                gtable[i][bi->tableIndices[i]].tag = bi->tableTags[i];
-                gtable[i][bi->tableIndices[i]].ctr = taken ? 0 : -1;
+            if (gtable.u(i, bi->tableIndices[i]) == 0) {
+                gtable.tag(i, bi->tableIndices[i]) = bi->tableTags[i];
+                gtable.ctr(i, bi->tableIndices[i]) = taken ? 0 : -1;
                 numAllocated++;
                 if (T <= 0) {
                     break;
@@ -157,7 +157,7 @@ MPP_TAGE::handleUReset()
         // Update the u bits for the short tags table
         for (int i = 1; i <= nHistoryTables; i++) {
             for (int j = 0; j < (1ULL << logTagTableSizes[i]); j++) {
-                resetUctr(gtable[i][j].u);
+                resetUctr(gtable.u(i, j));
             }
         }
 
@@ -244,7 +244,7 @@ bool
 MPP_TAGE::isHighConfidence(TAGEBase::BranchInfo *bi) const
 {
     if (bi->hitBank > 0) {
-        return (abs(2 * gtable[bi->hitBank][bi->hitBankIndex].ctr + 1)) >=
+        return (abs(2 * gtable.ctr(bi->hitBank, bi->hitBankIndex) + 1)) >=
                ((1 << tagTableCounterBits) - 1);
     } else {
         int bim = (btablePrediction[bi->bimodalIndex] << 1)
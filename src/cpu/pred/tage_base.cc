@@ -140,9 +140,8 @@ TAGEBase::init()
     assert(tagTableTagWidths[0] == 0);
 
     for (auto& history : threadHistory) {
-        history.computeIndices = new FoldedHistory[nHistoryTables+1];
-        history.computeTags[0] = new FoldedHistory[nHistoryTables+1];
-        history.computeTags[1] = new FoldedHistory[nHistoryTables+1];
+        history.numBanks = nHistoryTables + 1;
+        history.folded.resize(3 * history.numBanks);
 
         initFoldedHistories(history);
     }
@@ -152,9 +151,14 @@ TAGEBase::init()
     btableHysteresis.resize(bimodalTableSize >> logRatioBiModalHystEntries,
                             true);
 
-    gtable = new TageEntry*[nHistoryTables + 1];
+    gtable.resize(nHistoryTables + 1);
     buildTageTables();
 
+    for (int i = 1; i <= nHistoryTables; i++) {
+        if (noSkip[i])
+            noSkipMask |= 1ULL << i;
+    }
+
     tableIndices = new int [nHistoryTables+1];
     tableTags = new int [nHistoryTables+1];
     initialized = true;
@@ -164,12 +168,8 @@ void
 TAGEBase::initFoldedHistories(ThreadHistory & history)
 {
     for (int i = 1; i <= nHistoryTables; i++) {
-        history.computeIndices[i].init(
-            histLengths[i], (logTagTableSizes[i]));
-        history.computeTags[0][i].init(
-            history.computeIndices[i].origLength, tagTableTagWidths[i]);
-        history.computeTags[1][i].init(
-            history.computeIndices[i].origLength, tagTableTagWidths[i]-1);
+        history.initFoldedHistory(i, histLengths[i], logTagTableSizes[i],
+            tagTableTagWidths[i], tagTableTagWidths[i] - 1);
         DPRINTF(Tage, "HistLength:%d, TTSize:%d, TTTWidth:%d\n",
                 histLengths[i], logTagTableSizes[i], tagTableTagWidths[i]);
     }
@@ -179,7 +179,7 @@ void
 TAGEBase::buildTageTables()
 {
     for (int i = 1; i <= nHistoryTables; i++) {
-        gtable[i] = new TageEntry[1<<(logTagTableSizes[i])];
+        gtable.allocate(i, 1<<(logTagTableSizes[i]));
     }
 }
 
@@ -230,7 +230,7 @@ TAGEBase::gindex(ThreadID tid, Addr pc, int bank) const
     index =
         shiftedPc ^
         (shiftedPc >> ((int) abs(logTagTableSizes[bank] - bank) + 1)) ^
-        threadHistory[tid].computeIndices[bank].comp ^
+        threadHistory[tid].computeIndex(bank) ^
         F(threadHistory[tid].pathHist, hlen, bank);
 
     return (index & ((1ULL << (logTagTableSizes[bank])) - 1));
@@ -242,8 +242,8 @@ uint16_t
 TAGEBase::gtag(ThreadID tid, Addr pc, int bank) const
 {
     int tag = (pc >> instShiftAmt) ^
-              threadHistory[tid].computeTags[0][bank].comp ^
-              (threadHistory[tid].computeTags[1][bank].comp << 1);
+              threadHistory[tid].computeTag(0, bank) ^
+              (threadHistory[tid].computeTag(1, bank) << 1);
 
     return (tag & ((1ULL << tagTableTagWidths[bank]) - 1));
 }
@@ -342,11 +342,7 @@ TAGEBase::updateGHist(ThreadID tid, uint64_t bv, uint8_t n)
         bv >>= 1;
 
         // Update the folded histories with the new bit.
-        for (int i = 1; i <= nHistoryTables; i++) {
-            tHist.computeIndices[i].update(tHist.gHist);
-            tHist.computeTags[0][i].update(tHist.gHist);
-            tHist.computeTags[1][i].update(tHist.gHist);
-        }
+        tHist.folded.update(tHist.gHist);
     }
 }
 
@@ -386,40 +382,31 @@ TAGEBase::tagePredict(ThreadID tid, Addr branch_pc,
     calculateIndicesAndTags(tid, branch_pc, bi);
     bi->bimodalIndex = bindex(branch_pc);
 
-        bi->hitBank = 0;
-        bi->altBank = 0;
-        //Look for the bank with longest matching history
-        for (int i = nHistoryTables; i > 0; i--) {
-            if (noSkip[i] &&
-                gtable[i][tableIndices[i]].tag == tableTags[i]) {
-                bi->hitBank = i;
-                bi->hitBankIndex = tableIndices[bi->hitBank];
-                break;
-            }
-        }
-        //Look for the alternate bank
-        for (int i = bi->hitBank - 1; i > 0; i--) {
-            if (noSkip[i] &&
-                gtable[i][tableIndices[i]].tag == tableTags[i]) {
-                bi->altBank = i;
-                bi->altBankIndex = tableIndices[bi->altBank];
-                break;
-            }
-        }
+        //Look up all the banks at once, the one with the longest matching
+        //history provides the prediction and the next one the alternate
+        //prediction
+        const uint64_t hits =
+            gtable.match(tableIndices, tableTags, noSkipMask);
+        bi->hitBank = TaggedTables::hitBank(hits);
+        bi->altBank = TaggedTables::altBank(hits);
+        if (bi->hitBank > 0)
+            bi->hitBankIndex = tableIndices[bi->hitBank];
+        if (bi->altBank > 0)
+            bi->altBankIndex = tableIndices[bi->altBank];
         //computes the prediction and the alternate prediction
         if (bi->hitBank > 0) {
             if (bi->altBank > 0) {
                 bi->altTaken =
-                    gtable[bi->altBank][tableIndices[bi->altBank]].ctr >= 0;
+                    gtable.ctr(bi->altBank, tableIndices[bi->altBank]) >= 0;
                 extraAltCalc(bi);
             }else {
             bi->altTaken = getBimodePred(branch_pc, bi);
             }
 
             bi->longestMatchPred =
-                gtable[bi->hitBank][tableIndices[bi->hitBank]].ctr >= 0;
+                gtable.ctr(bi->hitBank, tableIndices[bi->hitBank]) >= 0;
             bi->pseudoNewAlloc =
-                abs(2 * gtable[bi->hitBank][bi->hitBankIndex].ctr + 1) <= 1;
+                abs(2 * gtable.ctr(bi->hitBank, bi->hitBankIndex) + 1) <= 1;
 
             //if the entry is recognized as a newly allocated entry and
             //useAltPredForNewlyAllocated is positive use the alternate
@@ -460,8 +447,8 @@ TAGEBase::handleAllocAndUReset(bool alloc, bool taken, BranchInfo* bi,
         // is there some "unuseful" entry to allocate
         uint8_t min = 1;
         for (int i = nHistoryTables; i > bi->hitBank; i--) {
-            if (gtable[i][bi->tableIndices[i]].u < min) {
-                min = gtable[i][bi->tableIndices[i]].u;
+            if (gtable.u(i, bi->tableIndices[i]) < min) {
+                min = gtable.u(i, bi->tableIndices[i]);
             }
         }
 
@@ -478,16 +465,16 @@ TAGEBase::handleAllocAndUReset(bool alloc, bool taken, BranchInfo* bi,
         }
         // No entry available, forces one to be available
         if (min > 0) {
-            gtable[X][bi->tableIndices[X]].u = 0;
+            gtable.u(X, bi->tableIndices[X]) = 0;
         }
 
 
         //Allocate entries
         unsigned numAllocated = 0;
         for (int i = X; i <= nHistoryTables; i++) {
-            if (gtable[i][bi->tableIndices[i]].u == 0) {
-                gtable[i][bi->tableIndices[i]].tag = bi->tableTags[i];
-                gtable[i][bi->tableIndices[i]].ctr = (taken) ? 0 : -1;
+            if (gtable.u(i, bi->tableIndices[i]) == 0) {
+                gtable.tag(i, bi->tableIndices[i]) = bi->tableTags[i];
+                gtable.ctr(i, bi->tableIndices[i]) = (taken) ? 0 : -1;
                 ++numAllocated;
                 if (numAllocated == maxNumAlloc) {
                     break;
@@ -509,8 +496,9 @@ TAGEBase::handleUReset()
         // reset least significant bit
         // most significant bit becomes least significant bit
         for (int i = 1; i <= nHistoryTables; i++) {
+            uint8_t *u = gtable.uArray(i);
             for (int j = 0; j < (1ULL << logTagTableSizes[i]); j++) {
-                resetUctr(gtable[i][j].u);
+                resetUctr(u[j]);
             }
         }
     }
@@ -569,13 +557,13 @@ TAGEBase::handleTAGEUpdate(Addr branch_pc, bool taken, BranchInfo* bi)
     if (bi->hitBank > 0) {
         DPRINTF(Tage, "Updating tag table entry (%d,%d) for branch %lx\n",
                 bi->hitBank, bi->hitBankIndex, branch_pc);
-        ctrUpdate(gtable[bi->hitBank][bi->hitBankIndex].ctr, taken,
+        ctrUpdate(gtable.ctr(bi->hitBank, bi->hitBankIndex), taken,
                   tagTableCounterBits);
         // if the provider entry is not certified to be useful also update
         // the alternate prediction
-        if (gtable[bi->hitBank][bi->hitBankIndex].u == 0) {
+        if (gtable.u(bi->hitBank, bi->hitBankIndex) == 0) {
             if (bi->altBank > 0) {
-                ctrUpdate(gtable[bi->altBank][bi->altBankIndex].ctr, taken,
+                ctrUpdate(gtable.ctr(bi->altBank, bi->altBankIndex), taken,
                           tagTableCounterBits);
                 DPRINTF(Tage, "Updating tag table entry (%d,%d) for"
                         " branch %lx\n", bi->hitBank, bi->hitBankIndex,
@@ -588,7 +576,7 @@ TAGEBase::handleTAGEUpdate(Addr branch_pc, bool taken, BranchInfo* bi)
 
         // update the u counter
         if (bi->tagePred != bi->altTaken) {
-            unsignedCtrUpdate(gtable[bi->hitBank][bi->hitBankIndex].u,
+            unsignedCtrUpdate(gtable.u(bi->hitBank, bi->hitBankIndex),
                               bi->tagePred == taken, tagTableUBits);
         }
     } else {
@@ -676,9 +664,9 @@ TAGEBase::recordHistState(ThreadID tid, BranchInfo* bi)
     bi->pathHist = tHist.pathHist;
 
     for (int i = 1; i <= nHistoryTables; i++) {
-        bi->ci[i]  = tHist.computeIndices[i].comp;
-        bi->ct0[i] = tHist.computeTags[0][i].comp;
-        bi->ct1[i] = tHist.computeTags[1][i].comp;
+        bi->ci[i]  = tHist.computeIndex(i);
+        bi->ct0[i] = tHist.computeTag(0, i);
+        bi->ct1[i] = tHist.computeTag(1, i);
     }
     }
 
@@ -697,11 +685,7 @@ TAGEBase::restoreHistState(ThreadID tid, BranchInfo* bi)
     for (int n = 0; n < bi->nGhist; n++) {
 
         // First revert the folded history
-    for (int i = 1; i <= nHistoryTables; i++) {
-            tHist.computeIndices[i].restore(tHist.gHist);
-            tHist.computeTags[0][i].restore(tHist.gHist);
-            tHist.computeTags[1][i].restore(tHist.gHist);
-    }
+        tHist.folded.restore(tHist.gHist);
         tHist.ptGhist++;
         tHist.gHist++;
     }
@@ -846,7 +830,7 @@ TAGEBase::TAGEBaseStats::TAGEBaseStats(
 int8_t
 TAGEBase::getCtr(int hitBank, int hitBankIndex) const
 {
-    return gtable[hitBank][hitBankIndex].ctr;
+    return gtable.ctr(hitBank, hitBankIndex);
 }
 
 unsigned
@@ -64,6 +64,8 @@
 
 #include "base/statistics.hh"
 #include "cpu/null_static_inst.hh"
+#include "cpu/pred/folded_history.hh"
+#include "cpu/pred/tagged_tables.hh"
 #include "cpu/static_inst.hh"
 #include "params/TAGEBase.hh"
 #include "sim/sim_object.hh"
@@ -83,54 +85,6 @@ class TAGEBase : public SimObject
   protected:
     // Prediction Structures
 
-    // Tage Entry
-    struct TageEntry
-    {
-        int8_t ctr;
-        uint16_t tag;
-        uint8_t u;
-        TageEntry() : ctr(0), tag(0), u(0) { }
-    };
-
-    // Folded History Table - compressed history
-    // to mix with instruction PC to index partially
-    // tagged tables.
-    struct FoldedHistory
-    {
-        unsigned comp;
-        int compLength;
-        int origLength;
-        int outpoint;
-        int bufferSize;
-
-        FoldedHistory()
-        {
-            comp = 0;
-        }
-
-        void init(int original_length, int compressed_length)
-        {
-            origLength = original_length;
-            compLength = compressed_length;
-            outpoint = original_length % compressed_length;
-        }
-
-        void update(uint8_t * h)
-        {
-            comp = (comp << 1) | h[0];
-            comp ^= h[origLength] << outpoint;
-            comp ^= (comp >> compLength);
-            comp &= (1ULL << compLength) - 1;
-        }
-
-        void restore(uint8_t * h)
-        {
-            comp ^= h[origLength] << outpoint;
-            auto tmp = (comp & 1) ^ h[0];
-            comp = ( tmp << (compLength-1)) | (comp >> 1);
-        }
-    };
-
   public:
 
     // provider type
@@ -483,7 +437,7 @@ class TAGEBase : public SimObject
 
     std::vector<bool> btablePrediction;
     std::vector<bool> btableHysteresis;
-    TageEntry **gtable;
+    TaggedTables gtable;
 
     // Keep per-thread histories to
     // support SMT.
@@ -504,9 +458,30 @@ class TAGEBase : public SimObject
         // Index to most recent branch outcome
         int ptGhist;
 
-        // Speculative folded histories.
-        FoldedHistory *computeIndices;
-        FoldedHistory *computeTags[2];
+        // Speculative folded histories. For each table, one is used
+        // to compute the index and two to compute the tag. They are all
+        // kept together so a branch can update them in a single pass.
+        FoldedHistories folded;
+        int numBanks;
+
+        void
+        initFoldedHistory(int bank, int orig_length, int index_length,
+                          int tag0_length, int tag1_length)
+        {
+            folded.init(bank, orig_length, index_length);
+            folded.init(numBanks + bank, orig_length, tag0_length);
+            folded.init(2 * numBanks + bank, orig_length, tag1_length);
+        }
+
+        /** Folded history used to compute the index of a table. */
+        unsigned computeIndex(int bank) const { return folded.comp(bank); }
+
+        /** Folded histories used to compute the tag of a table. */
+        unsigned
+        computeTag(int which, int bank) const
+        {
+            return folded.comp((1 + which) * numBanks + bank);
+        }
     };
 
     std::vector<ThreadHistory> threadHistory;
@@ -534,6 +509,8 @@ class TAGEBase : public SimObject
     // (for the base TAGE implementation all are active)
     // Some other classes use this for handling associativity
     std::vector<bool> noSkip;
+    // Same as noSkip, one bit per table, for the batched lookups
+    uint64_t noSkipMask = 0;
 
     const bool speculativeHistUpdate;
 
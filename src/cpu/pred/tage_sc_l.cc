@@ -125,14 +125,14 @@ TAGE_SC_L_TAGE::buildTageTables()
     // Trick! We only allocate entries for tables 1 and firstLongTagTable and
     // make the other tables point to these allocated entries
 
-    gtable[1] = new TageEntry[shortTagsTageFactor * (1 << logTagTableSize)];
-    gtable[firstLongTagTable] =
-        new TageEntry[longTagsTageFactor * (1 << logTagTableSize)];
+    gtable.allocate(1, shortTagsTageFactor * (1 << logTagTableSize));
+    gtable.allocate(firstLongTagTable,
+                    longTagsTageFactor * (1 << logTagTableSize));
     for (int i = 2; i < firstLongTagTable; ++i) {
-        gtable[i] = gtable[1];
+        gtable.share(i, 1);
     }
     for (int i = firstLongTagTable + 1; i <= nHistoryTables; ++i) {
-        gtable[i] = gtable[firstLongTagTable];
+        gtable.share(i, firstLongTagTable);
     }
 }
 
@@ -199,7 +199,7 @@ TAGE_SC_L_TAGE::gindex(ThreadID tid, Addr pc, int bank) const
     // pc is not shifted by instShiftAmt in this implementation
     index = shortPc ^
             (shortPc >> ((int) abs(logTagTableSizes[bank] - bank) + 1)) ^
-            threadHistory[tid].computeIndices[bank].comp ^
+            threadHistory[tid].computeIndex(bank) ^
             F(threadHistory[tid].pathHist, hlen, bank);
 
     index = gindex_ext(index, bank);
@@ -332,12 +332,12 @@ TAGE_SC_L_TAGE::handleUReset()
     if (tCounter >= ((1ULL << logUResetPeriod))) {
         // Update the u bits for the short tags table
         for (int j = 0; j < (shortTagsTageFactor*(1<<logTagTableSize)); j++) {
-            resetUctr(gtable[1][j].u);
+            resetUctr(gtable.u(1, j));
         }
 
         // Update the u bits for the long tags table
         for (int j = 0; j < (longTagsTageFactor*(1<<logTagTableSize)); j++) {
-            resetUctr(gtable[firstLongTagTable][j].u);
+            resetUctr(gtable.u(firstLongTagTable, j));
         }
 
         tCounter = 0;
@@ -365,7 +365,7 @@ TAGE_SC_L_TAGE::extraAltCalc(TAGEBase::BranchInfo* bi)
 {
     TAGE_SC_L_TAGE::BranchInfo *tage_scl_bi =
         static_cast<TAGE_SC_L_TAGE::BranchInfo *>(bi);
-    int8_t ctr = gtable[bi->altBank][bi->altBankIndex].ctr;
+    int8_t ctr = gtable.ctr(bi->altBank, bi->altBankIndex);
     tage_scl_bi->altConf = (abs(2*ctr + 1) > 1);
 }
 
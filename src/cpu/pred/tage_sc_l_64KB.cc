@@ -206,8 +206,8 @@ uint16_t
 TAGE_SC_L_TAGE_64KB::gtag(ThreadID tid, Addr pc, int bank) const
 {
     // very similar to the TAGE implementation, but w/o shifting the pc
-    int tag = pc ^ threadHistory[tid].computeTags[0][bank].comp ^
-              (threadHistory[tid].computeTags[1][bank].comp << 1);
+    int tag = pc ^ threadHistory[tid].computeTag(0, bank) ^
+              (threadHistory[tid].computeTag(1, bank) << 1);
 
     return (tag & ((1ULL << tagTableTagWidths[bank]) - 1));
 }
@@ -229,20 +229,20 @@ TAGE_SC_L_TAGE_64KB::handleAllocAndUReset(
         for (int j = 0; j < 2; ++j) {
             int i = ((j == 0) ? I : (I ^ 1)) + 1;
             if (noSkip[i]) {
-                if (gtable[i][bi->tableIndices[i]].u == 0) {
-                    int8_t ctr = gtable[i][bi->tableIndices[i]].ctr;
+                if (gtable.u(i, bi->tableIndices[i]) == 0) {
+                    int8_t ctr = gtable.ctr(i, bi->tableIndices[i]);
                     if (abs (2 * ctr + 1) <= 3) {
-                        gtable[i][bi->tableIndices[i]].tag = bi->tableTags[i];
-                        gtable[i][bi->tableIndices[i]].ctr = taken ? 0 : -1;
+                        gtable.tag(i, bi->tableIndices[i]) = bi->tableTags[i];
+                        gtable.ctr(i, bi->tableIndices[i]) = taken ? 0 : -1;
                         numAllocated++;
                         maxAllocReached = (numAllocated == maxNumAlloc);
                         I += 2;
                         break;
                     } else {
-                        if (gtable[i][bi->tableIndices[i]].ctr > 0) {
-                            gtable[i][bi->tableIndices[i]].ctr--;
+                        if (gtable.ctr(i, bi->tableIndices[i]) > 0) {
+                            gtable.ctr(i, bi->tableIndices[i])--;
                         } else {
-                            gtable[i][bi->tableIndices[i]].ctr++;
+                            gtable.ctr(i, bi->tableIndices[i])++;
                         }
                     }
                 } else {
@@ -265,11 +265,11 @@ TAGE_SC_L_TAGE_64KB::handleTAGEUpdate(Addr branch_pc, bool taken,
                                  TAGEBase::BranchInfo* bi)
 {
     if (bi->hitBank > 0) {
-        if (abs (2 * gtable[bi->hitBank][bi->hitBankIndex].ctr + 1) == 1) {
+        if (abs (2 * gtable.ctr(bi->hitBank, bi->hitBankIndex) + 1) == 1) {
             if (bi->longestMatchPred != taken) {
                 // acts as a protection
                 if (bi->altBank > 0) {
-                    ctrUpdate(gtable[bi->altBank][bi->altBankIndex].ctr, taken,
+                    ctrUpdate(gtable.ctr(bi->altBank, bi->altBankIndex), taken,
                               tagTableCounterBits);
                 }
                 if (bi->altBank == 0){
@@ -278,21 +278,21 @@ TAGE_SC_L_TAGE_64KB::handleTAGEUpdate(Addr branch_pc, bool taken,
             }
         }
 
-        ctrUpdate(gtable[bi->hitBank][bi->hitBankIndex].ctr, taken,
+        ctrUpdate(gtable.ctr(bi->hitBank, bi->hitBankIndex), taken,
                   tagTableCounterBits);
 
         //sign changes: no way it can have been useful
-        if (abs (2 * gtable[bi->hitBank][bi->hitBankIndex].ctr + 1) == 1) {
-            gtable[bi->hitBank][bi->hitBankIndex].u = 0;
+        if (abs (2 * gtable.ctr(bi->hitBank, bi->hitBankIndex) + 1) == 1) {
+            gtable.u(bi->hitBank, bi->hitBankIndex) = 0;
         }
 
         if (bi->altTaken == taken) {
             if (bi->altBank > 0) {
-                int8_t ctr = gtable[bi->altBank][bi->altBankIndex].ctr;
+                int8_t ctr = gtable.ctr(bi->altBank, bi->altBankIndex);
                 if (abs (2 * ctr + 1) == 7) {
-                    if (gtable[bi->hitBank][bi->hitBankIndex].u == 1) {
+                    if (gtable.u(bi->hitBank, bi->hitBankIndex) == 1) {
                         if (bi->longestMatchPred == taken) {
-                          gtable[bi->hitBank][bi->hitBankIndex].u = 0;
+                          gtable.u(bi->hitBank, bi->hitBankIndex) = 0;
                         }
                     }
                 }
@@ -304,8 +304,8 @@ TAGE_SC_L_TAGE_64KB::handleTAGEUpdate(Addr branch_pc, bool taken,
 
     if ((bi->longestMatchPred != bi->altTaken) &&
         (bi->longestMatchPred == taken) &&
-        (gtable[bi->hitBank][bi->hitBankIndex].u < (1 << tagTableUBits) -1)) {
-            gtable[bi->hitBank][bi->hitBankIndex].u++;
+        (gtable.u(bi->hitBank, bi->hitBankIndex) < (1 << tagTableUBits) -1)) {
+            gtable.u(bi->hitBank, bi->hitBankIndex)++;
     }
 }
 
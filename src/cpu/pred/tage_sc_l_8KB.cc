@@ -149,12 +149,8 @@ TAGE_SC_L_TAGE_8KB::initFoldedHistories(ThreadHistory & history)
     // Some hardcoded values are used here
     // (they do not seem to depend on any parameter)
     for (int i = 1; i <= nHistoryTables; i++) {
-        history.computeIndices[i].init(
-            histLengths[i], 17 + (2 * ((i - 1) / 2) % 4));
-        history.computeTags[0][i].init(
-            history.computeIndices[i].origLength, 13);
-        history.computeTags[1][i].init(
-            history.computeIndices[i].origLength, 11);
+        history.initFoldedHistory(
+            i, histLengths[i], 17 + (2 * ((i - 1) / 2) % 4), 13, 11);
         DPRINTF(TageSCL, "HistLength:%d, TTSize:%d, TTTWidth:%d\n",
                 histLengths[i], logTagTableSizes[i], tagTableTagWidths[i]);
     }
@@ -170,16 +166,16 @@ TAGE_SC_L_TAGE_8KB::gindex_ext(int index, int bank) const
 uint16_t
 TAGE_SC_L_TAGE_8KB::gtag(ThreadID tid, Addr pc, int bank) const
 {
-    int tag = (threadHistory[tid].computeIndices[bank - 1].comp << 2) ^ pc ^
+    int tag = (threadHistory[tid].computeIndex(bank - 1) << 2) ^ pc ^
               (pc >> instShiftAmt) ^
-              threadHistory[tid].computeIndices[bank].comp;
+              threadHistory[tid].computeIndex(bank);
     int hlen = (histLengths[bank] > pathHistBits) ? pathHistBits :
                                                     histLengths[bank];
 
     tag = (tag >> 1) ^ ((tag & 1) << 10) ^
            F(threadHistory[tid].pathHist, hlen, bank);
-    tag ^= threadHistory[tid].computeTags[0][bank].comp ^
-           (threadHistory[tid].computeTags[1][bank].comp << 1);
+    tag ^= threadHistory[tid].computeTag(0, bank) ^
+           (threadHistory[tid].computeTag(1, bank) << 1);
 
     return ((tag ^ (tag >> tagTableTagWidths[bank]))
             & ((1ULL << tagTableTagWidths[bank]) - 1));
@@ -206,12 +202,12 @@ TAGE_SC_L_TAGE_8KB::handleAllocAndUReset(
                 break;
             }
             if (noSkip[i]) {
-                if (gtable[i][bi->tableIndices[i]].u == 0) {
-                    gtable[i][bi->tableIndices[i]].u =
+                if (gtable.u(i, bi->tableIndices[i]) == 0) {
+                    gtable.u(i, bi->tableIndices[i]) =
                         ((random_mt.random<int>() & 31) == 0);
                     // protect randomly from fast replacement
-                    gtable[i][bi->tableIndices[i]].tag = bi->tableTags[i];
-                    gtable[i][bi->tableIndices[i]].ctr = taken ? 0 : -1;
+                    gtable.tag(i, bi->tableIndices[i]) = bi->tableTags[i];
+                    gtable.ctr(i, bi->tableIndices[i]) = taken ? 0 : -1;
                     numAllocated++;
 
                     if (numAllocated == maxNumAlloc) {
@@ -220,11 +216,11 @@ TAGE_SC_L_TAGE_8KB::handleAllocAndUReset(
                     }
                     I += 2;
                 } else {
-                    int8_t ctr = gtable[i][bi->tableIndices[i]].ctr;
-                    if ((gtable[i][bi->tableIndices[i]].u == 1) &
+                    int8_t ctr = gtable.ctr(i, bi->tableIndices[i]);
+                    if ((gtable.u(i, bi->tableIndices[i]) == 1) &
                         (abs (2 * ctr + 1) == 1)) {
                         if ((random_mt.random<int>() & 7) == 0) {
-                            gtable[i][bi->tableIndices[i]].u = 0;
+                            gtable.u(i, bi->tableIndices[i]) = 0;
                         }
                     } else {
                         truePen++;
@@ -259,20 +255,20 @@ TAGE_SC_L_TAGE_8KB::handleTAGEUpdate(Addr branch_pc, bool taken,
                                      TAGEBase::BranchInfo* bi)
 {
     if (bi->hitBank > 0) {
-        if (abs (2 * gtable[bi->hitBank][bi->hitBankIndex].ctr + 1) == 1) {
+        if (abs (2 * gtable.ctr(bi->hitBank, bi->hitBankIndex) + 1) == 1) {
             if (bi->longestMatchPred != taken) { // acts as a protection
                 if (bi->altBank > 0) {
-                    int8_t ctr = gtable[bi->altBank][bi->altBankIndex].ctr;
+                    int8_t ctr = gtable.ctr(bi->altBank, bi->altBankIndex);
                     if (abs (2 * ctr + 1) == 1) {
-                        gtable[bi->altBank][bi->altBankIndex].u = 0;
+                        gtable.u(bi->altBank, bi->altBankIndex) = 0;
                     }
 
                     //just mute from protected to unprotected
-                    ctrUpdate(gtable[bi->altBank][bi->altBankIndex].ctr, taken,
+                    ctrUpdate(gtable.ctr(bi->altBank, bi->altBankIndex), taken,
                               tagTableCounterBits);
-                    ctr = gtable[bi->altBank][bi->altBankIndex].ctr;
+                    ctr = gtable.ctr(bi->altBank, bi->altBankIndex);
                     if (abs (2 * ctr + 1) == 1) {
-                        gtable[bi->altBank][bi->altBankIndex].u = 0;
+                        gtable.u(bi->altBank, bi->altBankIndex) = 0;
                     }
                 }
                 if (bi->altBank == 0) {
@@ -282,25 +278,25 @@ TAGE_SC_L_TAGE_8KB::handleTAGEUpdate(Addr branch_pc, bool taken,
         }
 
         //just mute from protected to unprotected
-        if (abs (2 * gtable[bi->hitBank][bi->hitBankIndex].ctr + 1) == 1) {
-            gtable[bi->hitBank][bi->hitBankIndex].u = 0;
+        if (abs (2 * gtable.ctr(bi->hitBank, bi->hitBankIndex) + 1) == 1) {
+            gtable.u(bi->hitBank, bi->hitBankIndex) = 0;
         }
 
-        ctrUpdate(gtable[bi->hitBank][bi->hitBankIndex].ctr, taken,
+        ctrUpdate(gtable.ctr(bi->hitBank, bi->hitBankIndex), taken,
                   tagTableCounterBits);
 
         //sign changes: no way it can have been useful
-        if (abs (2 * gtable[bi->hitBank][bi->hitBankIndex].ctr + 1) == 1) {
-            gtable[bi->hitBank][bi->hitBankIndex].u = 0;
+        if (abs (2 * gtable.ctr(bi->hitBank, bi->hitBankIndex) + 1) == 1) {
+            gtable.u(bi->hitBank, bi->hitBankIndex) = 0;
         }
 
         if (bi->altTaken == taken) {
             if (bi->altBank > 0) {
-                int8_t ctr = gtable[bi->altBank][bi->altBankIndex].ctr;
+                int8_t ctr = gtable.ctr(bi->altBank, bi->altBankIndex);
                 if (abs (2*ctr + 1) == 7) {
-                    if (gtable[bi->hitBank][bi->hitBankIndex].u == 1) {
+                    if (gtable.u(bi->hitBank, bi->hitBankIndex) == 1) {
                         if (bi->longestMatchPred == taken) {
-                            gtable[bi->hitBank][bi->hitBankIndex].u = 0;
+                            gtable.u(bi->hitBank, bi->hitBankIndex) = 0;
                         }
                     }
                 }
@@ -312,8 +308,8 @@ TAGE_SC_L_TAGE_8KB::handleTAGEUpdate(Addr branch_pc, bool taken,
 
     if ((bi->longestMatchPred != bi->altTaken) &&
         (bi->longestMatchPred == taken) &&
-        (gtable[bi->hitBank][bi->hitBankIndex].u < (1 << tagTableUBits) -1)) {
-            gtable[bi->hitBank][bi->hitBankIndex].u++;
+        (gtable.u(bi->hitBank, bi->hitBankIndex) < (1 << tagTableUBits) -1)) {
+            gtable.u(bi->hitBank, bi->hitBankIndex)++;
     }
 }
 
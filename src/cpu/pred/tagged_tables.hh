@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_PRED_TAGGED_TABLES_HH__
+#define __CPU_PRED_TAGGED_TABLES_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "base/bitfield.hh"
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+namespace branch_prediction
+{
+
+/**
+ * The tagged tables of a TAGE-like predictor.
+ *
+ * The tags, prediction counters and usefulness counters of each table
+ * are stored as a structure of arrays. A lookup reads a single tag from
+ * each table and the periodic reset of the usefulness counters streams
+ * through one dense array per table, so neither has to bring the other
+ * fields into the cache. Several tables may share the same entries.
+ *
+ * Table 0 is the bimodal table of the predictor and is never allocated,
+ * so at most 63 tagged tables are supported.
+ */
+class TaggedTables
+{
+  private:
+    struct Storage
+    {
+        std::vector<uint16_t> tag;
+        std::vector<int8_t> ctr;
+        std::vector<uint8_t> u;
+
+        Storage(size_t entries) : tag(entries, 0), ctr(entries, 0),
+                                  u(entries, 0)
+        {}
+    };
+
+    std::vector<std::unique_ptr<Storage>> storage;
+
+    /// Entries of each table, pointing into storage.
+    std::vector<uint16_t *> tags;
+    std::vector<int8_t *> ctrs;
+    std::vector<uint8_t *> us;
+    std::vector<size_t> sizes;
+
+  public:
+    /**
+     * Set the number of tables, including the unused table 0. Tables
+     * have no entries until they are allocated.
+     */
+    void
+    resize(size_t num_tables)
+    {
+        panic_if(num_tables > 64, "Too many tagged tables: %d.",
+                 num_tables);
+        tags.resize(num_tables, nullptr);
+        ctrs.resize(num_tables, nullptr);
+        us.resize(num_tables, nullptr);
+        sizes.resize(num_tables, 0);
+    }
+
+    size_t numTables() const { return sizes.size(); }
+
+    /** Give a table its own, zeroed, entries. */
+    void
+    allocate(int table, size_t entries)
+    {
+        storage.emplace_back(new Storage(entries));
+        tags[table] = storage.back()->tag.data();
+        ctrs[table] = storage.back()->ctr.data();
+        us[table] = storage.back()->u.data();
+        sizes[table] = entries;
+    }
+
+    /** Make a table use the entries of another one. */
+    void
+    share(int table, int other)
+    {
+        tags[table] = tags[other];
+        ctrs[table] = ctrs[other];
+        us[table] = us[other];
+        sizes[table] = sizes[other];
+    }
+
+    /** Number of entries of a table. */
+    size_t size(int table) const { return sizes[table]; }
+
+    uint16_t &tag(int table, size_t idx) { return tags[table][idx]; }
+    int8_t &ctr(int table, size_t idx) { return ctrs[table][idx]; }
+    uint8_t &u(int table, size_t idx) { return us[table][idx]; }
+
+    uint16_t tag(int table, size_t idx) const { return tags[table][idx]; }
+    int8_t ctr(int table, size_t idx) const { return ctrs[table][idx]; }
+    uint8_t u(int table, size_t idx) const { return us[table][idx]; }
+
+    /** The usefulness counters of a table, e.g., to reset them. */
+    uint8_t *uArray(int table) { return us[table]; }
+
+    /**
+     * Look up a tag in every table at once.
+     *
+     * @param indices Index of the entry to check in each table.
+     * @param match_tags Tag expected in each table.
+     * @param enabled Bit mask of the tables to check.
+     * @return Bit mask of the enabled tables holding the expected tag.
+     */
+    uint64_t
+    match(const int *indices, const int *match_tags, uint64_t enabled) const
+    {
+        const size_t n = sizes.size();
+        uint64_t hits = 0;
+        for (size_t i = 1; i < n; i++) {
+            // Disabled tables may have neither entries nor a valid index.
+            if (!((enabled >> i) & 1))
+                continue;
+            hits |= (uint64_t)(tags[i][indices[i]] == match_tags[i]) << i;
+        }
+        return hits;
+    }
+
+    /** The table providing the prediction, i.e., the longest match. */
+    static int
+    hitBank(uint64_t hits)
+    {
+        return findMsbSet(hits);
+    }
+
+    /** The table providing the alternate prediction. */
+    static int
+    altBank(uint64_t hits)
+    {
+        return hits ? findMsbSet(hits & ~(1ULL << findMsbSet(hits))) : 0;
+    }
+};
+
+} // namespace branch_prediction
+} // namespace gem5
+
+#endif // __CPU_PRED_TAGGED_TABLES_HH__
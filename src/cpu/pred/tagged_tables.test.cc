@@ -0,0 +1,370 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "cpu/pred/branch_trace.hh"
+#include "cpu/pred/folded_history.hh"
+#include "cpu/pred/tagged_tables.hh"
+
+using namespace gem5;
+using namespace gem5::branch_prediction;
+
+namespace
+{
+
+const int numTables = 12;
+const int logTableSize = 10;
+const int minHist = 4;
+const int maxHist = 640;
+/// Table disabled in every lookup, as TAGE-SC-L does for associativity.
+const int skippedTable = 5;
+
+/** The outcome of a lookup. */
+struct Lookup
+{
+    int hitBank = 0;
+    int altBank = 0;
+    bool pred = false;
+
+    bool
+    operator==(const Lookup &other) const
+    {
+        return hitBank == other.hitBank && altBank == other.altBank &&
+            pred == other.pred;
+    }
+};
+
+/** The global history and the indices and tags of a small TAGE. */
+class TageHistory
+{
+  private:
+    std::vector<uint8_t> ghist;
+    int ptr;
+    FoldedHistories folded;
+    std::vector<int> histLengths;
+    std::vector<int> tagBits;
+
+  public:
+    int indices[numTables + 1];
+    int tags[numTables + 1];
+
+    TageHistory()
+        : ghist(1 << 14, 0), ptr(ghist.size() - maxHist - 1),
+          folded(3 * (numTables + 1)), histLengths(numTables + 1, 0),
+          tagBits(numTables + 1, 0)
+    {
+        for (int i = 1; i <= numTables; i++) {
+            histLengths[i] = minHist * std::pow(
+                (double)maxHist / minHist, (i - 1.0) / (numTables - 1));
+            tagBits[i] = 8 + i / 2;
+            folded.init(3 * i, histLengths[i], logTableSize);
+            folded.init(3 * i + 1, histLengths[i], tagBits[i]);
+            folded.init(3 * i + 2, histLengths[i], tagBits[i] - 1);
+        }
+    }
+
+    void
+    compute(Addr pc)
+    {
+        const Addr mask = (1 << logTableSize) - 1;
+        for (int i = 1; i <= numTables; i++) {
+            indices[i] = (pc ^ (pc >> (logTableSize - i % 4)) ^
+                          folded.comp(3 * i)) & mask;
+            tags[i] = (pc ^ folded.comp(3 * i + 1) ^
+                       (folded.comp(3 * i + 2) << 1)) &
+                ((1 << tagBits[i]) - 1);
+        }
+    }
+
+    void
+    update(bool taken)
+    {
+        if (ptr == 0) {
+            // Move the most recent bits back to the end of the buffer.
+            const int end = ghist.size() - maxHist - 1;
+            for (int i = 0; i <= maxHist; i++)
+                ghist[end + i] = ghist[i];
+            ptr = end;
+        }
+        ghist[--ptr] = taken;
+        folded.update(&ghist[ptr]);
+    }
+};
+
+/** Tagged tables stored as an array of structures, as they used to be. */
+class ReferenceTables
+{
+  private:
+    struct Entry
+    {
+        int8_t ctr = 0;
+        uint16_t tag = 0;
+        uint8_t u = 0;
+    };
+    std::vector<std::vector<Entry>> tables;
+
+  public:
+    ReferenceTables()
+        : tables(numTables + 1, std::vector<Entry>(1 << logTableSize))
+    {}
+
+    Lookup
+    lookup(const TageHistory &h) const
+    {
+        Lookup l;
+        for (int i = numTables; i > 0; i--) {
+            if (i != skippedTable &&
+                tables[i][h.indices[i]].tag == h.tags[i]) {
+                l.hitBank = i;
+                break;
+            }
+        }
+        for (int i = l.hitBank - 1; i > 0; i--) {
+            if (i != skippedTable &&
+                tables[i][h.indices[i]].tag == h.tags[i]) {
+                l.altBank = i;
+                break;
+            }
+        }
+        if (l.hitBank)
+            l.pred = tables[l.hitBank][h.indices[l.hitBank]].ctr >= 0;
+        return l;
+    }
+
+    void
+    update(const TageHistory &h, const Lookup &l, bool taken)
+    {
+        if (l.hitBank) {
+            Entry &e = tables[l.hitBank][h.indices[l.hitBank]];
+            if (taken && e.ctr < 3)
+                e.ctr++;
+            else if (!taken && e.ctr > -4)
+                e.ctr--;
+        }
+        if (l.pred == taken)
+            return;
+        for (int i = l.hitBank + 1; i <= numTables; i++) {
+            Entry &e = tables[i][h.indices[i]];
+            if (i == skippedTable)
+                continue;
+            if (e.u == 0) {
+                e.tag = h.tags[i];
+                e.ctr = taken ? 0 : -1;
+                e.u = 1;
+                return;
+            }
+            e.u--;
+        }
+    }
+};
+
+/** The same tables stored as a structure of arrays. */
+class SoATables
+{
+  private:
+    TaggedTables tables;
+    uint64_t enabled = 0;
+
+  public:
+    SoATables()
+    {
+        tables.resize(numTables + 1);
+        for (int i = 1; i <= numTables; i++) {
+            tables.allocate(i, 1 << logTableSize);
+            if (i != skippedTable)
+                enabled |= 1ULL << i;
+        }
+    }
+
+    Lookup
+    lookup(const TageHistory &h) const
+    {
+        Lookup l;
+        const uint64_t hits = tables.match(h.indices, h.tags, enabled);
+        l.hitBank = TaggedTables::hitBank(hits);
+        l.altBank = TaggedTables::altBank(hits);
+        if (l.hitBank)
+            l.pred = tables.ctr(l.hitBank, h.indices[l.hitBank]) >= 0;
+        return l;
+    }
+
+    void
+    update(const TageHistory &h, const Lookup &l, bool taken)
+    {
+        if (l.hitBank) {
+            int8_t &ctr = tables.ctr(l.hitBank, h.indices[l.hitBank]);
+            if (taken && ctr < 3)
+                ctr++;
+            else if (!taken && ctr > -4)
+                ctr--;
+        }
+        if (l.pred == taken)
+            return;
+        for (int i = l.hitBank + 1; i <= numTables; i++) {
+            if (i == skippedTable)
+                continue;
+            uint8_t &u = tables.u(i, h.indices[i]);
+            if (u == 0) {
+                tables.tag(i, h.indices[i]) = h.tags[i];
+                tables.ctr(i, h.indices[i]) = taken ? 0 : -1;
+                u = 1;
+                return;
+            }
+            u--;
+        }
+    }
+};
+
+std::string
+tempTraceName()
+{
+    char name[] = "/tmp/tagged_tables_test.XXXXXX";
+    int fd = mkstemp(name);
+    EXPECT_NE(fd, -1);
+    close(fd);
+    return name;
+}
+
+/**
+ * Write a trace of loops with different trip counts and of branches
+ * correlated with older ones, so that all the tables get used.
+ */
+void
+writeTrace(const std::string &name, int num_branches)
+{
+    BranchTraceWriter writer(name);
+    std::mt19937 rng(1234);
+    std::vector<bool> outcomes;
+    for (int i = 0; i < num_branches; i++) {
+        TraceBranch branch;
+        const int site = rng() % 64;
+        branch.pc = 0x400000 + site * 0x24;
+        branch.size = 4;
+        branch.type = BranchType::DirectCond;
+        if (site < 32) {
+            branch.taken = (i % (site + 2)) != 0;
+        } else if (outcomes.size() > (size_t)site * 8) {
+            branch.taken = outcomes[outcomes.size() - site * 8] ^ (site & 1);
+        } else {
+            branch.taken = rng() & 1;
+        }
+        branch.target = branch.taken ? branch.pc - 0x100 :
+            branch.pc + branch.size;
+        branch.insts = 1 + rng() % 8;
+        outcomes.push_back(branch.taken);
+        writer.write(branch);
+    }
+}
+
+/** Replay a trace through a set of tables, keeping all the lookups. */
+template <class Tables>
+void
+replay(const std::string &name, std::vector<Lookup> &lookups)
+{
+    BranchTraceReader reader(name);
+    TageHistory history;
+    Tables tables;
+    TraceBranch branch;
+    while (reader.read(branch)) {
+        history.compute(branch.pc);
+        const Lookup l = tables.lookup(history);
+        tables.update(history, l, branch.taken);
+        history.update(branch.taken);
+        lookups.push_back(l);
+    }
+}
+
+} // anonymous namespace
+
+TEST(TaggedTablesTest, AltBank)
+{
+    EXPECT_EQ(TaggedTables::hitBank(0), 0);
+    EXPECT_EQ(TaggedTables::altBank(0), 0);
+    EXPECT_EQ(TaggedTables::hitBank(1ULL << 7), 7);
+    EXPECT_EQ(TaggedTables::altBank(1ULL << 7), 0);
+    EXPECT_EQ(TaggedTables::hitBank((1ULL << 63) | (1ULL << 2)), 63);
+    EXPECT_EQ(TaggedTables::altBank((1ULL << 63) | (1ULL << 2)), 2);
+    EXPECT_EQ(TaggedTables::altBank(0xe), 2);
+}
+
+TEST(TaggedTablesTest, Share)
+{
+    TaggedTables tables;
+    tables.resize(4);
+    tables.allocate(1, 16);
+    tables.allocate(3, 8);
+    tables.share(2, 1);
+    tables.tag(2, 5) = 0x1234;
+    tables.u(1, 6) = 3;
+    EXPECT_EQ(tables.tag(1, 5), 0x1234);
+    EXPECT_EQ(tables.u(2, 6), 3);
+    EXPECT_EQ(tables.size(2), 16);
+    EXPECT_EQ(tables.size(3), 8);
+    EXPECT_EQ(tables.tag(3, 5), 0);
+
+    const int indices[] = {0, 5, 5, 5};
+    const int tags[] = {0, 0x1234, 0x1234, 0x1234};
+    EXPECT_EQ(tables.match(indices, tags, 0xe), 0x6);
+    EXPECT_EQ(tables.match(indices, tags, 0xa), 0x2);
+}
+
+/**
+ * Replay a branch trace through the batched lookups and through the
+ * previous table at a time search, which must agree on every branch.
+ */
+TEST(TaggedTablesTest, TraceReplay)
+{
+    const std::string name = tempTraceName();
+    writeTrace(name, 5000);
+
+    std::vector<Lookup> ref_lookups, soa_lookups;
+    replay<ReferenceTables>(name, ref_lookups);
+    replay<SoATables>(name, soa_lookups);
+    std::remove(name.c_str());
+
+    ASSERT_EQ(ref_lookups.size(), soa_lookups.size());
+    size_t hits = 0, alts = 0;
+    for (size_t i = 0; i < ref_lookups.size(); i++) {
+        ASSERT_EQ(ref_lookups[i], soa_lookups[i]) << "branch " << i;
+        hits += ref_lookups[i].hitBank != 0;
+        alts += ref_lookups[i].altBank != 0;
+    }
+    // Make sure the trace exercises both the providers and the alternates.
+    EXPECT_GT(hits, ref_lookups.size() / 2);
+    EXPECT_GT(alts, ref_lookups.size() / 10);
+}
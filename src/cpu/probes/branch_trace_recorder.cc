@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/probes/branch_trace_recorder.hh"
+
+#include "base/output.hh"
+#include "cpu/pred/branch_type.hh"
+#include "sim/core.hh"
+
+namespace gem5
+{
+
+BranchTraceRecorder::BranchTraceRecorder(
+        const BranchTraceRecorderParams &p)
+    : ProbeListenerObject(p),
+      writer(new branch_prediction::BranchTraceWriter(
+                  simout.resolve(p.trace_file)))
+{
+    // Simulation objects aren't destroyed on exit, so close the trace
+    // explicitly to flush it.
+    registerExitCallback([this]() { writer.reset(); });
+}
+
+void
+BranchTraceRecorder::regProbeListeners()
+{
+    typedef ProbeListenerArg<BranchTraceRecorder, Addr> InstListener;
+    typedef ProbeListenerArg<BranchTraceRecorder, BaseCPU::RetiredBranch>
+        BranchListener;
+
+    listeners.push_back(new InstListener(this, "RetiredInstsPC",
+                &BranchTraceRecorder::retiredInst));
+    listeners.push_back(new BranchListener(this, "RetiredBranchesPC",
+                &BranchTraceRecorder::retiredBranch));
+}
+
+void
+BranchTraceRecorder::retiredInst(const Addr &pc)
+{
+    insts++;
+}
+
+void
+BranchTraceRecorder::retiredBranch(const BaseCPU::RetiredBranch &retired)
+{
+    if (!writer)
+        return;
+
+    const StaticInstPtr inst(const_cast<StaticInst *>(retired.inst));
+    std::unique_ptr<PCStateBase> next(retired.pc->clone());
+    inst->advancePC(*next);
+
+    branch_prediction::TraceBranch branch;
+    branch.pc = retired.pc->instAddr();
+    branch.target = next->instAddr();
+    branch.type = branch_prediction::getBranchType(inst);
+    branch.taken = retired.pc->branching();
+    branch.insts = insts;
+    insts = 0;
+
+    if (inst->size()) {
+        branch.size = inst->size();
+    } else if (!branch.taken) {
+        branch.size = branch.target - branch.pc;
+        sizes[branch.pc] = branch.size;
+    } else {
+        auto it = sizes.find(branch.pc);
+        branch.size = it == sizes.end() ? 0 : it->second;
+    }
+
+    writer->write(branch);
+}
+
+} // namespace gem5
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_PROBES_BRANCH_TRACE_RECORDER_HH__
+#define __CPU_PROBES_BRANCH_TRACE_RECORDER_HH__
+
+#include <memory>
+#include <unordered_map>
+
+#include "cpu/base.hh"
+#include "cpu/pred/branch_trace.hh"
+#include "params/BranchTraceRecorder.hh"
+#include "sim/probe/probe.hh"
+
+namespace gem5
+{
+
+/**
+ * Records the branches retired by a CPU to a branch trace which can be
+ * replayed through a branch predictor by a BranchTraceReplayer.
+ *
+ * ISAs which don't record the size of an instruction in its StaticInst
+ * only provide the size of a branch once it has been seen not taken.
+ * Branches of unknown size are recorded with a size of 0.
+ */
+class BranchTraceRecorder : public ProbeListenerObject
+{
+  public:
+    BranchTraceRecorder(const BranchTraceRecorderParams &params);
+
+    void regProbeListeners() override;
+
+    void retiredInst(const Addr &pc);
+    void retiredBranch(const BaseCPU::RetiredBranch &branch);
+
+  private:
+    std::unique_ptr<branch_prediction::BranchTraceWriter> writer;
+
+    /** Instructions retired since the last recorded branch. */
+    uint64_t insts = 0;
+
+    /** Sizes of the branches seen not taken so far. */
+    std::unordered_map<Addr, unsigned> sizes;
+};
+
+} // namespace gem5
+
+#endif // __CPU_PROBES_BRANCH_TRACE_RECORDER_HH__
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/shared_decode_cache.hh"
+
+namespace gem5
+{
+
+SharedDecodeCache::SharedDecodeCache(const Params &p)
+    : SimObject(p), stats(*this)
+{}
+
+size_t
+SharedDecodeCache::numEntries() const
+{
+    std::shared_lock<std::shared_mutex> guard(instMapsLock);
+    size_t total = 0;
+    for (const auto &[type, map]: instMaps)
+        total += map->size();
+    return total;
+}
+
+size_t
+SharedDecodeCache::footprint() const
+{
+    std::shared_lock<std::shared_mutex> guard(instMapsLock);
+    size_t total = 0;
+    for (const auto &[type, map]: instMaps)
+        total += map->size() * map->entryBytes();
+    return total;
+}
+
+SharedDecodeCache::SharedDecodeCacheStats::SharedDecodeCacheStats(
+        SharedDecodeCache &_cache)
+    : statistics::Group(&_cache), cache(_cache),
+      ADD_STAT(lookups, statistics::units::Count::get(),
+               "Number of lookups which missed in a private decode cache"),
+      ADD_STAT(misses, statistics::units::Count::get(),
+               "Number of lookups which had to decode the instruction"),
+      ADD_STAT(hits, statistics::units::Count::get(),
+               "Number of lookups which found a decoded instruction"),
+      ADD_STAT(hitRate, statistics::units::Ratio::get(),
+               "Fraction of lookups which found a decoded instruction"),
+      ADD_STAT(entries, statistics::units::Count::get(),
+               "Number of decoded instructions in the cache"),
+      ADD_STAT(footprint, statistics::units::Byte::get(),
+               "Approximate host memory used by the cache index, "
+               "excluding the instructions themselves")
+{
+    lookups.functor([this]() {
+        return cache.numLookups.load(std::memory_order_relaxed) -
+            lookupsBase;
+    });
+    misses.functor([this]() {
+        return cache.numMisses.load(std::memory_order_relaxed) -
+            missesBase;
+    });
+    entries.functor([this]() { return cache.numEntries(); });
+    footprint.functor([this]() { return cache.footprint(); });
+
+    hits = lookups - misses;
+    hitRate = hits / lookups;
+}
+
+void
+SharedDecodeCache::SharedDecodeCacheStats::resetStats()
+{
+    statistics::Group::resetStats();
+    lookupsBase = cache.numLookups.load(std::memory_order_relaxed);
+    missesBase = cache.numMisses.load(std::memory_order_relaxed);
+}
+
+} // namespace gem5
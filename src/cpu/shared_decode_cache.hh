@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_SHARED_DECODE_CACHE_HH__
+#define __CPU_SHARED_DECODE_CACHE_HH__
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <typeindex>
+#include <unordered_map>
+
+#include "base/statistics.hh"
+#include "cpu/decode_cache.hh"
+#include "cpu/static_inst.hh"
+#include "params/SharedDecodeCache.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+/**
+ * A decoded instruction cache which can be shared by all the decoders in
+ * a system, e.g., when every core of a rate-style run executes the same
+ * binary. It sits behind the private per-decoder caches, so it is only
+ * consulted when a decoder misses locally.
+ *
+ * The cache may be used concurrently from several event queue threads.
+ * Instructions decoded through it are constructed as shared (see
+ * StaticInst::isShared()) so their reference count is never touched again.
+ */
+class SharedDecodeCache : public SimObject
+{
+  private:
+    struct InstMapBase
+    {
+        virtual ~InstMapBase() = default;
+        virtual size_t size() const = 0;
+        virtual size_t entryBytes() const = 0;
+    };
+
+    template <typename EMI>
+    struct InstMap : public InstMapBase
+    {
+        decode_cache::SharedInstMap<EMI> map;
+
+        size_t size() const override { return map.size(); }
+
+        size_t
+        entryBytes() const override
+        {
+            return decode_cache::SharedInstMap<EMI>::EntryBytes;
+        }
+    };
+
+    /// One map per machine instruction type, i.e., per ISA.
+    mutable std::shared_mutex instMapsLock;
+    std::unordered_map<std::type_index,
+        std::unique_ptr<InstMapBase>> instMaps;
+
+    template <typename EMI>
+    decode_cache::SharedInstMap<EMI> &
+    instMap()
+    {
+        const std::type_index type(typeid(EMI));
+        {
+            std::shared_lock<std::shared_mutex> guard(instMapsLock);
+            auto it = instMaps.find(type);
+            if (it != instMaps.end())
+                return static_cast<InstMap<EMI> *>(it->second.get())->map;
+        }
+
+        std::unique_lock<std::shared_mutex> guard(instMapsLock);
+        auto &entry = instMaps[type];
+        if (!entry)
+            entry = std::make_unique<InstMap<EMI>>();
+        return static_cast<InstMap<EMI> *>(entry.get())->map;
+    }
+
+    /// Counters are updated from several threads, so they live outside
+    /// of the stats and are only read when the stats are dumped.
+    std::atomic<uint64_t> numLookups{0};
+    std::atomic<uint64_t> numMisses{0};
+
+    size_t numEntries() const;
+    size_t footprint() const;
+
+    struct SharedDecodeCacheStats : public statistics::Group
+    {
+        SharedDecodeCacheStats(SharedDecodeCache &cache);
+
+        void resetStats() override;
+
+        SharedDecodeCache &cache;
+
+        /// Counter values at the last stats reset.
+        uint64_t lookupsBase = 0;
+        uint64_t missesBase = 0;
+
+        statistics::Value lookups;
+        statistics::Value misses;
+        statistics::Formula hits;
+        statistics::Formula hitRate;
+        statistics::Value entries;
+        statistics::Value footprint;
+    } stats;
+
+  public:
+    PARAMS(SharedDecodeCache);
+    SharedDecodeCache(const Params &p);
+
+    /**
+     * Look up a machine instruction, decoding and publishing it on a
+     * miss.
+     *
+     * @param mach_inst The machine instruction to look up.
+     * @param context Any decoder state decode_inst depends on which
+     *        isn't captured by mach_inst.
+     * @param decode_inst Callable decoding mach_inst.
+     * @retval The shared decoded instruction.
+     */
+    template <typename EMI, typename DecodeInst>
+    StaticInstPtr
+    decode(const EMI &mach_inst, uint64_t context, DecodeInst &&decode_inst)
+    {
+        auto &map = instMap<EMI>();
+        numLookups.fetch_add(1, std::memory_order_relaxed);
+
+        StaticInstPtr si = map.find(mach_inst, context);
+        if (si)
+            return si;
+
+        numMisses.fetch_add(1, std::memory_order_relaxed);
+        {
+            StaticInst::SharedScope scope;
+            si = decode_inst(mach_inst);
+        }
+        return map.insert(mach_inst, context, si);
+    }
+};
+
+} // namespace gem5
+
+#endif // __CPU_SHARED_DECODE_CACHE_HH__
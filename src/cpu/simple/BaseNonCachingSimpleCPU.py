@@ -52,6 +52,14 @@ class BaseNonCachingSimpleCPU(BaseAtomicSimpleCPU):
 
     numThreads = 1
 
+    translation_cache_size = Param.Unsigned(
+        0,
+        "Number of pages whose translations are cached for each kind of "
+        "access, letting their accesses skip the MMU and the memory system, "
+        "or 0 to always use them. Translations must be the same over whole "
+        "4KiB pages, e.g., no PMP region may end inside one.",
+    )
+
     @classmethod
     def memory_mode(cls):
         return "atomic_noncaching"
@@ -385,8 +385,7 @@ AtomicSimpleCPU::readMem(Addr addr, uint8_t *data, unsigned size,
 
         // translate to physical address
         if (predicate) {
-            fault = thread->mmu->translateAtomic(req, thread->getTC(),
-                                                 BaseMMU::Read);
+            fault = translate(req, BaseMMU::Read);
         }
 
         // Now do the access.
@@ -472,8 +471,7 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
 
         // translate to physical address
         if (predicate)
-            fault = thread->mmu->translateAtomic(req, thread->getTC(),
-                                                 BaseMMU::Write);
+            fault = translate(req, BaseMMU::Write);
 
         // Now do the access.
         if (predicate && fault == NoFault) {
@@ -576,8 +574,7 @@ AtomicSimpleCPU::amoMem(Addr addr, uint8_t* data, unsigned size,
                  thread->pcState().instAddr(), std::move(amo_op));
 
     // translate to physical address
-    Fault fault = thread->mmu->translateAtomic(
-        req, thread->getTC(), BaseMMU::Write);
+    Fault fault = translate(req, BaseMMU::Write);
 
     // Now do the access.
     if (fault == NoFault && !req->getFlags().isSet(Request::NO_ACCESS)) {
@@ -655,8 +652,7 @@ AtomicSimpleCPU::tick()
         if (needToFetch) {
             ifetch_req->taskId(taskId());
             setupFetchRequest(ifetch_req);
-            fault = thread->mmu->translateAtomic(ifetch_req, thread->getTC(),
-                                                 BaseMMU::Execute);
+            fault = translate(ifetch_req, BaseMMU::Execute);
         }
 
         if (fault == NoFault) {
@@ -738,6 +734,13 @@ AtomicSimpleCPU::tick()
         reschedule(tickEvent, curTick() + latency, true);
 }
 
+Fault
+AtomicSimpleCPU::translate(const RequestPtr &req, BaseMMU::Mode mode)
+{
+    SimpleThread *thread = threadInfo[curThread]->thread;
+    return thread->mmu->translateAtomic(req, thread->getTC(), mode);
+}
+
 Tick
 AtomicSimpleCPU::fetchInstMem()
 {
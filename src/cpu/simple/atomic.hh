@@ -106,6 +106,9 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     virtual Tick sendPacket(RequestPort &port, const PacketPtr &pkt);
     virtual Tick fetchInstMem();
 
+    /** Translate a request of the current thread. */
+    virtual Fault translate(const RequestPtr &req, BaseMMU::Mode mode);
+
     /**
      * An AtomicCPUPort overrides the default behaviour of the
      * recvAtomicSnoop and ignores the packet instead of panicking. It
@@ -486,7 +486,7 @@ BaseSimpleCPU::postExecute()
     }
 
     // Call CPU instruction commit probes
-    probeInstCommit(curStaticInst, instAddr);
+    probeInstCommit(curStaticInst, threadContexts[curThread]->pcState());
 }
 
 void
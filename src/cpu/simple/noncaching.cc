@@ -38,8 +38,11 @@
 #include "cpu/simple/noncaching.hh"
 
 #include <cassert>
+#include <cstring>
 
 #include "arch/generic/decoder.hh"
+#include "base/bitfield.hh"
+#include "cpu/exetrace.hh"
 
 namespace gem5
 {
@@ -51,6 +54,9 @@ NonCachingSimpleCPU::NonCachingSimpleCPU(
     assert(p.numThreads == 1);
     fatal_if(!FullSystem && p.workload.size() != 1,
              "only one workload allowed");
+
+    for (auto &table: translations)
+        table.resize(p.translation_cache_size);
 }
 
 void
@@ -77,12 +83,16 @@ NonCachingSimpleCPU::sendPacket(RequestPort &port, const PacketPtr &pkt)
                         it != memBackdoors.end(); it++) {
                     if (it->second == &backdoor) {
                         memBackdoors.erase(it);
+                        flushTranslations();
                         return;
                     }
                 }
                 panic("Got invalidation for unknown memory backdoor.");
             };
         bd->addInvalidationCallback(callback);
+
+        // Let the pages of the backdoor be accessed through it.
+        flushTranslations();
     }
     return latency;
 }
@@ -90,16 +100,161 @@ NonCachingSimpleCPU::sendPacket(RequestPort &port, const PacketPtr &pkt)
 Tick
 NonCachingSimpleCPU::fetchInstMem()
 {
+    auto &decoder = threadInfo[curThread]->thread->decoder;
+
+    uint8_t *host = hostAccess(ifetch_req->getVaddr(), ifetch_req->getSize(),
+                               ifetch_req->getFlags(), {}, BaseMMU::Execute);
+    if (host) {
+        memcpy(decoder->moreBytesPtr(), host, ifetch_req->getSize());
+        return 0;
+    }
+
     auto bd_it = memBackdoors.contains(ifetch_req->getPaddr());
     if (bd_it == memBackdoors.end())
         return AtomicSimpleCPU::fetchInstMem();
 
-    auto &decoder = threadInfo[curThread]->thread->decoder;
-
     auto *bd = bd_it->second;
     Addr offset = ifetch_req->getPaddr() - bd->range().start();
     memcpy(decoder->moreBytesPtr(), bd->ptr() + offset, ifetch_req->getSize());
     return 0;
 }
 
+void
+NonCachingSimpleCPU::drainResume()
+{
+    // The state translations depend on may have been restored.
+    flushTranslations();
+    AtomicSimpleCPU::drainResume();
+}
+
+NonCachingSimpleCPU::CachedTranslation *
+NonCachingSimpleCPU::lookupTranslation(Addr vaddr, Request::FlagsType flags,
+                                       BaseMMU::Mode mode)
+{
+    const BaseMMU *mmu = threadInfo[curThread]->thread->mmu;
+    auto &table = translations[mode];
+    const Addr vpn = vaddr >> CachedPageShift;
+    CachedTranslation &entry = table[vpn % table.size()];
+    if (entry.vpn != vpn || entry.flags != flags ||
+            entry.gen != mmu->translationGen()) {
+        return nullptr;
+    }
+    return &entry;
+}
+
+uint8_t *
+NonCachingSimpleCPU::hostAccess(Addr vaddr, unsigned size,
+                                Request::Flags flags,
+                                const std::vector<bool> &byte_enable,
+                                BaseMMU::Mode mode)
+{
+    if (!byte_enable.empty() || !cachedAccess(vaddr, size, flags))
+        return nullptr;
+
+    CachedTranslation *entry = lookupTranslation(vaddr, flags, mode);
+    if (!entry || !entry->host)
+        return nullptr;
+    return entry->host + (vaddr & mask(CachedPageShift));
+}
+
+void
+NonCachingSimpleCPU::flushTranslations()
+{
+    for (auto &table: translations) {
+        for (auto &entry: table)
+            entry.vpn = MaxAddr;
+    }
+}
+
+Fault
+NonCachingSimpleCPU::translate(const RequestPtr &req, BaseMMU::Mode mode)
+{
+    const Addr vaddr = req->getVaddr();
+    const Request::FlagsType flags = req->getFlags();
+    const bool cached = !req->isMasked() &&
+        cachedAccess(vaddr, req->getSize(), flags);
+
+    if (cached) {
+        CachedTranslation *entry = lookupTranslation(vaddr, flags, mode);
+        if (entry) {
+            req->setFlags(entry->setFlags);
+            req->setPaddr((entry->ppn << CachedPageShift) |
+                          (vaddr & mask(CachedPageShift)));
+            return NoFault;
+        }
+    }
+
+    Fault fault = AtomicSimpleCPU::translate(req, mode);
+    BaseMMU *mmu = threadInfo[curThread]->thread->mmu;
+    if (req->isLocalAccess()) {
+        // Accesses the MMU handles itself may change its state.
+        mmu->translationsChanged();
+        return fault;
+    }
+    const Request::FlagsType set_flags = req->getFlags() & ~flags;
+    if (!cached || fault != NoFault || (set_flags & ~CachedFlags))
+        return fault;
+
+    auto &table = translations[mode];
+    const Addr vpn = vaddr >> CachedPageShift;
+    CachedTranslation *entry = &table[vpn % table.size()];
+    entry->vpn = vpn;
+    entry->gen = mmu->translationGen();
+    entry->flags = flags;
+    entry->setFlags = set_flags;
+    entry->ppn = req->getPaddr() >> CachedPageShift;
+    entry->host = nullptr;
+
+    const Addr page = entry->ppn << CachedPageShift;
+    auto bd_it = memBackdoors.contains(
+            RangeSize(page, Addr(1) << CachedPageShift));
+    if (bd_it != memBackdoors.end()) {
+        const MemBackdoor *bd = bd_it->second;
+        if (mode == BaseMMU::Write ? bd->writeable() : bd->readable())
+            entry->host = bd->ptr() + (page - bd->range().start());
+    }
+    return fault;
+}
+
+Fault
+NonCachingSimpleCPU::readMem(Addr addr, uint8_t *data, unsigned size,
+                             Request::Flags flags,
+                             const std::vector<bool> &byte_enable)
+{
+    uint8_t *host = hostAccess(addr, size, flags, byte_enable,
+                               BaseMMU::Read);
+    if (!host)
+        return AtomicSimpleCPU::readMem(addr, data, size, flags, byte_enable);
+
+    if (traceData)
+        traceData->setMem(addr, size, flags);
+    memcpy(data, host, size);
+    dcache_latency = 0;
+    dcache_access = true;
+    return NoFault;
+}
+
+Fault
+NonCachingSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
+                              Request::Flags flags, uint64_t *res,
+                              const std::vector<bool> &byte_enable)
+{
+    // Backdoors are only handed out while no address is locked, so
+    // writing through them can't break load locked/store conditional
+    // pairs.
+    uint8_t *host = res ? nullptr :
+        hostAccess(addr, size, flags, byte_enable, BaseMMU::Write);
+    if (!host) {
+        return AtomicSimpleCPU::writeMem(data, size, addr, flags, res,
+                                         byte_enable);
+    }
+
+    if (traceData)
+        traceData->setMem(addr, size, flags);
+    memcpy(host, data, size);
+    dcache_latency = 0;
+    dcache_access = true;
+    return NoFault;
+}
+
 } // namespace gem5
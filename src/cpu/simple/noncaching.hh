@@ -38,7 +38,11 @@
 #ifndef __CPU_SIMPLE_NONCACHING_HH__
 #define __CPU_SIMPLE_NONCACHING_HH__
 
+#include <array>
+#include <vector>
+
 #include "base/addr_range_map.hh"
+#include "base/intmath.hh"
 #include "cpu/simple/atomic.hh"
 #include "mem/backdoor.hh"
 #include "params/BaseNonCachingSimpleCPU.hh"
@@ -49,6 +53,13 @@ namespace gem5
 /**
  * The NonCachingSimpleCPU is an AtomicSimpleCPU using the
  * 'atomic_noncaching' memory mode instead of just 'atomic'.
+ *
+ * It can cache the translations of the pages it recently accessed,
+ * along with the host memory backing them, for the plain accesses to
+ * these pages to skip both the MMU and the memory system. The cached
+ * translations are dropped whenever the MMU reports translations may
+ * have changed, e.g., when TLB entries are invalidated or misc regs are
+ * written, and when memory backdoors come and go.
  */
 class NonCachingSimpleCPU : public AtomicSimpleCPU
 {
@@ -57,11 +68,88 @@ class NonCachingSimpleCPU : public AtomicSimpleCPU
 
     void verifyMemoryMode() const override;
 
+    void drainResume() override;
+
+    Fault readMem(Addr addr, uint8_t *data, unsigned size,
+                  Request::Flags flags,
+                  const std::vector<bool> &byte_enable=std::vector<bool>())
+        override;
+
+    Fault writeMem(uint8_t *data, unsigned size,
+                   Addr addr, Request::Flags flags, uint64_t *res,
+                   const std::vector<bool> &byte_enable=std::vector<bool>())
+        override;
+
   protected:
     AddrRangeMap<MemBackdoorPtr, 1> memBackdoors;
 
+    /**
+     * Translations are cached by page of this size, which no MMU maps
+     * smaller pages than.
+     */
+    static constexpr unsigned CachedPageShift = 12;
+
+    /**
+     * The only flags of the requests whose translations are cached,
+     * before and after being translated.
+     */
+    static constexpr Request::FlagsType CachedFlags =
+        Request::ARCH_BITS | Request::INST_FETCH | Request::PRIVILEGED |
+        Request::KERNEL | Request::SECURE;
+
+    struct CachedTranslation
+    {
+        /** Virtual page number, or MaxAddr if the entry is invalid. */
+        Addr vpn = MaxAddr;
+        /** Translation generation of the MMU the entry is valid for. */
+        uint64_t gen = 0;
+        /** Flags of the requests the entry translates. */
+        Request::FlagsType flags = 0;
+        /** Flags the translation sets in the requests. */
+        Request::FlagsType setFlags = 0;
+        /** Physical page number. */
+        Addr ppn = 0;
+        /** Host memory backing the page, if any. */
+        uint8_t *host = nullptr;
+    };
+
+    /** Recently used translations for each access mode, by page. */
+    std::array<std::vector<CachedTranslation>, 3> translations;
+
+    /** Whether the translation of an access can be cached. */
+    bool
+    cachedAccess(Addr vaddr, unsigned size, Request::FlagsType flags) const
+    {
+        // Naturally aligned accesses don't cross pages, and don't fault
+        // because of their alignment.
+        return !translations[0].empty() && isPowerOf2(size) &&
+            size <= (1 << CachedPageShift) && !(vaddr & (size - 1)) &&
+            !(flags & ~CachedFlags);
+    }
+
+    /**
+     * Find the cached translation of an access.
+     *
+     * @return The entry, or nullptr if the translation isn't cached.
+     */
+    CachedTranslation *lookupTranslation(Addr vaddr,
+            Request::FlagsType flags, BaseMMU::Mode mode);
+
+    /**
+     * Find the host memory an access can directly use.
+     *
+     * @return A pointer to the data, or nullptr if the access can't
+     * bypass the MMU and the memory system.
+     */
+    uint8_t *hostAccess(Addr vaddr, unsigned size, Request::Flags flags,
+            const std::vector<bool> &byte_enable, BaseMMU::Mode mode);
+
+    /** Drop all the cached translations. */
+    void flushTranslations();
+
     Tick sendPacket(RequestPort &port, const PacketPtr &pkt) override;
     Tick fetchInstMem() override;
+    Fault translate(const RequestPtr &req, BaseMMU::Mode mode) override;
 };
 
 } // namespace gem5
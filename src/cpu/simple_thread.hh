@@ -280,12 +280,16 @@ class SimpleThread : public ThreadState, public ThreadContext
     void
     setMiscRegNoEffect(RegIndex misc_reg, RegVal val) override
     {
+        // Misc regs hold the state translations depend on, e.g., the
+        // execution mode.
+        mmu->translationsChanged();
         return isa->setMiscRegNoEffect(misc_reg, val);
     }
 
     void
     setMiscReg(RegIndex misc_reg, RegVal val) override
     {
+        mmu->translationsChanged();
         return isa->setMiscReg(misc_reg, val);
     }
 
@@ -35,6 +35,8 @@
 namespace gem5
 {
 
+thread_local bool StaticInst::constructShared = false;
+
 StaticInstPtr
 StaticInst::fetchMicroop(MicroPC upc) const
 {
@@ -97,6 +97,12 @@ class StaticInst : public RefCounted, public StaticInstFlags
     /// See destRegIdx().
     RegIdArrayPtr _destRegIdxPtr = nullptr;
 
+    /// Instructions constructed within a SharedScope, see isShared().
+    static thread_local bool constructShared;
+
+    /// See isShared().
+    const bool _shared = constructShared;
+
   protected:
 
     /// Flag values for this instruction.
@@ -288,6 +294,32 @@ class StaticInst : public RefCounted, public StaticInstFlags
   public:
     virtual ~StaticInst() {};
 
+    /**
+     * While an instance of this class is live, every instruction
+     * constructed by the current thread (including the microops of
+     * a macroop) is marked as shared.
+     */
+    class SharedScope
+    {
+      private:
+        bool prev;
+
+      public:
+        SharedScope() : prev(constructShared) { constructShared = true; }
+        ~SharedScope() { constructShared = prev; }
+    };
+
+    /**
+     * Shared instructions may be referenced from several event queue
+     * threads at once (see SharedDecodeCache). Since the reference count
+     * in RefCounted isn't thread safe, it is never updated for these
+     * instructions and they live until the simulator exits.
+     */
+    bool isShared() const { return _shared; }
+
+    void incref() const { if (!_shared) RefCounted::incref(); }
+    void decref() const { if (!_shared) RefCounted::decref(); }
+
     virtual Fault execute(ExecContext *xc,
             trace::InstRecord *traceData) const = 0;
 
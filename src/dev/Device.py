@@ -112,6 +112,13 @@ class DmaDevice(PioDevice):
         "several devices attached to it",
     )
 
+    dma_burst_packets = Param.Unsigned(
+        1, "Number of DMA packets sent back to back in one cycle"
+    )
+    dma_max_pending = Param.Unsigned(
+        0, "Maximum number of outstanding DMA packets, 0 for no limit"
+    )
+
     def addIommuProperty(self, state, node):
         """
         This method takes an FdtState and a FdtNode as parameters, and
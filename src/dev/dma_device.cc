@@ -49,6 +49,8 @@
 #include "base/trace.hh"
 #include "debug/DMA.hh"
 #include "debug/Drain.hh"
+#include "mem/abstract_mem.hh"
+#include "mem/physical.hh"
 #include "sim/clocked_object.hh"
 #include "sim/system.hh"
 
@@ -63,6 +65,15 @@ DmaPort::DmaPort(ClockedObject *dev, System *s,
       defaultSid(sid), defaultSSid(ssid), cacheLineSize(s->cacheLineSize())
 { }
 
+void
+DmaPort::setBursts(unsigned int burst_packets, unsigned int max_pending)
+{
+    fatal_if(burst_packets == 0, "%s: DMA bursts need at least one packet.",
+             name());
+    burstPackets = burst_packets;
+    maxPending = max_pending;
+}
+
 void
 DmaPort::handleRespPacket(PacketPtr pkt, Tick delay)
 {
@@ -119,6 +130,13 @@ DmaPort::handleResp(DmaReqState *state, Addr addr, Addr size, Tick delay)
         delete state;
     }
 
+    // Resume sending if it was held back by the outstanding packets.
+    if (pendingLimited) {
+        pendingLimited = false;
+        if (!transmitList.empty() && !retryPending && !sendEvent.scheduled())
+            device->schedule(sendEvent, device->clockEdge());
+    }
+
     // We might be drained at this point, if so signal the drain event.
     if (pendingCount == 0)
         signalDrainDone();
@@ -156,7 +174,9 @@ DmaPort::recvTimingResp(PacketPtr pkt)
 
 DmaDevice::DmaDevice(const Params &p)
     : PioDevice(p), dmaPort(this, sys, p.sid, p.ssid)
-{ }
+{
+    dmaPort.setBursts(p.dma_burst_packets, p.dma_max_pending);
+}
 
 void
 DmaDevice::init()
@@ -245,6 +265,7 @@ DmaPort::abortPending()
 
     if (sendEvent.scheduled())
         device->deschedule(sendEvent);
+    pendingLimited = false;
 
     if (pendingCount == 0)
         signalDrainDone();
@@ -253,40 +274,52 @@ DmaPort::abortPending()
 void
 DmaPort::trySendTimingReq()
 {
-    // Send the next packet for the first DMA request on the transmit list,
-    // and schedule the following send if it is successful
-    DmaReqState *state = transmitList.front();
+    // Send a burst of packets for the DMA requests on the transmit list,
+    // and schedule the following burst if it is successful
+    bool more = true;
+    for (unsigned int sent = 0; more && sent < burstPackets; sent++) {
+        if (maxPending && pendingCount >= maxPending) {
+            DPRINTF(DMA, "-- %d packets outstanding, waiting\n",
+                    pendingCount);
+            pendingLimited = true;
+            more = false;
+            break;
+        }
 
-    PacketPtr pkt = inRetry ? inRetry : state->createPacket();
-    inRetry = nullptr;
+        DmaReqState *state = transmitList.front();
 
-    DPRINTF(DMA, "Trying to send %s addr %#x\n", pkt->cmdString(),
-            pkt->getAddr());
+        PacketPtr pkt = inRetry ? inRetry : state->createPacket();
+        inRetry = nullptr;
+
+        DPRINTF(DMA, "Trying to send %s addr %#x\n", pkt->cmdString(),
+                pkt->getAddr());
+
+        // Check if this was the last packet now, since hypothetically the
+        // packet response may come immediately, and state may be deleted.
+        bool last = state->gen.last();
+        if (!sendTimingReq(pkt)) {
+            retryPending = true;
+            inRetry = pkt;
+            DPRINTF(DMA, "-- Failed, waiting for retry\n");
+            more = false;
+            break;
+        }
 
-    // Check if this was the last packet now, since hypothetically the packet
-    // response may come immediately, and state may be deleted.
-    bool last = state->gen.last();
-    if (sendTimingReq(pkt)) {
         pendingCount++;
-    } else {
-        retryPending = true;
-        inRetry = pkt;
-    }
-    if (!retryPending) {
         state->gen.next();
         // If that was the last packet from this request, pop it from the list.
         if (last)
             transmitList.pop_front();
         DPRINTF(DMA, "-- Done\n");
-        // If there is more to do, then do so.
-        if (!transmitList.empty()) {
-            // This should ultimately wait for as many cycles as the device
-            // needs to send the packet, but currently the port does not have
-            // any known width so simply wait a single cycle.
-            device->schedule(sendEvent, device->clockEdge(Cycles(1)));
-        }
-    } else {
-        DPRINTF(DMA, "-- Failed, waiting for retry\n");
+        more = !transmitList.empty();
+    }
+
+    // If there is more to do, then do so.
+    if (more) {
+        // This should ultimately wait for as many cycles as the device
+        // needs to send the burst, but currently the port does not have
+        // any known width so simply wait a single cycle.
+        device->schedule(sendEvent, device->clockEdge(Cycles(1)));
     }
 
     DPRINTF(DMA, "TransmitList: %d, retryPending: %d\n",
@@ -315,6 +348,28 @@ DmaPort::sendAtomicBdReq(DmaReqState *state)
     pendingCount++;
 
     auto bd_it = memBackdoors.contains(state->gen.addr());
+    const memory::AbstractMemory *mem = bd_it == memBackdoors.end() ?
+        sys->getPhysMem().findMemory(state->gen.addr()) : nullptr;
+    if (mem && !mem->getAddrRange().interleaved()) {
+        // Ask for a backdoor covering as much of the rest of the transfer
+        // as the memory holding the current address does, so that it can
+        // be handled in as few steps as possible. A range spanning several
+        // memories couldn't be routed.
+        const AddrRange mem_range = mem->getAddrRange();
+        const Addr end = std::min<Addr>(mem_range.end(),
+                state->gen.addr() + state->totBytes - state->gen.complete());
+        MemBackdoorPtr bd = nullptr;
+        sendMemBackdoorReq(MemBackdoorReq(
+                    AddrRange(state->gen.addr(), end),
+                    MemCmd(state->cmd).isRead() ? MemBackdoor::Readable :
+                                                  MemBackdoor::Writeable),
+                bd);
+        if (bd) {
+            addBackdoor(bd);
+            bd_it = memBackdoors.contains(state->gen.addr());
+        }
+    }
+
     if (bd_it == memBackdoors.end()) {
         // We don't have a backdoor for this address, so use a packet.
 
@@ -326,20 +381,8 @@ DmaPort::sendAtomicBdReq(DmaReqState *state)
         Tick lat = sendAtomicBackdoor(pkt, bd);
 
         // If we got a backdoor, record it.
-        if (bd && memBackdoors.insert(bd->range(), bd) != memBackdoors.end()) {
-            // Invalidation callback which finds this backdoor and removes it.
-            auto callback = [this](const MemBackdoor &backdoor) {
-                for (auto it = memBackdoors.begin();
-                        it != memBackdoors.end(); it++) {
-                    if (it->second == &backdoor) {
-                        memBackdoors.erase(it);
-                        return;
-                    }
-                }
-                panic("Got invalidation for unknown memory backdoor.");
-            };
-            bd->addInvalidationCallback(callback);
-        }
+        if (bd)
+            addBackdoor(bd);
 
         // Check if we're done now, since handleResp may delete state.
         done = !state->gen.next();
@@ -381,6 +424,29 @@ DmaPort::sendAtomicBdReq(DmaReqState *state)
     return done;
 }
 
+void
+DmaPort::addBackdoor(MemBackdoorPtr bd)
+{
+    // Interleaved memory isn't contiguous in the backdoor.
+    if (bd->range().interleaved() ||
+            memBackdoors.insert(bd->range(), bd) == memBackdoors.end()) {
+        return;
+    }
+
+    // Invalidation callback which finds this backdoor and removes it.
+    auto callback = [this](const MemBackdoor &backdoor) {
+        for (auto it = memBackdoors.begin();
+                it != memBackdoors.end(); it++) {
+            if (it->second == &backdoor) {
+                memBackdoors.erase(it);
+                return;
+            }
+        }
+        panic("Got invalidation for unknown memory backdoor.");
+    };
+    bd->addInvalidationCallback(callback);
+}
+
 void
 DmaPort::sendDma()
 {
@@ -64,9 +64,11 @@ class DmaPort : public RequestPort, public Drainable
     AddrRangeMap<MemBackdoorPtr, 1> memBackdoors;
 
     /**
-     * Take the first request on the transmit list and attempt to send a timing
-     * packet from it. If it is successful, schedule the sending of the next
-     * packet. Otherwise remember that we are waiting for a retry.
+     * Take the first request on the transmit list and attempt to send a
+     * burst of timing packets from it, and from the following requests if
+     * it runs out. If it is successful, schedule the sending of the next
+     * burst. Otherwise remember that we are waiting for a retry, or for
+     * outstanding packets to complete.
      */
     void trySendTimingReq();
 
@@ -138,6 +140,8 @@ class DmaPort : public RequestPort, public Drainable
      * and/or use memory backdoors if possible.
      */
     bool sendAtomicBdReq(DmaReqState *state);
+    /** Record a memory backdoor and forget it when it is invalidated. */
+    void addBackdoor(MemBackdoorPtr bd);
 
     /**
      * Handle a response packet by updating the corresponding DMA
@@ -181,6 +185,13 @@ class DmaPort : public RequestPort, public Drainable
      */
     bool retryPending = false;
 
+    /** Number of packets sent back to back in one cycle. */
+    unsigned int burstPackets = 1;
+    /** Maximum number of outstanding packets, 0 for no limit. */
+    unsigned int maxPending = 0;
+    /** Whether sending is held back until outstanding packets complete. */
+    bool pendingLimited = false;
+
     /** Default streamId */
     const uint32_t defaultSid;
 
@@ -198,6 +209,16 @@ class DmaPort : public RequestPort, public Drainable
 
     DmaPort(ClockedObject *dev, System *s, uint32_t sid=0, uint32_t ssid=0);
 
+    /**
+     * Send the packets of timing transfers in bursts.
+     *
+     * @param burst_packets Number of packets sent back to back in one
+     *                      cycle.
+     * @param max_pending Maximum number of outstanding packets, 0 for
+     *                    no limit.
+     */
+    void setBursts(unsigned int burst_packets, unsigned int max_pending);
+
     void
     dmaAction(Packet::Command cmd, Addr addr, int size, Event *event,
               uint8_t *data, Tick delay, Request::Flags flag=0);
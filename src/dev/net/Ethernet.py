@@ -67,6 +67,18 @@ class EtherLink(SimObject):
     delay_var = Param.Latency("0ns", "packet transmit delay variability")
     speed = Param.NetworkBandwidth("1Gbps", "link speed")
     dump = Param.EtherDump(NULL, "dump object")
+    int0_eventq_index = Param.UInt32(
+        Self.eventq_index,
+        "Event queue of the device on int0. If the ends of the link are "
+        "on different queues, delay must be at least the sim quantum",
+    )
+    int1_eventq_index = Param.UInt32(
+        Self.eventq_index, "Event queue of the device on int1"
+    )
+
+
+class DistTransport(Enum):
+    vals = ["tcp", "shm"]
 
 
 class DistEtherLink(SimObject):
@@ -88,6 +100,19 @@ class DistEtherLink(SimObject):
     is_switch = Param.Bool(False, "true if this a link in etherswitch")
     dist_sync_on_pseudo_op = Param.Bool(False, "Start sync with pseudo_op")
     num_nodes = Param.UInt32("2", "Number of simulate nodes")
+    transport = Param.DistTransport(
+        "tcp",
+        "Transport between the gem5 processes, shm only works when they "
+        "all run on the same host",
+    )
+    shm_name = Param.String(
+        "gem5-dist",
+        "Prefix of the shared memory segments (shm transport), unique to "
+        "each simulation on the host",
+    )
+    shm_ring_size = Param.MemorySize(
+        "4MiB", "Size of the ring in each direction (shm transport)"
+    )
 
 
 class EtherBus(SimObject):
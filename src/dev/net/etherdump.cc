@@ -102,6 +102,7 @@ EtherDump::dumpPacket(EthPacketPtr &packet)
     pkthdr.microseconds = (curTick() / sim_clock::as_int::us) % 1000000ULL;
     pkthdr.caplen = std::min(packet->length, maxlen);
     pkthdr.len = packet->length;
+    std::lock_guard<std::mutex> guard(lock);
     stream->write(reinterpret_cast<char *>(&pkthdr), sizeof(pkthdr));
     stream->write(reinterpret_cast<char *>(packet->data), pkthdr.caplen);
     stream->flush();
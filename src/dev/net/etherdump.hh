@@ -34,6 +34,7 @@
 #define __DEV_NET_ETHERDUMP_HH__
 
 #include <fstream>
+#include <mutex>
 
 #include "dev/net/etherpkt.hh"
 #include "params/EtherDump.hh"
@@ -50,6 +51,8 @@ class EtherDump : public SimObject
   private:
     std::ostream *stream;
     const unsigned maxlen;
+    /** The links of a dump may send packets from different threads. */
+    std::mutex lock;
     void dumpPacket(EthPacketPtr &packet);
     void init();
 
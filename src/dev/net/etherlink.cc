@@ -69,10 +69,12 @@ namespace gem5
 EtherLink::EtherLink(const Params &p)
     : SimObject(p)
 {
+    EventQueue *eventq0 = getEventQueue(p.int0_eventq_index);
+    EventQueue *eventq1 = getEventQueue(p.int1_eventq_index);
     link[0] = new Link(name() + ".link0", this, 0, p.speed,
-                       p.delay, p.delay_var, p.dump);
+                       p.delay, p.delay_var, p.dump, eventq0, eventq1);
     link[1] = new Link(name() + ".link1", this, 1, p.speed,
-                       p.delay, p.delay_var, p.dump);
+                       p.delay, p.delay_var, p.dump, eventq1, eventq0);
 
     interface[0] = new Interface(name() + ".int0", link[0], link[1]);
     interface[1] = new Interface(name() + ".int1", link[1], link[0]);
@@ -98,6 +100,17 @@ EtherLink::getPort(const std::string &if_name, PortID idx)
     return SimObject::getPort(if_name, idx);
 }
 
+void
+EtherLink::startup()
+{
+    for (auto l: link) {
+        fatal_if(l->crossing() && l->delay() < simQuantum,
+                 "%s: The ends of the link are on different event queues, "
+                 "so its delay (%d) can't be shorter than the simulation "
+                 "quantum (%d).", name(), l->delay(), simQuantum);
+    }
+}
+
 
 EtherLink::Interface::Interface(const std::string &name, Link *tx, Link *rx)
     : EtherInt(name), txlink(tx)
@@ -107,9 +120,11 @@ EtherLink::Interface::Interface(const std::string &name, Link *tx, Link *rx)
 }
 
 EtherLink::Link::Link(const std::string &name, EtherLink *p, int num,
-                      double rate, Tick delay, Tick delay_var, EtherDump *d)
+                      double rate, Tick delay, Tick delay_var, EtherDump *d,
+                      EventQueue *tx_eventq, EventQueue *rx_eventq)
     : objName(name), parent(p), number(num), txint(NULL), rxint(NULL),
       ticksPerByte(rate), linkDelay(delay), delayVar(delay_var), dump(d),
+      txEventq(tx_eventq), rxEventq(rx_eventq),
       doneEvent([this]{ txDone(); }, name),
       txQueueEvent([this]{ processTxQueue(); }, name)
 { }
@@ -142,11 +157,15 @@ EtherLink::Link::txDone()
     if (dump)
         dump->dump(packet);
 
-    if (linkDelay > 0) {
+    if (crossing()) {
+        DPRINTF(Ethernet, "packet crossing: delay=%d\n", linkDelay);
+        crossQueue.push(std::make_pair(curTick() + linkDelay, packet));
+        scheduleCrossing(curTick() + linkDelay);
+    } else if (linkDelay > 0) {
         DPRINTF(Ethernet, "packet delayed: delay=%d\n", linkDelay);
         txQueue.emplace_back(std::make_pair(curTick() + linkDelay, packet));
         if (!txQueueEvent.scheduled())
-            parent->schedule(txQueueEvent, txQueue.front().first);
+            rxEventq->schedule(&txQueueEvent, txQueue.front().first);
     } else {
         assert(txQueue.empty());
         txComplete(packet);
@@ -168,13 +187,35 @@ EtherLink::Link::processTxQueue()
     if (!txQueue.empty()) {
         auto next(txQueue.front());
         assert(next.first > curTick());
-        parent->schedule(txQueueEvent, next.first);
+        rxEventq->schedule(&txQueueEvent, next.first);
     }
 
     assert(cur.first == curTick());
     txComplete(cur.second);
 }
 
+void
+EtherLink::Link::scheduleCrossing(Tick when)
+{
+    // Packets are delivered in order, one per event, so the event
+    // doesn't need to know which packet it delivers. Scheduling it as a
+    // global event has the receiving queue take it at the end of the
+    // quantum, which keeps the simulation deterministic.
+    rxEventq->schedule(new EventFunctionWrapper(
+                [this]{ processCrossQueue(); }, objName, true),
+            when, true);
+}
+
+void
+EtherLink::Link::processCrossQueue()
+{
+    std::pair<Tick, EthPacketPtr> cur;
+    [[maybe_unused]] bool popped = crossQueue.pop(cur);
+    assert(popped);
+    assert(cur.first == curTick());
+    txComplete(cur.second);
+}
+
 bool
 EtherLink::Link::transmit(EthPacketPtr pkt)
 {
@@ -193,7 +234,7 @@ EtherLink::Link::transmit(EthPacketPtr pkt)
 
     DPRINTF(Ethernet, "scheduling packet: delay=%d, (rate=%f)\n",
             delay, ticksPerByte);
-    parent->schedule(doneEvent, curTick() + delay);
+    txEventq->schedule(&doneEvent, curTick() + delay);
 
     return true;
 }
@@ -213,10 +254,18 @@ EtherLink::Link::serialize(const std::string &base, CheckpointOut &cp) const
         paramOut(cp, base + ".event_time", event_time);
     }
 
-    const size_t tx_queue_size(txQueue.size());
+    // Packets crossing between event queues are saved as delayed ones,
+    // so checkpoints don't depend on the threads used.
+    std::vector<std::pair<Tick, EthPacketPtr>> in_flight(
+            txQueue.begin(), txQueue.end());
+    crossQueue.forEach([&in_flight](const auto &pe) {
+        in_flight.push_back(pe);
+    });
+
+    const size_t tx_queue_size(in_flight.size());
     paramOut(cp, base + ".tx_queue_size", tx_queue_size);
     unsigned idx(0);
-    for (const auto &pe : txQueue) {
+    for (const auto &pe : in_flight) {
         paramOut(cp, csprintf("%s.txQueue[%i].tick", base, idx), pe.first);
         pe.second->serialize(csprintf("%s.txQueue[%i].packet", base, idx), cp);
 
@@ -239,11 +288,12 @@ EtherLink::Link::unserialize(const std::string &base, CheckpointIn &cp)
     if (event_scheduled) {
         Tick event_time;
         paramIn(cp, base + ".event_time", event_time);
-        parent->schedule(doneEvent, event_time);
+        txEventq->schedule(&doneEvent, event_time);
     }
 
     size_t tx_queue_size = 0;
     if (optParamIn(cp, base + ".tx_queue_size", tx_queue_size)) {
+        Tick last_tick = 0;
         for (size_t idx = 0; idx < tx_queue_size; ++idx) {
             Tick tick;
             EthPacketPtr delayed_packet = std::make_shared<EthPacketData>();
@@ -252,13 +302,19 @@ EtherLink::Link::unserialize(const std::string &base, CheckpointIn &cp)
             delayed_packet->unserialize(
                 csprintf("%s.txQueue[%i].packet", base, idx), cp);
 
-            fatal_if(!txQueue.empty() && txQueue.back().first > tick,
+            fatal_if(tick < last_tick,
                      "Invalid txQueue packet order in EtherLink!\n");
-            txQueue.emplace_back(std::make_pair(tick, delayed_packet));
+            last_tick = tick;
+            if (crossing()) {
+                crossQueue.push(std::make_pair(tick, delayed_packet));
+                scheduleCrossing(tick);
+            } else {
+                txQueue.emplace_back(std::make_pair(tick, delayed_packet));
+            }
         }
 
         if (!txQueue.empty())
-            parent->schedule(txQueueEvent, txQueue.front().first);
+            rxEventq->schedule(&txQueueEvent, txQueue.front().first);
     } else {
         // We can't reliably convert in-flight packets from old
         // checkpoints. In fact, gem5 hasn't been able to load these
@@ -48,6 +48,7 @@
 #include <queue>
 #include <utility>
 
+#include "base/spsc_queue.hh"
 #include "base/types.hh"
 #include "dev/net/etherint.hh"
 #include "dev/net/etherpkt.hh"
@@ -87,6 +88,13 @@ class EtherLink : public SimObject
         const Tick delayVar;
         EtherDump *const dump;
 
+        /**
+         * Event queues of the sending and receiving ends, which may be
+         * serviced by different threads.
+         */
+        EventQueue *const txEventq;
+        EventQueue *const rxEventq;
+
       protected:
         /*
          * Transfer is complete
@@ -105,15 +113,34 @@ class EtherLink : public SimObject
         void processTxQueue();
         EventFunctionWrapper txQueueEvent;
 
+        /**
+         * In-flight packets when the ends are on different event
+         * queues. The sending thread appends packets, and schedules an
+         * event on the receiving queue to deliver each of them. The
+         * link delay is the lookahead: it must be at least a simulation
+         * quantum, so that the receiving queue gets the event before it
+         * is due.
+         */
+        SpscQueue<std::pair<Tick, EthPacketPtr>> crossQueue;
+
+        /** Schedule the delivery of a packet through crossQueue. */
+        void scheduleCrossing(Tick when);
+        void processCrossQueue();
+
         void txComplete(EthPacketPtr packet);
 
       public:
         Link(const std::string &name, EtherLink *p, int num,
-             double rate, Tick delay, Tick delay_var, EtherDump *dump);
+             double rate, Tick delay, Tick delay_var, EtherDump *dump,
+             EventQueue *tx_eventq, EventQueue *rx_eventq);
         ~Link() {}
 
         const std::string name() const { return objName; }
 
+        /** Whether the ends of the link are on different event queues. */
+        bool crossing() const { return txEventq != rxEventq; }
+        Tick delay() const { return linkDelay; }
+
         bool busy() const { return (bool)packet; }
         bool transmit(EthPacketPtr packet);
 
@@ -150,6 +177,8 @@ class EtherLink : public SimObject
     Port &getPort(const std::string &if_name,
                   PortID idx=InvalidPortID) override;
 
+    void startup() override;
+
     void serialize(CheckpointOut &cp) const override;
     void unserialize(CheckpointIn &cp) override;
 
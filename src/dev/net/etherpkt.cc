@@ -29,6 +29,7 @@
 #include "dev/net/etherpkt.hh"
 
 #include <iostream>
+#include <vector>
 
 #include "base/inet.hh"
 #include "base/logging.hh"
@@ -37,6 +38,116 @@
 namespace gem5
 {
 
+namespace
+{
+
+struct BufferPool
+{
+    /** Size of the buffers. */
+    unsigned size;
+    /** Number of free buffers kept per thread. */
+    size_t maxFree;
+};
+
+const BufferPool bufferPools[] = {
+    // Standard frames, including VLAN tags
+    { 2 * 1024, 1024 },
+    // Jumbo frames, and the transmit buffers of the devices
+    { 16 * 1024, 256 },
+    // Frames offloading segmentation (TSO/GSO), up to 64KiB of payload
+    { 128 * 1024, 32 },
+};
+
+const int numBufferPools = sizeof(bufferPools) / sizeof(bufferPools[0]);
+
+/** Set when the free lists of this thread are gone, at thread exit. */
+thread_local bool freeListsDestroyed = false;
+
+/**
+ * Free buffers of each pool. Buffers freed by a thread go to its own
+ * lists, whichever thread allocated them.
+ */
+struct FreeLists
+{
+    std::vector<uint8_t *> lists[numBufferPools];
+
+    ~FreeLists()
+    {
+        freeListsDestroyed = true;
+        for (auto &list: lists) {
+            for (auto buf: list)
+                delete [] buf;
+        }
+    }
+};
+
+FreeLists &
+freeLists()
+{
+    thread_local FreeLists lists;
+    return lists;
+}
+
+int
+bufferPool(unsigned size)
+{
+    for (int i = 0; i < numBufferPools; i++) {
+        if (size <= bufferPools[i].size)
+            return i;
+    }
+    return -1;
+}
+
+uint8_t *
+allocBuffer(unsigned size, unsigned &alloc_length)
+{
+    const int pool = bufferPool(size);
+    if (pool < 0) {
+        alloc_length = size;
+        return new uint8_t[size];
+    }
+
+    alloc_length = bufferPools[pool].size;
+    if (!freeListsDestroyed) {
+        auto &list = freeLists().lists[pool];
+        if (!list.empty()) {
+            uint8_t *buf = list.back();
+            list.pop_back();
+            return buf;
+        }
+    }
+    return new uint8_t[alloc_length];
+}
+
+void
+freeBuffer(uint8_t *buf, unsigned alloc_length)
+{
+    const int pool = bufferPool(alloc_length);
+    if (pool >= 0 && bufferPools[pool].size == alloc_length &&
+            !freeListsDestroyed) {
+        auto &list = freeLists().lists[pool];
+        if (list.size() < bufferPools[pool].maxFree) {
+            list.push_back(buf);
+            return;
+        }
+    }
+    delete [] buf;
+}
+
+} // anonymous namespace
+
+EthPacketData::EthPacketData(unsigned size)
+    : bufLength(size), length(0), simLength(0)
+{
+    data = allocBuffer(size, allocLength);
+}
+
+EthPacketData::~EthPacketData()
+{
+    if (data)
+        freeBuffer(data, allocLength);
+}
+
 void
 EthPacketData::serialize(const std::string &base, CheckpointOut &cp) const
 {
@@ -65,7 +176,7 @@ EthPacketData::unserialize(const std::string &base, CheckpointIn &cp)
     }
     assert(length <= bufLength);
     if (!data)
-        data = new uint8_t[bufLength];
+        data = allocBuffer(bufLength, allocLength);
     arrayParamIn(cp, base + ".data", data, length);
     if (!optParamIn(cp, base + ".simLength", simLength))
         simLength = length;
@@ -77,14 +77,30 @@ class EthPacketData
         : data(nullptr), bufLength(0), length(0), simLength(0)
     { }
 
-    explicit EthPacketData(unsigned size)
-        : data(new uint8_t[size]), bufLength(size), length(0), simLength(0)
-    { }
+    /**
+     * Allocate a data buffer of at least size bytes. Buffers come from
+     * per-thread pools of standard frames (2KiB), jumbo frames (16KiB)
+     * and TSO frames (128KiB), so devices can allocate a buffer per
+     * frame cheaply. Packets are shared through EthPacketPtr, so the
+     * buffer is filled once and never copied by the links, switches and
+     * dumps it goes through.
+     */
+    explicit EthPacketData(unsigned size);
+
+    EthPacketData(const EthPacketData &) = delete;
+    EthPacketData &operator=(const EthPacketData &) = delete;
 
-    ~EthPacketData() { if (data) delete [] data; }
+    ~EthPacketData();
 
     void serialize(const std::string &base, CheckpointOut &cp) const;
     void unserialize(const std::string &base, CheckpointIn &cp);
+
+  private:
+    /**
+     * Size of the buffer actually allocated, which is the size of its
+     * pool and may be larger than bufLength.
+     */
+    unsigned allocLength = 0;
 };
 
 typedef std::shared_ptr<EthPacketData> EthPacketPtr;
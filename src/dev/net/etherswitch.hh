@@ -51,6 +51,11 @@
 namespace gem5
 {
 
+/**
+ * Ethernet switch. All its ports are handled on the event queue of the
+ * switch: devices simulated on other event queues (threads) connect to
+ * it through EtherLinks whose ends are on different queues.
+ */
 class EtherSwitch : public SimObject
 {
   public:
@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Shared memory interface for dist-gem5 simulations.
+ */
+
+#include "dev/net/shm_iface.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/DistEthernet.hh"
+#include "debug/DistEthernetCmd.hh"
+#include "sim/sim_exit.hh"
+
+namespace gem5
+{
+
+// "gem5dist" in little endian
+const uint64_t ShmIface::Magic = 0x74736964'356d6567ULL;
+
+std::vector<ShmRing *> ShmIface::txRegistry;
+
+ShmIface::ShmIface(std::string shm_name, uint64_t ring_size,
+                   unsigned dist_rank, unsigned dist_size,
+                   Tick sync_start, Tick sync_repeat,
+                   EventManager *em, bool use_pseudo_op, bool is_switch,
+                   int num_nodes) :
+    DistIface(dist_rank, dist_size, sync_start, sync_repeat, em, use_pseudo_op,
+              is_switch, num_nodes), shmName(shm_name), ringSize(ring_size),
+    isSwitch(is_switch)
+{
+    fatal_if(ringSize < sizeof(Header),
+             "The dist shared memory rings must hold at least a header.");
+}
+
+std::string
+ShmIface::segmentName(unsigned node_rank, unsigned iface_id) const
+{
+    return "/" + shmName + "." + std::to_string(node_rank) + "." +
+        std::to_string(iface_id);
+}
+
+size_t
+ShmIface::segmentBytes(uint64_t ring_size)
+{
+    return sizeof(Segment) + 2 * roundUp(ShmRing::footprint(ring_size), 64);
+}
+
+void
+ShmIface::createSegment()
+{
+    const std::string seg_name = segmentName(rank, distIfaceId);
+    segmentSize = segmentBytes(ringSize);
+
+    // Replace any segment left behind by a previous simulation.
+    shm_unlink(seg_name.c_str());
+    int fd = shm_open(seg_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    fatal_if(fd == -1, "Could not create the shared memory segment %s: %s\n",
+             seg_name, strerror(errno));
+    fatal_if(ftruncate(fd, segmentSize),
+             "Could not set the size of the shared memory segment %s\n",
+             seg_name);
+    void *addr = mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE,
+                      MAP_SHARED, fd, 0);
+    close(fd);
+    fatal_if(addr == MAP_FAILED, "Could not map the shared memory segment "
+             "%s: %s\n", seg_name, strerror(errno));
+
+    segment = new (addr) Segment;
+    segment->magic = Magic;
+    segment->rank = rank;
+    segment->distIfaceId = distIfaceId;
+    segment->distIfaceNum = distIfaceNum;
+    segment->ringSize = ringSize;
+    mapRings(true);
+    segment->ready.store(1, std::memory_order_release);
+}
+
+void
+ShmIface::attachSegment(const std::string &seg_name)
+{
+    DPRINTF(DistEthernet, "Waiting for shared memory segment %s\n",
+            seg_name);
+
+    // The compute node may not have created the segment yet, or may not
+    // have set its size.
+    int fd;
+    while ((fd = shm_open(seg_name.c_str(), O_RDWR, 0)) == -1) {
+        fatal_if(errno != ENOENT, "Could not open the shared memory "
+                 "segment %s: %s\n", seg_name, strerror(errno));
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    struct stat st;
+    do {
+        fatal_if(fstat(fd, &st), "Could not stat the shared memory "
+                 "segment %s: %s\n", seg_name, strerror(errno));
+        if (st.st_size == 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    } while (st.st_size == 0);
+
+    segmentSize = st.st_size;
+    void *addr = mmap(nullptr, segmentSize, PROT_READ | PROT_WRITE,
+                      MAP_SHARED, fd, 0);
+    close(fd);
+    fatal_if(addr == MAP_FAILED, "Could not map the shared memory segment "
+             "%s: %s\n", seg_name, strerror(errno));
+
+    segment = static_cast<Segment *>(addr);
+    while (!segment->ready.load(std::memory_order_acquire))
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+    fatal_if(segment->magic != Magic,
+             "%s is not a dist shared memory segment.", seg_name);
+    fatal_if(segmentSize != segmentBytes(segment->ringSize),
+             "Bad size for the shared memory segment %s.", seg_name);
+    if (segment->ringSize != ringSize) {
+        warn("Dist link of node %d uses %d byte rings, not %d.",
+             segment->rank, segment->ringSize, ringSize);
+        ringSize = segment->ringSize;
+    }
+    mapRings(false);
+
+    // Both processes have the segment mapped, so it doesn't need a name
+    // anymore, and goes away with them.
+    shm_unlink(seg_name.c_str());
+}
+
+void
+ShmIface::mapRings(bool create)
+{
+    uint8_t *to_switch = reinterpret_cast<uint8_t *>(segment + 1);
+    uint8_t *to_node = to_switch + roundUp(ShmRing::footprint(ringSize), 64);
+
+    if (create) {
+        txRing.create(to_switch, ringSize);
+        rxRing.create(to_node, ringSize);
+    } else {
+        fatal_if(!txRing.attach(to_node) || !rxRing.attach(to_switch),
+                 "Corrupted dist shared memory segment.");
+    }
+}
+
+void
+ShmIface::establishConnection()
+{
+    static unsigned cur_rank = 0;
+    static unsigned cur_id = 0;
+
+    if (isSwitch) {
+        // Links are assigned to the compute nodes in the same order as
+        // with TCP, so that each node is always on the same switch port.
+        attachSegment(segmentName(cur_rank, cur_id));
+        assert(segment->rank == cur_rank);
+        assert(segment->distIfaceId == cur_id);
+        inform("Link okay  (iface:%d -> (node:%d, iface:%d))",
+               distIfaceId, segment->rank, segment->distIfaceId);
+        if (segment->distIfaceId < segment->distIfaceNum - 1) {
+            cur_id++;
+        } else {
+            cur_rank++;
+            cur_id = 0;
+        }
+    } else { // this is not a switch
+        createSegment();
+        inform("Link okay  (iface:%d -> shared memory %s)", distIfaceId,
+               segmentName(rank, distIfaceId));
+    }
+    txRegistry.push_back(&txRing);
+}
+
+ShmIface::~ShmIface()
+{
+    // Let the other side and the receiver thread know the link is gone.
+    // The segment stays mapped, as the receiver thread is only joined by
+    // the DistIface destructor.
+    txRing.close();
+    rxRing.close();
+}
+
+void
+ShmIface::send(ShmRing &ring, const void *buf, unsigned length)
+{
+    if (!ring.write(buf, length)) {
+        exitSimLoop("Message server closed connection, simulation "
+                    "is exiting");
+    }
+}
+
+void
+ShmIface::sendPacket(const Header &header, const EthPacketPtr &packet)
+{
+    // Only the simulation thread sends messages, so each ring has a
+    // single writer.
+    send(txRing, &header, sizeof(header));
+    send(txRing, packet->data, packet->length);
+}
+
+void
+ShmIface::sendCmd(const Header &header)
+{
+    DPRINTF(DistEthernetCmd, "ShmIface::sendCmd() type: %d\n",
+            static_cast<int>(header.msgType));
+    // Global commands (i.e. sync request) are always sent by the primary
+    // DistIface, to all the links of this process.
+    for (auto ring: txRegistry)
+        send(*ring, &header, sizeof(header));
+}
+
+bool
+ShmIface::recvHeader(Header &header)
+{
+    bool ret = rxRing.read(&header, sizeof(header));
+    if (!ret)
+        inform("Shared memory link closed");
+    DPRINTF(DistEthernetCmd, "ShmIface::recvHeader() type: %d ret: %d\n",
+            static_cast<int>(header.msgType), ret);
+    return ret;
+}
+
+void
+ShmIface::recvPacket(const Header &header, EthPacketPtr &packet)
+{
+    packet = std::make_shared<EthPacketData>(header.dataPacketLength);
+    bool ret = rxRing.read(packet->data, header.dataPacketLength);
+    panic_if(!ret, "Error while reading shared memory link");
+    packet->simLength = header.simLength;
+    packet->length = header.dataPacketLength;
+}
+
+void
+ShmIface::initTransport()
+{
+    // As with TCP, the segments can only be set up once the number of
+    // dist interfaces in each process is known.
+    establishConnection();
+}
+
+} // namespace gem5
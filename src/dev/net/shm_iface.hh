@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Shared memory interface for dist-gem5 simulations.
+ *
+ * For a high level description about dist-gem5 see comments in
+ * header file dist_iface.hh.
+ *
+ * This transport replaces the TCP sockets of TCPIface when all the gem5
+ * processes run on the same host. Each dist link of a compute node
+ * creates a POSIX shared memory segment holding a ring for each
+ * direction, which the switch process maps. Sync messages travel over
+ * the same rings as data packets, and a process waiting for a message
+ * spins for a while before sleeping on a futex, so barriers don't go
+ * through the network stack.
+ */
+
+#ifndef __DEV_NET_SHM_IFACE_HH__
+#define __DEV_NET_SHM_IFACE_HH__
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "dev/net/dist_iface.hh"
+#include "dev/net/shm_ring.hh"
+
+namespace gem5
+{
+
+class EventManager;
+
+class ShmIface : public DistIface
+{
+  private:
+    /**
+     * Start of the shared memory segment of a link, followed by the
+     * ring to the switch and the ring to the compute node.
+     */
+    struct alignas(64) Segment
+    {
+        uint64_t magic;
+        /** Set once the rings are set up. */
+        std::atomic<uint32_t> ready;
+        unsigned rank;
+        unsigned distIfaceId;
+        unsigned distIfaceNum;
+        uint64_t ringSize;
+    };
+
+    static const uint64_t Magic;
+
+    std::string shmName;
+    uint64_t ringSize;
+
+    bool isSwitch;
+
+    /** The segment mapped by this link. */
+    Segment *segment = nullptr;
+    size_t segmentSize = 0;
+
+    /** Rings to send to and receive from the other side of the link. */
+    ShmRing txRing;
+    ShmRing rxRing;
+
+    /**
+     * Rings to send to from all the links in this process, for
+     * global commands.
+     */
+    static std::vector<ShmRing *> txRegistry;
+
+  private:
+    /** Name of the segment of a dist link of a compute node. */
+    std::string segmentName(unsigned node_rank, unsigned iface_id) const;
+
+    /** Size of a segment with rings of ring_size bytes. */
+    static size_t segmentBytes(uint64_t ring_size);
+
+    /** Create and set up the segment of this link (compute node). */
+    void createSegment();
+    /**
+     * Wait for the segment of a compute node link, and map it (switch).
+     */
+    void attachSegment(const std::string &seg_name);
+
+    /** Map the rings of the segment. */
+    void mapRings(bool create);
+
+    void send(ShmRing &ring, const void *buf, unsigned length);
+
+    void establishConnection();
+
+  protected:
+
+    void sendPacket(const Header &header,
+                    const EthPacketPtr &packet) override;
+
+    void sendCmd(const Header &header) override;
+
+    bool recvHeader(Header &header) override;
+
+    void recvPacket(const Header &header, EthPacketPtr &packet) override;
+
+    void initTransport() override;
+
+  public:
+    /**
+     * @param shm_name Prefix of the shared memory segment names, which
+     * must be the same for all the gem5 processes of the simulation.
+     * @param ring_size Capacity of the ring in each direction, in bytes.
+     * @param sync_start The tick for the first dist synchronisation.
+     * @param sync_repeat The frequency of dist synchronisation.
+     * @param em The EventManager object associated with the simulated
+     * Ethernet link.
+     */
+    ShmIface(std::string shm_name, uint64_t ring_size,
+             unsigned dist_rank, unsigned dist_size,
+             Tick sync_start, Tick sync_repeat, EventManager *em,
+             bool use_pseudo_op, bool is_switch, int num_nodes);
+
+    ~ShmIface() override;
+};
+
+} // namespace gem5
+
+#endif // __DEV_NET_SHM_IFACE_HH__
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Byte stream between processes through a ring in shared memory.
+ */
+
+#include "dev/net/shm_ring.hh"
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#endif
+
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <cstring>
+#include <new>
+#include <thread>
+
+namespace gem5
+{
+
+// "gem5shmr" in little endian
+const uint64_t ShmRing::Magic = 0x726d6873'356d6567ULL;
+
+namespace
+{
+
+/** Sleep until a word shared between processes changes from val. */
+void
+futexWait(std::atomic<uint32_t> &word, uint32_t val)
+{
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAIT,
+            val, nullptr, nullptr, 0);
+#else
+    if (word.load() == val)
+        std::this_thread::yield();
+#endif
+}
+
+/** Wake up whoever sleeps on a word shared between processes. */
+void
+futexWake(std::atomic<uint32_t> &word)
+{
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAKE,
+            INT_MAX, nullptr, nullptr, 0);
+#endif
+}
+
+} // anonymous namespace
+
+size_t
+ShmRing::footprint(size_t capacity)
+{
+    return sizeof(Shared) + capacity;
+}
+
+void
+ShmRing::create(void *mem, size_t _capacity)
+{
+    assert(_capacity > 0);
+
+    shared = new (mem) Shared;
+    shared->magic = Magic;
+    shared->capacity = _capacity;
+    shared->writePos = 0;
+    shared->writeSeq = 0;
+    shared->readerSleeping = 0;
+    shared->readPos = 0;
+    shared->readSeq = 0;
+    shared->writerSleeping = 0;
+    shared->closed = 0;
+
+    buffer = (uint8_t *)mem + sizeof(Shared);
+    capacity = _capacity;
+}
+
+bool
+ShmRing::attach(void *mem)
+{
+    if (((Shared *)mem)->magic != Magic)
+        return false;
+
+    shared = (Shared *)mem;
+    buffer = (uint8_t *)mem + sizeof(Shared);
+    capacity = shared->capacity;
+    return true;
+}
+
+template <class Ready>
+bool
+ShmRing::waitFor(std::atomic<uint32_t> &seq,
+                 std::atomic<uint32_t> &sleeping, Ready ready)
+{
+    for (unsigned spins = 0;; spins++) {
+        const uint32_t seen = seq.load(std::memory_order_seq_cst);
+        if (ready())
+            return true;
+        if (shared->closed.load(std::memory_order_acquire))
+            return ready();
+        if (spins < spinLimit)
+            continue;
+
+        // Ask to be woken up, and check again in case the other side
+        // made progress before seeing the request. If it makes progress
+        // after that, seq changes and the futex doesn't sleep.
+        sleeping.store(1, std::memory_order_seq_cst);
+        if (!ready() && !shared->closed.load(std::memory_order_seq_cst))
+            futexWait(seq, seen);
+        sleeping.store(0, std::memory_order_relaxed);
+    }
+}
+
+void
+ShmRing::notify(std::atomic<uint32_t> &seq, std::atomic<uint32_t> &sleeping)
+{
+    seq.fetch_add(1, std::memory_order_seq_cst);
+    if (sleeping.load(std::memory_order_seq_cst))
+        futexWake(seq);
+}
+
+bool
+ShmRing::write(const void *data, size_t len)
+{
+    const uint8_t *src = (const uint8_t *)data;
+    while (len) {
+        const uint64_t pos = shared->writePos.load(std::memory_order_relaxed);
+        uint64_t room = 0;
+        if (shared->closed.load(std::memory_order_acquire) ||
+                !waitFor(shared->readSeq, shared->writerSleeping, [&]() {
+                    room = capacity - (pos - shared->readPos.load(
+                                std::memory_order_acquire));
+                    return room > 0;
+                })) {
+            return false;
+        }
+
+        // Copy as much as fits, wrapping around the end of the buffer.
+        const size_t n = std::min<uint64_t>(len, room);
+        const size_t offset = pos % capacity;
+        const size_t first = std::min<size_t>(n, capacity - offset);
+        memcpy(buffer + offset, src, first);
+        memcpy(buffer, src + first, n - first);
+
+        shared->writePos.store(pos + n, std::memory_order_release);
+        notify(shared->writeSeq, shared->readerSleeping);
+        src += n;
+        len -= n;
+    }
+    return true;
+}
+
+bool
+ShmRing::read(void *data, size_t len)
+{
+    uint8_t *dst = (uint8_t *)data;
+    while (len) {
+        const uint64_t pos = shared->readPos.load(std::memory_order_relaxed);
+        uint64_t avail = 0;
+        if (!waitFor(shared->writeSeq, shared->readerSleeping, [&]() {
+                    avail = shared->writePos.load(
+                            std::memory_order_acquire) - pos;
+                    return avail > 0;
+                })) {
+            return false;
+        }
+
+        const size_t n = std::min<uint64_t>(len, avail);
+        const size_t offset = pos % capacity;
+        const size_t first = std::min<size_t>(n, capacity - offset);
+        memcpy(dst, buffer + offset, first);
+        memcpy(dst + first, buffer, n - first);
+
+        shared->readPos.store(pos + n, std::memory_order_release);
+        notify(shared->readSeq, shared->writerSleeping);
+        dst += n;
+        len -= n;
+    }
+    return true;
+}
+
+void
+ShmRing::close()
+{
+    if (!shared)
+        return;
+
+    shared->closed.store(1, std::memory_order_seq_cst);
+    notify(shared->writeSeq, shared->readerSleeping);
+    notify(shared->readSeq, shared->writerSleeping);
+}
+
+} // namespace gem5
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Byte stream between processes through a ring in shared memory.
+ */
+
+#ifndef __DEV_NET_SHM_RING_HH__
+#define __DEV_NET_SHM_RING_HH__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace gem5
+{
+
+/**
+ * Stream of bytes from one writer to one reader, possibly in different
+ * processes, through a ring buffer in shared memory.
+ *
+ * The writer and the reader only exchange their positions in the
+ * stream through atomics, so neither side ever takes a lock. A side
+ * that has to wait, because the ring is empty or full, spins for a
+ * while and then sleeps on a futex until the other side makes
+ * progress.
+ */
+class ShmRing
+{
+  private:
+    /** State of the ring shared between the writer and the reader. */
+    struct Shared
+    {
+        uint64_t magic;
+        uint64_t capacity;
+
+        /** Bytes written so far, and writes made. */
+        alignas(64) std::atomic<uint64_t> writePos;
+        std::atomic<uint32_t> writeSeq;
+        /** Whether the reader sleeps on writeSeq. */
+        std::atomic<uint32_t> readerSleeping;
+
+        /** Bytes read so far, and reads made. */
+        alignas(64) std::atomic<uint64_t> readPos;
+        std::atomic<uint32_t> readSeq;
+        /** Whether the writer sleeps on readSeq. */
+        std::atomic<uint32_t> writerSleeping;
+
+        alignas(64) std::atomic<uint32_t> closed;
+    };
+
+    static_assert(std::atomic<uint64_t>::is_always_lock_free &&
+                  std::atomic<uint32_t>::is_always_lock_free,
+                  "Shared memory rings need address-free atomics");
+
+    static const uint64_t Magic;
+
+    Shared *shared = nullptr;
+    uint8_t *buffer = nullptr;
+    uint64_t capacity = 0;
+
+    /** Number of polls before sleeping. */
+    const unsigned spinLimit;
+
+    /**
+     * Wait until a condition holds, or the ring is closed.
+     *
+     * @param seq Counter the other side bumps when it makes progress.
+     * @param sleeping Flag telling the other side to wake us up.
+     * @param ready Condition to wait for.
+     * @return Whether the condition holds.
+     */
+    template <class Ready>
+    bool waitFor(std::atomic<uint32_t> &seq,
+                 std::atomic<uint32_t> &sleeping, Ready ready);
+
+    /** Let the other side know about progress made. */
+    static void notify(std::atomic<uint32_t> &seq,
+                       std::atomic<uint32_t> &sleeping);
+
+  public:
+    /**
+     * @param spin_limit Number of times to poll the ring before
+     *                   sleeping.
+     */
+    ShmRing(unsigned spin_limit=4096) : spinLimit(spin_limit) {}
+
+    /** Size of the shared memory for a ring holding capacity bytes. */
+    static size_t footprint(size_t capacity);
+
+    /**
+     * Set up a new empty ring in shared memory.
+     *
+     * @param mem Shared memory of footprint(capacity) bytes, aligned to
+     *            a cache line.
+     * @param capacity Number of bytes the ring holds.
+     */
+    void create(void *mem, size_t capacity);
+    /**
+     * Use a ring another process set up in shared memory.
+     *
+     * @return false if mem doesn't hold a ring.
+     */
+    bool attach(void *mem);
+
+    /**
+     * Write to the ring, waiting for room as needed.
+     *
+     * @return false if the ring got closed.
+     */
+    bool write(const void *data, size_t len);
+    /**
+     * Read exactly len bytes from the ring, waiting for them as needed.
+     *
+     * @return false if the ring got closed before they were written.
+     */
+    bool read(void *data, size_t len);
+
+    /**
+     * Close the ring. Pending and future reads and writes fail, once
+     * the bytes already written have been read.
+     */
+    void close();
+};
+
+} // namespace gem5
+
+#endif // __DEV_NET_SHM_RING_HH__
@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "dev/net/shm_ring.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Cache line aligned memory for a ring. */
+std::unique_ptr<uint64_t[]>
+ringMemory(size_t capacity)
+{
+    return std::make_unique<uint64_t[]>(
+            (ShmRing::footprint(capacity) + 64) / sizeof(uint64_t));
+}
+
+void *
+aligned(const std::unique_ptr<uint64_t[]> &mem)
+{
+    uintptr_t addr = (uintptr_t)mem.get();
+    return (void *)((addr + 63) & ~(uintptr_t)63);
+}
+
+} // anonymous namespace
+
+/** Bytes come out of the ring in the order they went in. */
+TEST(ShmRingTest, ReadBackWrites)
+{
+    auto mem = ringMemory(16);
+    ShmRing writer, reader;
+    writer.create(aligned(mem), 16);
+    ASSERT_TRUE(reader.attach(aligned(mem)));
+
+    const char in[] = "hello ring";
+    char out[sizeof(in)] = {};
+    ASSERT_TRUE(writer.write(in, sizeof(in)));
+    ASSERT_TRUE(reader.read(out, sizeof(out)));
+    ASSERT_STREQ(in, out);
+}
+
+/** Writes and reads wrap around the end of the buffer. */
+TEST(ShmRingTest, WrapAround)
+{
+    auto mem = ringMemory(7);
+    ShmRing writer, reader;
+    writer.create(aligned(mem), 7);
+    ASSERT_TRUE(reader.attach(aligned(mem)));
+
+    for (uint8_t i = 0; i < 20; i++) {
+        const uint8_t in[5] = {i, uint8_t(i + 1), uint8_t(i + 2),
+                               uint8_t(i + 3), uint8_t(i + 4)};
+        uint8_t out[5] = {};
+        ASSERT_TRUE(writer.write(in, sizeof(in)));
+        ASSERT_TRUE(reader.read(out, sizeof(out)));
+        for (int j = 0; j < 5; j++)
+            ASSERT_EQ(in[j], out[j]);
+    }
+}
+
+/**
+ * Writing more than the ring holds blocks the writer until the reader
+ * catches up, sleeping on both sides.
+ */
+TEST(ShmRingTest, TwoThreads)
+{
+    const size_t capacity = 64;
+    auto mem = ringMemory(capacity);
+    ShmRing writer(16), reader(16);
+    writer.create(aligned(mem), capacity);
+    ASSERT_TRUE(reader.attach(aligned(mem)));
+
+    std::vector<uint32_t> in(100000);
+    std::iota(in.begin(), in.end(), 0);
+    std::thread producer([&]() {
+        for (size_t i = 0; i < in.size(); i += 1000)
+            ASSERT_TRUE(writer.write(&in[i], 1000 * sizeof(uint32_t)));
+    });
+
+    std::vector<uint32_t> out(in.size());
+    for (size_t i = 0; i < out.size(); i += 10)
+        ASSERT_TRUE(reader.read(&out[i], 10 * sizeof(uint32_t)));
+    producer.join();
+    ASSERT_EQ(in, out);
+}
+
+/**
+ * Closing the ring wakes up a waiting reader, which still gets what
+ * was written before.
+ */
+TEST(ShmRingTest, Close)
+{
+    auto mem = ringMemory(16);
+    ShmRing writer(16), reader(16);
+    writer.create(aligned(mem), 16);
+    ASSERT_TRUE(reader.attach(aligned(mem)));
+
+    const uint32_t in = 42;
+    ASSERT_TRUE(writer.write(&in, sizeof(in)));
+
+    std::thread closer([&]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        writer.close();
+    });
+
+    uint32_t out = 0;
+    ASSERT_TRUE(reader.read(&out, sizeof(out)));
+    ASSERT_EQ(in, out);
+    ASSERT_FALSE(reader.read(&out, sizeof(out)));
+    closer.join();
+
+    ASSERT_FALSE(writer.write(&in, sizeof(in)));
+}
+
+/** Attaching to memory which doesn't hold a ring fails. */
+TEST(ShmRingTest, AttachGarbage)
+{
+    auto mem = ringMemory(16);
+    ShmRing reader;
+    ASSERT_FALSE(reader.attach(aligned(mem)));
+}
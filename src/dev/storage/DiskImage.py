@@ -50,3 +50,20 @@ class CowDiskImage(DiskImage):
     child = Param.DiskImage(RawDiskImage(read_only=True), "child image")
     table_size = Param.Int(65536, "initial table size")
     image_file = ""
+
+
+class MmapCowDiskImage(DiskImage):
+    type = "MmapCowDiskImage"
+    cxx_header = "dev/storage/mmap_disk_image.hh"
+    cxx_class = "gem5::MmapCowDiskImage"
+    overlay_file = Param.String(
+        "",
+        "Sparse file holding the blocks written to, kept across "
+        "simulations, or empty for a temporary overlay",
+    )
+    block_size = Param.MemorySize("64KiB", "Copy-on-write granularity")
+    max_checkpoint_chain = Param.Unsigned(
+        8,
+        "Number of earlier checkpoints a checkpoint may build on by only "
+        "storing the blocks written to since, 0 to always store all of them",
+    )
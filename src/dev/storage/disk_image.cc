@@ -32,11 +32,14 @@
 
 #include "dev/storage/disk_image.hh"
 
+#include <fcntl.h>
 #include <sys/types.h>
 #include <sys/uio.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cerrno>
+#include <climits>
 #include <cstring>
 #include <fstream>
 #include <string>
@@ -53,12 +56,120 @@
 namespace gem5
 {
 
+////////////////////////////////////////////////////////////////////////
+//
+// Disk image
+//
+namespace
+{
+
+uint64_t
+iovSize(const struct iovec *iov, int iovcnt)
+{
+    uint64_t size = 0;
+    for (int i = 0; i < iovcnt; i++)
+        size += iov[i].iov_len;
+
+    if (size % SectorSize != 0)
+        panic("Unexpected request/sector size relationship\n");
+    return size;
+}
+
+} // anonymous namespace
+
+std::streampos
+DiskImage::readv(const struct iovec *iov, int iovcnt,
+                 std::streampos offset) const
+{
+    const uint64_t size = iovSize(iov, iovcnt);
+    uint64_t sector = offset;
+    int i = 0;
+    size_t pos = 0;
+
+    for (uint64_t done = 0; done < size; done += SectorSize, ++sector) {
+        while (pos == iov[i].iov_len) {
+            ++i;
+            pos = 0;
+        }
+
+        uint8_t *dst = (uint8_t *)iov[i].iov_base + pos;
+        if (iov[i].iov_len - pos >= SectorSize) {
+            if (read(dst, sector) != SectorSize)
+                return done;
+            pos += SectorSize;
+            continue;
+        }
+
+        // The sector straddles buffers, so scatter it from a copy.
+        uint8_t data[SectorSize];
+        if (read(data, sector) != SectorSize)
+            return done;
+        for (size_t copied = 0; copied < SectorSize;) {
+            while (pos == iov[i].iov_len) {
+                ++i;
+                pos = 0;
+            }
+            const size_t len = std::min<size_t>(SectorSize - copied,
+                                                iov[i].iov_len - pos);
+            memcpy((uint8_t *)iov[i].iov_base + pos, data + copied, len);
+            pos += len;
+            copied += len;
+        }
+    }
+
+    return size;
+}
+
+std::streampos
+DiskImage::writev(const struct iovec *iov, int iovcnt,
+                  std::streampos offset)
+{
+    const uint64_t size = iovSize(iov, iovcnt);
+    uint64_t sector = offset;
+    int i = 0;
+    size_t pos = 0;
+
+    for (uint64_t done = 0; done < size; done += SectorSize, ++sector) {
+        while (pos == iov[i].iov_len) {
+            ++i;
+            pos = 0;
+        }
+
+        const uint8_t *src = (const uint8_t *)iov[i].iov_base + pos;
+        if (iov[i].iov_len - pos >= SectorSize) {
+            if (write(src, sector) != SectorSize)
+                return done;
+            pos += SectorSize;
+            continue;
+        }
+
+        // The sector straddles buffers, so gather it into a copy.
+        uint8_t data[SectorSize];
+        for (size_t copied = 0; copied < SectorSize;) {
+            while (pos == iov[i].iov_len) {
+                ++i;
+                pos = 0;
+            }
+            const size_t len = std::min<size_t>(SectorSize - copied,
+                                                iov[i].iov_len - pos);
+            memcpy(data + copied, (const uint8_t *)iov[i].iov_base + pos,
+                   len);
+            pos += len;
+            copied += len;
+        }
+        if (write(data, sector) != SectorSize)
+            return done;
+    }
+
+    return size;
+}
+
 ////////////////////////////////////////////////////////////////////////
 //
 // Raw Disk image
 //
 RawDiskImage::RawDiskImage(const Params &p)
-    : DiskImage(p), disk_size(0)
+    : DiskImage(p), fd(-1), disk_size(0)
 {
     open(p.image_file, p.read_only);
 }
@@ -87,11 +198,8 @@ RawDiskImage::open(const std::string &filename, bool rd_only)
         readonly = rd_only;
         file = filename;
 
-        std::ios::openmode mode = std::ios::in | std::ios::binary;
-        if (!readonly)
-            mode |= std::ios::out;
-        stream.open(file.c_str(), mode);
-        if (!stream.is_open())
+        fd = ::open(file.c_str(), readonly ? O_RDONLY : O_RDWR);
+        if (fd < 0)
             panic("Error opening %s", filename);
     }
 }
@@ -99,17 +207,18 @@ RawDiskImage::open(const std::string &filename, bool rd_only)
 void
 RawDiskImage::close()
 {
-    stream.close();
+    if (fd >= 0)
+        ::close(fd);
+    fd = -1;
 }
 
 std::streampos
 RawDiskImage::size() const
 {
     if (disk_size == 0) {
-        if (!stream.is_open())
+        if (fd < 0)
             panic("file not open!\n");
-        stream.seekg(0, std::ios::end);
-        disk_size = stream.tellg();
+        disk_size = lseek(fd, 0, SEEK_END);
     }
 
     return disk_size / SectorSize;
@@ -121,20 +230,17 @@ RawDiskImage::read(uint8_t *data, std::streampos offset) const
     if (!initialized)
         panic("RawDiskImage not initialized");
 
-    if (!stream.is_open())
+    if (fd < 0)
         panic("file not open!\n");
 
-    stream.seekg(offset * SectorSize, std::ios::beg);
-    if (!stream.good())
-        panic("Could not seek to location in file");
-
-    std::streampos pos = stream.tellg();
-    stream.read((char *)data, SectorSize);
+    const ssize_t ret = pread(fd, data, SectorSize, offset * SectorSize);
+    if (ret < 0)
+        panic("Could not read from %s: %s", file, strerror(errno));
 
     DPRINTF(DiskImageRead, "read: offset=%d\n", (uint64_t)offset);
     DDUMP(DiskImageRead, data, SectorSize);
 
-    return stream.tellg() - pos;
+    return ret;
 }
 
 std::streampos
@@ -146,19 +252,65 @@ RawDiskImage::write(const uint8_t *data, std::streampos offset)
     if (readonly)
         panic("Cannot write to a read only disk image");
 
-    if (!stream.is_open())
+    if (fd < 0)
         panic("file not open!\n");
 
-    stream.seekp(offset * SectorSize, std::ios::beg);
-    if (!stream.good())
-        panic("Could not seek to location in file");
-
     DPRINTF(DiskImageWrite, "write: offset=%d\n", (uint64_t)offset);
     DDUMP(DiskImageWrite, data, SectorSize);
 
-    std::streampos pos = stream.tellp();
-    stream.write((const char *)data, SectorSize);
-    return stream.tellp() - pos;
+    const ssize_t ret = pwrite(fd, data, SectorSize, offset * SectorSize);
+    if (ret < 0)
+        panic("Could not write to %s: %s", file, strerror(errno));
+    return ret;
+}
+
+std::streampos
+RawDiskImage::readv(const struct iovec *iov, int iovcnt,
+                    std::streampos offset) const
+{
+    if (!initialized)
+        panic("RawDiskImage not initialized");
+
+    if (iovcnt > IOV_MAX)
+        return DiskImage::readv(iov, iovcnt, offset);
+
+    if (fd < 0)
+        panic("file not open!\n");
+
+    const ssize_t ret = preadv(fd, iov, iovcnt, offset * SectorSize);
+    if (ret < 0)
+        panic("Could not read from %s: %s", file, strerror(errno));
+
+    DPRINTF(DiskImageRead, "readv: offset=%d size=%d\n", (uint64_t)offset,
+            ret);
+
+    return ret;
+}
+
+std::streampos
+RawDiskImage::writev(const struct iovec *iov, int iovcnt,
+                     std::streampos offset)
+{
+    if (!initialized)
+        panic("RawDiskImage not initialized");
+
+    if (readonly)
+        panic("Cannot write to a read only disk image");
+
+    if (iovcnt > IOV_MAX)
+        return DiskImage::writev(iov, iovcnt, offset);
+
+    if (fd < 0)
+        panic("file not open!\n");
+
+    const ssize_t ret = pwritev(fd, iov, iovcnt, offset * SectorSize);
+    if (ret < 0)
+        panic("Could not write to %s: %s", file, strerror(errno));
+
+    DPRINTF(DiskImageWrite, "writev: offset=%d size=%d\n", (uint64_t)offset,
+            ret);
+
+    return ret;
 }
 
 ////////////////////////////////////////////////////////////////////////
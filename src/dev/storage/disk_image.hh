@@ -33,6 +33,8 @@
 #ifndef __DEV_STORAGE_DISK_IMAGE_HH__
 #define __DEV_STORAGE_DISK_IMAGE_HH__
 
+#include <sys/uio.h>
+
 #include <fstream>
 #include <unordered_map>
 
@@ -65,6 +67,32 @@ class DiskImage : public SimObject
                                 std::streampos offset) const = 0;
     virtual std::streampos write(const uint8_t *data,
                                  std::streampos offset) = 0;
+
+    /**
+     * Read consecutive sectors into a list of buffers.
+     *
+     * The default implementation reads one sector at a time, directly
+     * into the buffers wherever a whole sector fits.
+     *
+     * @param iov Buffers to fill, their total size being a multiple
+     *            of the sector size.
+     * @param iovcnt Number of buffers.
+     * @param offset First sector to read.
+     * @return Number of bytes read.
+     */
+    virtual std::streampos readv(const struct iovec *iov, int iovcnt,
+                                 std::streampos offset) const;
+    /**
+     * Write consecutive sectors from a list of buffers.
+     *
+     * @param iov Buffers to write, their total size being a multiple
+     *            of the sector size.
+     * @param iovcnt Number of buffers.
+     * @param offset First sector to write.
+     * @return Number of bytes written.
+     */
+    virtual std::streampos writev(const struct iovec *iov, int iovcnt,
+                                  std::streampos offset);
 };
 
 /**
@@ -73,7 +101,7 @@ class DiskImage : public SimObject
 class RawDiskImage : public DiskImage
 {
   protected:
-    mutable std::fstream stream;
+    int fd;
     std::string file;
     bool readonly;
     mutable std::streampos disk_size;
@@ -92,6 +120,11 @@ class RawDiskImage : public DiskImage
 
     std::streampos read(uint8_t *data, std::streampos offset) const override;
     std::streampos write(const uint8_t *data, std::streampos offset) override;
+
+    std::streampos readv(const struct iovec *iov, int iovcnt,
+                         std::streampos offset) const override;
+    std::streampos writev(const struct iovec *iov, int iovcnt,
+                          std::streampos offset) override;
 };
 
 /**
@@ -0,0 +1,436 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ * Memory mapped copy-on-write disk image
+ */
+
+#include "dev/storage/mmap_disk_image.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "base/intmath.hh"
+#include "base/logging.hh"
+#include "base/trace.hh"
+#include "debug/DiskImageRead.hh"
+#include "debug/DiskImageWrite.hh"
+#include "sim/byteswap.hh"
+#include "sim/serialize.hh"
+#include "sim/sim_exit.hh"
+
+namespace gem5
+{
+
+// "M5COWIDX" and "M5COWBLK" in little endian
+const uint64_t MmapCowDiskImage::IndexMagic = 0x58444957'4f43354dULL;
+const uint64_t MmapCowDiskImage::BlocksMagic = 0x4b4c4257'4f43354dULL;
+
+namespace
+{
+
+template <class T>
+void
+readLE(std::ifstream &stream, T &data)
+{
+    SafeRead(stream, &data, sizeof(data));
+    data = letoh(data);
+}
+
+template <class T>
+void
+writeLE(std::ofstream &stream, T data)
+{
+    data = htole(data);
+    SafeWrite(stream, &data, sizeof(data));
+}
+
+} // anonymous namespace
+
+MmapCowDiskImage::MmapCowDiskImage(const Params &p)
+    : DiskImage(p), blockSize(p.block_size),
+      maxCheckpointChain(p.max_checkpoint_chain), readOnly(p.read_only),
+      overlayFile(p.overlay_file)
+{
+    fatal_if(blockSize == 0 || blockSize % SectorSize,
+             "%s: The block size must be a multiple of %d bytes.",
+             name(), SectorSize);
+
+    mapBase(p.image_file);
+    numBlocks = divCeil(diskBytes, blockSize);
+    present.resize(numBlocks, false);
+    dirty.resize(numBlocks, false);
+    mapOverlay();
+    initialized = true;
+
+    if (!overlayFile.empty() && !readOnly)
+        registerExitCallback([this]() { save(); });
+}
+
+MmapCowDiskImage::~MmapCowDiskImage()
+{
+    if (base)
+        munmap(const_cast<uint8_t *>(base), diskBytes);
+    if (overlay)
+        munmap(overlay, diskBytes);
+    if (overlayFd >= 0)
+        close(overlayFd);
+}
+
+uint64_t
+MmapCowDiskImage::blockBytes(uint64_t block) const
+{
+    return std::min(blockSize, diskBytes - block * blockSize);
+}
+
+void
+MmapCowDiskImage::mapBase(const std::string &file)
+{
+    int fd = open(file.c_str(), O_RDONLY);
+    fatal_if(fd < 0, "%s: Could not open disk image %s: %s", name(), file,
+             strerror(errno));
+
+    struct stat st;
+    fatal_if(fstat(fd, &st) < 0, "%s: Could not stat disk image %s: %s",
+             name(), file, strerror(errno));
+    diskBytes = st.st_size;
+
+    // A shared read-only mapping leaves the image in the page cache,
+    // where every simulation using it finds the same pages.
+    if (diskBytes) {
+        void *m = mmap(nullptr, diskBytes, PROT_READ, MAP_SHARED, fd, 0);
+        fatal_if(m == MAP_FAILED, "%s: Could not map disk image %s: %s",
+                 name(), file, strerror(errno));
+        base = (const uint8_t *)m;
+    }
+    close(fd);
+}
+
+void
+MmapCowDiskImage::mapOverlay()
+{
+    if (!diskBytes)
+        return;
+
+    void *m;
+    if (overlayFile.empty()) {
+        // Pages of an anonymous mapping are only allocated when a block
+        // is copied into them.
+        m = mmap(nullptr, diskBytes, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    } else {
+        overlayFd = open(overlayFile.c_str(),
+                         readOnly ? O_RDONLY : O_RDWR | O_CREAT, 0644);
+        fatal_if(overlayFd < 0, "%s: Could not open overlay %s: %s",
+                 name(), overlayFile, strerror(errno));
+
+        if (!loadIndex(overlayFile + ".idx")) {
+            fatal_if(readOnly, "%s: Could not open read-only overlay %s.",
+                     name(), overlayFile);
+            // Drop whatever is left of an earlier overlay, so that the
+            // file only allocates the blocks written to from now on.
+            fatal_if(ftruncate(overlayFd, 0) < 0,
+                     "%s: Could not truncate overlay %s: %s", name(),
+                     overlayFile, strerror(errno));
+        }
+        if (!readOnly) {
+            fatal_if(ftruncate(overlayFd, diskBytes) < 0,
+                     "%s: Could not size overlay %s: %s", name(),
+                     overlayFile, strerror(errno));
+        }
+
+        // A read-only overlay is mapped privately, so that restoring a
+        // checkpoint doesn't change the file.
+        m = mmap(nullptr, diskBytes, PROT_READ | PROT_WRITE,
+                 readOnly ? MAP_PRIVATE : MAP_SHARED, overlayFd, 0);
+    }
+    fatal_if(m == MAP_FAILED, "%s: Could not map the overlay: %s", name(),
+             strerror(errno));
+    overlay = (uint8_t *)m;
+}
+
+bool
+MmapCowDiskImage::loadIndex(const std::string &file)
+{
+    std::ifstream stream(file, std::ios::in | std::ios::binary);
+    if (!stream.is_open())
+        return false;
+
+    uint64_t magic, block_size, disk_bytes;
+    readLE(stream, magic);
+    readLE(stream, block_size);
+    readLE(stream, disk_bytes);
+    fatal_if(magic != IndexMagic, "%s: %s is not an overlay index.",
+             name(), file);
+    fatal_if(block_size != blockSize || disk_bytes != diskBytes,
+             "%s: Overlay index %s doesn't match the disk image.", name(),
+             file);
+
+    for (uint64_t first = 0; first < numBlocks; first += 64) {
+        uint64_t bits;
+        readLE(stream, bits);
+        for (uint64_t i = 0; i < 64 && first + i < numBlocks; i++)
+            present[first + i] = bits & (1ULL << i);
+    }
+    return true;
+}
+
+void
+MmapCowDiskImage::saveIndex(const std::string &file) const
+{
+    std::ofstream stream(file, std::ios::out | std::ios::binary |
+                         std::ios::trunc);
+    fatal_if(!stream.is_open(), "%s: Could not open overlay index %s.",
+             name(), file);
+
+    writeLE(stream, IndexMagic);
+    writeLE(stream, blockSize);
+    writeLE(stream, diskBytes);
+    for (uint64_t first = 0; first < numBlocks; first += 64) {
+        uint64_t bits = 0;
+        for (uint64_t i = 0; i < 64 && first + i < numBlocks; i++)
+            bits |= uint64_t(present[first + i]) << i;
+        writeLE(stream, bits);
+    }
+}
+
+void
+MmapCowDiskImage::save() const
+{
+    if (overlayFile.empty())
+        return;
+
+    if (overlay && msync(overlay, diskBytes, MS_SYNC) < 0)
+        warn("%s: Could not sync overlay %s: %s", name(), overlayFile,
+             strerror(errno));
+    saveIndex(overlayFile + ".idx");
+}
+
+void
+MmapCowDiskImage::notifyFork()
+{
+    if (overlayFd < 0 || readOnly)
+        return;
+
+    inform("Disabling saving of COW image in forked child process.\n");
+
+    // The child keeps the blocks written so far, but must not share its
+    // writes with the parent through the overlay file.
+    void *m = mmap(nullptr, diskBytes, PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    fatal_if(m == MAP_FAILED, "%s: Could not map the overlay: %s", name(),
+             strerror(errno));
+    for (uint64_t block = 0; block < numBlocks; block++) {
+        if (present[block]) {
+            const uint64_t start = block * blockSize;
+            memcpy((uint8_t *)m + start, overlay + start, blockBytes(block));
+        }
+    }
+    munmap(overlay, diskBytes);
+    close(overlayFd);
+    overlay = (uint8_t *)m;
+    overlayFd = -1;
+    overlayFile = "";
+}
+
+std::streampos
+MmapCowDiskImage::size() const
+{
+    return diskBytes / SectorSize;
+}
+
+std::streampos
+MmapCowDiskImage::read(uint8_t *data, std::streampos offset) const
+{
+    if (!initialized)
+        panic("MmapCowDiskImage not initialized");
+
+    const uint64_t pos = (uint64_t)offset * SectorSize;
+    if (pos + SectorSize > diskBytes)
+        panic("access out of bounds");
+
+    const uint8_t *src = present[pos / blockSize] ? overlay : base;
+    memcpy(data, src + pos, SectorSize);
+
+    DPRINTF(DiskImageRead, "read: offset=%d\n", (uint64_t)offset);
+    DDUMP(DiskImageRead, data, SectorSize);
+
+    return SectorSize;
+}
+
+std::streampos
+MmapCowDiskImage::write(const uint8_t *data, std::streampos offset)
+{
+    if (!initialized)
+        panic("MmapCowDiskImage not initialized");
+
+    if (readOnly)
+        panic("Cannot write to read only disk image %s", name());
+
+    const uint64_t pos = (uint64_t)offset * SectorSize;
+    if (pos + SectorSize > diskBytes)
+        panic("access out of bounds");
+
+    const uint64_t block = pos / blockSize;
+    if (!present[block]) {
+        const uint64_t start = block * blockSize;
+        memcpy(overlay + start, base + start, blockBytes(block));
+        present[block] = true;
+    }
+    memcpy(overlay + pos, data, SectorSize);
+    dirty[block] = true;
+
+    DPRINTF(DiskImageWrite, "write: offset=%d\n", (uint64_t)offset);
+    DDUMP(DiskImageWrite, data, SectorSize);
+
+    return SectorSize;
+}
+
+void
+MmapCowDiskImage::writeBlocks(const std::string &file, bool delta) const
+{
+    std::ofstream stream(file, std::ios::out | std::ios::binary |
+                         std::ios::trunc);
+    fatal_if(!stream.is_open(), "%s: Could not open checkpoint file %s.",
+             name(), file);
+
+    const std::vector<bool> &blocks = delta ? dirty : present;
+    const uint64_t count = std::count(blocks.begin(), blocks.end(), true);
+
+    writeLE(stream, BlocksMagic);
+    writeLE(stream, blockSize);
+    writeLE(stream, diskBytes);
+    writeLE(stream, count);
+    for (uint64_t block = 0; block < numBlocks; block++) {
+        if (!blocks[block])
+            continue;
+        writeLE(stream, block);
+        SafeWrite(stream, overlay + block * blockSize, blockBytes(block));
+    }
+}
+
+void
+MmapCowDiskImage::applyBlocks(const std::string &file)
+{
+    std::ifstream stream(file, std::ios::in | std::ios::binary);
+    fatal_if(!stream.is_open(), "%s: Could not open checkpoint file %s.",
+             name(), file);
+
+    uint64_t magic, block_size, disk_bytes, count;
+    readLE(stream, magic);
+    readLE(stream, block_size);
+    readLE(stream, disk_bytes);
+    readLE(stream, count);
+    fatal_if(magic != BlocksMagic, "%s: %s is not a disk block file.",
+             name(), file);
+    fatal_if(block_size != blockSize || disk_bytes != diskBytes,
+             "%s: Checkpoint file %s doesn't match the disk image.", name(),
+             file);
+
+    for (uint64_t i = 0; i < count; i++) {
+        uint64_t block;
+        readLE(stream, block);
+        fatal_if(block >= numBlocks, "%s: Bad block %d in %s.", name(),
+                 block, file);
+        SafeRead(stream, overlay + block * blockSize, blockBytes(block));
+        present[block] = true;
+    }
+}
+
+void
+MmapCowDiskImage::serialize(CheckpointOut &cp) const
+{
+    std::string blocksFile = name() + ".blocks";
+    SERIALIZE_SCALAR(blocksFile);
+
+    const std::string dir = CheckpointIn::dir();
+    const std::string filepath = dir + "/" + blocksFile;
+
+    // A delta only holds the blocks written to since the previous
+    // checkpoint, which it refers to relative to its own directory so
+    // that checkpoint directories can be moved together.
+    const bool delta = !chain.empty() && chain.size() <= maxCheckpointChain;
+    if (delta) {
+        unsigned int num_parents = chain.size();
+        SERIALIZE_SCALAR(num_parents);
+        for (unsigned int i = 0; i < num_parents; i++) {
+            paramOut(cp, csprintf("parent%d", i),
+                     std::filesystem::relative(chain[i], dir).string());
+        }
+    } else {
+        chain.clear();
+    }
+
+    writeBlocks(filepath, delta);
+    std::fill(dirty.begin(), dirty.end(), false);
+
+    if (maxCheckpointChain) {
+        chain.push_back(
+                std::filesystem::absolute(filepath).lexically_normal());
+    }
+}
+
+void
+MmapCowDiskImage::unserialize(CheckpointIn &cp)
+{
+    std::string blocksFile;
+    UNSERIALIZE_SCALAR(blocksFile);
+
+    chain.clear();
+    unsigned int num_parents = 0;
+    optParamIn(cp, "num_parents", num_parents, false);
+    for (unsigned int i = 0; i < num_parents; i++) {
+        std::string parent;
+        paramIn(cp, csprintf("parent%d", i), parent);
+        chain.push_back(std::filesystem::absolute(
+                std::filesystem::path(cp.getCptDir()) / parent)
+            .lexically_normal());
+    }
+    chain.push_back(std::filesystem::absolute(
+            std::filesystem::path(cp.getCptDir()) / blocksFile)
+        .lexically_normal());
+
+    // Blocks left in the overlay are stale until copied in again.
+    std::fill(present.begin(), present.end(), false);
+    for (const auto &file : chain)
+        applyBlocks(file);
+    std::fill(dirty.begin(), dirty.end(), false);
+
+    if (!maxCheckpointChain)
+        chain.clear();
+}
+
+} // namespace gem5
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/** @file
+ * Memory mapped copy-on-write disk image
+ */
+
+#ifndef __DEV_STORAGE_MMAP_DISK_IMAGE_HH__
+#define __DEV_STORAGE_MMAP_DISK_IMAGE_HH__
+
+#include <string>
+#include <vector>
+
+#include "dev/storage/disk_image.hh"
+#include "params/MmapCowDiskImage.hh"
+
+namespace gem5
+{
+
+/**
+ * Copy-on-write disk image which maps its base image read-only, so that
+ * any number of simulations can share it through the page cache, and
+ * keeps the blocks written to in an overlay mapped from a sparse file.
+ * The overlay has the same layout as the base image and a bitmap tells
+ * which blocks it holds, so accesses never need more than a memcpy.
+ *
+ * Checkpoints only hold the blocks written to since the previous
+ * checkpoint, and refer to the ones they build on, up to a maximum
+ * chain length after which all the overlaid blocks are stored again.
+ */
+class MmapCowDiskImage : public DiskImage
+{
+  public:
+    static const uint64_t IndexMagic;
+    static const uint64_t BlocksMagic;
+
+  protected:
+    const uint64_t blockSize;
+    const unsigned maxCheckpointChain;
+    const bool readOnly;
+
+    /** Overlay file kept across simulations, empty if anonymous. */
+    std::string overlayFile;
+
+    uint64_t diskBytes = 0;
+    uint64_t numBlocks = 0;
+
+    const uint8_t *base = nullptr;
+    uint8_t *overlay = nullptr;
+    int overlayFd = -1;
+
+    /** Blocks held by the overlay. */
+    std::vector<bool> present;
+    /** Blocks written to since the last checkpoint. */
+    mutable std::vector<bool> dirty;
+    /** Checkpoint block files the next checkpoint can build on. */
+    mutable std::vector<std::string> chain;
+
+    uint64_t blockBytes(uint64_t block) const;
+    void mapBase(const std::string &file);
+    void mapOverlay();
+    bool loadIndex(const std::string &file);
+    void saveIndex(const std::string &file) const;
+
+    void writeBlocks(const std::string &file, bool delta) const;
+    void applyBlocks(const std::string &file);
+
+  public:
+    typedef MmapCowDiskImageParams Params;
+    MmapCowDiskImage(const Params &p);
+    ~MmapCowDiskImage();
+
+    void notifyFork() override;
+
+    /** Save the overlay index, if the overlay is kept. */
+    void save() const;
+
+    void serialize(CheckpointOut &cp) const override;
+    void unserialize(CheckpointIn &cp) override;
+
+    std::streampos size() const override;
+
+    std::streampos read(uint8_t *data, std::streampos offset) const override;
+    std::streampos write(const uint8_t *data, std::streampos offset) override;
+};
+
+} // namespace gem5
+
+#endif // __DEV_STORAGE_MMAP_DISK_IMAGE_HH__
@@ -37,19 +37,56 @@
 
 #include "dev/virtio/base.hh"
 
+#include <cstring>
+
 #include "base/trace.hh"
 #include "debug/VIO.hh"
 #include "params/VirtIODeviceBase.hh"
 #include "params/VirtIODummyDevice.hh"
 #include "sim/serialize.hh"
+#include "sim/system.hh"
 
 namespace gem5
 {
 
-VirtDescriptor::VirtDescriptor(PortProxy &_memProxy, ByteOrder bo,
-                               VirtQueue &_queue, Index descIndex)
-    : memProxy(&_memProxy), queue(&_queue), byteOrder(bo), _index(descIndex),
-      desc{0, 0, 0, 0}
+VirtGuestMemory::VirtGuestMemory(System &_system)
+    : system(_system),
+      backdoors(_system.getSystemPort(), _system.getPhysMem())
+{
+}
+
+uint8_t *
+VirtGuestMemory::hostPtr(Addr addr, size_t size, bool writeable)
+{
+    // Backdoors bypass the caches, so they can only be used while
+    // memory isn't cached.
+    if (!system.bypassCaches())
+        return nullptr;
+    return backdoors.hostPtr(addr, size, writeable);
+}
+
+void
+VirtGuestMemory::readBlob(Addr addr, void *dst, size_t size)
+{
+    if (const uint8_t *host = hostPtr(addr, size, false))
+        std::memcpy(dst, host, size);
+    else
+        system.physProxy.readBlob(addr, dst, size);
+}
+
+void
+VirtGuestMemory::writeBlob(Addr addr, const void *src, size_t size)
+{
+    if (uint8_t *host = hostPtr(addr, size, true))
+        std::memcpy(host, src, size);
+    else
+        system.physProxy.writeBlob(addr, src, size);
+}
+
+
+VirtDescriptor::VirtDescriptor(ByteOrder bo, VirtQueue &_queue,
+                               Index descIndex)
+    : queue(&_queue), byteOrder(bo), _index(descIndex), desc{0, 0, 0, 0}
 {
 }
 
@@ -65,7 +102,6 @@ VirtDescriptor::~VirtDescriptor() noexcept
 VirtDescriptor &
 VirtDescriptor::operator=(VirtDescriptor &&rhs) noexcept
 {
-    memProxy = std::move(rhs.memProxy);
     queue = std::move(rhs.queue);
     byteOrder = std::move(rhs.byteOrder);
     _index = std::move(rhs._index);
@@ -85,7 +121,7 @@ VirtDescriptor::update()
     assert(_index < queue->getSize());
     const Addr desc_addr(vq_addr + sizeof(desc) * _index);
     vring_desc guest_desc;
-    memProxy->readBlob(desc_addr, &guest_desc, sizeof(guest_desc));
+    queue->readGuest(desc_addr, &guest_desc, sizeof(guest_desc));
     desc = gtoh(guest_desc, byteOrder);
     DPRINTF(VIO,
             "VirtDescriptor(%i): Addr: 0x%x, Len: %i, Flags: 0x%x, "
@@ -153,7 +189,7 @@ VirtDescriptor::read(size_t offset, uint8_t *dst, size_t size) const
     if (!isIncoming())
         panic("Trying to read from outgoing buffer\n");
 
-    memProxy->readBlob(desc.addr + offset, dst, size);
+    queue->readGuest(desc.addr + offset, dst, size);
 }
 
 void
@@ -165,7 +201,7 @@ VirtDescriptor::write(size_t offset, const uint8_t *src, size_t size)
     if (!isOutgoing())
         panic("Trying to write to incoming buffer\n");
 
-    memProxy->writeBlob(desc.addr + offset, src, size);
+    queue->writeGuest(desc.addr + offset, src, size);
 }
 
 void
@@ -226,16 +262,75 @@ VirtDescriptor::chainSize() const
     return size;
 }
 
+bool
+VirtDescriptor::chainIovecs(size_t offset, size_t size, bool outgoing,
+                            std::vector<struct iovec> &iov) const
+{
+    const VirtDescriptor *desc(this);
+    while (size > 0 && desc) {
+        if (offset < desc->size()) {
+            if (desc->isOutgoing() != outgoing)
+                return false;
+
+            const size_t chunk_size(std::min(desc->size() - offset, size));
+            uint8_t *host(queue->hostPtr(desc->desc.addr + offset,
+                                         chunk_size, outgoing));
+            if (!host)
+                return false;
+
+            if (!iov.empty() &&
+                    (uint8_t *)iov.back().iov_base + iov.back().iov_len ==
+                    host) {
+                iov.back().iov_len += chunk_size;
+            } else {
+                iov.push_back({host, chunk_size});
+            }
+            size -= chunk_size;
+            offset = 0;
+        } else {
+            offset -= desc->size();
+        }
+        desc = desc->next();
+    }
+
+    return size == 0;
+}
+
 
 
 VirtQueue::VirtQueue(PortProxy &proxy, ByteOrder bo, uint16_t size)
     : byteOrder(bo), _size(size), _address(0), memProxy(proxy),
-      avail(proxy, bo, size), used(proxy, bo, size),
+      guestMemory(nullptr), avail(*this, bo, size), used(*this, bo, size),
       _last_avail(0)
 {
     descriptors.reserve(_size);
     for (int i = 0; i < _size; ++i)
-        descriptors.emplace_back(proxy, bo, *this, i);
+        descriptors.emplace_back(bo, *this, i);
+}
+
+uint8_t *
+VirtQueue::hostPtr(Addr addr, size_t size, bool writeable) const
+{
+    return guestMemory ? guestMemory->hostPtr(addr, size, writeable) :
+                         nullptr;
+}
+
+void
+VirtQueue::readGuest(Addr addr, void *dst, size_t size) const
+{
+    if (guestMemory)
+        guestMemory->readBlob(addr, dst, size);
+    else
+        memProxy.readBlob(addr, dst, size);
+}
+
+void
+VirtQueue::writeGuest(Addr addr, const void *src, size_t size) const
+{
+    if (guestMemory)
+        guestMemory->writeBlob(addr, src, size);
+    else
+        memProxy.writeBlob(addr, src, size);
 }
 
 void
@@ -284,14 +379,18 @@ VirtQueue::setAddress(Addr address)
 VirtDescriptor *
 VirtQueue::consumeDescriptor()
 {
-    avail.read();
-    DPRINTF(VIO, "consumeDescriptor: _last_avail: %i, avail.idx: %i (->%i)\n",
-            _last_avail, avail.header.index,
-            avail.ring[_last_avail % used.ring.size()]);
+    // Only the header and the element being consumed are read, rather
+    // than the whole ring.
+    avail.readHeader();
+    DPRINTF(VIO, "consumeDescriptor: _last_avail: %i, avail.idx: %i\n",
+            _last_avail, avail.header.index);
     if (_last_avail == avail.header.index)
         return NULL;
 
-    VirtDescriptor::Index index(avail.ring[_last_avail % used.ring.size()]);
+    const uint16_t slot(_last_avail % avail.ring.size());
+    avail.readElement(slot);
+    VirtDescriptor::Index index(avail.ring[slot]);
+    DPRINTF(VIO, "consumeDescriptor: avail[%i]: %i\n", slot, index);
     ++_last_avail;
 
     VirtDescriptor *d(&descriptors[index]);
@@ -307,11 +406,14 @@ VirtQueue::produceDescriptor(VirtDescriptor *desc, uint32_t len)
     DPRINTF(VIO, "produceDescriptor: dscIdx: %i, len: %i, used.idx: %i\n",
             desc->index(), len, used.header.index);
 
-    struct vring_used_elem &e(used.ring[used.header.index % used.ring.size()]);
+    const uint16_t slot(used.header.index % used.ring.size());
+    struct vring_used_elem &e(used.ring[slot]);
     e.id = desc->index();
     e.len = len;
     used.header.index += 1;
-    used.write();
+    // The element has to be visible before the index is updated.
+    used.writeElement(slot);
+    used.writeHeader();
 }
 
 void
@@ -342,7 +444,7 @@ VirtIODeviceBase::VirtIODeviceBase(const Params &params, DeviceId id,
       guestFeatures(0),
       byteOrder(params.byte_order),
       deviceId(id), configSize(config_size), deviceFeatures(features),
-      _deviceStatus(0), _queueSelect(0)
+      _deviceStatus(0), _queueSelect(0), guestMemory(*params.system)
 {
 }
 
@@ -491,6 +593,7 @@ void
 VirtIODeviceBase::registerQueue(VirtQueue &queue)
 {
     _queues.push_back(&queue);
+    queue.setGuestMemory(&guestMemory);
 }
 
 
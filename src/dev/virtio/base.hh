@@ -38,6 +38,8 @@
 #ifndef __DEV_VIRTIO_BASE_HH__
 #define __DEV_VIRTIO_BASE_HH__
 
+#include <sys/uio.h>
+
 #include <cstdint>
 #include <functional>
 #include <vector>
@@ -46,6 +48,7 @@
 #include "base/compiler.hh"
 #include "base/types.hh"
 #include "dev/virtio/virtio_ring.h"
+#include "mem/backdoor_cache.hh"
 #include "mem/port_proxy.hh"
 #include "sim/serialize.hh"
 #include "sim/sim_object.hh"
@@ -56,6 +59,7 @@ namespace gem5
 struct VirtIODeviceBaseParams;
 struct VirtIODummyDeviceParams;
 
+class System;
 class VirtQueue;
 
 /** @{
@@ -93,6 +97,40 @@ swap_byte(T v)
 
 /** @} */
 
+/**
+ * Host access to the guest memory used by the virtqueues of a device.
+ *
+ * While the memory system doesn't cache guest memory, it is accessed
+ * through memory backdoors so that rings and buffers can be used in
+ * place. Anything else goes through the functional port proxy of the
+ * system.
+ */
+class VirtGuestMemory
+{
+  public:
+    VirtGuestMemory(System &system);
+
+    /**
+     * Get a host pointer to a range of guest memory.
+     *
+     * @param addr Guest physical address.
+     * @param size Size of the range (in bytes).
+     * @param writeable Whether the range will be written.
+     * @return Host pointer, or nullptr if the range can't be accessed
+     * directly.
+     */
+    uint8_t *hostPtr(Addr addr, size_t size, bool writeable);
+
+    void readBlob(Addr addr, void *dst, size_t size);
+    void writeBlob(Addr addr, const void *src, size_t size);
+
+  private:
+    System &system;
+
+    /** Backdoors into guest memory */
+    MemBackdoorCache backdoors;
+};
+
 /**
  * VirtIO descriptor (chain) wrapper
  *
@@ -126,12 +164,10 @@ class VirtDescriptor
     /**
      * Create a descriptor wrapper.
      *
-     * @param memProxy Proxy to the guest physical memory.
      * @param queue Queue owning this descriptor.
      * @param index Index within the queue.
      */
-    VirtDescriptor(PortProxy &memProxy, ByteOrder bo,
-            VirtQueue &queue, Index index);
+    VirtDescriptor(ByteOrder bo, VirtQueue &queue, Index index);
     // WORKAROUND: The noexcept declaration works around a bug where
     // gcc 4.7 tries to call the wrong constructor when emplacing
     // something into a vector.
@@ -267,6 +303,26 @@ class VirtDescriptor
      * @return Size of descriptor chain in bytes.
      */
     size_t chainSize() const;
+    /**
+     * Map part of a descriptor chain to host memory.
+     *
+     * This method appends host I/O vectors covering the specified
+     * number of bytes of the descriptor chain, starting at this
+     * descriptor plus an offset in bytes, to a vector. This lets
+     * devices move data between guest buffers and host files without
+     * intermediate copies. Adjacent buffers are merged into a single
+     * I/O vector.
+     *
+     * @param offset Offset into the chain (in bytes).
+     * @param size Size (in bytes).
+     * @param outgoing True to map outgoing (write-only) descriptors,
+     *                 false to map incoming (read-only) ones.
+     * @param iov Vector the I/O vectors are appended to.
+     * @return true if the whole range could be mapped, false if it has
+     * to be accessed through chainRead() or chainWrite().
+     */
+    bool chainIovecs(size_t offset, size_t size, bool outgoing,
+                     std::vector<struct iovec> &iov) const;
     /** @} */
 
   private:
@@ -275,8 +331,6 @@ class VirtDescriptor
     // Prevent copying
     VirtDescriptor(const VirtDescriptor &other);
 
-    /** Pointer to memory proxy */
-    PortProxy *memProxy;
     /** Pointer to virtqueue owning this descriptor */
     VirtQueue *queue;
 
@@ -353,6 +407,26 @@ class VirtQueue : public Serializable
     VirtDescriptor *getDescriptor(VirtDescriptor::Index index) {
         return &descriptors[index];
     }
+
+    /**
+     * Access guest memory through the backdoors of a device.
+     *
+     * @param memory Guest memory of the device, nullptr to only use
+     *               the memory proxy.
+     */
+    void setGuestMemory(VirtGuestMemory *memory) { guestMemory = memory; }
+
+    /**
+     * Get a host pointer to a range of guest memory.
+     *
+     * @return Host pointer, or nullptr if the range can't be accessed
+     * directly.
+     */
+    uint8_t *hostPtr(Addr addr, size_t size, bool writeable) const;
+    /** Read from guest memory. */
+    void readGuest(Addr addr, void *dst, size_t size) const;
+    /** Write to guest memory. */
+    void writeGuest(Addr addr, const void *src, size_t size) const;
     /** @} */
 
     /** @{
@@ -455,6 +529,8 @@ class VirtQueue : public Serializable
     Addr _address;
     /** Guest physical memory proxy */
     PortProxy &memProxy;
+    /** Backdoor access to guest memory, if any */
+    VirtGuestMemory *guestMemory;
 
   private:
     /**
@@ -477,8 +553,8 @@ class VirtQueue : public Serializable
             Index index;
         };
 
-        VirtRing<T>(PortProxy &proxy, ByteOrder bo, uint16_t size) :
-            header{0, 0}, ring(size), _proxy(proxy), _base(0), byteOrder(bo)
+        VirtRing<T>(VirtQueue &queue, ByteOrder bo, uint16_t size) :
+            header{0, 0}, ring(size), _queue(queue), _base(0), byteOrder(bo)
         {}
 
         /** Reset any state in the ring buffer. */
@@ -501,7 +577,7 @@ class VirtQueue : public Serializable
         readHeader()
         {
             assert(_base != 0);
-            _proxy.readBlob(_base, &header, sizeof(header));
+            _queue.readGuest(_base, &header, sizeof(header));
             header.flags = gtoh(header.flags, byteOrder);
             header.index = gtoh(header.index, byteOrder);
         }
@@ -513,7 +589,28 @@ class VirtQueue : public Serializable
             assert(_base != 0);
             out.flags = htog(header.flags, byteOrder);
             out.index = htog(header.index, byteOrder);
-            _proxy.writeBlob(_base, &out, sizeof(out));
+            _queue.writeGuest(_base, &out, sizeof(out));
+        }
+
+        /** Update a single element of the ring with data from the guest. */
+        void
+        readElement(Index i)
+        {
+            assert(_base != 0);
+            T temp;
+            _queue.readGuest(_base + sizeof(header) + sizeof(T) * i,
+                             &temp, sizeof(T));
+            ring[i] = gtoh(temp, byteOrder);
+        }
+
+        /** Write a single element of the ring to the guest. */
+        void
+        writeElement(Index i)
+        {
+            assert(_base != 0);
+            const T temp = htog(ring[i], byteOrder);
+            _queue.writeGuest(_base + sizeof(header) + sizeof(T) * i,
+                              &temp, sizeof(T));
         }
 
         void
@@ -523,8 +620,8 @@ class VirtQueue : public Serializable
 
             /* Read and byte-swap the elements in the ring */
             T temp[ring.size()];
-            _proxy.readBlob(_base + sizeof(header),
-                            temp, sizeof(T) * ring.size());
+            _queue.readGuest(_base + sizeof(header),
+                             temp, sizeof(T) * ring.size());
             for (int i = 0; i < ring.size(); ++i)
                 ring[i] = gtoh(temp[i], byteOrder);
         }
@@ -538,8 +635,8 @@ class VirtQueue : public Serializable
             T temp[ring.size()];
             for (int i = 0; i < ring.size(); ++i)
                 temp[i] = htog(ring[i], byteOrder);
-            _proxy.writeBlob(_base + sizeof(header),
-                             temp, sizeof(T) * ring.size());
+            _queue.writeGuest(_base + sizeof(header),
+                              temp, sizeof(T) * ring.size());
             writeHeader();
         }
 
@@ -552,8 +649,8 @@ class VirtQueue : public Serializable
         // Remove default constructor
         VirtRing<T>();
 
-        /** Guest physical memory proxy */
-        PortProxy &_proxy;
+        /** Queue owning the ring, which accesses guest memory */
+        VirtQueue &_queue;
         /** Guest physical base address of the ring buffer */
         Addr _base;
         /** Byte order in the ring */
@@ -899,6 +996,9 @@ class VirtIODeviceBase : public SimObject
     /** List of virtual queues supported by this device */
     std::vector<VirtQueue *> _queues;
 
+    /** Guest memory accessed by the queues of this device */
+    VirtGuestMemory guestMemory;
+
     /** Callbacks to kick the guest through the transport layer  */
     std::function<void()> transKick;
 };
@@ -73,7 +73,6 @@ VirtIOBlock::Status
 VirtIOBlock::read(const BlkRequest &req, VirtDescriptor *desc_chain,
                   size_t off_data, size_t size)
 {
-    std::vector<uint8_t> data(size);
     uint64_t sector(req.sector);
 
     DPRINTF(VIOBlock, "Read request starting @ sector %i (size: %i)\n",
@@ -82,6 +81,18 @@ VirtIOBlock::read(const BlkRequest &req, VirtDescriptor *desc_chain,
     if (size % SectorSize != 0)
         panic("Unexpected request/sector size relationship\n");
 
+    // Read straight into guest memory if it can be mapped.
+    std::vector<struct iovec> iov;
+    if (desc_chain->chainIovecs(off_data, size, true, iov)) {
+        if (image.readv(iov.data(), iov.size(), sector) != size) {
+            warn("Failed to read sectors %i-%i\n", sector,
+                 sector + size / SectorSize - 1);
+            return S_IOERR;
+        }
+        return S_OK;
+    }
+
+    std::vector<uint8_t> data(size);
     for (Addr offset = 0; offset < size; offset += SectorSize) {
         if (image.read(&data[offset], sector) != SectorSize) {
             warn("Failed to read sector %i\n", sector);
@@ -99,7 +110,6 @@ VirtIOBlock::Status
 VirtIOBlock::write(const BlkRequest &req, VirtDescriptor *desc_chain,
                   size_t off_data, size_t size)
 {
-    std::vector<uint8_t> data(size);
     uint64_t sector(req.sector);
 
     DPRINTF(VIOBlock, "Write request starting @ sector %i (size: %i)\n",
@@ -108,6 +118,18 @@ VirtIOBlock::write(const BlkRequest &req, VirtDescriptor *desc_chain,
     if (size % SectorSize != 0)
         panic("Unexpected request/sector size relationship\n");
 
+    // Write straight from guest memory if it can be mapped.
+    std::vector<struct iovec> iov;
+    if (desc_chain->chainIovecs(off_data, size, false, iov)) {
+        if (image.writev(iov.data(), iov.size(), sector) != size) {
+            warn("Failed to write sectors %i-%i\n", sector,
+                 sector + size / SectorSize - 1);
+            return S_IOERR;
+        }
+        return S_OK;
+    }
+
+    std::vector<uint8_t> data(size);
 
     desc_chain->chainRead(off_data, &data[0], size);
 
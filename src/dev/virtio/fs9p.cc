@@ -46,6 +46,8 @@
 #include <sys/wait.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <climits>
 #include <csignal>
 #include <cstring>
 #include <fstream>
@@ -64,6 +66,25 @@
 namespace gem5
 {
 
+namespace
+{
+
+/** Skip the first len bytes of a list of I/O vectors. */
+std::vector<struct iovec>::iterator
+consumeIovecs(std::vector<struct iovec>::iterator it,
+              std::vector<struct iovec>::iterator end, size_t len)
+{
+    for (; it != end && len >= it->iov_len; ++it)
+        len -= it->iov_len;
+    if (len) {
+        it->iov_base = (uint8_t *)it->iov_base + len;
+        it->iov_len -= len;
+    }
+    return it;
+}
+
+} // anonymous namespace
+
 struct P9MsgInfo
 {
     P9MsgInfo(P9MsgType _type, std::string _name)
@@ -153,42 +174,61 @@ VirtIO9PBase::FSQueue::onNotifyDescriptor(VirtDescriptor *desc)
     desc->chainRead(0, (uint8_t *)&header, sizeof(header));
     header = p9toh(header);
 
-    uint8_t data[header.len - sizeof(header)];
-    desc->chainRead(sizeof(header), data, sizeof(data));
-
     // Keep track of pending transactions
     parent.pendingTransactions[header.tag] = desc;
 
+    // Notify device of message
+    parent.recvTMsgChain(header, desc);
+}
+
+void
+VirtIO9PBase::recvTMsgChain(const P9MsgHeader &header,
+                            const VirtDescriptor *desc)
+{
+    uint8_t data[header.len - sizeof(header)];
+    desc->chainRead(sizeof(header), data, sizeof(data));
+
     DPRINTF(VIO9P, "recvTMsg\n");
-    parent.dumpMsg(header, data, sizeof(data));
+    dumpMsg(header, data, sizeof(data));
 
-    // Notify device of message
-    parent.recvTMsg(header, data, sizeof(data));
+    recvTMsg(header, data, sizeof(data));
+}
+
+VirtDescriptor *
+VirtIO9PBase::replyDescriptor(P9Tag tag) const
+{
+    auto it = pendingTransactions.find(tag);
+    if (it == pendingTransactions.end())
+        return nullptr;
+
+    VirtDescriptor *out_desc(it->second);
+    while (out_desc && !out_desc->isOutgoing())
+        out_desc = out_desc->next();
+    return out_desc;
 }
 
 void
 VirtIO9PBase::sendRMsg(const P9MsgHeader &header, const uint8_t *data, size_t size)
 {
     DPRINTF(VIO9P, "Sending RMsg\n");
-    dumpMsg(header, data, size);
+    dumpMsg(header, data, data ? size : 0);
     DPRINTF(VIO9P, "\tPending transactions: %i\n", pendingTransactions.size());
     assert(header.len >= sizeof(header));
 
-    VirtDescriptor *main_desc(pendingTransactions[header.tag]);
-    pendingTransactions.erase(header.tag);
-
     // Find the first output descriptor
-    VirtDescriptor *out_desc(main_desc);
-    while (out_desc && !out_desc->isOutgoing())
-        out_desc = out_desc->next();
+    VirtDescriptor *out_desc(replyDescriptor(header.tag));
     if (!out_desc)
         panic("sendRMsg: Framing error, no output descriptor.\n");
 
+    VirtDescriptor *main_desc(pendingTransactions[header.tag]);
+    pendingTransactions.erase(header.tag);
+
     P9MsgHeader header_out(htop9(header));
     header_out.len = htop9(sizeof(P9MsgHeader) + size);
 
     out_desc->chainWrite(0, (uint8_t *)&header_out, sizeof(header_out));
-    out_desc->chainWrite(sizeof(header_out), data, size);
+    if (data)
+        out_desc->chainWrite(sizeof(header_out), data, size);
 
     queue.produceDescriptor(main_desc, sizeof(P9MsgHeader) + size);
     kick();
@@ -267,6 +307,28 @@ VirtIO9PProxy::recvTMsg(const P9MsgHeader &header,
     writeAll(out, sizeof(header_out) + size);
 }
 
+void
+VirtIO9PProxy::recvTMsgChain(const P9MsgHeader &header,
+                             const VirtDescriptor *desc)
+{
+    // Send the message straight from guest memory if it can be mapped,
+    // unless its data has to be dumped.
+    P9MsgHeader header_out(htop9(header));
+    std::vector<struct iovec> iov{{&header_out, sizeof(header_out)}};
+    if (debug::VIO9PData ||
+            !desc->chainIovecs(sizeof(header), header.len - sizeof(header),
+                               false, iov)) {
+        VirtIO9PBase::recvTMsgChain(header, desc);
+        return;
+    }
+
+    DPRINTF(VIO9P, "recvTMsg\n");
+    dumpMsg(header, nullptr, 0);
+
+    deviceUsed = true;
+    writevAll(std::move(iov));
+}
+
 void
 VirtIO9PProxy::serverDataReady()
 {
@@ -277,6 +339,18 @@ VirtIO9PProxy::serverDataReady()
     const ssize_t payload_len(header.len - sizeof(header));
     if (payload_len < 0)
         panic("Payload length is negative!\n");
+
+    // Receive the reply straight into guest memory if it can be mapped,
+    // unless its data has to be dumped.
+    std::vector<struct iovec> iov;
+    const VirtDescriptor *out_desc(replyDescriptor(header.tag));
+    if (!debug::VIO9PData && out_desc &&
+            out_desc->chainIovecs(sizeof(header), payload_len, true, iov)) {
+        readvAll(std::move(iov));
+        sendRMsg(header, nullptr, payload_len);
+        return;
+    }
+
     uint8_t data[payload_len];
     readAll(data, payload_len);
 
@@ -314,6 +388,38 @@ VirtIO9PProxy::writeAll(const uint8_t *data, size_t len)
     }
 }
 
+void
+VirtIO9PProxy::readvAll(std::vector<struct iovec> iov)
+{
+    auto it = iov.begin();
+    while (it != iov.end()) {
+        const int count(std::min<size_t>(iov.end() - it, IOV_MAX));
+        ssize_t ret;
+        while ((ret = readv(&*it, count)) == -EAGAIN)
+            ;
+        if (ret < 0)
+            panic("readvAll: Read failed: %i\n", -ret);
+
+        it = consumeIovecs(it, iov.end(), ret);
+    }
+}
+
+void
+VirtIO9PProxy::writevAll(std::vector<struct iovec> iov)
+{
+    auto it = iov.begin();
+    while (it != iov.end()) {
+        const int count(std::min<size_t>(iov.end() - it, IOV_MAX));
+        ssize_t ret;
+        while ((ret = writev(&*it, count)) == -EAGAIN)
+            ;
+        if (ret < 0)
+            panic("writevAll: write failed: %i\n", -ret);
+
+        it = consumeIovecs(it, iov.end(), ret);
+    }
+}
+
 
 
 VirtIO9PDiod::VirtIO9PDiod(const Params &params)
@@ -425,6 +531,22 @@ VirtIO9PDiod::write(const uint8_t *data, size_t len)
     return ret < 0 ? -errno : ret;
 }
 
+ssize_t
+VirtIO9PDiod::readv(const struct iovec *iov, int iovcnt)
+{
+    assert(fd_from_diod != -1);
+    const ssize_t ret(::readv(fd_from_diod, iov, iovcnt));
+    return ret < 0 ? -errno : ret;
+}
+
+ssize_t
+VirtIO9PDiod::writev(const struct iovec *iov, int iovcnt)
+{
+    assert(fd_to_diod != -1);
+    const ssize_t ret(::writev(fd_to_diod, iov, iovcnt));
+    return ret < 0 ? -errno : ret;
+}
+
 void
 VirtIO9PDiod::DiodDataEvent::process(int revent)
 {
@@ -553,6 +675,25 @@ VirtIO9PSocket::write(const uint8_t *data, size_t len)
     return ret < 0 ? -errno : ret;
 }
 
+ssize_t
+VirtIO9PSocket::readv(const struct iovec *iov, int iovcnt)
+{
+    assert(fdSocket != -1);
+    const ssize_t ret(::readv(fdSocket, iov, iovcnt));
+    if (ret == 0)
+        socketDisconnect();
+
+    return ret < 0 ? -errno : ret;
+}
+
+ssize_t
+VirtIO9PSocket::writev(const struct iovec *iov, int iovcnt)
+{
+    assert(fdSocket != -1);
+    const ssize_t ret(::writev(fdSocket, iov, iovcnt));
+    return ret < 0 ? -errno : ret;
+}
+
 void
 VirtIO9PSocket::SocketDataEvent::process(int revent)
 {
@@ -38,9 +38,12 @@
 #ifndef __DEV_VIRTIO_FS9P_HH__
 #define __DEV_VIRTIO_FS9P_HH__
 
+#include <sys/uio.h>
+
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "base/compiler.hh"
 #include "base/pollevent.hh"
@@ -176,14 +179,34 @@ class VirtIO9PBase : public VirtIODeviceBase
      * @param size Size of data (excluding header)
      */
     virtual void recvTMsg(const P9MsgHeader &header, const uint8_t *data, size_t size) = 0;
+    /**
+     * Handle incoming 9p RPC message in its descriptor chain.
+     *
+     * The default implementation copies the message out of the chain
+     * and passes it to recvTMsg(). Devices that can consume it in
+     * place in guest memory override this.
+     *
+     * @param header 9p message header.
+     * @param desc Descriptor chain holding the message.
+     */
+    virtual void recvTMsgChain(const P9MsgHeader &header,
+                               const VirtDescriptor *desc);
     /**
      * Send a 9p RPC message reply.
      *
      * @param header 9p message header.
-     * @param data Pointer to data in message.
+     * @param data Pointer to data in message, or nullptr if it has
+     *             already been placed in the reply descriptors.
      * @param size Size of data (excluding header)
      */
     void sendRMsg(const P9MsgHeader &header, const uint8_t *data, size_t size);
+    /**
+     * Find the descriptor a reply to a pending transaction starts at.
+     *
+     * @param tag Tag of the transaction.
+     * @return First outgoing descriptor, or nullptr if there is none.
+     */
+    VirtDescriptor *replyDescriptor(P9Tag tag) const;
 
     /**
      * Dump a 9p RPC message on the debug output
@@ -228,6 +251,8 @@ class VirtIO9PProxy : public VirtIO9PBase
   protected:
     void recvTMsg(const P9MsgHeader &header, const uint8_t *data,
                   size_t size) override;
+    void recvTMsgChain(const P9MsgHeader &header,
+                       const VirtDescriptor *desc) override;
 
     /** Notification of pending data from server */
     void serverDataReady();
@@ -252,6 +277,30 @@ class VirtIO9PProxy : public VirtIO9PBase
      * @return Number of bytes written, -errno on failure.
      */
     virtual ssize_t write(const uint8_t *data, size_t len) = 0;
+    /**
+     * Read data from the server behind the proxy into a list of
+     * buffers.
+     *
+     * @note This method may return read fewer bytes than the buffers
+     * hold.
+     *
+     * @param iov Buffers to store results in.
+     * @param iovcnt Number of buffers.
+     * @return Number of bytes read, -errno on failure.
+     */
+    virtual ssize_t readv(const struct iovec *iov, int iovcnt) = 0;
+    /**
+     * Write data from a list of buffers to the server behind the
+     * proxy.
+     *
+     * @note This method may return write fewer bytes than the buffers
+     * hold.
+     *
+     * @param iov Buffers holding the data to write.
+     * @param iovcnt Number of buffers.
+     * @return Number of bytes written, -errno on failure.
+     */
+    virtual ssize_t writev(const struct iovec *iov, int iovcnt) = 0;
 
     /**
      * Convenience function that reads exactly len bytes.
@@ -275,6 +324,18 @@ class VirtIO9PProxy : public VirtIO9PBase
      * @param len Number of bytes to write.
      */
     void writeAll(const uint8_t *data, size_t len);
+    /**
+     * Convenience function that fills a list of buffers.
+     *
+     * @param iov Buffers to fill.
+     */
+    void readvAll(std::vector<struct iovec> iov);
+    /**
+     * Convenience function that writes a list of buffers.
+     *
+     * @param iov Buffers to write.
+     */
+    void writevAll(std::vector<struct iovec> iov);
 
     /**
      * Bool to track if the device has been used or not.
@@ -311,6 +372,8 @@ class VirtIO9PDiod : public VirtIO9PProxy
 
     ssize_t read(uint8_t *data, size_t len);
     ssize_t write(const uint8_t *data, size_t len);
+    ssize_t readv(const struct iovec *iov, int iovcnt) override;
+    ssize_t writev(const struct iovec *iov, int iovcnt) override;
     /** Kill the diod child process at the end of the simulation */
     void terminateDiod();
 
@@ -366,6 +429,8 @@ class VirtIO9PSocket : public VirtIO9PProxy
 
     ssize_t read(uint8_t *data, size_t len);
     ssize_t write(const uint8_t *data, size_t len);
+    ssize_t readv(const struct iovec *iov, int iovcnt) override;
+    ssize_t writev(const struct iovec *iov, int iovcnt) override;
 
   private:
     class SocketDataEvent : public PollEvent
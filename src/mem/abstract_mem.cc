@@ -62,6 +62,7 @@ AbstractMemory::AbstractMemory(const Params &p) :
              (MemBackdoor::Flags)(p.writeable ?
                  MemBackdoor::Readable | MemBackdoor::Writeable :
                  MemBackdoor::Readable)),
+    dirtyPages(nullptr),
     confTableReported(p.conf_table_reported), inAddrMap(p.in_addr_map),
     kvmMap(p.kvm_map), writeable(p.writeable), _system(NULL),
     stats(*this)
@@ -400,6 +401,8 @@ AbstractMemory::access(PacketPtr pkt)
             if (pmemAddr) {
                 pkt->setData(host_addr);
                 (*(pkt->getAtomicOp()))(host_addr);
+                if (dirtyPages)
+                    dirtyPages->mark(host_addr, pkt->getSize());
             }
         } else {
             std::vector<uint8_t> overwrite_val(pkt->getSize());
@@ -428,8 +431,11 @@ AbstractMemory::access(PacketPtr pkt)
                     panic("Invalid size for conditional read/write\n");
             }
 
-            if (overwrite_mem)
+            if (overwrite_mem) {
                 std::memcpy(host_addr, &overwrite_val[0], pkt->getSize());
+                if (dirtyPages)
+                    dirtyPages->mark(host_addr, pkt->getSize());
+            }
 
             assert(!pkt->req->isInstFetch());
             TRACE_PACKET("Read/Write");
@@ -461,6 +467,8 @@ AbstractMemory::access(PacketPtr pkt)
         if (writeOK(pkt)) {
             if (pmemAddr) {
                 pkt->writeData(host_addr);
+                if (dirtyPages)
+                    dirtyPages->mark(host_addr, pkt->getSize());
                 DPRINTF(MemoryAccess, "%s write due to %s\n",
                         __func__, pkt->print());
             }
@@ -494,6 +502,8 @@ AbstractMemory::functionalAccess(PacketPtr pkt)
     } else if (pkt->isWrite()) {
         if (pmemAddr) {
             pkt->writeData(host_addr);
+            if (dirtyPages)
+                dirtyPages->mark(host_addr, pkt->getSize());
         }
         TRACE_PACKET("Write");
         pkt->makeResponse();
@@ -47,6 +47,7 @@
 #define __MEM_ABSTRACT_MEMORY_HH__
 
 #include "mem/backdoor.hh"
+#include "mem/dirty_page_tracker.hh"
 #include "mem/port.hh"
 #include "params/AbstractMemory.hh"
 #include "sim/clocked_object.hh"
@@ -120,6 +121,10 @@ class AbstractMemory : public ClockedObject
     // Backdoor to access this memory.
     MemBackdoor backdoor;
 
+    // Pages of the backing store written since the last checkpoint,
+    // only tracked for delta checkpoints
+    DirtyPageTracker *dirtyPages;
+
     // Enable specific memories to be reported to the configuration table
     const bool confTableReported;
 
@@ -241,11 +246,56 @@ class AbstractMemory : public ClockedObject
      */
     void setBackingStore(uint8_t* pmem_addr);
 
+    /**
+     * Set the tracker of the pages written in the backing store.
+     *
+     * @param dirty_pages Tracker of the backing store, or nullptr
+     */
+    void setDirtyPageTracker(DirtyPageTracker *dirty_pages)
+    {
+        dirtyPages = dirty_pages;
+    }
+
+    /**
+     * Get the backdoor to this memory, if it can be accessed directly.
+     *
+     * @param bd_ptr Set to the backdoor, if there is one
+     * @param will_write Whether the backdoor may be used for writes
+     */
     void
-    getBackdoor(MemBackdoorPtr &bd_ptr)
+    getBackdoor(MemBackdoorPtr &bd_ptr, bool will_write=true)
     {
-        if (lockedAddrList.empty() && backdoor.ptr())
+        if (lockedAddrList.empty() && backdoor.ptr()) {
+            // Writes through the backdoor bypass the tracking.
+            if (dirtyPages && writeable && will_write)
+                dirtyPages->setUntracked();
             bd_ptr = &backdoor;
+        }
+    }
+
+    /**
+     * Get a host pointer for a write to this memory which the caller
+     * does right away, e.g., a functional write before the simulation
+     * starts. Unlike handing out a backdoor, this marks the pages as
+     * written, so they stay tracked.
+     *
+     * @param addr Physical address
+     * @param size Size of the write (in bytes)
+     * @return Host pointer, or nullptr if the write has to go through
+     * the memory system
+     */
+    uint8_t *
+    hostPtrForWrite(Addr addr, uint64_t size)
+    {
+        if (!writeable || !lockedAddrList.empty() || !backdoor.ptr() ||
+                size == 0 || !AddrRange(RangeSize(addr, size)).isSubset(
+                    range)) {
+            return nullptr;
+        }
+        uint8_t *host_addr = toHostAddr(addr);
+        if (dirtyPages)
+            dirtyPages->mark(host_addr, size);
+        return host_addr;
     }
 
     /**
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/backdoor_cache.hh"
+
+#include "base/logging.hh"
+#include "mem/abstract_mem.hh"
+#include "mem/physical.hh"
+#include "mem/port.hh"
+
+namespace gem5
+{
+
+uint8_t *
+MemBackdoorCache::hostPtr(Addr addr, size_t size, bool writeable)
+{
+    if (size == 0)
+        return nullptr;
+
+    const AddrRange range(RangeSize(addr, size));
+    auto it = backdoors.contains(range);
+    if (it == backdoors.end() || (writeable && !it->second.writeable)) {
+        // Only ask for ranges within a single memory, since the memory
+        // system can't route a request that spans several of them.
+        // Interleaved memories don't map to contiguous host memory.
+        const memory::AbstractMemory *mem = physmem.findMemory(addr);
+        if (!mem)
+            return nullptr;
+        const AddrRange &mem_range = mem->getAddrRange();
+        if (mem_range.interleaved() || !range.isSubset(mem_range))
+            return nullptr;
+
+        // Cover the whole memory, so a single backdoor serves any later
+        // access to it.
+        MemBackdoorPtr bd = nullptr;
+        port.sendMemBackdoorReq(
+                MemBackdoorReq(mem_range, writeable ?
+                    (MemBackdoor::Flags)(MemBackdoor::Readable |
+                                         MemBackdoor::Writeable) :
+                    MemBackdoor::Readable),
+                bd);
+        if (!bd || !bd->readable() || (writeable && !bd->writeable()) ||
+                bd->range().interleaved()) {
+            return nullptr;
+        }
+
+        if (it != backdoors.end() && it->second.backdoor == bd) {
+            // Same backdoor as before, which may now be written.
+            it->second.writeable = true;
+        } else {
+            it = backdoors.insert(bd->range(), {bd, writeable});
+            if (it == backdoors.end())
+                return nullptr;
+
+            // Forget about the backdoor when it goes away.
+            bd->addInvalidationCallback(
+                [this](const MemBackdoor &backdoor) {
+                    for (auto it = backdoors.begin();
+                            it != backdoors.end(); it++) {
+                        if (it->second.backdoor == &backdoor) {
+                            backdoors.erase(it);
+                            return;
+                        }
+                    }
+                    panic("Got invalidation for unknown memory backdoor.");
+                });
+        }
+
+        if (!range.isSubset(it->first))
+            return nullptr;
+    }
+
+    return it->second.backdoor->ptr() + (addr - it->first.start());
+}
+
+} // namespace gem5
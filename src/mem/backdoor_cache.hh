@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_BACKDOOR_CACHE_HH__
+#define __MEM_BACKDOOR_CACHE_HH__
+
+#include <cstddef>
+#include <cstdint>
+
+#include "base/addr_range_map.hh"
+#include "base/types.hh"
+#include "mem/backdoor.hh"
+
+namespace gem5
+{
+
+class RequestPort;
+
+namespace memory
+{
+class PhysicalMemory;
+} // namespace memory
+
+/**
+ * Backdoors into memory obtained through a request port, kept until the
+ * memory invalidates them.
+ *
+ * Backdoors bypass the caches, so users must only access memory through
+ * them while it isn't cached, e.g., when System::bypassCaches() holds.
+ */
+class MemBackdoorCache
+{
+  public:
+    MemBackdoorCache(RequestPort &_port,
+                     const memory::PhysicalMemory &_physmem)
+        : port(_port), physmem(_physmem)
+    {}
+
+    /**
+     * Get a host pointer to a range of memory. Backdoors are only
+     * requested for ranges that fall within a single, non-interleaved
+     * memory of the global address map, so that the request can always
+     * be routed to one memory.
+     *
+     * @param addr Physical address.
+     * @param size Size of the range (in bytes).
+     * @param writeable Whether the range will be written. Memories
+     * can't tell which pages are written through a writeable backdoor,
+     * so one is only requested when needed.
+     * @return Host pointer, or nullptr if the range can't be accessed
+     * directly.
+     */
+    uint8_t *hostPtr(Addr addr, size_t size, bool writeable);
+
+  private:
+    RequestPort &port;
+
+    /** Memories of the system, to find the one a range falls in */
+    const memory::PhysicalMemory &physmem;
+
+    struct Entry
+    {
+        MemBackdoorPtr backdoor;
+        /** Whether it was requested for writes */
+        bool writeable;
+    };
+
+    /** Backdoors into memory, indexed by the range they cover */
+    AddrRangeMap<Entry, 1> backdoors;
+};
+
+} // namespace gem5
+
+#endif // __MEM_BACKDOOR_CACHE_HH__
@@ -131,8 +131,10 @@ CfiMemory::ProgramBuffer::writeback()
     if (parent.blocks.isLocked(blockPointer)) {
         return false;
     } else {
-        std::memcpy(parent.toHostAddr(parent.start() + blockPointer),
-            buffer.data(), bytesWritten);
+        uint8_t *host_addr = parent.toHostAddr(parent.start() + blockPointer);
+        std::memcpy(host_addr, buffer.data(), bytesWritten);
+        if (parent.dirtyPages && bytesWritten)
+            parent.dirtyPages->mark(host_addr, bytesWritten);
         return true;
     }
 }
@@ -252,8 +254,12 @@ CfiMemory::recvAtomicBackdoor(PacketPtr pkt, MemBackdoorPtr &_backdoor)
 {
     Tick latency = recvAtomic(pkt);
 
-    if (backdoor.ptr())
+    if (backdoor.ptr()) {
+        // Writes through the backdoor bypass the tracking.
+        if (dirtyPages && backdoor.writeable())
+            dirtyPages->setUntracked();
         _backdoor = &backdoor;
+    }
     return latency;
 }
 
@@ -279,8 +285,12 @@ void
 CfiMemory::recvMemBackdoorReq(const MemBackdoorReq &req,
         MemBackdoorPtr &_backdoor)
 {
-    if (backdoor.ptr())
+    if (backdoor.ptr()) {
+        // Writes through the backdoor bypass the tracking.
+        if (dirtyPages && backdoor.writeable() && req.writeable())
+            dirtyPages->setUntracked();
         _backdoor = &backdoor;
+    }
 }
 
 bool
@@ -756,6 +766,8 @@ CfiMemory::BlockData::erase(PacketPtr pkt)
 {
     auto host_address = parent.toHostAddr(pkt->getAddr());
     std::memset(host_address, 0xff, blockSize);
+    if (parent.dirtyPages)
+        parent.dirtyPages->mark(host_address, blockSize);
 }
 
 } // namespace memory
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/dirty_page_tracker.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+
+#include "base/intmath.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+namespace
+{
+
+/** Soft-dirty bit of the /proc/self/pagemap entries. */
+constexpr uint64_t PagemapSoftDirty = 1ULL << 55;
+
+} // anonymous namespace
+
+bool DirtyPageTracker::softDirty = false;
+
+std::set<DirtyPageTracker *> &
+DirtyPageTracker::trackers()
+{
+    static std::set<DirtyPageTracker *> all;
+    return all;
+}
+
+DirtyPageTracker::DirtyPageTracker(const uint8_t *pmem, uint64_t size)
+    : pmem(pmem), size(size), pageShift(floorLog2(sysconf(_SC_PAGE_SIZE))),
+      numWords(divCeil(divCeil(size, 1ULL << pageShift), 64)),
+      bits(new std::atomic<uint64_t>[numWords]),
+      untracked(false)
+{
+    for (uint64_t i = 0; i < numWords; i++)
+        bits[i].store(0, std::memory_order_relaxed);
+    trackers().insert(this);
+}
+
+DirtyPageTracker::~DirtyPageTracker()
+{
+    trackers().erase(this);
+}
+
+std::vector<uint64_t>
+DirtyPageTracker::dirtyPages() const
+{
+    const uint64_t num_pages = divCeil(size, 1ULL << pageShift);
+    std::vector<uint64_t> dirty(numWords);
+
+    if (untracked.load(std::memory_order_relaxed) && !softDirty) {
+        for (uint64_t p = 0; p < num_pages; p++)
+            dirty[p / 64] |= 1ULL << (p % 64);
+        return dirty;
+    }
+
+    for (uint64_t i = 0; i < numWords; i++)
+        dirty[i] = bits[i].load(std::memory_order_relaxed);
+
+    // Merge the pages the kernel has seen written.
+    if (untracked.load(std::memory_order_relaxed) && !readSoftDirty(dirty)) {
+        for (uint64_t p = 0; p < num_pages; p++)
+            dirty[p / 64] |= 1ULL << (p % 64);
+    }
+
+    return dirty;
+}
+
+bool
+DirtyPageTracker::readSoftDirty(std::vector<uint64_t> &dirty) const
+{
+    int pagemap = open("/proc/self/pagemap", O_RDONLY);
+    if (pagemap < 0)
+        return false;
+
+    const uint64_t num_pages = divCeil(size, 1ULL << pageShift);
+    const uint64_t first = (uintptr_t)pmem >> pageShift;
+    std::vector<uint64_t> entries(64);
+    for (uint64_t i = 0; i < numWords; i++) {
+        const uint64_t pages = std::min<uint64_t>(64, num_pages - i * 64);
+        const ssize_t bytes = pages * sizeof(uint64_t);
+        if (pread(pagemap, entries.data(), bytes,
+                  (first + i * 64) * sizeof(uint64_t)) != bytes) {
+            std::fill(entries.begin(), entries.end(), PagemapSoftDirty);
+        }
+        for (uint64_t p = 0; p < pages; p++) {
+            if (entries[p] & PagemapSoftDirty)
+                dirty[i] |= 1ULL << p;
+        }
+    }
+    close(pagemap);
+
+    return true;
+}
+
+void
+DirtyPageTracker::clear()
+{
+    for (uint64_t i = 0; i < numWords; i++)
+        bits[i].store(0, std::memory_order_relaxed);
+}
+
+bool
+DirtyPageTracker::clearSoftDirty()
+{
+    // Keep the writes the kernel has seen so far in the bitmaps, or
+    // consider the whole store written when they can't be read.
+    if (softDirty) {
+        for (auto *t : trackers()) {
+            if (!t->untracked.load(std::memory_order_relaxed))
+                continue;
+            std::vector<uint64_t> dirty(t->numWords);
+            if (!t->readSoftDirty(dirty)) {
+                const uint64_t num_pages =
+                    divCeil(t->size, 1ULL << t->pageShift);
+                for (uint64_t p = 0; p < num_pages; p++)
+                    dirty[p / 64] |= 1ULL << (p % 64);
+            }
+            for (uint64_t i = 0; i < t->numWords; i++) {
+                if (dirty[i])
+                    t->bits[i].fetch_or(dirty[i], std::memory_order_relaxed);
+            }
+        }
+    }
+
+    int fd = open("/proc/self/clear_refs", O_WRONLY);
+    if (fd < 0) {
+        softDirty = false;
+        return false;
+    }
+    softDirty = write(fd, "4", 1) == 1;
+    close(fd);
+
+    // Kernels built without soft-dirty support accept the above but
+    // never set the bit, so check that a write to a page sets it.
+    if (softDirty) {
+        const size_t page_size = sysconf(_SC_PAGE_SIZE);
+        void *page = mmap(nullptr, page_size, PROT_READ | PROT_WRITE,
+                          MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (page == MAP_FAILED) {
+            softDirty = false;
+            return false;
+        }
+        *(volatile uint8_t *)page = 1;
+
+        uint64_t entry = 0;
+        int pagemap = open("/proc/self/pagemap", O_RDONLY);
+        softDirty = pagemap >= 0 &&
+            pread(pagemap, &entry, sizeof(entry),
+                  (uintptr_t)page / page_size * sizeof(entry)) ==
+                (ssize_t)sizeof(entry) &&
+            (entry & PagemapSoftDirty);
+        if (pagemap >= 0)
+            close(pagemap);
+        munmap(page, page_size);
+    }
+    return softDirty;
+}
+
+} // namespace memory
+} // namespace gem5
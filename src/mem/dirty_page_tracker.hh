@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_DIRTY_PAGE_TRACKER_HH__
+#define __MEM_DIRTY_PAGE_TRACKER_HH__
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <vector>
+
+namespace gem5
+{
+
+namespace memory
+{
+
+/**
+ * Tracks the host pages of a backing store written since the last
+ * checkpoint, so that the next one only has to store those.
+ *
+ * Writes done through the memories mark the pages themselves. Writes
+ * done behind their back, i.e., through backdoors or by KVM, are
+ * caught by the soft-dirty bits of the host kernel when it has them.
+ * When it doesn't, the whole store is considered dirty as soon as
+ * such a writer may exist.
+ */
+class DirtyPageTracker
+{
+  private:
+    const uint8_t *pmem;
+    const uint64_t size;
+    const unsigned pageShift;
+
+    const uint64_t numWords;
+    std::unique_ptr<std::atomic<uint64_t>[]> bits;
+
+    /** Whether the store may have been written without being marked. */
+    std::atomic<bool> untracked;
+
+    /** Whether the host kernel tracks soft-dirty pages. */
+    static bool softDirty;
+
+    /**
+     * All the trackers of the process, since the soft-dirty bits they
+     * rely on are shared.
+     */
+    static std::set<DirtyPageTracker *> &trackers();
+
+    /**
+     * Add the pages of the store the kernel has seen written to a
+     * bitmap.
+     *
+     * @return Whether the kernel could be asked.
+     */
+    bool readSoftDirty(std::vector<uint64_t> &dirty) const;
+
+  public:
+    DirtyPageTracker(const uint8_t *pmem, uint64_t size);
+    ~DirtyPageTracker();
+
+    DirtyPageTracker(const DirtyPageTracker &) = delete;
+    DirtyPageTracker &operator=(const DirtyPageTracker &) = delete;
+
+    /** Mark the pages of a write to [addr, addr + len) as dirty. */
+    void
+    mark(const uint8_t *addr, uint64_t len)
+    {
+        const uint64_t first = (addr - pmem) >> pageShift;
+        const uint64_t last = (addr - pmem + len - 1) >> pageShift;
+        for (uint64_t p = first; p <= last; p++) {
+            auto &word = bits[p / 64];
+            const uint64_t bit = 1ULL << (p % 64);
+            // Pages are usually written many times between checkpoints,
+            // so avoid the atomic update when the bit is already set.
+            if (!(word.load(std::memory_order_relaxed) & bit))
+                word.fetch_or(bit, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * The store has been handed out to a writer which doesn't mark its
+     * writes, e.g., through a backdoor.
+     */
+    void
+    setUntracked()
+    {
+        untracked.store(true, std::memory_order_relaxed);
+    }
+
+    /**
+     * Get the bitmap of the pages written since the last clear(), one
+     * bit per host page.
+     */
+    std::vector<uint64_t> dirtyPages() const;
+
+    /** Forget about all the writes so far. */
+    void clear();
+
+    /**
+     * Clear the soft-dirty bits of the whole process. Since they are
+     * shared by all the stores, the pages they mark as written are first
+     * moved to the bitmap of every store that relies on them, so that
+     * checkpointing one store doesn't lose the writes to the others.
+     *
+     * @return Whether the host kernel tracks soft-dirty pages.
+     */
+    static bool clearSoftDirty();
+};
+
+} // namespace memory
+} // namespace gem5
+
+#endif // __MEM_DIRTY_PAGE_TRACKER_HH__
@@ -146,9 +146,9 @@ HBMCtrl::recvMemBackdoorReq(const MemBackdoorReq &req,
 {
     auto &range = req.range();
     if (pc0Int && pc0Int->getAddrRange().isSubset(range)) {
-        pc0Int->getBackdoor(backdoor);
+        pc0Int->getBackdoor(backdoor, req.writeable());
     } else if (pc1Int && pc1Int->getAddrRange().isSubset(range)) {
-        pc1Int->getBackdoor(backdoor);
+        pc1Int->getBackdoor(backdoor, req.writeable());
     }
     else {
         panic("Can't handle address range for range %s\n", range.to_string());
@@ -1388,7 +1388,7 @@ MemCtrl::recvMemBackdoorReq(const MemBackdoorReq &req,
             "Can't handle address range for backdoor %s.",
             req.range().to_string());
 
-    dram->getBackdoor(backdoor);
+    dram->getBackdoor(backdoor, req.writeable());
 }
 
 bool
@@ -47,6 +47,7 @@
 #include <cerrno>
 #include <climits>
 #include <cstdio>
+#include <filesystem>
 #include <iostream>
 #include <string>
 
@@ -55,6 +56,7 @@
 #include "debug/AddrRanges.hh"
 #include "debug/Checkpoint.hh"
 #include "mem/abstract_mem.hh"
+#include "mem/store_checkpoint.hh"
 #include "sim/serialize.hh"
 #include "sim/sim_exit.hh"
 
@@ -80,11 +82,27 @@ PhysicalMemory::PhysicalMemory(const std::string& _name,
                                const std::vector<AbstractMemory*>& _memories,
                                bool mmap_using_noreserve,
                                const std::string& shared_backstore,
-                               bool auto_unlink_shared_backstore) :
+                               bool auto_unlink_shared_backstore,
+                               const StoreCheckpointConfig& store_cpt_config) :
     _name(_name), size(0), mmapUsingNoReserve(mmap_using_noreserve),
     sharedBackstore(shared_backstore), sharedBackstoreSize(0),
-    pageSize(sysconf(_SC_PAGE_SIZE))
+    pageSize(sysconf(_SC_PAGE_SIZE)), storeCptConfig(store_cpt_config)
 {
+    if (storeCptConfig.delta) {
+        fatal_if(storeCptConfig.legacy,
+                 "Delta memory checkpoints need the sparse format");
+        if (!DirtyPageTracker::clearSoftDirty()) {
+            inform("No soft-dirty page tracking on this host, delta memory "
+                   "checkpoints will be full ones once a backdoor or KVM "
+                   "is used\n");
+        }
+        // Soft-dirty bits only cover the writes of this process.
+        if (!sharedBackstore.empty()) {
+            warn("Other processes may write the shared backing store, so "
+                 "delta memory checkpoints will be full ones\n");
+        }
+    }
+
     // Register cleanup callback if requested.
     if (auto_unlink_shared_backstore && !sharedBackstore.empty()) {
         registerExitCallback([=]() { shm_unlink(shared_backstore.c_str()); });
@@ -253,12 +271,17 @@ PhysicalMemory::createBackingStore(
     backingStore.emplace_back(range, pmem,
                               conf_table_reported, in_addr_map, kvm_map,
                               shm_fd, map_offset);
+    mappedStores.push_back(false);
+    storeChains.emplace_back();
+    dirtyPages.emplace_back(storeCptConfig.delta ?
+            new DirtyPageTracker(pmem, range.size()) : nullptr);
 
     // point the memories to their backing store
     for (const auto& m : _memories) {
         DPRINTF(AddrRanges, "Mapping memory %s to backing store\n",
                 m->name());
         m->setBackingStore(pmem);
+        m->setDirtyPageTracker(dirtyPages.back().get());
     }
 }
 
@@ -275,6 +298,13 @@ PhysicalMemory::isMemAddr(Addr addr) const
     return addrMap.contains(addr) != addrMap.end();
 }
 
+AbstractMemory *
+PhysicalMemory::findMemory(Addr addr) const
+{
+    auto m = addrMap.contains(addr);
+    return m == addrMap.end() ? nullptr : m->second;
+}
+
 AddrRangeList
 PhysicalMemory::getConfAddrRanges() const
 {
@@ -357,11 +387,83 @@ PhysicalMemory::serialize(CheckpointOut &cp) const
         ScopedCheckpointSection sec(cp, csprintf("store%d", store_id));
         serializeStore(cp, store_id++, s.range, s.pmem);
     }
+
+    // the next delta checkpoint is relative to this one
+    if (storeCptConfig.delta)
+        resetDirtyPages();
+}
+
+void
+PhysicalMemory::resetDirtyPages() const
+{
+    // Other memories may still need the soft-dirty bits, which are
+    // moved to their trackers before being cleared, so only forget about
+    // the pages of this one afterwards.
+    DirtyPageTracker::clearSoftDirty();
+    for (auto &d : dirtyPages)
+        d->clear();
 }
 
 void
 PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
                                AddrRange range, uint8_t* pmem) const
+{
+    if (storeCptConfig.legacy) {
+        serializeLegacyStore(cp, store_id, range, pmem);
+        return;
+    }
+
+    // we cannot use the address range for the name as the
+    // memories that are not part of the address map can overlap
+    std::string filename =
+        name() + ".store" + std::to_string(store_id) + ".spmem";
+    long range_size = range.size();
+    std::string format = "sparse";
+
+    DPRINTF(Checkpoint, "Serializing physical memory %s with size %d\n",
+            filename, range_size);
+
+    SERIALIZE_SCALAR(store_id);
+    SERIALIZE_SCALAR(filename);
+    SERIALIZE_SCALAR(range_size);
+    SERIALIZE_SCALAR(format);
+
+    const std::string dir = CheckpointIn::dir();
+    const std::string filepath = dir + "/" + filename;
+    auto &chain = storeChains[store_id];
+
+    // A delta store needs the stores of the previous checkpoints, which
+    // are referred to relative to this one so that checkpoint
+    // directories can be moved together.
+    std::vector<uint64_t> dirty;
+    if (storeCptConfig.delta && sharedBackstore.empty() &&
+            !chain.empty() && chain.size() <= storeCptConfig.maxDeltaChain) {
+        unsigned int num_parents = chain.size();
+        SERIALIZE_SCALAR(num_parents);
+        for (unsigned int i = 0; i < num_parents; i++) {
+            paramOut(cp, csprintf("parent%d", i),
+                     std::filesystem::relative(chain[i], dir).string());
+        }
+        dirty = dirtyPages[store_id]->dirtyPages();
+    } else {
+        chain.clear();
+    }
+
+    // Untouched pages of private anonymous mappings are known to be zero.
+    const bool anonymous = sharedBackstore.empty() && !mappedStores[store_id];
+    writeSparseStore(filepath, pmem, range.size(), anonymous,
+                     storeCptConfig, chain.empty() ? nullptr : &dirty);
+
+    if (storeCptConfig.delta) {
+        chain.push_back(
+                std::filesystem::absolute(filepath).lexically_normal());
+    }
+}
+
+void
+PhysicalMemory::serializeLegacyStore(CheckpointOut &cp,
+                                     unsigned int store_id,
+                                     AddrRange range, uint8_t* pmem) const
 {
     // we cannot use the address range for the name as the
     // memories that are not part of the address map can overlap
@@ -429,6 +531,9 @@ PhysicalMemory::unserialize(CheckpointIn &cp)
         unserializeStore(cp);
     }
 
+    // the next delta checkpoint is relative to the restored one
+    if (storeCptConfig.delta)
+        resetDirtyPages();
 }
 
 void
@@ -443,6 +548,66 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
     UNSERIALIZE_SCALAR(filename);
     std::string filepath = cp.getCptDir() + "/" + filename;
 
+    // checkpoints without a format use the legacy one
+    std::string format;
+    if (optParamIn(cp, "format", format, false) && format == "sparse") {
+        long range_size;
+        UNSERIALIZE_SCALAR(range_size);
+        DPRINTF(Checkpoint, "Unserializing physical memory %s with size %d\n",
+                filename, range_size);
+
+        // a delta store is applied on top of the ones it builds on
+        auto &chain = storeChains[store_id];
+        chain.clear();
+        unsigned int num_parents = 0;
+        optParamIn(cp, "num_parents", num_parents, false);
+        for (unsigned int i = 0; i < num_parents; i++) {
+            std::string parent;
+            paramIn(cp, csprintf("parent%d", i), parent);
+            chain.push_back(std::filesystem::absolute(
+                    std::filesystem::path(cp.getCptDir()) / parent)
+                .lexically_normal());
+        }
+        chain.push_back(
+                std::filesystem::absolute(filepath).lexically_normal());
+
+        // map a flattened copy of the stores, shared with the other
+        // processes restoring them, and only keep the pages written to
+        if (!storeCptConfig.sharedImageDir.empty() &&
+                sharedBackstore.empty()) {
+            const std::string image = sharedSparseStore(
+                    chain, storeCptConfig.sharedImageDir,
+                    backingStore[store_id].range.size(),
+                    storeCptConfig.threads);
+            DPRINTF(Checkpoint, "Mapping shared physical memory image %s\n",
+                    image);
+            mappedStores[store_id] = readSparseStore(
+                    image, backingStore[store_id].pmem,
+                    backingStore[store_id].range.size(), true,
+                    storeCptConfig.threads);
+            return;
+        }
+
+        // a shared backing store has to stay shared, so it can't be
+        // replaced by a private mapping of the checkpoint
+        bool mapped = false;
+        for (const auto &store_file : chain) {
+            DPRINTF(Checkpoint, "Applying physical memory store %s\n",
+                    store_file);
+            mapped |= readSparseStore(
+                    store_file, backingStore[store_id].pmem,
+                    backingStore[store_id].range.size(),
+                    sharedBackstore.empty(), storeCptConfig.threads);
+        }
+        mappedStores[store_id] = mapped;
+        return;
+    }
+    fatal_if(!format.empty(), "Unknown physical memory checkpoint format %s",
+             format);
+
+    // a legacy store can't be the base of a delta one
+    storeChains[store_id].clear();
+
     // mmap memoryfile
     gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
     if (compressed_mem == NULL)
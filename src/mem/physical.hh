@@ -39,12 +39,15 @@
 #define __MEM_PHYSICAL_HH__
 
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "base/addr_range.hh"
 #include "base/addr_range_map.hh"
+#include "mem/dirty_page_tracker.hh"
 #include "mem/packet.hh"
+#include "mem/store_checkpoint.hh"
 #include "sim/serialize.hh"
 
 namespace gem5
@@ -162,6 +165,21 @@ class PhysicalMemory : public Serializable
     // system
     std::vector<BackingStoreEntry> backingStore;
 
+    // How to checkpoint the backing stores
+    const StoreCheckpointConfig storeCptConfig;
+
+    // Backing stores which have been restored by mapping a checkpoint,
+    // and hence aren't anonymous mappings anymore
+    std::vector<bool> mappedStores;
+
+    // Pages of each backing store written since the last checkpoint,
+    // only tracked for delta checkpoints
+    std::vector<std::unique_ptr<DirtyPageTracker>> dirtyPages;
+
+    // Store files the current content of each backing store is
+    // relative to, oldest first, which a delta checkpoint builds on
+    mutable std::vector<std::vector<std::string>> storeChains;
+
     // Prevent copying
     PhysicalMemory(const PhysicalMemory&);
 
@@ -191,7 +209,8 @@ class PhysicalMemory : public Serializable
                    const std::vector<AbstractMemory*>& _memories,
                    bool mmap_using_noreserve,
                    const std::string& shared_backstore,
-                   bool auto_unlink_shared_backstore);
+                   bool auto_unlink_shared_backstore,
+                   const StoreCheckpointConfig& store_cpt_config={});
 
     /**
      * Unmap all the backing store we have used.
@@ -213,6 +232,15 @@ class PhysicalMemory : public Serializable
      */
     bool isMemAddr(Addr addr) const;
 
+    /**
+     * Find the memory in the global address map that contains a
+     * physical address.
+     *
+     * @param addr A physical address
+     * @return The memory, or nullptr if the address isn't mapped
+     */
+    AbstractMemory *findMemory(Addr addr) const;
+
     /**
      * Get the memory ranges for all memories that are to be reported
      * to the configuration table. The ranges are merged before they
@@ -243,7 +271,14 @@ class PhysicalMemory : public Serializable
      * @return Pointers to the memory backing store
      */
     std::vector<BackingStoreEntry> getBackingStore() const
-    { return backingStore; }
+    {
+        // the users of the backing store write it behind our back
+        for (auto &d : dirtyPages) {
+            if (d)
+                d->setUntracked();
+        }
+        return backingStore;
+    }
 
     /**
      * Perform an untimed memory access and update all the state
@@ -284,6 +319,19 @@ class PhysicalMemory : public Serializable
     void serializeStore(CheckpointOut &cp, unsigned int store_id,
                         AddrRange range, uint8_t* pmem) const;
 
+    /**
+     * Serialize a specific store as a single gzip stream, the format
+     * used before sparse store checkpoints.
+     */
+    void serializeLegacyStore(CheckpointOut &cp, unsigned int store_id,
+                              AddrRange range, uint8_t* pmem) const;
+
+    /**
+     * Forget about the pages written so far, once the backing stores
+     * match the last checkpoint.
+     */
+    void resetDirtyPages() const;
+
     /**
      * Unserialize the memories in the system. As with the
      * serialization, this action is independent of how the address
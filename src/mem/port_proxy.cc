@@ -37,27 +37,52 @@
 
 #include "mem/port_proxy.hh"
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 #include "base/chunk_generator.hh"
 #include "cpu/thread_context.hh"
 #include "mem/port.hh"
+#include "sim/system.hh"
 
 namespace gem5
 {
 
 PortProxy::PortProxy(ThreadContext *tc, unsigned int cache_line_size) :
     PortProxy([tc](PacketPtr pkt)->void { tc->sendFunctional(pkt); },
-        cache_line_size)
+        cache_line_size,
+        [tc](Addr addr, size_t size, bool write)->uint8_t * {
+            return tc->getSystemPtr()->hostPtr(addr, size, write);
+        })
 {}
 
-PortProxy::PortProxy(const RequestPort &port, unsigned int cache_line_size) :
+PortProxy::PortProxy(const RequestPort &port, unsigned int cache_line_size,
+                     HostPtrFunc host_ptr) :
     PortProxy([&port](PacketPtr pkt)->void { port.sendFunctional(pkt); },
-        cache_line_size)
+        cache_line_size, host_ptr)
 {}
 
+uint8_t *
+PortProxy::directPtr(Addr addr, Request::Flags flags, int size,
+                     bool write) const
+{
+    // Flags may change how the memory system handles an access, e.g.,
+    // which security state it's in, so only plain accesses go direct.
+    if (!hostPtr || flags != 0 || size <= 0)
+        return nullptr;
+    return hostPtr(addr, size, write);
+}
+
 void
 PortProxy::readBlobPhys(Addr addr, Request::Flags flags,
                         void *p, int size) const
 {
+    if (uint8_t *host = directPtr(addr, flags, size, false)) {
+        std::memcpy(p, host, size);
+        return;
+    }
+
     for (ChunkGenerator gen(addr, size, _cacheLineSize); !gen.done();
          gen.next()) {
 
@@ -75,6 +100,11 @@ void
 PortProxy::writeBlobPhys(Addr addr, Request::Flags flags,
                          const void *p, int size) const
 {
+    if (uint8_t *host = directPtr(addr, flags, size, true)) {
+        std::memcpy(host, p, size);
+        return;
+    }
+
     for (ChunkGenerator gen(addr, size, _cacheLineSize); !gen.done();
          gen.next()) {
 
@@ -92,13 +122,24 @@ void
 PortProxy::memsetBlobPhys(Addr addr, Request::Flags flags,
                           uint8_t v, int size) const
 {
-    // quick and dirty...
-    uint8_t *buf = new uint8_t[size];
+    if (uint8_t *host = directPtr(addr, flags, size, true)) {
+        std::memset(host, v, size);
+        return;
+    }
 
-    std::memset(buf, v, size);
-    PortProxy::writeBlobPhys(addr, flags, buf, size);
+    // Every packet carries the same data, so they can all share one
+    // buffer the size of a single transaction.
+    std::vector<uint8_t> buf(std::min<int>(size, _cacheLineSize), v);
+    for (ChunkGenerator gen(addr, size, _cacheLineSize); !gen.done();
+         gen.next()) {
+
+        auto req = std::make_shared<Request>(
+            gen.addr(), gen.size(), flags, Request::funcRequestorId);
 
-    delete [] buf;
+        Packet pkt(req, MemCmd::WriteReq);
+        pkt.dataStaticConst(buf.data());
+        sendFunctional(&pkt);
+    }
 }
 
 bool
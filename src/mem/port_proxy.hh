@@ -57,6 +57,8 @@
 #ifndef __MEM_PORT_PROXY_HH__
 #define __MEM_PORT_PROXY_HH__
 
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <limits>
 
@@ -80,6 +82,11 @@ class ThreadContext;
  *
  * The addresses are interpreted as physical addresses.
  *
+ * The owner of the proxy can also give it a way to find host memory
+ * backing a physical range, for accesses that may bypass the memory
+ * system. Accesses to such ranges are then plain copies instead of
+ * functional packets.
+ *
  * @sa SETranslatingProxy
  * @sa FSTranslatingProxy
  */
@@ -88,12 +95,28 @@ class PortProxy : FunctionalRequestProtocol
   public:
     typedef std::function<void(PacketPtr pkt)> SendFunctionalFunc;
 
+    /**
+     * Returns a host pointer to size bytes of memory at a physical
+     * address, or nullptr if accesses must go through the memory system.
+     * The last argument tells whether the memory is about to be written.
+     */
+    typedef std::function<uint8_t *(Addr addr, size_t size, bool write)>
+        HostPtrFunc;
+
   private:
     SendFunctionalFunc sendFunctional;
+    HostPtrFunc hostPtr;
 
     /** Granularity of any transactions issued through this proxy. */
     const unsigned int _cacheLineSize;
 
+    /**
+     * Host memory to access directly instead of sending packets, or
+     * nullptr if there is none.
+     */
+    uint8_t *directPtr(Addr addr, Request::Flags flags, int size,
+                       bool write) const;
+
     void
     recvFunctionalSnoop(PacketPtr pkt) override
     {
@@ -103,13 +126,16 @@ class PortProxy : FunctionalRequestProtocol
     }
 
   public:
-    PortProxy(SendFunctionalFunc func, unsigned int cache_line_size) :
-        sendFunctional(func), _cacheLineSize(cache_line_size)
+    PortProxy(SendFunctionalFunc func, unsigned int cache_line_size,
+              HostPtrFunc host_ptr=nullptr) :
+        sendFunctional(func), hostPtr(host_ptr),
+        _cacheLineSize(cache_line_size)
     {}
 
     // Helpers which create typical SendFunctionalFunc-s from other objects.
     PortProxy(ThreadContext *tc, unsigned int cache_line_size);
-    PortProxy(const RequestPort &port, unsigned int cache_line_size);
+    PortProxy(const RequestPort &port, unsigned int cache_line_size,
+              HostPtrFunc host_ptr=nullptr);
 
     virtual ~PortProxy() {}
 
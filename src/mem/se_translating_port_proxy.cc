@@ -40,6 +40,7 @@
 
 #include "mem/se_translating_port_proxy.hh"
 
+#include "sim/mem_state.hh"
 #include "sim/process.hh"
 #include "sim/system.hh"
 
@@ -57,6 +58,13 @@ SETranslatingPortProxy::fixupRange(const TranslationGen::Range &range,
 {
     auto *process = _tc->getProcessPtr();
 
+    // Pages of lazily loaded images are filled on their first access,
+    // whether it is a read or a write.
+    if (process->memState->loadLazyRange(range.vaddr,
+                                         range.vaddr + range.size)) {
+        return true;
+    }
+
     if (mode == BaseMMU::Write) {
         if (allocating == Always) {
             process->allocateMem(range.vaddr, range.size);
@@ -0,0 +1,530 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "mem/store_checkpoint.hh"
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "base/bitfield.hh"
+#include "base/cprintf.hh"
+#include "base/intmath.hh"
+#include "base/logging.hh"
+
+namespace gem5
+{
+
+namespace memory
+{
+
+namespace
+{
+
+const char Magic[8] = {'g', 'e', 'm', '5', 's', 'p', 'm', '1'};
+constexpr uint64_t ChunkSize = 1 << 20;
+
+struct Header
+{
+    char magic[8];
+    uint32_t pageSize;
+    int32_t compressionLevel;
+    uint64_t size;
+    uint64_t chunkSize;
+    uint64_t numChunks;
+    uint64_t indexOffset;
+};
+
+/**
+ * Index entry of a stored chunk, followed in the index by the bitmap of
+ * its non-zero pages.
+ */
+struct ChunkEntry
+{
+    uint64_t chunk;
+    uint64_t offset;
+    uint64_t bytes;
+};
+
+struct Chunk
+{
+    ChunkEntry entry = {};
+    std::vector<uint64_t> pages;
+};
+
+/** Page present (bit 63) or swapped (bit 62) in /proc/self/pagemap. */
+constexpr uint64_t PagemapUsed = 3ULL << 62;
+
+unsigned
+numThreads(unsigned threads)
+{
+    if (threads)
+        return threads;
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+/** Call func(i) for i in [0, n) from several threads. */
+void
+parallelFor(unsigned threads, uint64_t n,
+            const std::function<void(uint64_t)> &func)
+{
+    std::atomic<uint64_t> next(0);
+    auto worker = [&]() {
+        for (uint64_t i = next++; i < n; i = next++)
+            func(i);
+    };
+
+    std::vector<std::thread> workers;
+    for (unsigned t = 1; t < std::min<uint64_t>(threads, n); t++)
+        workers.emplace_back(worker);
+    worker();
+    for (auto &w: workers)
+        w.join();
+}
+
+bool
+isZero(const uint8_t *page, size_t size)
+{
+    const uint64_t *words = reinterpret_cast<const uint64_t *>(page);
+    for (size_t i = 0; i < size / sizeof(uint64_t); i++) {
+        if (words[i])
+            return false;
+    }
+    return true;
+}
+
+void
+pwriteAll(int fd, const void *buf, size_t len, off_t offset,
+          const std::string &path)
+{
+    const uint8_t *ptr = static_cast<const uint8_t *>(buf);
+    while (len) {
+        ssize_t ret = pwrite(fd, ptr, len, offset);
+        fatal_if(ret < 0, "Write failed on memory checkpoint file '%s': %s",
+                 path, strerror(errno));
+        ptr += ret;
+        offset += ret;
+        len -= ret;
+    }
+}
+
+void
+preadAll(int fd, void *buf, size_t len, off_t offset,
+         const std::string &path)
+{
+    uint8_t *ptr = static_cast<uint8_t *>(buf);
+    while (len) {
+        ssize_t ret = pread(fd, ptr, len, offset);
+        fatal_if(ret <= 0, "Read failed on memory checkpoint file '%s'",
+                 path);
+        ptr += ret;
+        offset += ret;
+        len -= ret;
+    }
+}
+
+/** A store in the sparse format, opened for reading. */
+struct StoreReader
+{
+    StoreReader(const std::string &_path, uint64_t size);
+    ~StoreReader() { close(fd); }
+
+    /**
+     * Write the contents of a chunk to the bytes of memory it covers,
+     * starting at dst.
+     */
+    void apply(const Chunk &chunk, uint8_t *dst, uint64_t bytes) const;
+
+    const std::string path;
+    int fd;
+    Header header;
+    std::vector<Chunk> chunks;
+};
+
+StoreReader::StoreReader(const std::string &_path, uint64_t size)
+    : path(_path)
+{
+    fd = open(path.c_str(), O_RDONLY);
+    fatal_if(fd < 0, "Can't open memory checkpoint file '%s'", path);
+
+    preadAll(fd, &header, sizeof(header), 0, path);
+    fatal_if(memcmp(header.magic, Magic, sizeof(Magic)),
+             "'%s' isn't a sparse memory checkpoint", path);
+    fatal_if(header.size != size,
+             "Memory range size has changed! Saw %lld, expected %lld\n",
+             header.size, size);
+
+    const uint64_t bitmap_words =
+        divCeil(header.chunkSize / header.pageSize, 64);
+    const uint64_t entry_bytes =
+        sizeof(ChunkEntry) + bitmap_words * sizeof(uint64_t);
+
+    std::vector<uint8_t> index(header.numChunks * entry_bytes);
+    preadAll(fd, index.data(), index.size(), header.indexOffset, path);
+
+    chunks.resize(header.numChunks);
+    for (uint64_t i = 0; i < header.numChunks; i++) {
+        const uint8_t *entry = index.data() + i * entry_bytes;
+        memcpy(&chunks[i].entry, entry, sizeof(ChunkEntry));
+        chunks[i].pages.resize(bitmap_words);
+        memcpy(chunks[i].pages.data(), entry + sizeof(ChunkEntry),
+               bitmap_words * sizeof(uint64_t));
+    }
+}
+
+void
+StoreReader::apply(const Chunk &chunk, uint8_t *dst, uint64_t bytes) const
+{
+    const uint64_t page_size = header.pageSize;
+
+    std::vector<uint8_t> data(chunk.entry.bytes);
+    preadAll(fd, data.data(), data.size(), chunk.entry.offset, path);
+
+    // Uncompressed chunks hold all their pages.
+    if (header.compressionLevel == 0) {
+        memcpy(dst, data.data(), bytes);
+        return;
+    }
+
+    uLongf len = 0;
+    for (auto word: chunk.pages)
+        len += popCount(word) * page_size;
+    std::vector<uint8_t> pages(len);
+    fatal_if(uncompress(pages.data(), &len, data.data(),
+                        data.size()) != Z_OK,
+             "Failed to uncompress memory checkpoint '%s'", path);
+
+    const uint8_t *page = pages.data();
+    for (uint64_t p = 0; p * page_size < bytes; p++) {
+        if (!(chunk.pages[p / 64] & (1ULL << (p % 64))))
+            continue;
+        const uint64_t page_len = std::min(page_size, bytes - p * page_size);
+        memcpy(dst + p * page_size, page, page_len);
+        page += page_len;
+    }
+}
+
+} // anonymous namespace
+
+void
+writeSparseStore(const std::string &path, const uint8_t *pmem,
+                 uint64_t size, bool anonymous,
+                 const StoreCheckpointConfig &config,
+                 const std::vector<uint64_t> *dirty)
+{
+    const uint64_t page_size = sysconf(_SC_PAGE_SIZE);
+    const uint64_t chunk_pages = ChunkSize / page_size;
+    const uint64_t num_chunks = divCeil(size, ChunkSize);
+    const bool compress = config.compressionLevel != 0;
+
+    int fd = open(path.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0664);
+    fatal_if(fd < 0, "Can't open memory checkpoint file '%s'", path);
+
+    int pagemap = anonymous && !dirty ?
+        open("/proc/self/pagemap", O_RDONLY) : -1;
+
+    // The chunks are written in the order they are done, the index tells
+    // where each of them is.
+    std::atomic<uint64_t> next_offset(page_size);
+    std::mutex chunks_mutex;
+    std::vector<Chunk> chunks;
+
+    parallelFor(numThreads(config.threads), num_chunks, [&](uint64_t c) {
+        const uint64_t start = c * ChunkSize;
+        const uint64_t bytes = std::min(ChunkSize, size - start);
+        const uint64_t pages = divCeil(bytes, page_size);
+
+        std::vector<uint64_t> used(pages, PagemapUsed);
+        if (dirty) {
+            // Pages written since the parent checkpoint have to be
+            // stored even if they are zero now.
+            for (uint64_t p = 0; p < pages; p++) {
+                const uint64_t page = c * chunk_pages + p;
+                if (!((*dirty)[page / 64] & (1ULL << (page % 64))))
+                    used[p] = 0;
+            }
+        } else if (pagemap >= 0) {
+            const off_t offset =
+                (uintptr_t)(pmem + start) / page_size * sizeof(uint64_t);
+            if (pread(pagemap, used.data(), pages * sizeof(uint64_t),
+                      offset) != (ssize_t)(pages * sizeof(uint64_t))) {
+                std::fill(used.begin(), used.end(), PagemapUsed);
+            }
+        }
+
+        Chunk chunk;
+        chunk.pages.resize(divCeil(chunk_pages, 64));
+        std::vector<uint8_t> data;
+        bool stored = false;
+        for (uint64_t p = 0; p < pages; p++) {
+            const uint8_t *page = pmem + start + p * page_size;
+            const uint64_t len = std::min(page_size, bytes - p * page_size);
+            if (!(used[p] & PagemapUsed) || (!dirty && isZero(page, len)))
+                continue;
+            stored = true;
+            chunk.pages[p / 64] |= 1ULL << (p % 64);
+            if (compress)
+                data.insert(data.end(), page, page + len);
+        }
+        if (!stored)
+            return;
+
+        const uint8_t *out = pmem + start;
+        uint64_t out_len = bytes;
+        std::vector<uint8_t> compressed;
+        if (compress) {
+            uLongf len = compressBound(data.size());
+            compressed.resize(len);
+            fatal_if(compress2(compressed.data(), &len, data.data(),
+                               data.size(), config.compressionLevel) != Z_OK,
+                     "Failed to compress memory checkpoint '%s'", path);
+            out = compressed.data();
+            out_len = len;
+        }
+
+        // Keep uncompressed chunks page aligned so they can be mapped.
+        const uint64_t offset = next_offset.fetch_add(
+                compress ? out_len : roundUp(out_len, page_size));
+        pwriteAll(fd, out, out_len, offset, path);
+
+        chunk.entry = {c, offset, out_len};
+        std::lock_guard<std::mutex> lock(chunks_mutex);
+        chunks.push_back(std::move(chunk));
+    });
+
+    if (pagemap >= 0)
+        close(pagemap);
+
+    std::sort(chunks.begin(), chunks.end(),
+              [](const Chunk &a, const Chunk &b) {
+                  return a.entry.chunk < b.entry.chunk;
+              });
+
+    std::vector<uint8_t> index;
+    for (const auto &chunk: chunks) {
+        const uint8_t *entry = (const uint8_t *)&chunk.entry;
+        index.insert(index.end(), entry, entry + sizeof(chunk.entry));
+        const uint8_t *pages = (const uint8_t *)chunk.pages.data();
+        index.insert(index.end(), pages,
+                     pages + chunk.pages.size() * sizeof(uint64_t));
+    }
+
+    Header header = {};
+    memcpy(header.magic, Magic, sizeof(Magic));
+    header.pageSize = page_size;
+    header.compressionLevel = config.compressionLevel;
+    header.size = size;
+    header.chunkSize = ChunkSize;
+    header.numChunks = chunks.size();
+    header.indexOffset = roundUp(next_offset.load(), page_size);
+
+    pwriteAll(fd, index.data(), index.size(), header.indexOffset, path);
+    pwriteAll(fd, &header, sizeof(header), 0, path);
+
+    fatal_if(close(fd), "Close failed on memory checkpoint file '%s'", path);
+}
+
+bool
+readSparseStore(const std::string &path, uint8_t *pmem, uint64_t size,
+                bool allow_map, unsigned threads)
+{
+    const StoreReader store(path, size);
+    const Header &header = store.header;
+    const uint64_t page_size = header.pageSize;
+
+    const bool map = allow_map && header.compressionLevel == 0 &&
+        page_size == (uint64_t)sysconf(_SC_PAGE_SIZE);
+
+    if (map) {
+        // Adjacent chunks are adjacent in the file, so the kernel merges
+        // their mappings.
+        for (const auto &chunk: store.chunks) {
+            void *addr = pmem + chunk.entry.chunk * header.chunkSize;
+            void *ret = mmap(addr, roundUp(chunk.entry.bytes, page_size),
+                             PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED,
+                             store.fd, chunk.entry.offset);
+            fatal_if(ret == MAP_FAILED,
+                     "Failed to map memory checkpoint file '%s': %s", path,
+                     strerror(errno));
+        }
+        return !store.chunks.empty();
+    }
+
+    parallelFor(numThreads(threads), store.chunks.size(), [&](uint64_t i) {
+        const Chunk &chunk = store.chunks[i];
+        const uint64_t start = chunk.entry.chunk * header.chunkSize;
+        store.apply(chunk, pmem + start,
+                    std::min(header.chunkSize, size - start));
+    });
+
+    return false;
+}
+
+void
+flattenSparseStores(const std::vector<std::string> &paths,
+                    const std::string &out_path, uint64_t size,
+                    unsigned threads)
+{
+    const uint64_t page_size = sysconf(_SC_PAGE_SIZE);
+    const uint64_t num_chunks = divCeil(size, ChunkSize);
+
+    // Find which chunks each store holds.
+    std::vector<std::unique_ptr<StoreReader>> stores;
+    std::vector<std::vector<const Chunk *>> chunk_maps;
+    for (const auto &path: paths) {
+        stores.emplace_back(new StoreReader(path, size));
+        fatal_if(stores.back()->header.chunkSize != ChunkSize,
+                 "Memory checkpoint '%s' uses a different chunk size", path);
+        chunk_maps.emplace_back(num_chunks, nullptr);
+        for (const auto &chunk: stores.back()->chunks)
+            chunk_maps.back()[chunk.entry.chunk] = &chunk;
+    }
+
+    int fd = open(out_path.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0664);
+    fatal_if(fd < 0, "Can't open memory checkpoint file '%s'", out_path);
+
+    // Every chunk has a fixed place in the file, so that the chunks are
+    // adjacent in the file when they are adjacent in memory.
+    const uint64_t chunk_pages = ChunkSize / page_size;
+    std::vector<Chunk> out_chunks(num_chunks);
+    parallelFor(numThreads(threads), num_chunks, [&](uint64_t c) {
+        const uint64_t start = c * ChunkSize;
+        const uint64_t bytes = std::min(ChunkSize, size - start);
+
+        std::vector<uint8_t> data(bytes, 0);
+        bool any = false;
+        for (size_t s = 0; s < stores.size(); s++) {
+            if (const Chunk *chunk = chunk_maps[s][c]) {
+                stores[s]->apply(*chunk, data.data(), bytes);
+                any = true;
+            }
+        }
+        if (!any)
+            return;
+
+        Chunk &out = out_chunks[c];
+        out.pages.resize(divCeil(chunk_pages, 64));
+        bool stored = false;
+        for (uint64_t p = 0; p * page_size < bytes; p++) {
+            const uint64_t len = std::min(page_size, bytes - p * page_size);
+            if (isZero(data.data() + p * page_size, len))
+                continue;
+            stored = true;
+            out.pages[p / 64] |= 1ULL << (p % 64);
+        }
+        if (!stored)
+            return;
+
+        out.entry = {c, page_size + start, bytes};
+        pwriteAll(fd, data.data(), bytes, out.entry.offset, out_path);
+    });
+
+    std::vector<uint8_t> index;
+    uint64_t num_stored = 0;
+    for (const auto &chunk: out_chunks) {
+        if (!chunk.entry.bytes)
+            continue;
+        const uint8_t *entry = (const uint8_t *)&chunk.entry;
+        index.insert(index.end(), entry, entry + sizeof(chunk.entry));
+        const uint8_t *pages = (const uint8_t *)chunk.pages.data();
+        index.insert(index.end(), pages,
+                     pages + chunk.pages.size() * sizeof(uint64_t));
+        num_stored++;
+    }
+
+    Header header = {};
+    memcpy(header.magic, Magic, sizeof(Magic));
+    header.pageSize = page_size;
+    header.compressionLevel = 0;
+    header.size = size;
+    header.chunkSize = ChunkSize;
+    header.numChunks = num_stored;
+    header.indexOffset = page_size + roundUp(size, page_size);
+
+    pwriteAll(fd, index.data(), index.size(), header.indexOffset, out_path);
+    pwriteAll(fd, &header, sizeof(header), 0, out_path);
+
+    fatal_if(close(fd), "Close failed on memory checkpoint file '%s'",
+             out_path);
+}
+
+std::string
+sharedSparseStore(const std::vector<std::string> &paths,
+                  const std::string &cache_dir, uint64_t size,
+                  unsigned threads)
+{
+    // Identify the stores by their path and modification time, so that a
+    // checkpoint taken again in the same place isn't mistaken for the
+    // previous one.
+    std::string key;
+    for (const auto &path: paths) {
+        struct stat st;
+        fatal_if(stat(path.c_str(), &st),
+                 "Can't open memory checkpoint file '%s'", path);
+        key += csprintf("%s:%d.%09d;", path, st.st_mtim.tv_sec,
+                        st.st_mtim.tv_nsec);
+    }
+    const std::string image = csprintf("%s/%016x.spmem", cache_dir,
+                                       std::hash<std::string>()(key));
+
+    // Only one process writes the image, the others wait for it.
+    const std::string lock_path = image + ".lock";
+    int lock = open(lock_path.c_str(), O_CREAT | O_RDWR, 0664);
+    fatal_if(lock < 0, "Can't open memory image lock '%s': %s", lock_path,
+             strerror(errno));
+    fatal_if(flock(lock, LOCK_EX), "Can't lock memory image '%s': %s",
+             lock_path, strerror(errno));
+
+    if (access(image.c_str(), R_OK) != 0) {
+        inform("Writing shared memory image %s\n", image);
+        const std::string tmp = csprintf("%s.%d", image, getpid());
+        flattenSparseStores(paths, tmp, size, threads);
+        fatal_if(rename(tmp.c_str(), image.c_str()),
+                 "Can't rename memory image '%s': %s", tmp,
+                 strerror(errno));
+    }
+
+    flock(lock, LOCK_UN);
+    close(lock);
+    return image;
+}
+
+} // namespace memory
+} // namespace gem5
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __MEM_STORE_CHECKPOINT_HH__
+#define __MEM_STORE_CHECKPOINT_HH__
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace gem5
+{
+
+namespace memory
+{
+
+/**
+ * @file
+ * Sparse checkpoint format of the physical memory backing stores.
+ *
+ * A store is split in fixed size chunks. Chunks which only contain zero
+ * pages aren't stored at all, and the others are compressed in parallel
+ * by worker threads. A chunk stores its non-zero pages only when it is
+ * compressed, and all its pages otherwise, at page aligned offsets, so
+ * that uncompressed stores can be restored lazily by mapping the file
+ * copy-on-write over the backing store.
+ *
+ * Pages of private anonymous stores which have never been touched are
+ * identified through /proc/self/pagemap, when available, without
+ * reading them.
+ *
+ * A delta store only holds the pages written since a previous
+ * checkpoint, whether they are zero or not, and is restored by
+ * applying it on top of the stores it is based on.
+ *
+ * Compressed stores, and chains of delta stores, can be flattened into
+ * a single uncompressed store, so that many processes restoring the
+ * same checkpoint can all map it and share its pages.
+ */
+
+struct StoreCheckpointConfig
+{
+    /** Write the legacy format, i.e., a gzip stream of the whole store. */
+    bool legacy = false;
+    /** zlib compression level, 0 for uncompressed, lazily restored. */
+    int compressionLevel = 1;
+    /** Worker threads, 0 for one per host CPU. */
+    unsigned threads = 0;
+    /** Only store the pages written since the previous checkpoint. */
+    bool delta = false;
+    /** Number of delta stores after which a full one is written. */
+    unsigned maxDeltaChain = 8;
+    /**
+     * Directory of flattened copies of the restored stores, shared by
+     * the processes restoring them, or empty to restore stores in place.
+     */
+    std::string sharedImageDir;
+};
+
+/**
+ * Write a store in the sparse format.
+ *
+ * @param path File to write.
+ * @param pmem Backing store.
+ * @param size Size of the backing store.
+ * @param anonymous Whether the backing store is a private anonymous
+ *                  mapping, whose untouched pages are known to be zero.
+ * @param config Compression configuration.
+ * @param dirty Bitmap of the host pages to store for a delta store, or
+ *              nullptr to store all the non-zero pages.
+ */
+void writeSparseStore(const std::string &path, const uint8_t *pmem,
+                      uint64_t size, bool anonymous,
+                      const StoreCheckpointConfig &config,
+                      const std::vector<uint64_t> *dirty=nullptr);
+
+/**
+ * Restore a store written in the sparse format. The backing store must
+ * only contain zeros, or the stores a delta store is based on.
+ *
+ * @param path File to read.
+ * @param pmem Backing store.
+ * @param size Size of the backing store.
+ * @param allow_map Whether uncompressed chunks may be mapped over the
+ *                  backing store instead of being copied.
+ * @param threads Worker threads, 0 for one per host CPU.
+ * @return Whether any part of the store was mapped.
+ */
+bool readSparseStore(const std::string &path, uint8_t *pmem, uint64_t size,
+                     bool allow_map, unsigned threads);
+
+/**
+ * Write a single uncompressed store with the contents of a chain of
+ * stores, as if they were restored in order.
+ *
+ * @param paths Stores to flatten, starting with a full one.
+ * @param out_path File to write.
+ * @param size Size of the backing store.
+ * @param threads Worker threads, 0 for one per host CPU.
+ */
+void flattenSparseStores(const std::vector<std::string> &paths,
+                         const std::string &out_path, uint64_t size,
+                         unsigned threads);
+
+/**
+ * Get the flattened copy of a chain of stores in a directory shared
+ * between processes, writing it if no other process has yet.
+ *
+ * @param paths Stores to flatten, starting with a full one.
+ * @param cache_dir Directory of the flattened copies.
+ * @param size Size of the backing store.
+ * @param threads Worker threads, 0 for one per host CPU.
+ * @return Path of the flattened copy.
+ */
+std::string sharedSparseStore(const std::vector<std::string> &paths,
+                              const std::string &cache_dir, uint64_t size,
+                              unsigned threads);
+
+} // namespace memory
+} // namespace gem5
+
+#endif // __MEM_STORE_CHECKPOINT_HH__
@@ -0,0 +1,301 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "mem/dirty_page_tracker.hh"
+#include "mem/store_checkpoint.hh"
+
+using namespace gem5;
+using namespace gem5::memory;
+
+namespace
+{
+
+// Not a multiple of the chunk or page size.
+constexpr uint64_t StoreSize = (5 << 20) + 1000;
+
+uint8_t *
+mapStore()
+{
+    void *pmem = mmap(nullptr, StoreSize, PROT_READ | PROT_WRITE,
+                      MAP_ANON | MAP_PRIVATE, -1, 0);
+    EXPECT_NE(pmem, MAP_FAILED);
+    return static_cast<uint8_t *>(pmem);
+}
+
+void
+fillStore(uint8_t *pmem)
+{
+    // A few scattered pages, including the partial last one, and a
+    // fully populated chunk.
+    for (uint64_t addr: {0UL, 4096UL * 3 + 17, StoreSize - 1})
+        pmem[addr] = addr % 251 + 1;
+    for (uint64_t addr = 2 << 20; addr < 3 << 20; addr += 8)
+        pmem[addr] = addr % 13;
+}
+
+std::string
+tempName()
+{
+    char name[] = "/tmp/store_checkpoint_test.XXXXXX";
+    int fd = mkstemp(name);
+    EXPECT_NE(fd, -1);
+    close(fd);
+    return name;
+}
+
+void
+roundTrip(int level, bool anonymous, bool allow_map, bool expect_map)
+{
+    uint8_t *orig = mapStore();
+    fillStore(orig);
+
+    StoreCheckpointConfig config;
+    config.compressionLevel = level;
+    config.threads = 3;
+    const std::string name = tempName();
+    writeSparseStore(name, orig, StoreSize, anonymous, config);
+
+    uint8_t *restored = mapStore();
+    EXPECT_EQ(expect_map,
+              readSparseStore(name, restored, StoreSize, allow_map, 2));
+    EXPECT_EQ(0, memcmp(orig, restored, StoreSize));
+
+    // Restored pages are private copies.
+    restored[0]++;
+    EXPECT_NE(orig[0], restored[0]);
+
+    munmap(orig, StoreSize);
+    munmap(restored, StoreSize);
+    std::remove(name.c_str());
+}
+
+void
+deltaRoundTrip(int level, bool allow_map)
+{
+    uint8_t *orig = mapStore();
+    fillStore(orig);
+
+    StoreCheckpointConfig config;
+    config.compressionLevel = level;
+    config.threads = 3;
+    const std::string base = tempName();
+    writeSparseStore(base, orig, StoreSize, true, config);
+
+    // Zero a page which was stored, and write a few new ones.
+    DirtyPageTracker tracker(orig, StoreSize);
+    for (uint64_t addr: {0UL, (1UL << 20) + 5, StoreSize - 1}) {
+        orig[addr] = addr ? 42 : 0;
+        tracker.mark(orig + addr, 1);
+    }
+    std::vector<uint64_t> dirty = tracker.dirtyPages();
+    const std::string delta = tempName();
+    writeSparseStore(delta, orig, StoreSize, true, config, &dirty);
+
+    uint8_t *restored = mapStore();
+    readSparseStore(base, restored, StoreSize, allow_map, 2);
+    readSparseStore(delta, restored, StoreSize, allow_map, 2);
+    EXPECT_EQ(0, memcmp(orig, restored, StoreSize));
+
+    munmap(orig, StoreSize);
+    munmap(restored, StoreSize);
+    std::remove(base.c_str());
+    std::remove(delta.c_str());
+}
+
+} // anonymous namespace
+
+TEST(StoreCheckpointTest, Compressed)
+{
+    roundTrip(1, true, true, false);
+}
+
+TEST(StoreCheckpointTest, CompressedNotAnonymous)
+{
+    roundTrip(6, false, false, false);
+}
+
+TEST(StoreCheckpointTest, Uncompressed)
+{
+    roundTrip(0, true, false, false);
+}
+
+TEST(StoreCheckpointTest, UncompressedMapped)
+{
+    roundTrip(0, true, true, true);
+}
+
+TEST(StoreCheckpointTest, SkipsZeroChunks)
+{
+    uint8_t *pmem = mapStore();
+    pmem[100] = 1;
+
+    StoreCheckpointConfig config;
+    config.compressionLevel = 0;
+    const std::string name = tempName();
+    writeSparseStore(name, pmem, StoreSize, true, config);
+
+    FILE *f = fopen(name.c_str(), "rb");
+    fseek(f, 0, SEEK_END);
+    // Header, a single chunk and the index.
+    EXPECT_LT(ftell(f), (2 << 20));
+    fclose(f);
+
+    munmap(pmem, StoreSize);
+    std::remove(name.c_str());
+}
+
+TEST(StoreCheckpointTest, DeltaCompressed)
+{
+    deltaRoundTrip(1, false);
+}
+
+TEST(StoreCheckpointTest, DeltaMapped)
+{
+    deltaRoundTrip(0, true);
+}
+
+TEST(StoreCheckpointTest, Flattened)
+{
+    uint8_t *orig = mapStore();
+    fillStore(orig);
+
+    StoreCheckpointConfig config;
+    config.compressionLevel = 1;
+    config.threads = 3;
+    const std::string base = tempName();
+    writeSparseStore(base, orig, StoreSize, true, config);
+
+    // Zero a whole chunk which was stored, and write a new page.
+    DirtyPageTracker tracker(orig, StoreSize);
+    memset(orig + (2 << 20), 0, 1 << 20);
+    tracker.mark(orig + (2 << 20), 1 << 20);
+    orig[(4 << 20) + 3] = 7;
+    tracker.mark(orig + (4 << 20) + 3, 1);
+    std::vector<uint64_t> dirty = tracker.dirtyPages();
+    const std::string delta = tempName();
+    writeSparseStore(delta, orig, StoreSize, true, config, &dirty);
+
+    const std::string flat = tempName();
+    flattenSparseStores({base, delta}, flat, StoreSize, 2);
+
+    uint8_t *restored = mapStore();
+    EXPECT_TRUE(readSparseStore(flat, restored, StoreSize, true, 2));
+    EXPECT_EQ(0, memcmp(orig, restored, StoreSize));
+
+    munmap(orig, StoreSize);
+    munmap(restored, StoreSize);
+    std::remove(base.c_str());
+    std::remove(delta.c_str());
+    std::remove(flat.c_str());
+}
+
+TEST(StoreCheckpointTest, SharedImage)
+{
+    uint8_t *orig = mapStore();
+    fillStore(orig);
+
+    StoreCheckpointConfig config;
+    const std::string name = tempName();
+    writeSparseStore(name, orig, StoreSize, true, config);
+
+    char dir[] = "/tmp/store_checkpoint_test.XXXXXX";
+    ASSERT_NE(mkdtemp(dir), nullptr);
+
+    // The second restore finds the copy written by the first one.
+    const std::string image = sharedSparseStore({name}, dir, StoreSize, 2);
+    struct stat st;
+    ASSERT_EQ(0, stat(image.c_str(), &st));
+    EXPECT_EQ(image, sharedSparseStore({name}, dir, StoreSize, 2));
+    struct stat st_again;
+    ASSERT_EQ(0, stat(image.c_str(), &st_again));
+    EXPECT_EQ(st.st_ino, st_again.st_ino);
+
+    uint8_t *restored = mapStore();
+    EXPECT_TRUE(readSparseStore(image, restored, StoreSize, true, 2));
+    EXPECT_EQ(0, memcmp(orig, restored, StoreSize));
+
+    munmap(orig, StoreSize);
+    munmap(restored, StoreSize);
+    std::remove(name.c_str());
+    std::remove(image.c_str());
+    std::remove((image + ".lock").c_str());
+    rmdir(dir);
+}
+
+TEST(StoreCheckpointTest, DirtyPageTracker)
+{
+    uint8_t *pmem = mapStore();
+    DirtyPageTracker tracker(pmem, StoreSize);
+
+    // A write across a page boundary dirties both pages.
+    const uint64_t page_size = sysconf(_SC_PAGE_SIZE);
+    tracker.mark(pmem + page_size * 2 - 1, 2);
+    std::vector<uint64_t> dirty = tracker.dirtyPages();
+    EXPECT_EQ(dirty[0], 0x6);
+
+    tracker.clear();
+    dirty = tracker.dirtyPages();
+    EXPECT_EQ(dirty[0], 0);
+
+    munmap(pmem, StoreSize);
+}
+
+TEST(StoreCheckpointTest, DirtyPageTrackerSharedSoftDirty)
+{
+    DirtyPageTracker::clearSoftDirty();
+
+    uint8_t *pmem_a = mapStore();
+    uint8_t *pmem_b = mapStore();
+    DirtyPageTracker tracker_a(pmem_a, StoreSize);
+    DirtyPageTracker tracker_b(pmem_b, StoreSize);
+
+    // Both stores are written behind the back of their trackers.
+    tracker_a.setUntracked();
+    tracker_b.setUntracked();
+    pmem_a[0] = 1;
+    pmem_b[0] = 1;
+
+    // Checkpointing the first store must not lose the write to the
+    // second one.
+    DirtyPageTracker::clearSoftDirty();
+    tracker_a.clear();
+    EXPECT_EQ(tracker_b.dirtyPages()[0] & 0x1, 0x1);
+
+    munmap(pmem_a, StoreSize);
+    munmap(pmem_b, StoreSize);
+}
@@ -500,11 +500,15 @@ class Simulator:
             if exit_on_completion:
                 return
 
-    def save_checkpoint(self, checkpoint_dir: Path) -> None:
+    def save_checkpoint(
+        self, checkpoint_dir: Path, binary: bool = False
+    ) -> None:
         """
         This function will save the checkpoint to the specified directory.
 
         :param checkpoint_dir: The path to the directory where the checkpoint
         will be saved.
+        :param binary: Whether to save the checkpoint in the binary format,
+        which is faster to save and restore.
         """
-        m5.checkpoint(str(checkpoint_dir))
+        m5.checkpoint(str(checkpoint_dir), binary)
@@ -0,0 +1,267 @@
+# Copyright (c) 2026 The Regents of The University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""
+A pool of simulator forks, to run many simulations from the same warm
+state, e.g., one per SimPoint or LoopPoint region:
+
+.. code-block:: python
+
+    def run_region(region):
+        ...
+        m5.simulate()
+        return region
+
+    m5.disableAllListeners()
+    with ForkPool() as pool:
+        for region in regions:
+            pool.submit(run_region, region)
+        for result in pool.results():
+            print(result.job, result.result, result.stats)
+
+Every job runs in a child forked with ``m5.fork()``, so the children share
+the memory pages of the parent until they write them, provided the backing
+stores are private mappings, i.e., no system has a ``shared_backstore``.
+The parallel event queue threads, terminated by the fork, are restarted
+by the next ``m5.simulate()`` in each child. The value returned by a job
+and, optionally, the stats of its child are pickled back to the parent.
+"""
+
+import atexit
+import os
+import pickle
+import selectors
+import struct
+import sys
+import traceback
+from dataclasses import dataclass
+from typing import (
+    Any,
+    Callable,
+    Dict,
+    Iterator,
+    List,
+    Optional,
+)
+
+import m5
+from m5.objects import (
+    Root,
+    System,
+)
+
+
+@dataclass
+class ForkResult:
+    """The outcome of a job run by a ForkPool."""
+
+    job: int
+    """The job id returned by ``ForkPool.submit()``."""
+    pid: int
+    """The pid of the child which ran the job."""
+    exit_code: int
+    """The exit status of the child, 0 if the job succeeded."""
+    result: Any = None
+    """The value returned by the job."""
+    stats: Optional[Dict] = None
+    """The stats of the child when the job returned, as JSON data."""
+    error: Optional[str] = None
+    """The traceback of the exception raised by the job, if any."""
+
+
+class _Child:
+    def __init__(self, job: int, pid: int, fd: int):
+        self.job = job
+        self.pid = pid
+        self.fd = fd
+        self.data = bytearray()
+
+
+class ForkPool:
+    """Runs jobs in forks of the simulator, with a bounded number of
+    children running at any time.
+    """
+
+    def __init__(
+        self,
+        max_workers: Optional[int] = None,
+        simout: str = "%(parent)s.f%(fork_seq)i",
+        collect_stats: bool = True,
+    ):
+        """
+        :param max_workers: The maximum number of children running at once,
+                            the number of host cores by default.
+        :param simout: The output directory of the children, see
+                       ``m5.fork()``.
+        :param collect_stats: Whether to send the stats of the children back
+                              to the parent.
+        """
+        self._max_workers = max_workers or len(os.sched_getaffinity(0))
+        self._simout = simout
+        self._collect_stats = collect_stats
+        self._next_job = 0
+        self._running: Dict[int, _Child] = {}
+        self._done: List[ForkResult] = []
+        self._selector = selectors.DefaultSelector()
+
+    def __enter__(self) -> "ForkPool":
+        return self
+
+    def __exit__(self, *args) -> None:
+        self.join()
+
+    def _check_forkable(self) -> None:
+        if not m5.listenersDisabled():
+            raise RuntimeError(
+                "Can not fork a simulator with listeners enabled, call "
+                "m5.disableAllListeners() before instantiating the system."
+            )
+        root = Root.getInstance()
+        for obj in root.descendants() if root else []:
+            if isinstance(obj, System) and obj.shared_backstore:
+                raise RuntimeError(
+                    f"{obj.path()} has a shared backing store, the children "
+                    "would share its memory."
+                )
+
+    def submit(self, func: Callable, *args, **kwargs) -> int:
+        """Fork a child running ``func(*args, **kwargs)``, once fewer than
+        ``max_workers`` children are running.
+
+        :returns: The id of the job.
+        """
+        while len(self._running) >= self._max_workers:
+            self._wait_one()
+        self._check_forkable()
+
+        job = self._next_job
+        self._next_job += 1
+
+        read_fd, write_fd = os.pipe()
+        pid = m5.fork(self._simout)
+        if pid == 0:
+            os.close(read_fd)
+            self._run_child(job, write_fd, func, args, kwargs)
+
+        os.close(write_fd)
+        os.set_blocking(read_fd, False)
+        child = _Child(job, pid, read_fd)
+        self._running[read_fd] = child
+        self._selector.register(read_fd, selectors.EVENT_READ, child)
+        return job
+
+    def _run_child(self, job, fd, func, args, kwargs) -> None:
+        # The child doesn't manage the other children of the parent.
+        for child in self._running.values():
+            os.close(child.fd)
+        self._running = {}
+
+        message = {}
+        exit_code = 0
+        try:
+            message["result"] = func(*args, **kwargs)
+            if self._collect_stats:
+                from m5.stats.gem5stats import get_simstat
+
+                message["stats"] = get_simstat(Root.getInstance()).to_json()
+        except BaseException:
+            message = {"error": traceback.format_exc()}
+            exit_code = 1
+
+        try:
+            data = pickle.dumps(message)
+        except Exception:
+            data = pickle.dumps({"error": traceback.format_exc()})
+            exit_code = 1
+        with os.fdopen(fd, "wb") as pipe:
+            pipe.write(struct.pack("<Q", len(data)))
+            pipe.write(data)
+
+        # Exit without unwinding the stack of the parent, but still dump
+        # the stats and clean up the simulator like a normal exit.
+        sys.stdout.flush()
+        sys.stderr.flush()
+        atexit._run_exitfuncs()
+        os._exit(exit_code)
+
+    def _wait_one(self) -> None:
+        """Wait for a child to exit, collecting its result."""
+        while True:
+            for key, _ in self._selector.select():
+                child = key.data
+                chunk = os.read(child.fd, 1 << 20)
+                if chunk:
+                    child.data += chunk
+                    continue
+
+                # The child closed the pipe, it is exiting.
+                self._selector.unregister(child.fd)
+                os.close(child.fd)
+                del self._running[child.fd]
+                _, status = os.waitpid(child.pid, 0)
+                self._done.append(self._result(child, status))
+                return
+
+    def _result(self, child: _Child, status: int) -> ForkResult:
+        if os.WIFEXITED(status):
+            exit_code = os.WEXITSTATUS(status)
+        else:
+            exit_code = -os.WTERMSIG(status)
+        result = ForkResult(job=child.job, pid=child.pid, exit_code=exit_code)
+        data = bytes(child.data)
+        if len(data) < 8:
+            result.error = "Child exited without a result"
+            return result
+        (size,) = struct.unpack("<Q", data[:8])
+        message = pickle.loads(data[8 : 8 + size])
+        result.result = message.get("result")
+        result.stats = message.get("stats")
+        result.error = message.get("error")
+        return result
+
+    def results(self) -> Iterator[ForkResult]:
+        """Yield the results of the jobs, in the order they finish, until
+        all the submitted jobs are done.
+        """
+        while self._running or self._done:
+            if not self._done:
+                self._wait_one()
+            yield self._done.pop(0)
+
+    def map(self, func: Callable, iterable) -> List[ForkResult]:
+        """Run ``func`` on every item of ``iterable``, each in its own
+        child, and return the results in the order of the items.
+        """
+        jobs = [self.submit(func, item) for item in iterable]
+        results = {result.job: result for result in self.results()}
+        return [results[job] for job in jobs]
+
+    def join(self) -> None:
+        """Wait for all the children to exit. Results which haven't been
+        consumed yet remain available from ``results()``.
+        """
+        while self._running:
+            self._wait_one()
@@ -308,7 +308,11 @@ def memInvalidate(root):
         obj.memInvalidate()
 
 
-def checkpoint(dir):
+def checkpoint(dir, binary=False):
+    """Checkpoint the simulation in the directory dir. Binary checkpoints
+    are faster to write and restore, and can be converted to and from
+    text ones with util/cpt_convert.py.
+    """
     root = objects.Root.getInstance()
     if not isinstance(root, objects.Root):
         raise TypeError("Checkpoint must be called on a root object.")
@@ -316,7 +320,7 @@ def checkpoint(dir):
     drain()
     memWriteback(root)
     print("Writing checkpoint")
-    _m5.core.serializeAll(dir)
+    _m5.core.serializeAll(dir, binary)
 
 
 def _changeMemoryMode(system, mode):
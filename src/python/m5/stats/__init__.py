@@ -186,6 +186,57 @@ def _hdf5Factory(fn, chunking=10, desc=True, formulas=True):
     return _m5.stats.initHDF5(fn, chunking, desc, formulas)
 
 
+@_url_factory(["col", "columnar"])
+def _columnarFactory(fn, desc=True, background=True):
+    """Output stats in a compact, columnar binary format.
+
+    Each stat value is a column, and each dump only stores the columns
+    which changed since the previous one, which keeps frequent periodic
+    dumps of large systems small and cheap. The values are encoded and
+    written by a background thread unless disabled.
+
+    The file can be converted to Parquet, Arrow or CSV with
+    util/stats_columnar.py. Sparse histograms are unsupported.
+
+    Parameters:
+      * desc (bool): Output stat descriptions (default: True)
+      * background (bool): Write dumps from a separate thread
+        (default: True)
+
+    Example:
+      col://stats.col?desc=False
+
+    """
+
+    return _m5.stats.initColumnar(fn, desc, background)
+
+
+@_url_factory(["shm"])
+def _shmFactory(fn, stats="", slots=16):
+    """Publish stats to a shared memory ring for live monitoring.
+
+    The values of the selected stats are written to a POSIX shared
+    memory segment on every dump, where external monitors can poll them
+    without pausing the simulation, e.g., with util/stats_shm.py. The
+    last dumps are kept in a ring, and each one is protected by a
+    sequence lock. Distributions only publish their number of samples
+    and their mean.
+
+    Parameters:
+      * stats (str): Comma separated stat names to publish, which may
+        use * to match any SimObject, or all stats if empty
+        (default: "")
+      * slots (int): Number of dumps kept in the ring (default: 16)
+
+    Example:
+      shm://gem5_stats?stats="system.cpu.ipc,system.*.overallMissRate"
+
+    """
+
+    patterns = [p.strip() for p in stats.split(",") if p.strip()]
+    return _m5.stats.initShmRing(fn, patterns, slots)
+
+
 @_url_factory(["json"])
 def _jsonFactory(fn):
     """Output stats in JSON format.
@@ -340,16 +391,25 @@ def enable():
     _m5.stats.enable()
 
 
-def prepare():
+def prepare(roots=None):
     """Prepare all stats for data access.  This must be done before
-    dumping and serialization."""
+    dumping and serialization.
+
+    If roots are given, only the stats of these SimObjects, and the
+    stats their formulas depend on, are prepared."""
+
+    if roots:
+        _m5.stats.prepare([root.getCCObject() for root in roots])
+        return
 
     # Legacy stats
     for stat in stats_list:
         stat.prepare()
 
     # New stats
-    _visit_stats(lambda g, s: s.prepare())
+    sim_root = Root.getInstance()
+    if sim_root:
+        _m5.stats.prepare([sim_root.getCCObject()])
 
 
 def _dump_to_visitor(visitor, roots=None):
@@ -382,6 +442,9 @@ def _dump_to_visitor(visitor, roots=None):
 lastDump = 0
 # List[SimObject].
 global_dump_roots = []
+# Ids of the roots of partial dumps prepared in the current tick, or None
+# if all stats were.
+_prepared_roots = set()
 
 
 def dump(roots=None):
@@ -407,23 +470,40 @@ def dump(roots=None):
     # Only prepare stats the first time we dump them in the same tick.
     if new_dump:
         _m5.stats.processDumpQueue()
+        _prepared_roots.clear()
         # Notify new-style stats group that we are about to dump stats.
+        # Partial dumps notify the whole hierarchy too, as their formulas
+        # may depend on stats of groups outside of the dumped roots.
         sim_root = Root.getInstance()
         if sim_root:
             sim_root.preDumpStats()
-        prepare()
-
-    for output in outputList:
-        if isinstance(output, JsonOutputVistor):
-            if not all_roots:
-                output.dump(Root.getInstance())
+        if not all_roots:
+            prepare()
+            _prepared_roots.add(None)
+
+    # Partial dumps only prepare the stats they need.
+    new_roots = []
+    if None not in _prepared_roots:
+        new_roots = [r for r in all_roots if id(r) not in _prepared_roots]
+    if new_roots:
+        _prepared_roots.update(id(r) for r in new_roots)
+        prepare(new_roots)
+
+    _m5.stats.beginDump()
+    try:
+        for output in outputList:
+            if isinstance(output, JsonOutputVistor):
+                if not all_roots:
+                    output.dump(Root.getInstance())
+                else:
+                    output.dump(all_roots)
             else:
-                output.dump(all_roots)
-        else:
-            if output.valid():
-                output.begin()
-                _dump_to_visitor(output, roots=all_roots)
-                output.end()
+                if output.valid():
+                    output.begin()
+                    _dump_to_visitor(output, roots=all_roots)
+                    output.end()
+    finally:
+        _m5.stats.endDump()
 
 
 def reset():
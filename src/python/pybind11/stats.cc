@@ -42,6 +42,8 @@
 #include "pybind11/stl.h"
 
 #include "base/statistics.hh"
+#include "base/stats/columnar.hh"
+#include "base/stats/shm_ring.hh"
 #include "base/stats/text.hh"
 #include "config/have_hdf5.hh"
 
@@ -111,6 +113,8 @@ pybind_init_stats(py::module_ &m_native)
         .def("initSimStats", &statistics::initSimStats)
         .def("initText", &statistics::initText,
             py::return_value_policy::reference)
+        .def("initColumnar", &statistics::initColumnar)
+        .def("initShmRing", &statistics::initShmRing)
 #if HAVE_HDF5
         .def("initHDF5", &statistics::initHDF5)
 #endif
@@ -123,6 +127,9 @@ pybind_init_stats(py::module_ &m_native)
         .def("processDumpQueue", &statistics::processDumpQueue)
         .def("enable", &statistics::enable)
         .def("enabled", &statistics::enabled)
+        .def("prepare", &statistics::prepare)
+        .def("beginDump", &statistics::beginDump)
+        .def("endDump", &statistics::endDump)
         .def("statsList", &statistics::statsList)
         ;
 
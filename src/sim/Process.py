@@ -49,6 +49,11 @@ class Process(SimObject):
                             table in an architecture-specific format",
     )
     kvmInSE = Param.Bool("false", "initialize the process for KvmCPU in SE")
+    lazy_load = Param.Bool(
+        False,
+        "load the binary into memory a page at a time, when the page is "
+        "first touched, instead of all at startup",
+    )
     maxStackSize = Param.MemorySize("64MiB", "maximum size of the stack")
 
     uid = Param.Int(100, "user id")
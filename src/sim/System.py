@@ -105,6 +105,38 @@ class System(SimObject):
         "shared_backstore is non-empty.",
     )
 
+    legacy_memory_checkpoint = Param.Bool(
+        False,
+        "Checkpoint the memory as a single gzip stream, as done before "
+        "sparse memory checkpoints. Both formats can be restored.",
+    )
+    memory_checkpoint_compression = Param.Int(
+        1,
+        "zlib compression level of the memory checkpoints. Uncompressed "
+        "(0) checkpoints are restored lazily, by mapping them copy-on-write.",
+    )
+    memory_checkpoint_threads = Param.Unsigned(
+        0,
+        "Threads compressing and decompressing the memory checkpoints, "
+        "0 for one per host CPU",
+    )
+    delta_memory_checkpoints = Param.Bool(
+        False,
+        "Only store the memory pages written since the previous checkpoint "
+        "taken or restored. Restoring needs the previous checkpoints too.",
+    )
+    max_delta_memory_checkpoints = Param.Unsigned(
+        8,
+        "Number of successive delta memory checkpoints after which a full "
+        "one is taken",
+    )
+    shared_memory_image_dir = Param.String(
+        "",
+        "Directory in which to keep uncompressed copies of the restored "
+        "memory checkpoints. Processes restoring the same checkpoint map "
+        "the same copy, and share the pages they don't write to.",
+    )
+
     cache_line_size = Param.Unsigned(64, "Cache line size in bytes")
 
     redirect_paths = VectorParam.RedirectPath([], "Path redirections")
@@ -100,6 +100,15 @@ class SEWorkload(Workload, metaclass=SEWorkloadMeta):
     cxx_class = "gem5::SEWorkload"
     abstract = True
 
+    io_threads = Param.Unsigned(
+        0,
+        "Host threads splitting large reads and writes of regular files "
+        "by the simulated processes, 0 to do them on the simulation thread",
+    )
+    io_chunk_size = Param.MemorySize(
+        "1MiB", "Size of the chunks large file transfers are split into"
+    )
+
     @classmethod
     def _is_compatible_with(cls, obj):
         return False
@@ -37,10 +37,12 @@
 #include <unordered_map>
 #include <vector>
 
+#include "base/compiler.hh"
 #include "base/logging.hh"
 #include "base/trace.hh"
 #include "cpu/smt.hh"
 #include "debug/Checkpoint.hh"
+#include "sim/host_profile.hh"
 
 namespace gem5
 {
@@ -77,6 +79,9 @@ Counter Event::instanceCounter = 0;
 Event::~Event()
 {
     assert(!scheduled());
+    // The profile only tracks the events which aren't auto delete.
+    if (GEM5_UNLIKELY(host_profile::enabled) && !isAutoDelete())
+        host_profile::forget(this);
     flags = 0;
 }
 
@@ -246,7 +251,10 @@ EventQueue::serviceOne()
         setCurTick(event->when());
         if (debug::Event)
             event->trace("executed");
-        event->process();
+        if (GEM5_UNLIKELY(host_profile::enabled))
+            host_profile::process(event);
+        else
+            event->process();
         if (event->isExitEvent()) {
             assert(!event->flags.isSet(Event::Managed) ||
                    !event->flags.isSet(Event::IsMainQueue)); // would be silly
@@ -0,0 +1,266 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/host_io.hh"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+
+namespace gem5
+{
+
+namespace
+{
+
+/**
+ * Transfer on the calling thread, in as many host calls as the number
+ * of buffers requires.
+ */
+ssize_t
+serialTransfer(bool write, int fd, const iovec *iov, size_t count,
+               off_t offset)
+{
+    ssize_t done = 0;
+    while (count) {
+        const int batch = std::min<size_t>(count, IOV_MAX);
+        size_t wanted = 0;
+        for (int i = 0; i < batch; i++)
+            wanted += iov[i].iov_len;
+
+        ssize_t ret;
+        if (offset < 0) {
+            ret = write ? ::writev(fd, iov, batch) : ::readv(fd, iov, batch);
+        } else if (write) {
+            ret = ::pwritev(fd, iov, batch, offset + done);
+        } else {
+            ret = ::preadv(fd, iov, batch, offset + done);
+        }
+
+        if (ret < 0)
+            return done ? done : -1;
+        done += ret;
+        if ((size_t)ret < wanted)
+            break;
+
+        iov += batch;
+        count -= batch;
+    }
+    return done;
+}
+
+} // anonymous namespace
+
+HostIO::HostIO(unsigned threads, size_t chunk_size)
+    : chunkSize(chunk_size)
+{
+    for (unsigned i = 0; i < threads; i++)
+        workers.emplace_back([this]() { workerLoop(); });
+}
+
+HostIO::~HostIO()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stopping = true;
+    }
+    workAvailable.notify_all();
+    for (auto &worker: workers)
+        worker.join();
+}
+
+ssize_t
+HostIO::readv(int fd, const std::vector<iovec> &iov, off_t offset)
+{
+    return transfer(false, fd, iov, offset);
+}
+
+ssize_t
+HostIO::writev(int fd, const std::vector<iovec> &iov, off_t offset)
+{
+    return transfer(true, fd, iov, offset);
+}
+
+ssize_t
+HostIO::transfer(bool write, int fd, const std::vector<iovec> &iov,
+                 off_t offset)
+{
+    size_t size = 0;
+    for (const auto &v: iov)
+        size += v.iov_len;
+
+    if (splittable(write, fd, size))
+        return parallelTransfer(write, fd, iov, offset);
+    return serialTransfer(write, fd, iov.data(), iov.size(), offset);
+}
+
+bool
+HostIO::splittable(bool write, int fd, size_t size) const
+{
+    if (workers.empty() || size < 2 * chunkSize)
+        return false;
+
+    // Only regular files can be accessed at several offsets at once.
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+        return false;
+
+    // Appending writes go to the end of the file, whatever the offset.
+    if (write) {
+        const int flags = fcntl(fd, F_GETFL);
+        if (flags == -1 || (flags & O_APPEND))
+            return false;
+    }
+    return true;
+}
+
+ssize_t
+HostIO::parallelTransfer(bool write, int fd, const std::vector<iovec> &iov,
+                         off_t offset)
+{
+    off_t start = offset;
+    if (offset < 0) {
+        start = lseek(fd, 0, SEEK_CUR);
+        if (start < 0)
+            return serialTransfer(write, fd, iov.data(), iov.size(), offset);
+    }
+
+    struct Chunk
+    {
+        std::vector<iovec> iov;
+        off_t offset = 0;
+        size_t size = 0;
+        ssize_t result = 0;
+        int error = 0;
+    };
+
+    // Split the buffers into chunks of consecutive bytes of the file.
+    std::vector<Chunk> chunks;
+    Chunk chunk;
+    chunk.offset = start;
+    for (const auto &v: iov) {
+        uint8_t *base = static_cast<uint8_t *>(v.iov_base);
+        size_t left = v.iov_len;
+        while (left) {
+            const size_t len = std::min(left, chunkSize - chunk.size);
+            chunk.iov.push_back({base, len});
+            chunk.size += len;
+            base += len;
+            left -= len;
+            if (chunk.size == chunkSize) {
+                const off_t next = chunk.offset + chunk.size;
+                chunks.push_back(std::move(chunk));
+                chunk = Chunk();
+                chunk.offset = next;
+            }
+        }
+    }
+    if (chunk.size)
+        chunks.push_back(std::move(chunk));
+
+    std::vector<std::function<void()>> tasks;
+    for (auto &c: chunks) {
+        tasks.emplace_back([&c, write, fd]() {
+            c.result = serialTransfer(write, fd, c.iov.data(), c.iov.size(),
+                                      c.offset);
+            c.error = errno;
+        });
+    }
+    run(tasks);
+
+    // Like a single host call, return the bytes transferred up to the
+    // first error or short chunk.
+    ssize_t done = 0;
+    for (const auto &c: chunks) {
+        if (c.result < 0) {
+            if (done == 0) {
+                errno = c.error;
+                return -1;
+            }
+            break;
+        }
+        done += c.result;
+        if ((size_t)c.result < c.size)
+            break;
+    }
+
+    if (offset < 0)
+        lseek(fd, start + done, SEEK_SET);
+    return done;
+}
+
+void
+HostIO::run(std::vector<std::function<void()>> &tasks)
+{
+    std::lock_guard<std::mutex> transfer_guard(transferLock);
+
+    std::unique_lock<std::mutex> guard(lock);
+    for (auto &task: tasks)
+        work.push_back(std::move(task));
+    pending += tasks.size();
+    workAvailable.notify_all();
+
+    // Help the workers rather than sleep.
+    while (!work.empty()) {
+        auto task = std::move(work.front());
+        work.pop_front();
+        guard.unlock();
+        task();
+        guard.lock();
+        pending--;
+    }
+    workDone.wait(guard, [this]() { return pending == 0; });
+}
+
+void
+HostIO::workerLoop()
+{
+    std::unique_lock<std::mutex> guard(lock);
+    while (true) {
+        workAvailable.wait(guard, [this]() {
+            return stopping || !work.empty();
+        });
+        if (stopping)
+            return;
+
+        auto task = std::move(work.front());
+        work.pop_front();
+        guard.unlock();
+        task();
+        guard.lock();
+        if (--pending == 0)
+            workDone.notify_all();
+    }
+}
+
+} // namespace gem5
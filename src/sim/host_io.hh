@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __SIM_HOST_IO_HH__
+#define __SIM_HOST_IO_HH__
+
+#include <sys/types.h>
+#include <sys/uio.h>
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gem5
+{
+
+/**
+ * Reads and writes of host files on behalf of simulated processes.
+ *
+ * Transfers are scatter/gather, so that syscall emulation can read and
+ * write guest memory directly. Large transfers to and from regular files
+ * may be split into chunks handled by a pool of host threads. Calls
+ * still return once the whole transfer is done, so the simulation sees
+ * the same results, at the same simulated time, as with a single host
+ * call.
+ */
+class HostIO
+{
+  public:
+    /**
+     * @param threads Number of helper threads for large transfers, or 0
+     *                to do all transfers on the calling thread.
+     * @param chunk_size Size of the chunks large transfers are split
+     *                   into.
+     */
+    HostIO(unsigned threads=0, size_t chunk_size=1024 * 1024);
+    ~HostIO();
+
+    HostIO(const HostIO &) = delete;
+    HostIO &operator=(const HostIO &) = delete;
+
+    /**
+     * Read from a file, like readv() or preadv().
+     *
+     * @param fd Host file descriptor.
+     * @param iov Buffers to fill, in order.
+     * @param offset Offset in the file, or -1 to read from and advance
+     *               the file position.
+     * @return Number of bytes read, or -1 with errno set.
+     */
+    ssize_t readv(int fd, const std::vector<iovec> &iov, off_t offset=-1);
+
+    /**
+     * Write to a file, like writev() or pwritev().
+     *
+     * @param fd Host file descriptor.
+     * @param iov Buffers to write, in order.
+     * @param offset Offset in the file, or -1 to write at and advance
+     *               the file position.
+     * @return Number of bytes written, or -1 with errno set.
+     */
+    ssize_t writev(int fd, const std::vector<iovec> &iov,
+                   off_t offset=-1);
+
+  private:
+    const size_t chunkSize;
+
+    std::vector<std::thread> workers;
+
+    /** Protects the fields below. */
+    std::mutex lock;
+    std::condition_variable workAvailable;
+    std::condition_variable workDone;
+    std::deque<std::function<void()>> work;
+    size_t pending = 0;
+    bool stopping = false;
+
+    /** Only one transfer uses the workers at a time. */
+    std::mutex transferLock;
+
+    ssize_t transfer(bool write, int fd, const std::vector<iovec> &iov,
+                     off_t offset);
+
+    /** Whether a transfer is worth splitting between threads. */
+    bool splittable(bool write, int fd, size_t size) const;
+
+    ssize_t parallelTransfer(bool write, int fd,
+                             const std::vector<iovec> &iov, off_t offset);
+
+    /** Run tasks on the workers and the calling thread. */
+    void run(std::vector<std::function<void()>> &tasks);
+
+    void workerLoop();
+};
+
+} // namespace gem5
+
+#endif // __SIM_HOST_IO_HH__
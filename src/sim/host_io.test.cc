@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "sim/host_io.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** Temporary file, removed when the test ends. */
+class HostIOTest : public testing::Test
+{
+  protected:
+    int fd = -1;
+
+    void
+    SetUp() override
+    {
+        char name[] = "/tmp/host_io.test.XXXXXX";
+        fd = mkstemp(name);
+        ASSERT_NE(fd, -1);
+        unlink(name);
+    }
+
+    void
+    TearDown() override
+    {
+        close(fd);
+    }
+};
+
+/** Split a buffer into iovecs of irregular sizes. */
+std::vector<iovec>
+scatter(std::vector<uint8_t> &buf)
+{
+    std::vector<iovec> iov;
+    size_t pos = 0;
+    for (size_t len = 1; pos < buf.size(); len = len * 3 + 7) {
+        len = std::min(len, buf.size() - pos);
+        iov.push_back({&buf[pos], len});
+        pos += len;
+    }
+    return iov;
+}
+
+} // anonymous namespace
+
+/** Transfers without helper threads behave like readv and writev. */
+TEST_F(HostIOTest, Serial)
+{
+    HostIO io;
+    std::vector<uint8_t> out(10000);
+    std::iota(out.begin(), out.end(), 0);
+    ASSERT_EQ(io.writev(fd, scatter(out)), out.size());
+    ASSERT_EQ(lseek(fd, 0, SEEK_CUR), out.size());
+
+    std::vector<uint8_t> in(out.size());
+    ASSERT_EQ(io.readv(fd, scatter(in), 0), in.size());
+    ASSERT_EQ(in, out);
+}
+
+/**
+ * Large transfers split between threads read and write the same bytes,
+ * and move the file position like a single call.
+ */
+TEST_F(HostIOTest, Parallel)
+{
+    HostIO io(3, 4096);
+    std::vector<uint8_t> out(100000);
+    std::iota(out.begin(), out.end(), 0);
+    ASSERT_EQ(io.writev(fd, scatter(out)), out.size());
+    ASSERT_EQ(lseek(fd, 0, SEEK_CUR), out.size());
+
+    ASSERT_EQ(lseek(fd, 0, SEEK_SET), 0);
+    std::vector<uint8_t> in(out.size());
+    ASSERT_EQ(io.readv(fd, scatter(in)), in.size());
+    ASSERT_EQ(in, out);
+    ASSERT_EQ(lseek(fd, 0, SEEK_CUR), out.size());
+}
+
+/** Reads past the end of the file stop there. */
+TEST_F(HostIOTest, ShortRead)
+{
+    HostIO io(2, 4096);
+    std::vector<uint8_t> out(30000, 0xa5);
+    ASSERT_EQ(io.writev(fd, scatter(out), 0), out.size());
+
+    std::vector<uint8_t> in(50000);
+    ASSERT_EQ(io.readv(fd, scatter(in), 1000), out.size() - 1000);
+    ASSERT_EQ(in[0], 0xa5);
+    ASSERT_EQ(in[out.size() - 1001], 0xa5);
+    ASSERT_EQ(in[out.size() - 1000], 0);
+}
+
+/** Errors are reported through errno. */
+TEST_F(HostIOTest, Error)
+{
+    HostIO io(2, 4096);
+    std::vector<uint8_t> buf(100000);
+    ASSERT_EQ(io.readv(-1, scatter(buf)), -1);
+    ASSERT_EQ(errno, EBADF);
+}
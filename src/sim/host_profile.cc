@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/host_profile.hh"
+
+#include <cxxabi.h>
+
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
+#include <vector>
+
+#include "sim/eventq.hh"
+
+namespace gem5
+{
+
+namespace host_profile
+{
+
+bool enabled = false;
+
+namespace
+{
+
+/** The profile of one thread, only written by that thread. */
+struct ThreadProfile
+{
+    struct EventSample
+    {
+        const std::type_info *type = nullptr;
+        Sample sample;
+    };
+
+    /// Samples of the events which are still alive, by address.
+    std::unordered_map<const Event *, EventSample> events;
+    /// Samples of the events which have been deleted, by type.
+    std::unordered_map<std::type_index, Sample> types;
+
+    /// Event being processed, and whether it deleted itself.
+    const Event *current = nullptr;
+    bool currentDeleted = false;
+
+    /// Events of this profile deleted by other threads, which are only
+    /// retired once the threads are synchronized.
+    std::vector<const Event *> retired;
+
+    /** Move the samples of a deleted event to its type. */
+    void
+    retire(const Event *event)
+    {
+        auto it = events.find(event);
+        if (it == events.end())
+            return;
+        types[*it->second.type] += it->second.sample;
+        events.erase(it);
+    }
+};
+
+std::mutex profilesMutex;
+std::vector<std::unique_ptr<ThreadProfile>> profiles;
+/// Profiles holding samples of each event, guarded by profilesMutex.
+std::unordered_multimap<const Event *, ThreadProfile *> owners;
+
+thread_local ThreadProfile *ownProfile = nullptr;
+
+ThreadProfile &
+threadProfile()
+{
+    if (!ownProfile) {
+        std::lock_guard<std::mutex> lock(profilesMutex);
+        profiles.emplace_back(new ThreadProfile);
+        ownProfile = profiles.back().get();
+    }
+    return *ownProfile;
+}
+
+/** Make a string usable in a folded stack. */
+std::string
+sanitize(std::string stack)
+{
+    // Spaces separate the stack from the sample in the folded format.
+    for (auto &c: stack) {
+        if (c == ' ')
+            c = '_';
+    }
+    return stack;
+}
+
+std::string
+stackOf(const Event *event)
+{
+    // Events without a name of their own get a unique one, which would
+    // spread their samples, so only use the description for them.
+    std::string stack = event->name();
+    if (stack.compare(0, 6, "Event_") == 0) {
+        stack = "(unnamed)";
+    } else {
+        for (auto &c: stack) {
+            if (c == '.')
+                c = ';';
+        }
+    }
+    stack += ';';
+    stack += event->description();
+    return sanitize(stack);
+}
+
+std::string
+stackOf(const std::type_index &type)
+{
+    std::string stack = "(deleted);";
+    int status;
+    char *name = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+    stack += status == 0 ? name : type.name();
+    std::free(name);
+    return sanitize(stack);
+}
+
+/** Retire the events deleted by other threads. Needs profilesMutex. */
+void
+retireAll()
+{
+    for (auto &profile: profiles) {
+        for (const Event *event: profile->retired)
+            profile->retire(event);
+        profile->retired.clear();
+    }
+}
+
+} // anonymous namespace
+
+void
+process(Event *event)
+{
+    ThreadProfile &profile = threadProfile();
+    const std::type_info &type = typeid(*event);
+    // Auto delete events are deleted as soon as they are processed, so
+    // don't bother tracking them by address.
+    const bool by_type = event->isAutoDelete();
+
+    profile.current = event;
+    profile.currentDeleted = false;
+    const uint64_t start = hostCycles();
+    event->process();
+    const Sample sample{1, hostCycles() - start};
+    profile.current = nullptr;
+
+    // The event may have deleted itself, so don't touch it anymore.
+    if (by_type || profile.currentDeleted) {
+        profile.types[type] += sample;
+        return;
+    }
+
+    auto [it, inserted] = profile.events.try_emplace(event);
+    if (inserted) {
+        it->second.type = &type;
+        std::lock_guard<std::mutex> lock(profilesMutex);
+        owners.emplace(event, &profile);
+    }
+    it->second.sample += sample;
+}
+
+void
+forget(const Event *event)
+{
+    ThreadProfile *own = ownProfile;
+    if (own && own->current == event)
+        own->currentDeleted = true;
+
+    std::lock_guard<std::mutex> lock(profilesMutex);
+    auto [begin, end] = owners.equal_range(event);
+    for (auto it = begin; it != end; ++it) {
+        if (it->second == own)
+            own->retire(event);
+        else
+            it->second->retired.push_back(event);
+    }
+    owners.erase(begin, end);
+}
+
+Profile
+collect()
+{
+    std::lock_guard<std::mutex> lock(profilesMutex);
+    retireAll();
+    Profile merged;
+    for (const auto &profile: profiles) {
+        // Only live events are left, so their names can be looked up.
+        for (const auto &[event, entry]: profile->events)
+            merged[stackOf(event)] += entry.sample;
+        for (const auto &[type, sample]: profile->types)
+            merged[stackOf(type)] += sample;
+    }
+    return merged;
+}
+
+void
+reset()
+{
+    std::lock_guard<std::mutex> lock(profilesMutex);
+    retireAll();
+    for (auto &profile: profiles) {
+        profile->events.clear();
+        profile->types.clear();
+    }
+    owners.clear();
+}
+
+void
+writeFolded(std::ostream &os, const Profile &profile)
+{
+    for (const auto &[stack, sample]: profile)
+        os << stack << " " << sample.cycles << "\n";
+}
+
+} // namespace host_profile
+} // namespace gem5
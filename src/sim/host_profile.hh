@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Host time profiling of the events processed by the event queues.
+ *
+ * When enabled, the host cycles spent in every Event::process() call are
+ * accumulated per event. Every thread servicing an event queue
+ * accumulates into its own table, so recording a sample doesn't take any
+ * lock. The samples are keyed by the address of the event, and the names
+ * of the events are only looked up when the tables are merged. This
+ * must only happen while the event queues are synchronized, e.g., when
+ * dumping statistics.
+ *
+ * The samples of the events which have been deleted, including all the
+ * auto delete events, can't be named anymore and are accumulated per
+ * type of event instead.
+ */
+
+#ifndef __SIM_HOST_PROFILE_HH__
+#define __SIM_HOST_PROFILE_HH__
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+
+namespace gem5
+{
+
+class Event;
+
+namespace host_profile
+{
+
+/** Read the host cycle counter, or a nanosecond clock if there is none. */
+inline uint64_t
+hostCycles()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+struct Sample
+{
+    uint64_t count = 0;
+    uint64_t cycles = 0;
+
+    Sample &
+    operator+=(const Sample &other)
+    {
+        count += other.count;
+        cycles += other.cycles;
+        return *this;
+    }
+};
+
+/**
+ * Merged profile, indexed by the stack of the event in the flame graph
+ * folded format, i.e., the event name with '.' replaced by ';', followed
+ * by the event description. Deleted events are under "(deleted)",
+ * followed by their type.
+ */
+typedef std::map<std::string, Sample> Profile;
+
+/** Set while profiling. Only changed outside of simulate(). */
+extern bool enabled;
+
+/** Process an event, accounting the host cycles spent to its profile. */
+void process(Event *event);
+
+/** Stop tracking an event as it is being deleted. */
+void forget(const Event *event);
+
+/** Merge the profiles of all the threads. */
+Profile collect();
+
+/** Clear the profiles of all the threads. */
+void reset();
+
+/** Write a profile in the flame graph folded format. */
+void writeFolded(std::ostream &os, const Profile &profile);
+
+} // namespace host_profile
+} // namespace gem5
+
+#endif // __SIM_HOST_PROFILE_HH__
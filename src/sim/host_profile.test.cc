@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "sim/eventq.hh"
+#include "sim/host_profile.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** An event counting how many times its name is looked up. */
+class NamedEvent : public Event
+{
+  private:
+    std::string _name;
+
+  public:
+    mutable int nameLookups = 0;
+    int processed = 0;
+
+    NamedEvent(const std::string &name) : _name(name) {}
+
+    void process() override { processed++; }
+
+    const std::string
+    name() const override
+    {
+        nameLookups++;
+        return _name;
+    }
+
+    const char *description() const override { return "named event"; }
+};
+
+/** An event deleting itself when processed. */
+class SelfDeletingEvent : public Event
+{
+  public:
+    void process() override { delete this; }
+    const std::string name() const override { return "self"; }
+};
+
+class HostProfileTest : public testing::Test
+{
+  protected:
+    EventQueue queue;
+
+    HostProfileTest() : queue("test queue") {}
+
+    void
+    SetUp() override
+    {
+        curEventQueue(&queue);
+        host_profile::enabled = true;
+        host_profile::reset();
+    }
+
+    void
+    TearDown() override
+    {
+        host_profile::reset();
+        host_profile::enabled = false;
+    }
+
+    /** Schedule an event on the next tick and process it. */
+    void
+    run(Event *event)
+    {
+        queue.schedule(event, queue.getCurTick() + 1);
+        queue.serviceOne();
+    }
+};
+
+} // anonymous namespace
+
+TEST_F(HostProfileTest, NamesOnlyLookedUpWhenCollected)
+{
+    NamedEvent event("system.cpu.tick");
+    for (int i = 0; i < 10; i++)
+        run(&event);
+    EXPECT_EQ(event.processed, 10);
+    EXPECT_EQ(event.nameLookups, 0);
+
+    host_profile::Profile profile = host_profile::collect();
+    EXPECT_EQ(event.nameLookups, 1);
+    ASSERT_EQ(profile.size(), 1);
+    ASSERT_EQ(profile.count("system;cpu;tick;named_event"), 1);
+    EXPECT_EQ(profile["system;cpu;tick;named_event"].count, 10);
+}
+
+TEST_F(HostProfileTest, EventsWithTheSameName)
+{
+    NamedEvent a("system.cpu.tick"), b("system.cpu.tick");
+    run(&a);
+    run(&b);
+    run(&b);
+
+    host_profile::Profile profile = host_profile::collect();
+    ASSERT_EQ(profile.size(), 1);
+    EXPECT_EQ(profile["system;cpu;tick;named_event"].count, 3);
+}
+
+TEST_F(HostProfileTest, DeletedEvents)
+{
+    NamedEvent *event = new NamedEvent("system.cpu.tick");
+    run(event);
+    run(event);
+    delete event;
+
+    // The event can't be looked up anymore, so its samples are kept
+    // by type.
+    host_profile::Profile profile = host_profile::collect();
+    ASSERT_EQ(profile.size(), 1);
+    ASSERT_EQ(profile.count("(deleted);(anonymous_namespace)::NamedEvent"),
+              1);
+    EXPECT_EQ(profile["(deleted);(anonymous_namespace)::NamedEvent"].count,
+              2);
+}
+
+TEST_F(HostProfileTest, DeletedByAnotherThread)
+{
+    NamedEvent *event = new NamedEvent("system.cpu.tick");
+    std::thread thread([event]() {
+        EventQueue other("other queue");
+        curEventQueue(&other);
+        other.schedule(event, 1);
+        other.serviceOne();
+    });
+    thread.join();
+    delete event;
+
+    host_profile::Profile profile = host_profile::collect();
+    ASSERT_EQ(profile.size(), 1);
+    EXPECT_EQ(profile["(deleted);(anonymous_namespace)::NamedEvent"].count,
+              1);
+}
+
+TEST_F(HostProfileTest, SelfDeletingEvents)
+{
+    run(new SelfDeletingEvent);
+    run(new SelfDeletingEvent);
+
+    host_profile::Profile profile = host_profile::collect();
+    ASSERT_EQ(profile.size(), 1);
+    EXPECT_EQ(profile[
+        "(deleted);(anonymous_namespace)::SelfDeletingEvent"].count, 2);
+}
+
+TEST_F(HostProfileTest, AutoDeleteEvents)
+{
+    int calls = 0;
+    for (int i = 0; i < 5; i++)
+        run(new EventFunctionWrapper([&calls]() { calls++; }, "wrapper",
+                                     true));
+    EXPECT_EQ(calls, 5);
+
+    host_profile::Profile profile = host_profile::collect();
+    ASSERT_EQ(profile.size(), 1);
+    EXPECT_EQ(profile["(deleted);gem5::EventFunctionWrapper"].count, 5);
+}
+
+TEST_F(HostProfileTest, Reset)
+{
+    NamedEvent event("system.cpu.tick");
+    run(&event);
+    run(new SelfDeletingEvent);
+    host_profile::reset();
+    EXPECT_TRUE(host_profile::collect().empty());
+
+    run(&event);
+    host_profile::Profile profile = host_profile::collect();
+    ASSERT_EQ(profile.size(), 1);
+    EXPECT_EQ(profile["system;cpu;tick;named_event"].count, 1);
+}
+
+TEST_F(HostProfileTest, WriteFolded)
+{
+    host_profile::Profile profile;
+    profile["a;b;c"].cycles = 12;
+    profile["a;d"].cycles = 3;
+    std::ostringstream os;
+    host_profile::writeFolded(os, profile);
+    EXPECT_EQ(os.str(), "a;b;c 12\na;d 3\n");
+}
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/host_profiler.hh"
+
+#include "base/output.hh"
+
+namespace gem5
+{
+
+HostProfiler::HostProfiler(const HostProfilerParams &p)
+    : SimObject(p), flameGraphFile(p.flame_graph_file), stats(this)
+{
+    host_profile::enabled = true;
+}
+
+void
+HostProfiler::regProbePoints()
+{
+    ppProfile = new ProbePointArg<host_profile::Profile>(
+            getProbeManager(), "Profile");
+}
+
+void
+HostProfiler::preDumpStats()
+{
+    SimObject::preDumpStats();
+
+    profile = host_profile::collect();
+    total = host_profile::Sample();
+    for (const auto &entry: profile)
+        total += entry.second;
+
+    if (!flameGraphFile.empty()) {
+        OutputStream *os = simout.create(flameGraphFile);
+        host_profile::writeFolded(*os->stream(), profile);
+        simout.close(os);
+    }
+
+    ppProfile->notify(profile);
+}
+
+void
+HostProfiler::resetStats()
+{
+    SimObject::resetStats();
+    host_profile::reset();
+}
+
+HostProfiler::HostProfilerStats::HostProfilerStats(HostProfiler *profiler)
+    : statistics::Group(profiler),
+      ADD_STAT(events, statistics::units::Count::get(),
+               "Number of events processed"),
+      ADD_STAT(hostCycles, statistics::units::Cycle::get(),
+               "Host cycles spent processing events"),
+      ADD_STAT(profiledEvents, statistics::units::Count::get(),
+               "Number of distinct events profiled"),
+      ADD_STAT(cyclesPerEvent, statistics::units::Rate<
+                    statistics::units::Cycle, statistics::units::Count>::get(),
+               "Average host cycles per event", hostCycles / events)
+{
+    events.functor([profiler]() { return profiler->total.count; });
+    hostCycles.functor([profiler]() { return profiler->total.cycles; });
+    profiledEvents.functor([profiler]() { return profiler->profile.size(); });
+}
+
+} // namespace gem5
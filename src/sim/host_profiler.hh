@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __SIM_HOST_PROFILER_HH__
+#define __SIM_HOST_PROFILER_HH__
+
+#include <string>
+
+#include "base/statistics.hh"
+#include "params/HostProfiler.hh"
+#include "sim/host_profile.hh"
+#include "sim/probe/probe.hh"
+#include "sim/sim_object.hh"
+
+namespace gem5
+{
+
+/**
+ * Enables the host time profiling of the events, see host_profile.hh.
+ * Every time the stats are dumped, the profile accumulated since the last
+ * stats reset is written to a file in the flame graph folded format and
+ * notified through the "Profile" probe point.
+ */
+class HostProfiler : public SimObject
+{
+  public:
+    HostProfiler(const HostProfilerParams &p);
+
+    void regProbePoints() override;
+    void preDumpStats() override;
+    void resetStats() override;
+
+  private:
+    const std::string flameGraphFile;
+
+    /** Profile as of the last stats dump. */
+    host_profile::Profile profile;
+    host_profile::Sample total;
+
+    ProbePointArg<host_profile::Profile> *ppProfile;
+
+    struct HostProfilerStats : public statistics::Group
+    {
+        HostProfilerStats(HostProfiler *profiler);
+
+        statistics::Value events;
+        statistics::Value hostCycles;
+        statistics::Value profiledEvents;
+        statistics::Formula cyclesPerEvent;
+    } stats;
+};
+
+} // namespace gem5
+
+#endif // __SIM_HOST_PROFILER_HH__
@@ -28,6 +28,7 @@
 
 #include "sim/mem_state.hh"
 
+#include <algorithm>
 #include <cassert>
 
 #include "arch/generic/mmu.hh"
@@ -69,6 +70,7 @@ MemState::operator=(const MemState &in)
     _mmapEnd = in._mmapEnd;
     _endBrkPoint = in._endBrkPoint;
     _vmaList = in._vmaList; /* This assignment does a deep copy. */
+    _lazySegments = in._lazySegments;
 
     return *this;
 }
@@ -89,6 +91,14 @@ MemState::isUnmapped(Addr start_addr, Addr length)
             return false;
     }
 
+    /**
+     * Parts of images which haven't been loaded yet are as good as mapped.
+     */
+    for (const auto &seg : _lazySegments) {
+        if (seg.size && range.intersects(RangeSize(seg.base, seg.size)))
+            return false;
+    }
+
     /**
      * In case someone skips the VMA interface and just directly maps memory
      * also consult the page tables to make sure that this memory isnt mapped.
@@ -189,6 +199,8 @@ MemState::unmapRegion(Addr start_addr, Addr length)
     Addr end_addr = start_addr + length;
     const AddrRange range(start_addr, end_addr);
 
+    dropLazyRange(start_addr, end_addr);
+
     auto vma = std::begin(_vmaList);
     while (vma != std::end(_vmaList)) {
         if (vma->isStrictSuperset(range)) {
@@ -286,6 +298,12 @@ MemState::remapRegion(Addr start_addr, Addr new_start_addr, Addr length)
     Addr end_addr = start_addr + length;
     const AddrRange range(start_addr, end_addr);
 
+    /**
+     * Only the page table moves, so load the parts of images in the region
+     * which haven't been loaded yet first.
+     */
+    loadLazyRange(start_addr, end_addr);
+
     auto vma = std::begin(_vmaList);
     while (vma != std::end(_vmaList)) {
         if (vma->isStrictSuperset(range)) {
@@ -386,6 +404,13 @@ MemState::remapRegion(Addr start_addr, Addr new_start_addr, Addr length)
 bool
 MemState::fixupFault(Addr vaddr)
 {
+    /**
+     * Check if this page holds part of an image which hasn't been loaded
+     * yet.
+     */
+    if (!_lazySegments.empty() && loadLazyPage(roundDown(vaddr, _pageBytes)))
+        return true;
+
     /**
      * Check if we are accessing a mapped virtual address. If so then we
      * just haven't allocated it a physical page yet and can do so here.
@@ -448,6 +473,103 @@ MemState::fixupFault(Addr vaddr)
     return false;
 }
 
+void
+MemState::addLazyImage(const loader::MemoryImage &image)
+{
+    for (const auto &seg : image.segments()) {
+        if (seg.size)
+            _lazySegments.push_back(seg);
+    }
+}
+
+void
+MemState::loadLazyImage()
+{
+    for (const auto &seg : _lazySegments)
+        loadLazyRange(seg.base, seg.base + seg.size);
+    _lazySegments.clear();
+}
+
+bool
+MemState::loadLazyPage(Addr vpage_start)
+{
+    const AddrRange page(vpage_start, vpage_start + _pageBytes);
+    PortProxy &phys_proxy = system()->physProxy;
+
+    Addr ppage_start = 0;
+    bool allocated = false;
+    for (const auto &seg : _lazySegments) {
+        const Addr seg_end = seg.base + seg.size;
+        if (!page.intersects(AddrRange(seg.base, seg_end)))
+            continue;
+
+        if (!allocated) {
+            _ownerProcess->allocateMem(vpage_start, _pageBytes);
+            [[maybe_unused]] bool found =
+                _ownerProcess->pTable->translate(vpage_start, ppage_start);
+            assert(found);
+            allocated = true;
+        }
+
+        // Segments don't have to be page aligned, so only fill the part of
+        // the page this one covers.
+        const Addr start = std::max(seg.base, page.start());
+        const Addr end = std::min(seg_end, page.end());
+        const Addr paddr = ppage_start + (start - vpage_start);
+        if (seg.data) {
+            phys_proxy.writeBlob(paddr, seg.data + (start - seg.base),
+                                 end - start);
+        } else {
+            phys_proxy.memsetBlob(paddr, 0, end - start);
+        }
+    }
+
+    if (allocated) {
+        DPRINTF(Vma, "memstate: loaded image page %#x\n", vpage_start);
+    }
+    return allocated;
+}
+
+bool
+MemState::loadLazyRange(Addr start_addr, Addr end_addr)
+{
+    if (_lazySegments.empty())
+        return false;
+
+    bool loaded = false;
+    for (Addr vpage = roundDown(start_addr, _pageBytes); vpage < end_addr;
+         vpage += _pageBytes) {
+        if (!_ownerProcess->pTable->lookup(vpage))
+            loaded |= loadLazyPage(vpage);
+    }
+    return loaded;
+}
+
+void
+MemState::dropLazyRange(Addr start_addr, Addr end_addr)
+{
+    std::vector<loader::MemoryImage::Segment> kept;
+    for (const auto &seg : _lazySegments) {
+        const Addr seg_end = seg.base + seg.size;
+        // Keep what is left of the range...
+        if (seg.base < start_addr) {
+            auto left = seg;
+            left.size = std::min(seg_end, start_addr) - seg.base;
+            kept.push_back(left);
+        }
+        // ...and what is right of it.
+        if (seg_end > end_addr) {
+            auto right = seg;
+            right.base = std::max(seg.base, end_addr);
+            right.size = seg_end - right.base;
+            if (right.data)
+                right.data += right.base - seg.base;
+            kept.push_back(right);
+        }
+    }
+    _lazySegments = std::move(kept);
+}
+
 Addr
 MemState::extendMmap(Addr length)
 {
@@ -37,6 +37,7 @@
 #include <string>
 #include <vector>
 
+#include "base/loader/memory_image.hh"
 #include "debug/Vma.hh"
 #include "mem/page_table.hh"
 #include "mem/se_translating_port_proxy.hh"
@@ -172,6 +173,31 @@ class MemState : public Serializable
      */
     bool fixupFault(Addr vaddr);
 
+    /**
+     * Load an image into memory lazily. Each page the image covers is
+     * allocated and filled on the first fault on it, instead of upfront.
+     *
+     * @param image The image to load. Its segments keep the image data
+     *        alive until the pages are loaded.
+     */
+    void addLazyImage(const loader::MemoryImage &image);
+
+    /**
+     * Load all the pages of lazily loaded images which haven't been
+     * touched yet, so that the page table describes all of memory, e.g.,
+     * before taking a checkpoint.
+     */
+    void loadLazyImage();
+
+    /**
+     * Load the pages of lazily loaded images between start_addr and
+     * end_addr which haven't been touched yet, e.g., because the
+     * simulator is about to access them on behalf of the guest.
+     *
+     * @return Whether any page was loaded.
+     */
+    bool loadLazyRange(Addr start_addr, Addr end_addr);
+
     /**
      * Given the vaddr and size, this method will chunk the allocation into
      * page granularity and then request physical pages (frames) from the
@@ -252,6 +278,20 @@ class MemState : public Serializable
     std::string printVmaList();
 
   private:
+    /**
+     * Allocate and fill the page at vpage_start if it holds part of a
+     * lazily loaded image.
+     *
+     * @return Whether the page is part of a lazily loaded image.
+     */
+    bool loadLazyPage(Addr vpage_start);
+
+    /**
+     * Forget the parts of lazily loaded images between start_addr and
+     * end_addr, e.g., because the guest unmapped them.
+     */
+    void dropLazyRange(Addr start_addr, Addr end_addr);
+
     /**
      * @param
      */
@@ -295,6 +335,12 @@ class MemState : public Serializable
      * support this or the unmapping method must be changed.
      */
     std::list<VMA> _vmaList;
+
+    /**
+     * Segments of lazily loaded images. Their pages are filled on the
+     * first fault on them.
+     */
+    std::vector<loader::MemoryImage::Segment> _lazySegments;
 };
 
 } // namespace gem5
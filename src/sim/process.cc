@@ -116,6 +116,7 @@ Process::Process(const ProcessParams &params, EmulationPageTable *pTable,
       seWorkload(dynamic_cast<SEWorkload *>(system->workload)),
       useArchPT(params.useArchPT),
       kvmInSE(params.kvmInSE),
+      lazyLoad(params.lazy_load),
       useForClone(false),
       pTable(pTable),
       objFile(obj_file),
@@ -302,14 +303,22 @@ Process::initState()
                 tc, SETranslatingPortProxy::Always));
 
     // load object file into target memory
-    image.write(*initVirtMem);
-    interpImage.write(*initVirtMem);
+    if (lazyLoad) {
+        memState->addLazyImage(image);
+        memState->addLazyImage(interpImage);
+    } else {
+        image.write(*initVirtMem);
+        interpImage.write(*initVirtMem);
+    }
 }
 
 DrainState
 Process::drain()
 {
     fds->updateFileOffsets();
+    // Checkpoints only hold the pages in the page table, so any part of
+    // the binary which hasn't been touched yet needs to be loaded.
+    memState->loadLazyImage();
     return DrainState::Drained;
 }
 
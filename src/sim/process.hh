@@ -178,6 +178,8 @@ class Process : public SimObject
     bool useArchPT;
     // running KVM requires special initialization
     bool kvmInSE;
+    // flag for loading the binary into memory as pages are touched
+    bool lazyLoad;
     // flag for using the process as a thread which shares page tables
     bool useForClone;
 
@@ -36,7 +36,8 @@ namespace gem5
 {
 
 SEWorkload::SEWorkload(const Params &p, Addr page_shift) :
-    Workload(p), memPools(page_shift)
+    Workload(p), memPools(page_shift),
+    _hostIO(p.io_threads, p.io_chunk_size)
 {}
 
 void
@@ -53,6 +54,12 @@ SEWorkload::setSystem(System *sys)
     memPools.populate(memories);
 }
 
+uint8_t *
+SEWorkload::hostPtr(Addr addr, size_t size, bool writeable)
+{
+    return system->hostPtr(addr, size, writeable);
+}
+
 void
 SEWorkload::serialize(CheckpointOut &cp) const
 {
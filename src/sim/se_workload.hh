@@ -29,6 +29,7 @@
 #define __SIM_SE_WORKLOAD_HH__
 
 #include "params/SEWorkload.hh"
+#include "sim/host_io.hh"
 #include "sim/mem_pool.hh"
 #include "sim/workload.hh"
 
@@ -41,6 +42,9 @@ class SEWorkload : public Workload
     /** Memory allocation objects for all physical memories in the system. */
     MemPools memPools;
 
+    /** Host file I/O of the simulated processes. */
+    HostIO _hostIO;
+
   public:
     using Params = SEWorkloadParams;
 
@@ -89,6 +93,18 @@ class SEWorkload : public Workload
     // For now, assume the only type of events are system calls.
     void event(ThreadContext *tc) override { syscall(tc); }
 
+    HostIO &hostIO() { return _hostIO; }
+
+    /**
+     * Get a host pointer to a range of physical memory, for syscalls to
+     * access guest buffers directly.
+     *
+     * @param writeable Whether the range will be written.
+     * @return Host pointer, or nullptr if the range can't be accessed
+     * directly, e.g., because memory may be cached.
+     */
+    uint8_t *hostPtr(Addr addr, size_t size, bool writeable);
+
     Addr allocPhysPages(int npages, int pool_id=0);
     Addr memSize(int pool_id=0) const;
     Addr freeMemSize(int pool_id=0) const;
@@ -84,15 +84,28 @@ Serializable::unserializeSection(CheckpointIn &cp, const char *name)
     unserialize(cp);
 }
 
-void
-Serializable::generateCheckpointOut(const std::string &cpt_dir,
-        std::ofstream &outstream)
+std::string
+Serializable::checkpointFile(const std::string &cpt_dir)
 {
     std::string dir = CheckpointIn::setDir(cpt_dir);
     if (mkdir(dir.c_str(), 0775) == -1 && errno != EEXIST)
             fatal("couldn't mkdir %s\n", dir);
 
-    std::string cpt_file = dir + CheckpointIn::baseFilename;
+    return dir + CheckpointIn::baseFilename;
+}
+
+void
+Serializable::generateCheckpointOut(const std::string &cpt_dir,
+        BinaryCheckpointOut &outstream)
+{
+    outstream.open(checkpointFile(cpt_dir));
+}
+
+void
+Serializable::generateCheckpointOut(const std::string &cpt_dir,
+        std::ofstream &outstream)
+{
+    std::string cpt_file = checkpointFile(cpt_dir);
     outstream = std::ofstream(cpt_file.c_str());
     time_t t = time(NULL);
     if (!outstream)
@@ -123,7 +136,10 @@ Serializable::ScopedCheckpointSection::nameOut(CheckpointOut &cp)
 {
     DPRINTF(Checkpoint, "ScopedCheckpointSection::nameOut: %s\n",
             Serializable::currentSection());
-    cp << "\n[" << Serializable::currentSection() << "]\n";
+    if (auto *bin = BinaryCheckpointOut::from(cp))
+        bin->section(Serializable::currentSection());
+    else
+        cp << "\n[" << Serializable::currentSection() << "]\n";
 }
 
 const std::string &
@@ -160,7 +176,9 @@ CheckpointIn::CheckpointIn(const std::string &cpt_dir)
     : db(), _cptDir(setDir(cpt_dir))
 {
     std::string filename = getCptDir() + "/" + CheckpointIn::baseFilename;
-    if (!db.load(filename)) {
+    if (BinaryCheckpointIn::isBinary(filename)) {
+        binaryDb = std::make_unique<BinaryCheckpointIn>(filename);
+    } else if (!db.load(filename)) {
         fatal("Can't load checkpoint file '%s'\n", filename);
     }
 }
@@ -177,6 +195,8 @@ CheckpointIn::CheckpointIn(const std::string &cpt_dir)
 bool
 CheckpointIn::entryExists(const std::string &section, const std::string &entry)
 {
+    if (binaryDb)
+        return binaryDb->find(section, entry);
     return db.entryExists(section, entry);
 }
 /**
@@ -193,12 +213,20 @@ bool
 CheckpointIn::find(const std::string &section, const std::string &entry,
         std::string &value)
 {
+    if (binaryDb) {
+        const BinaryCheckpointIn::Value *v = binaryDb->find(section, entry);
+        if (v)
+            value = BinaryCheckpointIn::toString(*v);
+        return v;
+    }
     return db.find(section, entry, value);
 }
 
 bool
 CheckpointIn::sectionExists(const std::string &section)
 {
+    if (binaryDb)
+        return binaryDb->sectionExists(section);
     return db.sectionExists(section);
 }
 
@@ -206,7 +234,10 @@ void
 CheckpointIn::visitSection(const std::string &section,
     IniFile::VisitSectionCallback cb)
 {
-    db.visitSection(section, cb);
+    if (binaryDb)
+        binaryDb->visitSection(section, cb);
+    else
+        db.visitSection(section, cb);
 }
 
 } // namespace gem5
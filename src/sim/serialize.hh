@@ -50,6 +50,7 @@
 #include <fstream>
 #include <iostream>
 #include <iterator>
+#include <memory>
 #include <stack>
 #include <string>
 #include <type_traits>
@@ -58,6 +59,7 @@
 
 #include "base/inifile.hh"
 #include "base/logging.hh"
+#include "sim/serialize_binary.hh"
 #include "sim/serialize_handlers.hh"
 
 namespace gem5
@@ -70,6 +72,9 @@ class CheckpointIn
   private:
     IniFile db;
 
+    // Index of the checkpoint file if it is a binary one
+    std::unique_ptr<BinaryCheckpointIn> binaryDb;
+
     const std::string _cptDir;
 
   public:
@@ -91,6 +96,12 @@ class CheckpointIn
     bool sectionExists(const std::string &section);
     void visitSection(const std::string &section,
         IniFile::VisitSectionCallback cb);
+
+    /**
+     * @return The binary checkpoint being restored, or nullptr if it is
+     * a text one.
+     */
+    BinaryCheckpointIn *binary() { return binaryDb.get(); }
     /** @}*/ //end of api_checkout group
 
     // The following static functions have to do with checkpoint
@@ -311,8 +322,22 @@ class Serializable
     static void generateCheckpointOut(const std::string &cpt_dir,
         std::ofstream &outstream);
 
+    /**
+     * Generate a binary checkpoint file so that the serialization can be
+     * routed to it.
+     *
+     * @param cpt_dir The dir at which the cpt file will be created.
+     * @param outstream The cpt file.
+     * @ingroup api_serialize
+     */
+    static void generateCheckpointOut(const std::string &cpt_dir,
+        BinaryCheckpointOut &outstream);
+
   private:
     static std::stack<std::string> path;
+
+    /** Create the checkpoint directory and return the file to write. */
+    static std::string checkpointFile(const std::string &cpt_dir);
 };
 
 /**
@@ -326,6 +351,13 @@ template <class T>
 void
 paramOut(CheckpointOut &os, const std::string &name, const T &param)
 {
+    if constexpr (binary_checkpoint::Typed<T>) {
+        if (auto *bin = BinaryCheckpointOut::from(os)) {
+            bin->scalar(name, param);
+            return;
+        }
+    }
+
     os << name << "=";
     ShowParam<T>::show(os, param);
     os << "\n";
@@ -336,6 +368,13 @@ bool
 paramInImpl(CheckpointIn &cp, const std::string &name, T &param)
 {
     const std::string &section(Serializable::currentSection());
+    if constexpr (binary_checkpoint::Typed<T>) {
+        if (auto *bin = cp.binary()) {
+            const auto *value = bin->find(section, name);
+            return value && BinaryCheckpointIn::get(*value, param);
+        }
+    }
+
     std::string str;
     return cp.find(section, name, str) && ParseParam<T>::parse(str, param);
 }
@@ -388,9 +427,16 @@ void
 arrayParamOut(CheckpointOut &os, const std::string &name,
               InputIterator start, InputIterator end)
 {
+    using Elem = std::remove_cv_t<std::remove_reference_t<decltype(*start)>>;
+    if constexpr (binary_checkpoint::Typed<Elem>) {
+        if (auto *bin = BinaryCheckpointOut::from(os)) {
+            bin->array<Elem>(name, start, end);
+            return;
+        }
+    }
+
     os << name << "=";
     auto it = start;
-    using Elem = std::remove_cv_t<std::remove_reference_t<decltype(*it)>>;
     if (it != end)
         ShowParam<Elem>::show(os, *it++);
     while (it != end) {
@@ -442,6 +488,26 @@ arrayParamIn(CheckpointIn &cp, const std::string &name,
              InsertIterator inserter, ssize_t fixed_size=-1)
 {
     const std::string &section = Serializable::currentSection();
+    if constexpr (binary_checkpoint::Typed<T>) {
+        const BinaryCheckpointIn::Value *value =
+            cp.binary() ? cp.binary()->find(section, name) : nullptr;
+        if (value && value->isArray()) {
+            BinaryCheckpointIn::ArrayReader elems(*value);
+            fatal_if(fixed_size >= 0 &&
+                     (ssize_t)elems.size() != fixed_size,
+                     "Array size mismatch on %s:%s (Got %u, expected %u)'\n",
+                     section, name, elems.size(), fixed_size);
+            for (uint64_t i = 0; i < elems.size(); i++) {
+                T elem;
+                fatal_if(!elems.next(elem),
+                         "Could not parse element %d of %s:%s.", i,
+                         section, name);
+                *inserter = elem;
+            }
+            return;
+        }
+    }
+
     std::string str;
     fatal_if(!cp.find(section, name, str),
         "Can't unserialize '%s:%s'.", section, name);
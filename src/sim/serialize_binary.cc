@@ -0,0 +1,568 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/serialize_binary.hh"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <sstream>
+#include <streambuf>
+
+#include "base/logging.hh"
+#include "base/str.hh"
+
+namespace gem5
+{
+
+namespace binary_checkpoint
+{
+
+const char Magic[8] = {'g', 'e', 'm', '5', 'b', 'c', 'p', '1'};
+
+namespace
+{
+
+struct Header
+{
+    char magic[8];
+    uint64_t indexOffset;
+    uint64_t numExtents;
+};
+
+} // anonymous namespace
+
+ValueType
+elementType(ValueType array)
+{
+    switch (array) {
+      case ValueType::BoolArray:
+        return ValueType::Bool;
+      case ValueType::IntArray:
+        return ValueType::Int;
+      case ValueType::UIntArray:
+        return ValueType::UInt;
+      case ValueType::DoubleArray:
+        return ValueType::Double;
+      default:
+        panic("Checkpoint value type %d isn't an array", (int)array);
+    }
+}
+
+} // namespace binary_checkpoint
+
+using namespace binary_checkpoint;
+
+/**
+ * Buffer behind a binary checkpoint stream. Text written to the stream
+ * is parsed as in a text checkpoint, one line at a time, while typed
+ * entries are added directly.
+ */
+class BinaryCheckpointOut::Writer : public std::streambuf
+{
+  private:
+    std::string path;
+    std::ofstream out;
+    uint64_t offset = 0;
+
+    struct IndexEntry
+    {
+        std::string section;
+        uint64_t offset;
+        uint64_t size;
+    };
+    std::vector<IndexEntry> index;
+
+    /** Name and entries of the current section. */
+    bool inSection = false;
+    std::string sectionName;
+    std::vector<uint8_t> data;
+
+    /** Text written to the stream, and not parsed yet. */
+    char textBuf[4096];
+    std::string pending;
+
+    void
+    write(const void *buf, size_t size)
+    {
+        out.write(static_cast<const char *>(buf), size);
+        fatal_if(!out, "Write failed on checkpoint file '%s'", path);
+        offset += size;
+    }
+
+    void
+    endSection()
+    {
+        if (!inSection)
+            return;
+        index.push_back({sectionName, offset, data.size()});
+        write(data.data(), data.size());
+        data.clear();
+        inSection = false;
+    }
+
+    void
+    parseLine(std::string line)
+    {
+        eat_white(line);
+        if (line.empty())
+            return;
+
+        if (line.front() == '[' && line.back() == ']') {
+            std::string name = line.substr(1, line.size() - 2);
+            eat_white(name);
+            startSection(name);
+            return;
+        }
+
+        // Lines outside of sections, e.g., comments, are ignored.
+        if (!inSection)
+            return;
+
+        const auto eq = line.find('=');
+        warn_if(eq == std::string::npos,
+                "Can't parse checkpoint line '%s'", line);
+        if (eq == std::string::npos)
+            return;
+
+        const bool append = eq > 0 && line[eq - 1] == '+';
+        std::string name = line.substr(0, append ? eq - 1 : eq);
+        std::string value = line.substr(eq + 1);
+        eat_white(name);
+        eat_white(value);
+        addEntry(name, append ? ValueType::Append : ValueType::String,
+                 reinterpret_cast<const uint8_t *>(value.data()),
+                 value.size());
+    }
+
+    void
+    startSection(const std::string &name)
+    {
+        endSection();
+        inSection = true;
+        sectionName = name;
+    }
+
+    void
+    addEntry(const std::string &name, ValueType type, const uint8_t *value,
+             size_t size)
+    {
+        panic_if(!inSection, "Checkpoint entry %s outside of a section",
+                 name);
+        varint::append(data, name.size());
+        data.insert(data.end(), name.begin(), name.end());
+        data.push_back(static_cast<uint8_t>(type));
+        varint::append(data, size);
+        data.insert(data.end(), value, value + size);
+    }
+
+    /** Parse the complete lines of the text written so far. */
+    void
+    parseText()
+    {
+        pending.append(pbase(), pptr() - pbase());
+        setp(textBuf, textBuf + sizeof(textBuf));
+
+        size_t start = 0;
+        for (size_t nl = pending.find('\n'); nl != std::string::npos;
+             nl = pending.find('\n', start)) {
+            parseLine(pending.substr(start, nl - start));
+            start = nl + 1;
+        }
+        pending.erase(0, start);
+    }
+
+  protected:
+    int_type
+    overflow(int_type c) override
+    {
+        parseText();
+        if (!traits_type::eq_int_type(c, traits_type::eof()))
+            sputc(traits_type::to_char_type(c));
+        return traits_type::not_eof(c);
+    }
+
+    int
+    sync() override
+    {
+        parseText();
+        return 0;
+    }
+
+  public:
+    Writer() { setp(textBuf, textBuf + sizeof(textBuf)); }
+
+    void
+    open(const std::string &_path)
+    {
+        path = _path;
+        out.open(path, std::ios::out | std::ios::trunc | std::ios::binary);
+        fatal_if(!out, "Unable to open file %s for writing\n", path);
+        offset = 0;
+        index.clear();
+
+        // The header is written once the index is.
+        const Header header = {};
+        write(&header, sizeof(header));
+    }
+
+    bool isOpen() const { return out.is_open(); }
+
+    void
+    close()
+    {
+        parseText();
+        if (!pending.empty())
+            parseLine(pending);
+        pending.clear();
+        endSection();
+
+        Header header;
+        memcpy(header.magic, Magic, sizeof(Magic));
+        header.indexOffset = offset;
+        header.numExtents = index.size();
+
+        std::vector<uint8_t> buf;
+        for (const auto &e: index) {
+            varint::append(buf, e.section.size());
+            buf.insert(buf.end(), e.section.begin(), e.section.end());
+            varint::append(buf, e.offset);
+            varint::append(buf, e.size);
+        }
+        write(buf.data(), buf.size());
+
+        out.seekp(0);
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        out.close();
+        fatal_if(!out, "Close failed on checkpoint file '%s'", path);
+    }
+
+    // The text written so far is parsed first, to keep the entries in
+    // the order they were written in.
+
+    void
+    section(const std::string &name)
+    {
+        parseText();
+        startSection(name);
+    }
+
+    void
+    entry(const std::string &name, ValueType type, const uint8_t *value,
+          size_t size)
+    {
+        parseText();
+        addEntry(name, type, value, size);
+    }
+};
+
+BinaryCheckpointOut::BinaryCheckpointOut()
+    : std::ostream(nullptr), writer(new Writer)
+{
+    rdbuf(writer.get());
+    pword(streamIndex()) = this;
+}
+
+BinaryCheckpointOut::~BinaryCheckpointOut()
+{
+    if (writer->isOpen())
+        close();
+}
+
+int
+BinaryCheckpointOut::streamIndex()
+{
+    static const int index = std::ios_base::xalloc();
+    return index;
+}
+
+void
+BinaryCheckpointOut::open(const std::string &path)
+{
+    writer->open(path);
+}
+
+void
+BinaryCheckpointOut::close()
+{
+    writer->close();
+}
+
+void
+BinaryCheckpointOut::section(const std::string &name)
+{
+    writer->section(name);
+}
+
+void
+BinaryCheckpointOut::entry(const std::string &name, ValueType type,
+                           const std::vector<uint8_t> &value)
+{
+    writer->entry(name, type, value.data(), value.size());
+}
+
+BinaryCheckpointIn::ArrayReader::ArrayReader(const Value &value)
+    : type(elementType(value.type)), pos(value.data),
+      end(value.data + value.size), count(0)
+{
+    const size_t bytes = varint::decode(pos, end - pos, count);
+    panic_if(!bytes, "Corrupted checkpoint array");
+    pos += bytes;
+}
+
+bool
+BinaryCheckpointIn::isBinary(const std::string &path)
+{
+    std::ifstream f(path, std::ios::binary);
+    char magic[sizeof(Magic)];
+    return f.read(magic, sizeof(magic)) &&
+        !memcmp(magic, Magic, sizeof(Magic));
+}
+
+BinaryCheckpointIn::BinaryCheckpointIn(const std::string &_path)
+    : path(_path), file(nullptr), fileSize(0)
+{
+    int fd = open(path.c_str(), O_RDONLY);
+    fatal_if(fd < 0, "Can't load checkpoint file '%s'\n", path);
+
+    struct stat st;
+    fatal_if(fstat(fd, &st), "Can't load checkpoint file '%s'\n", path);
+    fileSize = st.st_size;
+    fatal_if(fileSize < sizeof(Header), "Truncated checkpoint file '%s'\n",
+             path);
+
+    void *ptr = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    fatal_if(ptr == MAP_FAILED, "Can't map checkpoint file '%s'\n", path);
+    file = static_cast<const uint8_t *>(ptr);
+
+    Header header;
+    memcpy(&header, file, sizeof(header));
+    fatal_if(memcmp(header.magic, Magic, sizeof(Magic)),
+             "'%s' isn't a binary checkpoint\n", path);
+    fatal_if(header.indexOffset > fileSize,
+             "Corrupted checkpoint file '%s'\n", path);
+
+    const uint8_t *pos = file + header.indexOffset;
+    const uint8_t *end = file + fileSize;
+    auto next = [&]() {
+        uint64_t val;
+        const size_t bytes = varint::decode(pos, end - pos, val);
+        fatal_if(!bytes, "Corrupted checkpoint index in '%s'\n", path);
+        pos += bytes;
+        return val;
+    };
+    for (uint64_t i = 0; i < header.numExtents; i++) {
+        const uint64_t len = next();
+        fatal_if(len > (uint64_t)(end - pos),
+                 "Corrupted checkpoint index in '%s'\n", path);
+        std::string name(reinterpret_cast<const char *>(pos), len);
+        pos += len;
+        Extent extent;
+        extent.offset = next();
+        extent.size = next();
+        fatal_if(extent.offset + extent.size > header.indexOffset,
+                 "Corrupted checkpoint index in '%s'\n", path);
+        sections[name].extents.push_back(extent);
+    }
+}
+
+BinaryCheckpointIn::~BinaryCheckpointIn()
+{
+    if (file)
+        munmap(const_cast<uint8_t *>(file), fileSize);
+}
+
+void
+BinaryCheckpointIn::decodeSection(Section &section)
+{
+    for (const auto &extent: section.extents) {
+        const uint8_t *pos = file + extent.offset;
+        const uint8_t *end = pos + extent.size;
+        auto next = [&]() {
+            uint64_t val;
+            const size_t bytes = varint::decode(pos, end - pos, val);
+            fatal_if(!bytes, "Corrupted checkpoint file '%s'\n", path);
+            pos += bytes;
+            return val;
+        };
+        while (pos < end) {
+            const uint64_t name_len = next();
+            fatal_if(name_len >= (uint64_t)(end - pos),
+                     "Corrupted checkpoint file '%s'\n", path);
+            std::string name(reinterpret_cast<const char *>(pos), name_len);
+            pos += name_len;
+            const auto type = static_cast<ValueType>(*pos++);
+            const uint64_t size = next();
+            fatal_if(size > (uint64_t)(end - pos),
+                     "Corrupted checkpoint file '%s'\n", path);
+            Value value{type, pos, size};
+            pos += size;
+
+            auto it = section.entries.find(name);
+            if (type == ValueType::Append) {
+                value.type = ValueType::String;
+                if (it != section.entries.end()) {
+                    appended.push_back(toString(it->second) + " " +
+                            std::string(reinterpret_cast<const char *>(
+                                    value.data), value.size));
+                    value.data = reinterpret_cast<const uint8_t *>(
+                            appended.back().data());
+                    value.size = appended.back().size();
+                }
+            }
+            if (it == section.entries.end()) {
+                section.order.push_back(name);
+                section.entries.emplace(std::move(name), value);
+            } else {
+                it->second = value;
+            }
+        }
+    }
+    section.decoded = true;
+}
+
+BinaryCheckpointIn::Section *
+BinaryCheckpointIn::findSection(const std::string &name)
+{
+    auto it = sections.find(name);
+    if (it == sections.end())
+        return nullptr;
+    if (!it->second.decoded)
+        decodeSection(it->second);
+    return &it->second;
+}
+
+const BinaryCheckpointIn::Value *
+BinaryCheckpointIn::find(const std::string &section, const std::string &entry)
+{
+    Section *s = findSection(section);
+    if (!s)
+        return nullptr;
+    auto it = s->entries.find(entry);
+    return it == s->entries.end() ? nullptr : &it->second;
+}
+
+bool
+BinaryCheckpointIn::sectionExists(const std::string &section)
+{
+    return sections.find(section) != sections.end();
+}
+
+void
+BinaryCheckpointIn::visitSection(const std::string &section,
+                                 IniFile::VisitSectionCallback cb)
+{
+    Section *s = findSection(section);
+    panic_if(!s, "No section %s in checkpoint '%s'", section, path);
+    for (const auto &name: s->order)
+        cb(name, toString(s->entries.at(name)));
+}
+
+bool
+BinaryCheckpointIn::decodeRaw(ValueType type, const uint8_t *&pos,
+                              const uint8_t *end, uint64_t &raw)
+{
+    if (type == ValueType::Double) {
+        if (end - pos < (ssize_t)sizeof(raw))
+            return false;
+        memcpy(&raw, pos, sizeof(raw));
+        pos += sizeof(raw);
+        return true;
+    }
+
+    const size_t bytes = varint::decode(pos, end - pos, raw);
+    pos += bytes;
+    return bytes != 0;
+}
+
+std::string
+BinaryCheckpointIn::scalarString(ValueType type, uint64_t raw)
+{
+    std::ostringstream os;
+    switch (type) {
+      case ValueType::Bool:
+        ShowParam<bool>::show(os, raw != 0);
+        break;
+      case ValueType::Int:
+        ShowParam<int64_t>::show(os, varint::unzigzag(raw));
+        break;
+      case ValueType::UInt:
+        ShowParam<uint64_t>::show(os, raw);
+        break;
+      case ValueType::Double:
+        {
+            double d;
+            memcpy(&d, &raw, sizeof(d));
+            ShowParam<double>::show(os, d);
+        }
+        break;
+      default:
+        panic("Checkpoint value type %d isn't a scalar", (int)type);
+    }
+    return os.str();
+}
+
+std::string
+BinaryCheckpointIn::toString(const Value &value)
+{
+    if (value.type == ValueType::String || value.type == ValueType::Append)
+        return std::string(reinterpret_cast<const char *>(value.data),
+                           value.size);
+
+    const uint8_t *pos = value.data;
+    const uint8_t *end = value.data + value.size;
+    uint64_t raw;
+
+    if (!value.isArray()) {
+        panic_if(!decodeRaw(value.type, pos, end, raw),
+                 "Corrupted checkpoint value");
+        return scalarString(value.type, raw);
+    }
+
+    const ValueType type = elementType(value.type);
+    uint64_t count;
+    const size_t bytes = varint::decode(pos, end - pos, count);
+    panic_if(!bytes, "Corrupted checkpoint value");
+    pos += bytes;
+
+    std::string str;
+    for (uint64_t i = 0; i < count; i++) {
+        panic_if(!decodeRaw(type, pos, end, raw),
+                 "Corrupted checkpoint value");
+        if (i)
+            str += " ";
+        str += scalarString(type, raw);
+    }
+    return str;
+}
+
+} // namespace gem5
@@ -0,0 +1,389 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Binary checkpoint format
+ *
+ * A binary checkpoint holds the same sections and entries as the text
+ * one, but scalars and arrays of arithmetic types are stored as typed
+ * binary values instead of being formatted and parsed, and an index
+ * of the sections at the end of the file lets a restore only decode
+ * the sections it looks up.
+ *
+ * The file starts with a header pointing to the index. Each section
+ * is stored as one or more extents of entries, where an entry is its
+ * name, the type of its value, and its encoded value:
+ *
+ *   varint name length, name, uint8 type, varint value length, value
+ *
+ * Integers are stored as varints, zigzag encoded when signed, and
+ * floating point values as host order doubles. The index lists the
+ * extents, as their section name, offset and length.
+ *
+ * Entries which aren't written through the typed helpers, e.g., those
+ * written directly to the stream, are stored as strings, and values
+ * are rendered as in text checkpoints when read as strings.
+ */
+
+#ifndef __SIM_SERIALIZE_BINARY_HH__
+#define __SIM_SERIALIZE_BINARY_HH__
+
+#include <sys/types.h>
+
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "base/inifile.hh"
+#include "base/varint.hh"
+#include "sim/serialize_handlers.hh"
+
+namespace gem5
+{
+
+namespace binary_checkpoint
+{
+
+/** Magic number at the start of binary checkpoint files. */
+extern const char Magic[8];
+
+enum class ValueType : uint8_t
+{
+    String,
+    /** A string appended to the previous value, as with += in text. */
+    Append,
+    Bool,
+    Int,
+    UInt,
+    Double,
+    BoolArray,
+    IntArray,
+    UIntArray,
+    DoubleArray,
+};
+
+/** Whether values of type T are stored in binary. */
+template <class T>
+constexpr bool Typed = std::is_arithmetic_v<T>;
+
+template <class T>
+constexpr ValueType
+scalarType()
+{
+    if constexpr (std::is_same_v<T, bool>)
+        return ValueType::Bool;
+    else if constexpr (std::is_floating_point_v<T>)
+        return ValueType::Double;
+    else if constexpr (std::is_signed_v<T>)
+        return ValueType::Int;
+    else
+        return ValueType::UInt;
+}
+
+template <class T>
+constexpr ValueType
+arrayType()
+{
+    switch (scalarType<T>()) {
+      case ValueType::Bool:
+        return ValueType::BoolArray;
+      case ValueType::Double:
+        return ValueType::DoubleArray;
+      case ValueType::Int:
+        return ValueType::IntArray;
+      default:
+        return ValueType::UIntArray;
+    }
+}
+
+/** Scalar type of the elements of an array type. */
+ValueType elementType(ValueType array);
+
+template <class T>
+void
+encode(std::vector<uint8_t> &out, const T &value)
+{
+    if constexpr (std::is_floating_point_v<T>) {
+        const double d = value;
+        const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&d);
+        out.insert(out.end(), bytes, bytes + sizeof(d));
+    } else if constexpr (std::is_signed_v<T>) {
+        varint::append(out, varint::zigzag(value));
+    } else {
+        varint::append(out, value);
+    }
+}
+
+} // namespace binary_checkpoint
+
+/**
+ * Stream writing a binary checkpoint. It can be used wherever a text
+ * checkpoint stream is, and the serialization helpers check for it to
+ * store typed values.
+ */
+class BinaryCheckpointOut : public std::ostream
+{
+  private:
+    class Writer;
+    std::unique_ptr<Writer> writer;
+
+    /** Scratch buffer for the values being encoded. */
+    std::vector<uint8_t> scratch;
+
+    static int streamIndex();
+
+    void entry(const std::string &name, binary_checkpoint::ValueType type,
+               const std::vector<uint8_t> &value);
+
+  public:
+    BinaryCheckpointOut();
+    ~BinaryCheckpointOut();
+
+    /** Start writing a checkpoint file. */
+    void open(const std::string &path);
+
+    /** Finish writing the checkpoint file. */
+    void close();
+
+    /**
+     * @return The binary checkpoint behind a checkpoint stream, or
+     * nullptr if it's a text checkpoint.
+     */
+    static BinaryCheckpointOut *
+    from(std::ostream &os)
+    {
+        return static_cast<BinaryCheckpointOut *>(os.pword(streamIndex()));
+    }
+
+    /** Start a new section. */
+    void section(const std::string &name);
+
+    template <class T>
+    void
+    scalar(const std::string &name, const T &value)
+    {
+        scratch.clear();
+        binary_checkpoint::encode(scratch, value);
+        entry(name, binary_checkpoint::scalarType<T>(), scratch);
+    }
+
+    template <class Elem, class InputIterator>
+    void
+    array(const std::string &name, InputIterator start, InputIterator end)
+    {
+        // The elements are encoded after their count, which is only
+        // known once they have been.
+        std::vector<uint8_t> elems;
+        uint64_t count = 0;
+        for (auto it = start; it != end; ++it, ++count)
+            binary_checkpoint::encode<Elem>(elems, *it);
+
+        scratch.clear();
+        varint::append(scratch, count);
+        scratch.insert(scratch.end(), elems.begin(), elems.end());
+        entry(name, binary_checkpoint::arrayType<Elem>(), scratch);
+    }
+};
+
+/**
+ * Index of a binary checkpoint file, which is mapped in memory. The
+ * entries of a section are decoded the first time it is looked up.
+ */
+class BinaryCheckpointIn
+{
+  public:
+    struct Value
+    {
+        binary_checkpoint::ValueType type;
+        const uint8_t *data;
+        size_t size;
+
+        bool
+        isArray() const
+        {
+            return type >= binary_checkpoint::ValueType::BoolArray;
+        }
+    };
+
+    /** Sequential decoder of the elements of an array value. */
+    class ArrayReader
+    {
+      private:
+        binary_checkpoint::ValueType type;
+        const uint8_t *pos;
+        const uint8_t *end;
+        uint64_t count;
+
+      public:
+        ArrayReader(const Value &value);
+
+        uint64_t size() const { return count; }
+
+        /** Decode the next element into value. */
+        template <class T>
+        bool
+        next(T &value)
+        {
+            return decode(type, pos, end, value);
+        }
+    };
+
+  private:
+    struct Extent
+    {
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    struct Section
+    {
+        std::vector<Extent> extents;
+        bool decoded = false;
+        std::unordered_map<std::string, Value> entries;
+        std::vector<std::string> order;
+    };
+
+    const std::string path;
+    const uint8_t *file;
+    size_t fileSize;
+
+    std::unordered_map<std::string, Section> sections;
+
+    /** Values of entries appended to, which aren't in the file. */
+    std::deque<std::string> appended;
+
+    Section *findSection(const std::string &section);
+    void decodeSection(Section &section);
+
+    static bool decodeRaw(binary_checkpoint::ValueType type,
+                          const uint8_t *&pos, const uint8_t *end,
+                          uint64_t &raw);
+
+    /**
+     * Decode a scalar of a given type, converting it to T. Conversions
+     * which aren't exact, e.g., from a double to an integer, go through
+     * the text representation so they behave as with text checkpoints.
+     */
+    template <class T>
+    static bool
+    decode(binary_checkpoint::ValueType type, const uint8_t *&pos,
+           const uint8_t *end, T &value)
+    {
+        using binary_checkpoint::ValueType;
+
+        uint64_t raw;
+        if (!decodeRaw(type, pos, end, raw))
+            return false;
+
+        if constexpr (std::is_same_v<T, bool>) {
+            if (type == ValueType::Bool) {
+                value = raw;
+                return raw <= 1;
+            }
+        } else if constexpr (std::is_floating_point_v<T>) {
+            if (type == ValueType::Double) {
+                double d;
+                memcpy(&d, &raw, sizeof(d));
+                value = d;
+                return true;
+            } else if (type == ValueType::Int) {
+                value = varint::unzigzag(raw);
+                return true;
+            } else if (type == ValueType::UInt) {
+                value = raw;
+                return true;
+            }
+        } else if constexpr (std::is_integral_v<T>) {
+            using Limits = std::numeric_limits<T>;
+            if (type == ValueType::UInt) {
+                if (raw > (uint64_t)Limits::max())
+                    return false;
+                value = raw;
+                return true;
+            } else if (type == ValueType::Int) {
+                const int64_t i = varint::unzigzag(raw);
+                if (i >= 0 && (uint64_t)i <= (uint64_t)Limits::max()) {
+                    value = i;
+                    return true;
+                } else if (i < 0 && std::is_signed_v<T>) {
+                    if (i < (int64_t)Limits::min())
+                        return false;
+                    value = i;
+                    return true;
+                }
+            }
+        }
+
+        return ParseParam<T>::parse(scalarString(type, raw), value);
+    }
+
+    static std::string scalarString(binary_checkpoint::ValueType type,
+                                    uint64_t raw);
+
+  public:
+    /** @return Whether a checkpoint file is a binary one. */
+    static bool isBinary(const std::string &path);
+
+    BinaryCheckpointIn(const std::string &path);
+    ~BinaryCheckpointIn();
+
+    BinaryCheckpointIn(const BinaryCheckpointIn &) = delete;
+    BinaryCheckpointIn &operator=(const BinaryCheckpointIn &) = delete;
+
+    const Value *find(const std::string &section, const std::string &entry);
+    bool sectionExists(const std::string &section);
+    void visitSection(const std::string &section,
+                      IniFile::VisitSectionCallback cb);
+
+    /** Render a value as it would be in a text checkpoint. */
+    static std::string toString(const Value &value);
+
+    /** Get a scalar value, converted to T. */
+    template <class T>
+    static bool
+    get(const Value &value, T &out)
+    {
+        if (value.isArray() ||
+                value.type == binary_checkpoint::ValueType::String) {
+            return ParseParam<T>::parse(toString(value), out);
+        }
+        const uint8_t *pos = value.data;
+        return decode(value.type, pos, value.data + value.size, out);
+    }
+};
+
+} // namespace gem5
+
+#endif // __SIM_SERIALIZE_BINARY_HH__
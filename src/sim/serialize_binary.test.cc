@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest-spi.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "base/gtest/cur_tick_fake.hh"
+#include "base/gtest/logging.hh"
+#include "base/gtest/serialization_fixture.hh"
+#include "sim/serialize.hh"
+
+using namespace gem5;
+
+// Instantiate the mock class to have a valid curTick of 0
+GTestTickHandler tickHandler;
+
+using BinarySerializeFixture = SerializationFixture;
+
+/** Test that typed and text entries survive a binary checkpoint. */
+TEST_F(BinarySerializeFixture, ParamOutIn)
+{
+    const int integer = -5;
+    const uint64_t big = 0xfedcba9876543210ULL;
+    const double real = 3.14159265358979;
+    const bool boolean = true;
+    const std::string str = "string test";
+    const char character = 'c';
+    const std::vector<int> ints = {1, -2, 300000};
+    const std::list<double> reals = {0.5, -1e100};
+
+    {
+        BinaryCheckpointOut cp;
+        Serializable::generateCheckpointOut(getDirName(), cp);
+        Serializable::ScopedCheckpointSection scs(cp, "Section1");
+        paramOut(cp, "Param1", integer);
+        paramOut(cp, "Param2", big);
+        paramOut(cp, "Param3", real);
+        paramOut(cp, "Param4", boolean);
+        paramOut(cp, "Param5", str);
+        paramOut(cp, "Param6", character);
+        arrayParamOut(cp, "Param7", ints);
+        arrayParamOut(cp, "Param8", reals);
+        cp << "Param9=written directly\n";
+        {
+            Serializable::ScopedCheckpointSection scs(cp, "Nested");
+            paramOut(cp, "Param1", integer + 1);
+        }
+    }
+
+    CheckpointIn cpt(getDirName());
+    ASSERT_NE(cpt.binary(), nullptr);
+    ASSERT_TRUE(cpt.sectionExists("Section1"));
+    ASSERT_TRUE(cpt.sectionExists("Section1.Nested"));
+    ASSERT_FALSE(cpt.sectionExists("Section2"));
+
+    Serializable::ScopedCheckpointSection scs(cpt, "Section1");
+
+    int unserialized_integer;
+    paramIn(cpt, "Param1", unserialized_integer);
+    ASSERT_EQ(integer, unserialized_integer);
+
+    uint64_t unserialized_big;
+    paramIn(cpt, "Param2", unserialized_big);
+    ASSERT_EQ(big, unserialized_big);
+
+    // Unlike text checkpoints, doubles are restored exactly.
+    double unserialized_real;
+    paramIn(cpt, "Param3", unserialized_real);
+    ASSERT_EQ(real, unserialized_real);
+
+    bool unserialized_boolean;
+    paramIn(cpt, "Param4", unserialized_boolean);
+    ASSERT_EQ(boolean, unserialized_boolean);
+
+    std::string unserialized_str;
+    paramIn(cpt, "Param5", unserialized_str);
+    ASSERT_EQ(str, unserialized_str);
+
+    char unserialized_character;
+    paramIn(cpt, "Param6", unserialized_character);
+    ASSERT_EQ(character, unserialized_character);
+
+    std::vector<int> unserialized_ints;
+    arrayParamIn(cpt, "Param7", unserialized_ints);
+    ASSERT_EQ(ints, unserialized_ints);
+
+    std::list<double> unserialized_reals;
+    arrayParamIn(cpt, "Param8", unserialized_reals);
+    ASSERT_EQ(reals, unserialized_reals);
+
+    paramIn(cpt, "Param9", unserialized_str);
+    ASSERT_EQ("written directly", unserialized_str);
+
+    // Values are rendered as in text checkpoints.
+    std::string value;
+    ASSERT_TRUE(cpt.find("Section1", "Param4", value));
+    ASSERT_EQ("true", value);
+    ASSERT_TRUE(cpt.find("Section1", "Param6", value));
+    ASSERT_EQ("99", value);
+    ASSERT_TRUE(cpt.find("Section1", "Param7", value));
+    ASSERT_EQ("1 -2 300000", value);
+    ASSERT_TRUE(cpt.find("Section1.Nested", "Param1", value));
+    ASSERT_EQ("-4", value);
+    ASSERT_FALSE(cpt.find("Section1", "Param10", value));
+}
+
+/** Test conversions between the stored and the requested types. */
+TEST_F(BinarySerializeFixture, Conversions)
+{
+    {
+        BinaryCheckpointOut cp;
+        Serializable::generateCheckpointOut(getDirName(), cp);
+        Serializable::ScopedCheckpointSection scs(cp, "Section1");
+        paramOut(cp, "Negative", -1);
+        paramOut(cp, "Large", 300u);
+        paramOut(cp, "Real", 2.0);
+        paramOut(cp, "Int", 7);
+    }
+
+    CheckpointIn cpt(getDirName());
+    Serializable::ScopedCheckpointSection scs(cpt, "Section1");
+
+    unsigned u;
+    ASSERT_FALSE(optParamIn(cpt, "Negative", u, false));
+    uint8_t byte;
+    ASSERT_FALSE(optParamIn(cpt, "Large", byte, false));
+    int64_t i;
+    ASSERT_TRUE(optParamIn(cpt, "Large", i, false));
+    ASSERT_EQ(300, i);
+    // As with text checkpoints, "2" can be parsed as an integer.
+    ASSERT_TRUE(optParamIn(cpt, "Real", i, false));
+    ASSERT_EQ(2, i);
+    double d;
+    ASSERT_TRUE(optParamIn(cpt, "Int", d, false));
+    ASSERT_EQ(7.0, d);
+    bool b;
+    ASSERT_FALSE(optParamIn(cpt, "Int", b, false));
+}
+
+/**
+ * Test that sections written several times are merged, with later
+ * entries overriding the earlier ones, and that entries appended to in
+ * text are.
+ */
+TEST_F(BinarySerializeFixture, RepeatedSections)
+{
+    {
+        BinaryCheckpointOut cp;
+        Serializable::generateCheckpointOut(getDirName(), cp);
+        {
+            Serializable::ScopedCheckpointSection scs(cp, "Section1");
+            paramOut(cp, "Param1", 1);
+            paramOut(cp, "Param2", std::string("a"));
+        }
+        {
+            Serializable::ScopedCheckpointSection scs(cp, "Section2");
+        }
+        {
+            Serializable::ScopedCheckpointSection scs(cp, "Section1");
+            paramOut(cp, "Param1", 2);
+            cp << "Param2+=b\n";
+        }
+    }
+
+    CheckpointIn cpt(getDirName());
+    ASSERT_TRUE(cpt.sectionExists("Section2"));
+
+    std::string value;
+    ASSERT_TRUE(cpt.find("Section1", "Param1", value));
+    ASSERT_EQ("2", value);
+    ASSERT_TRUE(cpt.find("Section1", "Param2", value));
+    ASSERT_EQ("a b", value);
+
+    std::vector<std::string> entries;
+    cpt.visitSection("Section1",
+        [&](const std::string &key, const std::string &val) {
+            entries.push_back(key + "=" + val);
+        });
+    ASSERT_EQ(std::vector<std::string>({"Param1=2", "Param2=a b"}),
+              entries);
+}
+
+/** Test that an array of the wrong size can't be restored. */
+TEST_F(BinarySerializeFixture, ArraySizeMismatch)
+{
+    const int ints[] = {1, 2, 3};
+    {
+        BinaryCheckpointOut cp;
+        Serializable::generateCheckpointOut(getDirName(), cp);
+        Serializable::ScopedCheckpointSection scs(cp, "Section1");
+        arrayParamOut(cp, "Param1", ints, 3);
+    }
+
+    CheckpointIn cpt(getDirName());
+    Serializable::ScopedCheckpointSection scs(cpt, "Section1");
+    int restored[4];
+    gtestLogOutput.str("");
+    ASSERT_ANY_THROW(arrayParamIn(cpt, "Param1", restored, 4));
+    ASSERT_NE(gtestLogOutput.str().find("Array size mismatch"),
+              std::string::npos);
+}
@@ -129,10 +129,16 @@ SimObject::getPort(const std::string &if_name, PortID idx)
 // static function: serialize all SimObjects.
 //
 void
-SimObject::serializeAll(const std::string &cpt_dir)
-{
-    std::ofstream cp;
-    Serializable::generateCheckpointOut(cpt_dir, cp);
+SimObject::serializeAll(const std::string &cpt_dir, bool binary)
+{
+    std::ofstream text_cp;
+    BinaryCheckpointOut binary_cp;
+    if (binary)
+        Serializable::generateCheckpointOut(cpt_dir, binary_cp);
+    else
+        Serializable::generateCheckpointOut(cpt_dir, text_cp);
+    CheckpointOut &cp = binary ?
+        static_cast<CheckpointOut &>(binary_cp) : text_cp;
 
     SimObjectList::reverse_iterator ri = simObjectList.rbegin();
     SimObjectList::reverse_iterator rend = simObjectList.rend();
@@ -326,8 +326,12 @@ class SimObject : public EventManager, public Serializable, public Drainable,
      * in its own section. As such, the serialization functions should not
      * be called on sim objects anywhere else; otherwise, these objects
      * would be needlessly serialized more than once.
+     *
+     * @param cpt_dir The checkpoint directory.
+     * @param binary Whether to write a binary checkpoint file.
      */
-    static void serializeAll(const std::string &cpt_dir);
+    static void serializeAll(const std::string &cpt_dir,
+                             bool binary=false);
 
     /**
      * Find the SimObject with the given name and return a pointer to
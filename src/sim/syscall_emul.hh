@@ -82,9 +82,11 @@
 #include <sys/uio.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cerrno>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "arch/generic/tlb.hh"
 #include "base/intmath.hh"
@@ -104,6 +106,7 @@
 #include "sim/guest_abi.hh"
 #include "sim/process.hh"
 #include "sim/proxy_ptr.hh"
+#include "sim/se_workload.hh"
 #include "sim/syscall_debug_macros.hh"
 #include "sim/syscall_desc.hh"
 #include "sim/syscall_emul_buf.hh"
@@ -1788,27 +1791,32 @@ readvFunc(SyscallDesc *desc, ThreadContext *tc,
     int sim_fd = ffdp->getSimFD();
 
     SETranslatingPortProxy prox(tc);
-    typename OS::tgt_iovec tiov[count];
-    struct iovec hiov[count];
+    std::vector<std::unique_ptr<IoBufferArg>> bufs;
+    std::vector<iovec> hiov;
     for (typename OS::size_t i = 0; i < count; ++i) {
+        typename OS::tgt_iovec tiov;
         prox.readBlob(tiov_base + (i * sizeof(typename OS::tgt_iovec)),
-                      &tiov[i], sizeof(typename OS::tgt_iovec));
-        hiov[i].iov_len = gtoh(tiov[i].iov_len, OS::byteOrder);
-        hiov[i].iov_base = new char [hiov[i].iov_len];
+                      &tiov, sizeof(typename OS::tgt_iovec));
+        bufs.emplace_back(new IoBufferArg(tc,
+                    gtoh(tiov.iov_base, OS::byteOrder),
+                    gtoh(tiov.iov_len, OS::byteOrder),
+                    true));
+        const auto &buf_iov = bufs.back()->iovecs();
+        hiov.insert(hiov.end(), buf_iov.begin(), buf_iov.end());
     }
 
-    int result = readv(sim_fd, hiov, count);
-    int local_errno = errno;
+    ssize_t result = p->seWorkload->hostIO().readv(sim_fd, hiov);
+    if (result == -1)
+        return -errno;
 
-    for (typename OS::size_t i = 0; i < count; ++i) {
-        if (result != -1) {
-            prox.writeBlob(htog(tiov[i].iov_base, OS::byteOrder),
-                           hiov[i].iov_base, hiov[i].iov_len);
-        }
-        delete [] (char *)hiov[i].iov_base;
+    size_t left = result;
+    for (auto &buf: bufs) {
+        const size_t len = std::min(left, buf->size());
+        buf->copyOut(len);
+        left -= len;
     }
 
-    return (result == -1) ? -local_errno : result;
+    return result;
 }
 
 /// Target writev() handler.
@@ -1826,22 +1834,23 @@ writevFunc(SyscallDesc *desc, ThreadContext *tc,
     int sim_fd = hbfdp->getSimFD();
 
     SETranslatingPortProxy prox(tc);
-    struct iovec hiov[count];
+    std::vector<std::unique_ptr<IoBufferArg>> bufs;
+    std::vector<iovec> hiov;
     for (typename OS::size_t i = 0; i < count; ++i) {
         typename OS::tgt_iovec tiov;
 
         prox.readBlob(tiov_base + i*sizeof(typename OS::tgt_iovec),
                       &tiov, sizeof(typename OS::tgt_iovec));
-        hiov[i].iov_len = gtoh(tiov.iov_len, OS::byteOrder);
-        hiov[i].iov_base = new char [hiov[i].iov_len];
-        prox.readBlob(gtoh(tiov.iov_base, OS::byteOrder), hiov[i].iov_base,
-                      hiov[i].iov_len);
+        bufs.emplace_back(new IoBufferArg(tc,
+                    gtoh(tiov.iov_base, OS::byteOrder),
+                    gtoh(tiov.iov_len, OS::byteOrder),
+                    false));
+        bufs.back()->copyIn();
+        const auto &buf_iov = bufs.back()->iovecs();
+        hiov.insert(hiov.end(), buf_iov.begin(), buf_iov.end());
     }
 
-    int result = writev(sim_fd, hiov, count);
-
-    for (typename OS::size_t i = 0; i < count; ++i)
-        delete [] (char *)hiov[i].iov_base;
+    ssize_t result = p->seWorkload->hostIO().writev(sim_fd, hiov);
 
     return (result == -1) ? -errno : result;
 }
@@ -2001,13 +2010,20 @@ pread64Func(SyscallDesc *desc, ThreadContext *tc,
         return -EBADF;
     int sim_fd = ffdp->getSimFD();
 
-    BufferArg bufArg(bufPtr, nbytes);
+    // HostIO takes a negative offset to mean the file position.
+    if (offset < 0)
+        return -EINVAL;
+
+    IoBufferArg buf_arg(tc, bufPtr, nbytes, true);
 
-    int bytes_read = pread(sim_fd, bufArg.bufferPtr(), nbytes, offset);
+    ssize_t bytes_read = p->seWorkload->hostIO().readv(
+            sim_fd, buf_arg.iovecs(), offset);
+    if (bytes_read == -1)
+        return -errno;
 
-    bufArg.copyOut(SETranslatingPortProxy(tc));
+    buf_arg.copyOut(bytes_read);
 
-    return (bytes_read == -1) ? -errno : bytes_read;
+    return bytes_read;
 }
 
 template <class OS>
@@ -2022,10 +2038,15 @@ pwrite64Func(SyscallDesc *desc, ThreadContext *tc,
         return -EBADF;
     int sim_fd = ffdp->getSimFD();
 
-    BufferArg bufArg(bufPtr, nbytes);
-    bufArg.copyIn(SETranslatingPortProxy(tc));
+    // HostIO takes a negative offset to mean the file position.
+    if (offset < 0)
+        return -EINVAL;
+
+    IoBufferArg buf_arg(tc, bufPtr, nbytes, false);
+    buf_arg.copyIn();
 
-    int bytes_written = pwrite(sim_fd, bufArg.bufferPtr(), nbytes, offset);
+    ssize_t bytes_written = p->seWorkload->hostIO().writev(
+            sim_fd, buf_arg.iovecs(), offset);
 
     return (bytes_written == -1) ? -errno : bytes_written;
 }
@@ -2662,13 +2683,15 @@ readFunc(SyscallDesc *desc, ThreadContext *tc,
         && !(hbfdp->getFlags() & OS::TGT_O_NONBLOCK))
         return SyscallReturn::retry();
 
-    BufferArg buf_arg(buf_ptr, nbytes);
-    int bytes_read = read(sim_fd, buf_arg.bufferPtr(), nbytes);
+    IoBufferArg buf_arg(tc, buf_ptr, nbytes, true);
+    ssize_t bytes_read = p->seWorkload->hostIO().readv(
+            sim_fd, buf_arg.iovecs());
+    if (bytes_read == -1)
+        return -errno;
 
-    if (bytes_read > 0)
-        buf_arg.copyOut(SETranslatingPortProxy(tc));
+    buf_arg.copyOut(bytes_read);
 
-    return (bytes_read == -1) ? -errno : bytes_read;
+    return bytes_read;
 }
 
 template <class OS>
@@ -2683,9 +2706,6 @@ writeFunc(SyscallDesc *desc, ThreadContext *tc,
         return -EBADF;
     int sim_fd = hbfdp->getSimFD();
 
-    BufferArg buf_arg(buf_ptr, nbytes);
-    buf_arg.copyIn(SETranslatingPortProxy(tc));
-
     struct pollfd pfd;
     pfd.fd = sim_fd;
     pfd.events = POLLOUT;
@@ -2702,7 +2722,11 @@ writeFunc(SyscallDesc *desc, ThreadContext *tc,
             return SyscallReturn::retry();
     }
 
-    int bytes_written = write(sim_fd, buf_arg.bufferPtr(), nbytes);
+    IoBufferArg buf_arg(tc, buf_ptr, nbytes, false);
+    buf_arg.copyIn();
+
+    ssize_t bytes_written = p->seWorkload->hostIO().writev(
+            sim_fd, buf_arg.iovecs());
 
     if (bytes_written != -1)
         fsync(sim_fd);
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/syscall_emul_buf.hh"
+
+#include <algorithm>
+
+#include "cpu/thread_context.hh"
+#include "mem/page_table.hh"
+#include "sim/mem_state.hh"
+#include "sim/process.hh"
+#include "sim/se_workload.hh"
+
+namespace gem5
+{
+
+IoBufferArg::IoBufferArg(ThreadContext *_tc, Addr _addr, size_t size,
+                         bool _writeable)
+    : tc(_tc), addr(_addr), _size(size), writeable(_writeable)
+{
+    if (_size == 0 || mapDirect())
+        return;
+
+    iov.clear();
+    bounce.reset(new uint8_t[_size]());
+    iov.push_back({bounce.get(), _size});
+}
+
+bool
+IoBufferArg::mapDirect()
+{
+    Process *p = tc->getProcessPtr();
+    EmulationPageTable *pt = p->pTable;
+    const Addr page_size = pt->pageSize();
+
+    Addr vaddr = addr;
+    size_t left = _size;
+    while (left) {
+        const size_t len = std::min<size_t>(
+                left, pt->pageAlign(vaddr) + page_size - vaddr);
+
+        // Pages of lazily loaded images may not have been touched yet.
+        Addr paddr;
+        if (!pt->translate(vaddr, paddr) &&
+                !(p->memState->loadLazyRange(vaddr, vaddr + len) &&
+                  pt->translate(vaddr, paddr))) {
+            return false;
+        }
+        uint8_t *host = p->seWorkload->hostPtr(paddr, len, writeable);
+        if (!host)
+            return false;
+
+        // Physically contiguous pages are usually contiguous on the host
+        // too, so merge them to keep the host call short.
+        if (!iov.empty() &&
+                (uint8_t *)iov.back().iov_base + iov.back().iov_len == host) {
+            iov.back().iov_len += len;
+        } else {
+            iov.push_back({host, len});
+        }
+
+        vaddr += len;
+        left -= len;
+    }
+    return true;
+}
+
+void
+IoBufferArg::copyIn()
+{
+    if (bounce)
+        SETranslatingPortProxy(tc).readBlob(addr, bounce.get(), _size);
+}
+
+void
+IoBufferArg::copyOut(size_t len)
+{
+    if (bounce && len)
+        SETranslatingPortProxy(tc).writeBlob(addr, bounce.get(),
+                std::min(len, _size));
+}
+
+} // namespace gem5
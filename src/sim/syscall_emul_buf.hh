@@ -35,7 +35,11 @@
 /// This file defines buffer classes used to handle pointer arguments
 /// in emulated syscalls.
 
+#include <sys/uio.h>
+
 #include <cstring>
+#include <memory>
+#include <vector>
 
 #include "base/types.hh"
 #include "mem/se_translating_port_proxy.hh"
@@ -43,6 +47,8 @@
 namespace gem5
 {
 
+class ThreadContext;
+
 /**
  * Base class for BufferArg and TypedBufferArg, Not intended to be
  * used directly.
@@ -168,6 +174,58 @@ class TypedBufferArg : public BaseBufferArg
     T &operator[](int i) { return ((T *)bufPtr)[i]; }
 };
 
+/**
+ * IoBufferArg represents a buffer in the target address space that a
+ * host read or write transfers data to or from, through iovecs.
+ *
+ * When memory isn't cached and the buffer is mapped, the iovecs point
+ * straight at the pages of the buffer in simulated memory, and copying
+ * in and out does nothing. Otherwise, they point at a buffer in
+ * simulator space, like BufferArg.
+ */
+class IoBufferArg
+{
+  public:
+    /**
+     * @param writeable Whether the host call writes the buffer, i.e.,
+     * it is a read into target memory.
+     */
+    IoBufferArg(ThreadContext *tc, Addr addr, size_t size, bool writeable);
+
+    IoBufferArg(const IoBufferArg &) = delete;
+    IoBufferArg &operator=(const IoBufferArg &) = delete;
+
+    /** Buffers for the host call to read from or write to. */
+    const std::vector<iovec> &iovecs() const { return iov; }
+
+    size_t size() const { return _size; }
+
+    /** Whether the iovecs point at simulated memory. */
+    bool direct() const { return !bounce; }
+
+    /** Read the buffer from target memory, before a host write. */
+    void copyIn();
+
+    /**
+     * Write the first len bytes of the buffer to target memory, after a
+     * host read.
+     */
+    void copyOut(size_t len);
+
+  private:
+    ThreadContext *tc;
+    const Addr addr;
+    const size_t _size;
+    const bool writeable;
+
+    std::vector<iovec> iov;
+    /** Buffer in simulator space, if the iovecs don't point at memory. */
+    std::unique_ptr<uint8_t[]> bounce;
+
+    /** Point the iovecs at simulated memory, if possible. */
+    bool mapDirect();
+};
+
 } // namespace gem5
 
 #endif // __SIM_SYSCALL_EMUL_BUF_HH__
@@ -166,12 +166,20 @@ int System::numSystemsRunning = 0;
 
 System::System(const Params &p)
     : SimObject(p), _systemPort("system_port"),
+      backdoors(_systemPort, physmem),
       multiThread(p.multi_thread),
       init_param(p.init_param),
-      physProxy(_systemPort, p.cache_line_size),
+      physProxy(_systemPort, p.cache_line_size,
+                [this](Addr addr, size_t size, bool writeable) {
+                    return hostPtr(addr, size, writeable);
+                }),
       workload(p.workload),
       physmem(name() + ".physmem", p.memories, p.mmap_using_noreserve,
-              p.shared_backstore, p.auto_unlink_shared_backstore),
+              p.shared_backstore, p.auto_unlink_shared_backstore,
+              {p.legacy_memory_checkpoint, p.memory_checkpoint_compression,
+               p.memory_checkpoint_threads, p.delta_memory_checkpoints,
+               p.max_delta_memory_checkpoints,
+               p.shared_memory_image_dir}),
       ShadowRomRanges(p.shadow_rom_ranges.begin(),
                       p.shadow_rom_ranges.end()),
       memoryMode(p.mem_mode),
@@ -226,6 +234,27 @@ System::getPort(const std::string &if_name, PortID idx)
     return _systemPort;
 }
 
+uint8_t *
+System::hostPtr(Addr addr, size_t size, bool writeable)
+{
+    // Backdoors bypass the caches, so they can only be used while the
+    // caches are guaranteed to be empty or out of the way.
+    if (started && !bypassCaches())
+        return nullptr;
+    if (!writeable)
+        return backdoors.hostPtr(addr, size, false);
+
+    memory::AbstractMemory *mem = physmem.findMemory(addr);
+    return mem ? mem->hostPtrForWrite(addr, size) : nullptr;
+}
+
+void
+System::startup()
+{
+    SimObject::startup();
+    started = true;
+}
+
 void
 System::setMemoryMode(enums::MemoryMode mode)
 {
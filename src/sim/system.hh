@@ -53,6 +53,7 @@
 #include "base/statistics.hh"
 #include "cpu/pc_event.hh"
 #include "enums/MemoryMode.hh"
+#include "mem/backdoor_cache.hh"
 #include "mem/mem_requestor.hh"
 #include "mem/physical.hh"
 #include "mem/port.hh"
@@ -107,6 +108,15 @@ class System : public SimObject, public PCEventScope
     std::list<PCEvent *> liveEvents;
     SystemPort _systemPort;
 
+    /** Backdoors into memory obtained through the system port. */
+    MemBackdoorCache backdoors;
+
+    /**
+     * Whether simulation has started. Until then, no cache can hold
+     * data, so memory can be accessed behind their back.
+     */
+    bool started = false;
+
     // Map of memory address ranges for devices with their own backing stores
     std::unordered_map<RequestorID, std::vector<memory::AbstractMemory *>>
         deviceMemMap;
@@ -238,6 +248,25 @@ class System : public SimObject, public PCEventScope
      */
     RequestPort& getSystemPort() { return _systemPort; }
 
+    /**
+     * Get a host pointer to a range of physical memory, to access it
+     * without going through the memory system. This is only possible
+     * while memory can't be cached, i.e., before simulation starts or
+     * while caches are bypassed.
+     *
+     * Reads go through a readable backdoor. Writes are marked as such
+     * in the memory, so it keeps tracking the pages written for delta
+     * checkpoints, which it can't do for writes through a backdoor.
+     * The write must therefore be done right away.
+     *
+     * @param addr Physical address.
+     * @param size Size of the range (in bytes).
+     * @param writeable Whether the range will be written.
+     * @return Host pointer, or nullptr if the range can't be accessed
+     * directly.
+     */
+    uint8_t *hostPtr(Addr addr, size_t size, bool writeable);
+
     /**
      * Additional function to return the Port of a memory object.
      */
@@ -577,6 +606,8 @@ class System : public SimObject, public PCEventScope
     void registerThreadContext(ThreadContext *tc);
     void replaceThreadContext(ThreadContext *tc, ContextID context_id);
 
+    void startup() override;
+
     void serialize(CheckpointOut &cp) const override;
     void unserialize(CheckpointIn &cp) override;
 
@@ -98,6 +98,12 @@ parser.add_argument(
     help="The number of CPU cores to run.",
 )
 
+parser.add_argument(
+    "--lazy-load",
+    action="store_true",
+    help="Load the binary into memory a page at a time, when first touched.",
+)
+
 args = parser.parse_args()
 
 # Setup the system.
@@ -137,6 +143,9 @@ motherboard = SimpleBoard(
 # Set the workload
 binary = Resource(args.resource, resource_directory=args.resource_directory)
 motherboard.set_se_binary_workload(binary, arguments=args.arguments)
+if args.lazy_load:
+    for core in motherboard.get_processor().get_cores():
+        core.get_simobject().workload[0].lazy_load = True
 
 # Run the simulation
 simulator = Simulator(board=motherboard)
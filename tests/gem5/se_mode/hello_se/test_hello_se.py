@@ -89,10 +89,10 @@ regex = re.compile(r"Hello world!")
 stdout_verifier = verifier.MatchRegex(regex)
 
 
-def verify_config(isa, binary, cpu, hosts, verifier, input):
+def verify_config(isa, binary, cpu, hosts, verifier, input, suffix=""):
 
     gem5_verify_config(
-        name="test-" + binary + "-" + cpu,
+        name="test-" + binary + "-" + cpu + suffix,
         fixtures=(),
         verifiers=(verifier,),
         config=joinpath(
@@ -138,6 +138,24 @@ for isa in dynamic_progs:
                 [],
             )
 
+# Run hello worlds with the binaries loaded lazily. The dynamic loader
+# passes paths from its own image straight to syscalls like access()
+# and openat(), so these pages may be accessed by a syscall before the
+# CPU ever touches them. Atomic CPUs access syscall buffers in place,
+# timing ones copy them.
+for isa in dynamic_progs:
+    for binary in static_progs[isa] + dynamic_progs[isa]:
+        for cpu in ("atomic", "timing"):
+            verify_config(
+                isa,
+                binary,
+                cpu,
+                constants.target_host[isa],
+                stdout_verifier,
+                ["--lazy-load"],
+                suffix="-lazy-load",
+            )
+
 regex = re.compile(r"1 print this")
 stdout_verifier = verifier.MatchRegex(regex)
 
@@ -0,0 +1,160 @@
+# Copyright (c) 2026 The Regents of The University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+import unittest
+from unittest import mock
+
+import m5.stats
+
+
+class MockStat:
+    def __init__(self, name, value):
+        self.name = name
+        self.value = value
+
+    def visit(self, visitor):
+        visitor.visit(self.name, self.value())
+
+
+class MockGroup:
+    """A stat group, which is also a SimObject when it has a path."""
+
+    def __init__(self, path=None, stats=(), groups=None):
+        self.path = path
+        self.stats = list(stats)
+        self.groups = groups or {}
+        self.lazy_value = 0
+        self.pending = 0
+
+    def preDumpStats(self):
+        # Bring the lazy value up to date, like SimObjects computing some
+        # of their stats only before dumping.
+        self.lazy_value += self.pending
+        self.pending = 0
+        for group in self.groups.values():
+            group.preDumpStats()
+
+    def getStats(self):
+        return self.stats
+
+    def getStatGroups(self):
+        return self.groups
+
+    def getCCObject(self):
+        return self
+
+    def path_list(self):
+        return self.path.split(".")
+
+
+class MockOutput:
+    def __init__(self):
+        self.values = {}
+        self.groups = []
+
+    def valid(self):
+        return True
+
+    def begin(self):
+        pass
+
+    def end(self):
+        pass
+
+    def beginGroup(self, name):
+        self.groups.append(name)
+
+    def endGroup(self):
+        self.groups.pop()
+
+    def visit(self, name, value):
+        self.values[".".join(self.groups + [name])] = value
+
+
+class StatsDumpTestSuite(unittest.TestCase):
+    def setUp(self):
+        # system.lazy has a stat only updated by preDumpStats(), and
+        # system.formula a formula computed from it.
+        self.lazy = MockGroup(
+            "system.lazy",
+            [MockStat("value", lambda: self.lazy.lazy_value)],
+        )
+        self.formula = MockGroup(
+            "system.formula",
+            [MockStat("doubled", lambda: 2 * self.lazy.lazy_value)],
+        )
+        self.system = MockGroup(
+            "system", groups={"lazy": self.lazy, "formula": self.formula}
+        )
+        self.root = MockGroup(groups={"system": self.system})
+        self.output = MockOutput()
+        self.tick = 0
+
+        patches = [
+            mock.patch.object(m5.stats, "_m5"),
+            mock.patch.object(m5.stats.Root, "getInstance", self.getRoot),
+            mock.patch.object(m5, "curTick", lambda: self.tick),
+            mock.patch.object(m5.stats, "outputList", [self.output]),
+            mock.patch.object(m5.stats, "global_dump_roots", []),
+            mock.patch.object(m5.stats, "lastDump", 0),
+            mock.patch.object(m5.stats, "_prepared_roots", set()),
+        ]
+        for patch in patches:
+            patch.start()
+            self.addCleanup(patch.stop)
+
+    def getRoot(self):
+        return self.root
+
+    def test_partial_dump_of_formula_depending_on_another_group(self):
+        self.lazy.pending = 21
+        self.tick = 100
+        m5.stats.dump(roots=[self.formula])
+
+        self.assertEqual(self.output.values, {"system.formula.doubled": 42})
+        # Only the dumped stats, and the ones they depend on, are prepared.
+        m5.stats._m5.stats.prepare.assert_called_once_with([self.formula])
+
+    def test_partial_dumps_in_the_same_tick(self):
+        self.lazy.pending = 1
+        self.tick = 100
+        m5.stats.dump(roots=[self.formula])
+        self.lazy.pending = 1
+        m5.stats.dump(roots=[self.lazy])
+
+        # The stats are only brought up to date once per tick.
+        self.assertEqual(self.output.values["system.lazy.value"], 1)
+        self.assertEqual(m5.stats._m5.stats.prepare.call_count, 2)
+
+    def test_partial_dumps_in_different_ticks(self):
+        self.lazy.pending = 1
+        self.tick = 100
+        m5.stats.dump(roots=[self.formula])
+        self.lazy.pending = 2
+        self.tick = 200
+        m5.stats.dump(roots=[self.formula])
+
+        self.assertEqual(self.output.values["system.formula.doubled"], 6)
@@ -0,0 +1,121 @@
+# Copyright (c) 2026 The Regents of The University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+import argparse
+import importlib.util
+import io
+import os
+import unittest
+
+_spec = importlib.util.spec_from_file_location(
+    "decode_bin_trace",
+    os.path.join(
+        os.path.dirname(os.path.abspath(__file__)),
+        os.pardir,
+        os.pardir,
+        os.pardir,
+        "util",
+        "decode_bin_trace.py",
+    ),
+)
+decode_bin_trace = importlib.util.module_from_spec(_spec)
+_spec.loader.exec_module(decode_bin_trace)
+
+
+def _varint(val):
+    out = bytearray()
+    while True:
+        byte = val & 0x7F
+        val >>= 7
+        if val:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return bytes(out)
+
+
+def _zigzag(val):
+    return (val << 1) ^ (val >> 63)
+
+
+def _string(text):
+    data = text.encode()
+    return _varint(decode_bin_trace.STRING_DEF) + _varint(len(data)) + data
+
+
+class DecodeBinTraceTestSuite(unittest.TestCase):
+    """Test cases for the BinTracer trace decoder"""
+
+    def decode(self, chunk):
+        args = argparse.Namespace(
+            symbols=True,
+            seq=False,
+            user_only=False,
+            kernel_only=False,
+            no_micro=False,
+            no_ticks=False,
+        )
+        out = io.StringIO()
+        decode_bin_trace.Stream().decode(chunk, args, out)
+        return out.getvalue()
+
+    def inst(self, status, data, mem_addr=None):
+        d = decode_bin_trace
+        header = d.INST | d.CONTEXT | status << d.DATA_STATUS_SHIFT
+        if mem_addr is not None:
+            header |= d.MEM
+        rec = _varint(header)
+        # CPU name, thread, tick, PC and instruction strings
+        rec += _varint(0) + _varint(0)
+        rec += _varint(_zigzag(100)) + _varint(_zigzag(0x1000))
+        rec += _varint(1)
+        rec += _varint(data)
+        if mem_addr is not None:
+            rec += _varint(_zigzag(mem_addr))
+        return rec
+
+    def test_int64_data(self):
+        # A 64 bit integer result must neither be dropped nor turn on the
+        # memory flag.
+        chunk = _string("system.cpu") + _string("\0add x1, x2\0IntAlu")
+        chunk += self.inst(8, 0x1234)
+        self.assertEqual(
+            self.decode(chunk),
+            "    100: system.cpu: T0 : 0x1000    : add x1, x2"
+            + " " * 16
+            + " : IntAlu :  D=0x0000000000001234\n",
+        )
+
+    def test_int64_data_with_memory(self):
+        chunk = _string("system.cpu") + _string("\0ldr x1, [x2]\0MemRead")
+        chunk += self.inst(8, 0x42, mem_addr=0x8000)
+        line = self.decode(chunk)
+        self.assertIn(" D=0x0000000000000042", line)
+        self.assertTrue(line.endswith(" A=0x8000\n"))
+
+
+if __name__ == "__main__":
+    unittest.main()
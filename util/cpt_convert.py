@@ -0,0 +1,236 @@
+#!/usr/bin/env python3
+# Copyright (c) 2026 The Regents of The University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Converts gem5 checkpoint files between the text and the binary formats,
+# e.g., to inspect or edit a binary checkpoint:
+#   cpt_convert.py m5out/cpt.1000/m5.cpt m5.cpt.txt
+#   cpt_convert.py m5.cpt.txt m5out/cpt.1000/m5.cpt
+#
+# The format of the output is the other one than the input's, unless
+# --to is given. Entries converted from text are stored as strings in
+# binary checkpoints, which gem5 parses as it does text ones.
+
+import argparse
+import struct
+import sys
+
+MAGIC = b"gem5bcp1"
+HEADER = struct.Struct("<8sQQ")
+
+STRING = 0
+APPEND = 1
+BOOL = 2
+INT = 3
+UINT = 4
+DOUBLE = 5
+BOOL_ARRAY = 6
+INT_ARRAY = 7
+UINT_ARRAY = 8
+DOUBLE_ARRAY = 9
+
+ELEMENT_TYPES = {
+    BOOL_ARRAY: BOOL,
+    INT_ARRAY: INT,
+    UINT_ARRAY: UINT,
+    DOUBLE_ARRAY: DOUBLE,
+}
+
+
+def read_varint(buf, pos):
+    val = 0
+    shift = 0
+    while True:
+        byte = buf[pos]
+        pos += 1
+        val |= (byte & 0x7F) << shift
+        if not byte & 0x80:
+            return val, pos
+        shift += 7
+
+
+def write_varint(out, val):
+    while val >= 0x80:
+        out.append((val & 0x7F) | 0x80)
+        val >>= 7
+    out.append(val)
+
+
+def unzigzag(val):
+    return (val >> 1) ^ -(val & 1)
+
+
+def show_scalar(kind, buf, pos):
+    """Render a scalar the way gem5 writes it in text checkpoints."""
+    if kind == DOUBLE:
+        (val,) = struct.unpack_from("<d", buf, pos)
+        return "%g" % val, pos + 8
+    val, pos = read_varint(buf, pos)
+    if kind == BOOL:
+        return ("true" if val else "false"), pos
+    if kind == INT:
+        val = unzigzag(val)
+    return str(val), pos
+
+
+def show_value(kind, buf):
+    if kind in (STRING, APPEND):
+        return bytes(buf).decode()
+    if kind not in ELEMENT_TYPES:
+        return show_scalar(kind, buf, 0)[0]
+    count, pos = read_varint(buf, 0)
+    elems = []
+    for _ in range(count):
+        elem, pos = show_scalar(ELEMENT_TYPES[kind], buf, pos)
+        elems.append(elem)
+    return " ".join(elems)
+
+
+def read_binary(data):
+    """Yield (section, [(name, is_append, value)]) for each extent."""
+    magic, index_offset, num_extents = HEADER.unpack_from(data, 0)
+    if magic != MAGIC:
+        sys.exit("Not a binary checkpoint")
+
+    pos = index_offset
+    for _ in range(num_extents):
+        length, pos = read_varint(data, pos)
+        section = bytes(data[pos : pos + length]).decode()
+        pos += length
+        offset, pos = read_varint(data, pos)
+        size, pos = read_varint(data, pos)
+
+        entries = []
+        entry_pos = offset
+        while entry_pos < offset + size:
+            length, entry_pos = read_varint(data, entry_pos)
+            name = bytes(data[entry_pos : entry_pos + length]).decode()
+            entry_pos += length
+            kind = data[entry_pos]
+            length, entry_pos = read_varint(data, entry_pos + 1)
+            value = data[entry_pos : entry_pos + length]
+            entry_pos += length
+            entries.append((name, kind == APPEND, show_value(kind, value)))
+        yield section, entries
+
+
+def read_text(data):
+    """Parse a text checkpoint as gem5's IniFile does."""
+    section = None
+    entries = None
+    for line in bytes(data).decode().splitlines():
+        line = line.strip()
+        if not line:
+            continue
+        if line.startswith("[") and line.endswith("]"):
+            if section is not None:
+                yield section, entries
+            section = line[1:-1].strip()
+            entries = []
+            continue
+        if section is None:
+            continue
+        name, sep, value = line.partition("=")
+        if not sep:
+            sys.exit(f"Can't parse checkpoint line '{line}'")
+        append = name.endswith("+")
+        if append:
+            name = name[:-1]
+        entries.append((name.strip(), append, value.strip()))
+    if section is not None:
+        yield section, entries
+
+
+def write_text(out, extents):
+    out.write(b"## checkpoint converted from the binary format\n")
+    for section, entries in extents:
+        out.write(f"\n[{section}]\n".encode())
+        for name, append, value in entries:
+            op = "+=" if append else "="
+            out.write(f"{name}{op}{value}\n".encode())
+
+
+def write_binary(out, extents):
+    out.write(bytes(HEADER.size))
+    offset = HEADER.size
+    num_extents = 0
+    index = bytearray()
+    for section, entries in extents:
+        data = bytearray()
+        for name, append, value in entries:
+            name = name.encode()
+            value = value.encode()
+            write_varint(data, len(name))
+            data += name
+            data.append(APPEND if append else STRING)
+            write_varint(data, len(value))
+            data += value
+        out.write(data)
+
+        section = section.encode()
+        write_varint(index, len(section))
+        index += section
+        write_varint(index, offset)
+        write_varint(index, len(data))
+        offset += len(data)
+        num_extents += 1
+    out.write(index)
+
+    out.seek(0)
+    out.write(HEADER.pack(MAGIC, offset, num_extents))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Convert checkpoint files between the text and the "
+        "binary formats"
+    )
+    parser.add_argument("input", help="checkpoint file to convert")
+    parser.add_argument("output", help="converted checkpoint file")
+    parser.add_argument(
+        "--to",
+        choices=["text", "binary"],
+        help="format of the output, the other one than the input's by "
+        "default",
+    )
+    args = parser.parse_args()
+
+    with open(args.input, "rb") as f:
+        data = memoryview(f.read())
+
+    binary_in = bytes(data[: len(MAGIC)]) == MAGIC
+    extents = read_binary(data) if binary_in else read_text(data)
+    to = args.to or ("text" if binary_in else "binary")
+
+    with open(args.output, "wb") as out:
+        if to == "text":
+            write_text(out, extents)
+        else:
+            write_binary(out, extents)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,208 @@
+#!/usr/bin/env python3
+# Copyright (c) 2026 The Regents of The University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Decodes the instruction traces recorded by the BinTracer to the text the
+# ExeTracer prints with the Exec debug flags, e.g.,
+#   decode_bin_trace.py m5out/inst_trace.bin.gz > trace.txt
+#
+# Records of different streams, i.e., of CPUs in different event queues,
+# are printed in the order their chunks were written.
+
+import argparse
+import gzip
+import struct
+import sys
+
+MAGIC = b"gem5bit2"
+
+STRING_DEF = 0
+INST = 1
+MACRO_INST = 2
+
+# Record header layout, see src/cpu/bin_trace_format.hh.
+KIND_MASK = 0x3
+MICROOP = 1 << 2
+PRED_FALSE = 1 << 3
+DATA_STATUS_SHIFT = 4
+DATA_STATUS_MASK = 0xF
+MEM = 1 << 8
+FETCH_SEQ = 1 << 9
+CP_SEQ = 1 << 10
+USER_MODE = 1 << 11
+CONTEXT = 1 << 12
+
+DATA_INVALID = 0
+DATA_REG = 5
+
+
+def read_varint(buf, pos):
+    val = 0
+    shift = 0
+    while True:
+        byte = buf[pos]
+        pos += 1
+        val |= (byte & 0x7F) << shift
+        if not byte & 0x80:
+            return val, pos
+        shift += 7
+
+
+def unzigzag(val):
+    return (val >> 1) ^ -(val & 1)
+
+
+class Stream:
+    """Decoding state of the records of one tracer."""
+
+    def __init__(self):
+        self.strings = []
+        self.when = 0
+        self.pc = 0
+        self.addr = 0
+        self.fetch_seq = 0
+        self.cp_seq = 0
+        self.cpu = ""
+        self.tid = 0
+
+    def decode(self, buf, args, out):
+        mask = (1 << 64) - 1
+        pos = 0
+        while pos < len(buf):
+            header, pos = read_varint(buf, pos)
+            kind = header & KIND_MASK
+            if kind == STRING_DEF:
+                size, pos = read_varint(buf, pos)
+                self.strings.append(buf[pos : pos + size].decode())
+                pos += size
+                continue
+
+            if header & CONTEXT:
+                cpu, pos = read_varint(buf, pos)
+                self.cpu = self.strings[cpu]
+                self.tid, pos = read_varint(buf, pos)
+            val, pos = read_varint(buf, pos)
+            self.when = (self.when + unzigzag(val)) & mask
+            val, pos = read_varint(buf, pos)
+            self.pc = (self.pc + unzigzag(val)) & mask
+            upc = None
+            if header & MICROOP:
+                upc, pos = read_varint(buf, pos)
+            inst, pos = read_varint(buf, pos)
+            symbol, disasm, op_class = self.strings[inst].split("\0")
+
+            line = f"T{self.tid} : {self.pc:#x}"
+            if args.symbols:
+                line += symbol
+            line += f".{upc:2d}" if upc is not None else "   "
+            line += f" : {disasm:<26}"
+
+            if kind == INST:
+                line += " : " + op_class + " : "
+                if header & PRED_FALSE:
+                    line += "Predicated False"
+                status = (header >> DATA_STATUS_SHIFT) & DATA_STATUS_MASK
+                if status == DATA_REG:
+                    size, pos = read_varint(buf, pos)
+                    line += " D=" + buf[pos : pos + size].decode()
+                    pos += size
+                elif status != DATA_INVALID:
+                    val, pos = read_varint(buf, pos)
+                    line += f" D={val:#018x}"
+                if header & MEM:
+                    val, pos = read_varint(buf, pos)
+                    self.addr = (self.addr + unzigzag(val)) & mask
+                    line += f" A={self.addr:#x}"
+                if header & FETCH_SEQ:
+                    val, pos = read_varint(buf, pos)
+                    self.fetch_seq += unzigzag(val)
+                    if args.seq:
+                        line += f"  FetchSeq={self.fetch_seq}"
+                if header & CP_SEQ:
+                    val, pos = read_varint(buf, pos)
+                    self.cp_seq += unzigzag(val)
+                    if args.seq:
+                        line += f"  CPSeq={self.cp_seq}"
+
+            if args.user_only and not header & USER_MODE:
+                continue
+            if args.kernel_only and header & USER_MODE:
+                continue
+            if args.no_micro and kind == INST and upc is not None:
+                continue
+
+            prefix = "" if args.no_ticks else f"{self.when:7d}: "
+            out.write(f"{prefix}{self.cpu}: {line}\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Decode a BinTracer instruction trace to text."
+    )
+    parser.add_argument("trace", help="Trace file")
+    parser.add_argument(
+        "--no-ticks", action="store_true", help="Omit the ticks"
+    )
+    parser.add_argument(
+        "--no-symbols", dest="symbols", action="store_false",
+        help="Omit the symbols",
+    )
+    parser.add_argument(
+        "--no-micro", action="store_true", help="Omit the microops"
+    )
+    parser.add_argument(
+        "--seq",
+        action="store_true",
+        help="Include the fetch and commit sequence numbers",
+    )
+    parser.add_argument(
+        "--user-only", action="store_true", help="Only user mode instructions"
+    )
+    parser.add_argument(
+        "--kernel-only",
+        action="store_true",
+        help="Only kernel mode instructions",
+    )
+    args = parser.parse_args()
+
+    with gzip.open(args.trace, "rb") as f:
+        data = f.read()
+    if data[: len(MAGIC)] != MAGIC:
+        sys.exit(f"{args.trace} is not a BinTracer trace")
+
+    streams = {}
+    pos = len(MAGIC)
+    out = sys.stdout
+    while pos < len(data):
+        stream_id, pos = read_varint(data, pos)
+        size, pos = read_varint(data, pos)
+        stream = streams.setdefault(stream_id, Stream())
+        stream.decode(data[pos : pos + size], args, out)
+        pos += size
+
+
+if __name__ == "__main__":
+    main()
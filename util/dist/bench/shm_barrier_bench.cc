@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2026 The Regents of The University of California
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * Measure the latency of dist-gem5 sync barriers over the shared memory
+ * transport, for increasing numbers of compute nodes.
+ *
+ * The benchmark forks a process per compute node, and runs the sync
+ * protocol of the switch in this process: a receiver thread per node
+ * counts the sync requests, and once all of them arrived, the switch
+ * sends an ack to every node, which then sends its next request. Each
+ * barrier is timed from the acks of the previous one to the last
+ * request, which is a round trip through all the rings.
+ *
+ * Usage: shm_barrier_bench [-i iterations] [-s spin_limit] [nodes...]
+ */
+
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "dev/net/shm_ring.hh"
+
+using namespace gem5;
+
+namespace
+{
+
+/** About the size of a dist-gem5 message header. */
+struct Msg
+{
+    uint64_t seq;
+    uint8_t pad[56];
+};
+
+const size_t RingSize = 64 * 1024;
+
+size_t
+slotSize()
+{
+    return (ShmRing::footprint(RingSize) + 63) & ~size_t(63);
+}
+
+void
+runNode(uint8_t *to_switch, uint8_t *to_node, unsigned iterations,
+        unsigned spin_limit)
+{
+    ShmRing tx(spin_limit), rx(spin_limit);
+    if (!tx.attach(to_switch) || !rx.attach(to_node))
+        _exit(1);
+
+    Msg msg = {};
+    for (uint64_t i = 0; i < iterations; i++) {
+        msg.seq = i;
+        if (!tx.write(&msg, sizeof(msg)) || !rx.read(&msg, sizeof(msg)) ||
+                msg.seq != i) {
+            _exit(1);
+        }
+    }
+    _exit(0);
+}
+
+/** Run the barriers with nodes processes, and return their latencies. */
+std::vector<double>
+runSwitch(unsigned nodes, unsigned iterations, unsigned spin_limit)
+{
+    const size_t slot = slotSize();
+    const size_t bytes = 2 * nodes * slot;
+    void *addr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (addr == MAP_FAILED) {
+        perror("mmap");
+        exit(1);
+    }
+    uint8_t *base = static_cast<uint8_t *>(addr);
+
+    std::vector<ShmRing> rx(nodes, ShmRing(spin_limit));
+    std::vector<ShmRing> tx(nodes, ShmRing(spin_limit));
+    for (unsigned n = 0; n < nodes; n++) {
+        rx[n].create(base + 2 * n * slot, RingSize);
+        tx[n].create(base + (2 * n + 1) * slot, RingSize);
+    }
+
+    std::vector<pid_t> pids;
+    for (unsigned n = 0; n < nodes; n++) {
+        pid_t pid = fork();
+        if (pid == -1) {
+            perror("fork");
+            exit(1);
+        } else if (pid == 0) {
+            runNode(base + 2 * n * slot, base + (2 * n + 1) * slot,
+                    iterations, spin_limit);
+        }
+        pids.push_back(pid);
+    }
+
+    // Like the receiver threads of DistIface::SyncSwitch.
+    std::mutex lock;
+    std::condition_variable cv;
+    unsigned waiting = nodes;
+    std::vector<std::thread> threads;
+    for (unsigned n = 0; n < nodes; n++) {
+        threads.emplace_back([&, n]() {
+            Msg msg;
+            for (unsigned i = 0; i < iterations; i++) {
+                if (!rx[n].read(&msg, sizeof(msg)) || msg.seq != i)
+                    abort();
+                std::lock_guard<std::mutex> guard(lock);
+                if (--waiting == 0)
+                    cv.notify_one();
+            }
+        });
+    }
+
+    using Clock = std::chrono::steady_clock;
+    std::vector<double> latencies;
+    Clock::time_point start;
+    Msg ack = {};
+    for (unsigned i = 0; i < iterations; i++) {
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            cv.wait(guard, [&]() { return waiting == 0; });
+            waiting = nodes;
+        }
+        if (i > 0) {
+            latencies.push_back(std::chrono::duration<double, std::micro>(
+                        Clock::now() - start).count());
+        }
+        start = Clock::now();
+        ack.seq = i;
+        for (auto &ring: tx) {
+            if (!ring.write(&ack, sizeof(ack)))
+                abort();
+        }
+    }
+
+    for (auto &thread: threads)
+        thread.join();
+    for (auto pid: pids) {
+        int status;
+        if (waitpid(pid, &status, 0) == -1 || !WIFEXITED(status) ||
+                WEXITSTATUS(status) != 0) {
+            fprintf(stderr, "Node process %d failed\n", (int)pid);
+            exit(1);
+        }
+    }
+    munmap(addr, bytes);
+    return latencies;
+}
+
+} // anonymous namespace
+
+int
+main(int argc, char **argv)
+{
+    unsigned iterations = 10000;
+    unsigned spin_limit = 4096;
+    int opt;
+    while ((opt = getopt(argc, argv, "i:s:")) != -1) {
+        switch (opt) {
+          case 'i':
+            iterations = atoi(optarg);
+            break;
+          case 's':
+            spin_limit = atoi(optarg);
+            break;
+          default:
+            fprintf(stderr, "Usage: %s [-i iterations] [-s spin_limit] "
+                    "[nodes...]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (iterations < 2) {
+        fprintf(stderr, "At least 2 iterations are needed\n");
+        return 1;
+    }
+
+    std::vector<unsigned> node_counts;
+    for (int i = optind; i < argc; i++)
+        node_counts.push_back(atoi(argv[i]));
+    if (node_counts.empty())
+        node_counts = {2, 4, 8, 16, 32, 64};
+
+    printf("%6s %12s %12s %12s %12s\n", "nodes", "mean (us)", "p50 (us)",
+           "p99 (us)", "max (us)");
+    for (auto nodes: node_counts) {
+        auto latencies = runSwitch(nodes, iterations, spin_limit);
+        std::sort(latencies.begin(), latencies.end());
+        double sum = 0;
+        for (auto latency: latencies)
+            sum += latency;
+        printf("%6u %12.2f %12.2f %12.2f %12.2f\n", nodes,
+               sum / latencies.size(), latencies[latencies.size() / 2],
+               latencies[latencies.size() * 99 / 100], latencies.back());
+        fflush(stdout);
+    }
+    return 0;
+}
@@ -0,0 +1,192 @@
+#!/usr/bin/env python3
+# Copyright (c) 2026 The Regents of The University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Exports the statistics written by the columnar stats output, e.g., with
+# --stats-file=col://stats.col, to a table with one row per dump and one
+# column per stat value:
+#   stats_columnar.py m5out/stats.col stats.parquet
+#
+# The format is picked from the extension of the output: Parquet (.parquet)
+# and Arrow IPC (.arrow, .feather) require pyarrow, and anything else is
+# written as CSV. When the stats dumped change, the columns of the previous
+# dumps are kept, and are empty in the dumps which don't have them.
+
+import argparse
+import csv
+import struct
+import sys
+
+MAGIC = b"gem5col1"
+
+SCHEMA = ord("S")
+DUMP = ord("D")
+
+
+def read_varint(buf, pos):
+    val = 0
+    shift = 0
+    while True:
+        byte = buf[pos]
+        pos += 1
+        val |= (byte & 0x7F) << shift
+        if not byte & 0x80:
+            return val, pos
+        shift += 7
+
+
+def read_string(buf, pos):
+    size, pos = read_varint(buf, pos)
+    return bytes(buf[pos : pos + size]).decode(), pos + size
+
+
+def read_dumps(data):
+    """Yields the schema and the tick and values of each dump."""
+
+    if data[: len(MAGIC)] != MAGIC:
+        sys.exit("Not a columnar statistics file")
+
+    pos = len(MAGIC)
+    schema = []
+    bits = []
+    while pos < len(data):
+        kind = data[pos]
+        size, pos = read_varint(data, pos + 1)
+        end = pos + size
+        if end > len(data):
+            # Truncated by a simulation which didn't exit cleanly.
+            break
+
+        if kind == SCHEMA:
+            count, pos = read_varint(data, pos)
+            schema = []
+            for _ in range(count):
+                name, pos = read_string(data, pos)
+                unit, pos = read_string(data, pos)
+                desc, pos = read_string(data, pos)
+                schema.append((name, unit, desc))
+            bits = [0] * count
+        elif kind == DUMP:
+            tick, pos = read_varint(data, pos)
+            changes, pos = read_varint(data, pos)
+            index = 0
+            for _ in range(changes):
+                gap, pos = read_varint(data, pos)
+                delta, pos = read_varint(data, pos)
+                index += gap
+                bits[index] ^= delta
+            values = [
+                struct.unpack("<d", struct.pack("<Q", b))[0] for b in bits
+            ]
+            yield schema, tick, values
+        else:
+            sys.exit(f"Unknown record {kind:#x} at offset {pos}")
+        pos = end
+
+
+def read_table(path):
+    """Returns the column names, their units and descriptions, and the
+    rows of the dumps."""
+
+    with open(path, "rb") as f:
+        data = memoryview(f.read())
+
+    columns = {}
+    rows = []
+    for schema, tick, values in read_dumps(data):
+        row = {"tick": tick}
+        for (name, unit, desc), value in zip(schema, values):
+            columns.setdefault(name, (unit, desc))
+            row[name] = value
+        rows.append(row)
+    return columns, rows
+
+
+def write_arrow(columns, rows, path, fmt):
+    import pyarrow as pa
+
+    fields = [pa.field("tick", pa.uint64())]
+    arrays = [pa.array([row["tick"] for row in rows], pa.uint64())]
+    for name, (unit, desc) in columns.items():
+        meta = {"unit": unit}
+        if desc:
+            meta["description"] = desc
+        fields.append(pa.field(name, pa.float64(), metadata=meta))
+        arrays.append(pa.array([row.get(name) for row in rows], pa.float64()))
+    table = pa.Table.from_arrays(arrays, schema=pa.schema(fields))
+
+    if fmt == "parquet":
+        import pyarrow.parquet as pq
+
+        pq.write_table(table, path)
+    else:
+        import pyarrow.feather as feather
+
+        feather.write_feather(table, path)
+
+
+def write_csv(columns, rows, path):
+    with open(path, "w", newline="") as f:
+        writer = csv.DictWriter(f, fieldnames=["tick"] + list(columns))
+        writer.writeheader()
+        writer.writerows(rows)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Export columnar gem5 statistics to Parquet, Arrow or "
+        "CSV"
+    )
+    parser.add_argument("stats", help="columnar statistics file")
+    parser.add_argument("output", help="output table")
+    parser.add_argument(
+        "--format",
+        choices=["parquet", "arrow", "csv"],
+        help="format of the output, from its extension by default",
+    )
+    args = parser.parse_args()
+
+    fmt = args.format
+    if fmt is None:
+        if args.output.endswith(".parquet"):
+            fmt = "parquet"
+        elif args.output.endswith((".arrow", ".feather")):
+            fmt = "arrow"
+        else:
+            fmt = "csv"
+
+    columns, rows = read_table(args.stats)
+    if fmt == "csv":
+        write_csv(columns, rows, args.output)
+    else:
+        try:
+            write_arrow(columns, rows, args.output, fmt)
+        except ImportError:
+            sys.exit(f"pyarrow is required for {fmt} outputs")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,182 @@
+#!/usr/bin/env python3
+# Copyright (c) 2026 The Regents of The University of California
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Polls the stats which gem5 publishes to shared memory with a stats file
+# like shm://gem5_stats, and prints their values after every dump, e.g.,
+#   stats_shm.py gem5_stats --stats 'ipc$' 'overallMissRate'
+#
+# The simulation isn't slowed down by monitors, which only read the
+# shared memory segment.
+
+import argparse
+import mmap
+import os
+import re
+import struct
+import sys
+import time
+
+MAGIC = b"gem5shm1"
+
+# magic, valid, numColumns, numSlots, namesOffset, namesSize, slotsOffset,
+# slotSize, numDumps
+HEADER = struct.Struct("=8s8Q")
+VALID_OFFSET = 8
+NUM_DUMPS_OFFSET = 64
+
+SLOT_SEQ = 0
+SLOT_TICK = 8
+SLOT_VALUES = 16
+
+
+class Ring:
+    """Reader of a stats ring in shared memory."""
+
+    def __init__(self, name):
+        path = os.path.join("/dev/shm", name.lstrip("/"))
+        with open(path, "rb") as f:
+            self.mem = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+
+        (
+            magic,
+            self.valid,
+            num_columns,
+            self.num_slots,
+            names_offset,
+            names_size,
+            self.slots_offset,
+            self.slot_size,
+            _,
+        ) = HEADER.unpack_from(self.mem)
+        if magic != MAGIC:
+            sys.exit(f"{path} isn't a gem5 stats ring")
+
+        strings = self.mem[names_offset : names_offset + names_size]
+        strings = strings.decode().split("\0")
+        self.columns = strings[0 : 2 * num_columns : 2]
+        self.units = strings[1 : 2 * num_columns : 2]
+        self.values = struct.Struct(f"={num_columns}d")
+
+    def is_valid(self):
+        return struct.unpack_from("=Q", self.mem, VALID_OFFSET)[0] == 1
+
+    def num_dumps(self):
+        return struct.unpack_from("=Q", self.mem, NUM_DUMPS_OFFSET)[0]
+
+    def read(self, dump):
+        """Returns the tick and the values of a dump, or None if it was
+        overwritten."""
+
+        offset = self.slots_offset + (dump % self.num_slots) * self.slot_size
+        while True:
+            seq = struct.unpack_from("=Q", self.mem, offset + SLOT_SEQ)[0]
+            if seq & 1:
+                continue
+            data = self.mem[offset : offset + self.slot_size]
+            if struct.unpack_from("=Q", self.mem, offset + SLOT_SEQ)[0] != seq:
+                continue
+            if self.num_dumps() - dump > self.num_slots:
+                return None
+            tick = struct.unpack_from("=Q", data, SLOT_TICK)[0]
+            return tick, self.values.unpack_from(data, SLOT_VALUES)
+
+    def close(self):
+        self.mem.close()
+
+
+def open_ring(name, interval):
+    while True:
+        try:
+            ring = Ring(name)
+            if ring.is_valid():
+                return ring
+            ring.close()
+        except (FileNotFoundError, ValueError):
+            pass
+        time.sleep(interval)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Monitor the stats gem5 publishes to shared memory"
+    )
+    parser.add_argument("name", help="name of the shared memory segment")
+    parser.add_argument(
+        "--stats",
+        nargs="*",
+        default=[],
+        help="regular expressions of the stats to print, all by default",
+    )
+    parser.add_argument(
+        "--interval",
+        type=float,
+        default=0.5,
+        help="polling interval in seconds",
+    )
+    parser.add_argument(
+        "--once",
+        action="store_true",
+        help="print the last dump and exit",
+    )
+    args = parser.parse_args()
+    patterns = [re.compile(s) for s in args.stats]
+
+    ring = None
+    last = 0
+    while True:
+        if ring is None or not ring.is_valid():
+            # The stats published changed, or gem5 restarted.
+            if ring is not None:
+                ring.close()
+            ring = open_ring(args.name, args.interval)
+            selected = [
+                i
+                for i, name in enumerate(ring.columns)
+                if not patterns or any(p.search(name) for p in patterns)
+            ]
+            last = max(ring.num_dumps() - 1, 0)
+
+        num_dumps = ring.num_dumps()
+        for dump in range(max(last, num_dumps - ring.num_slots), num_dumps):
+            result = ring.read(dump)
+            if result is None:
+                continue
+            tick, values = result
+            print(f"---------- tick {tick} ----------")
+            for i in selected:
+                name, unit = ring.columns[i], ring.units[i]
+                print(f"{name:<60} {values[i]:>16g} {unit}")
+            sys.stdout.flush()
+        last = num_dumps
+
+        if args.once and num_dumps:
+            return
+        time.sleep(args.interval)
+
+
+if __name__ == "__main__":
+    main()